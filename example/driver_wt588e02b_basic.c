@@ -37,6 +37,40 @@
 #include "driver_wt588e02b_basic.h"
 
 static wt588e02b_handle_t gs_handle;        /**< wt588e02b handle */
+#if (WT588E02B_FEATURE_UPDATE != 0)
+static uint8_t gs_buf[512];                 /**< update buffer */
+#endif
+
+/**
+ * @brief wt588e02b ops table, it is const and lives in flash
+ */
+static const wt588e02b_ops_t gs_ops =
+{
+    .sclk_gpio_init = wt588e02b_interface_sclk_gpio_init,
+    .sclk_gpio_deinit = wt588e02b_interface_sclk_gpio_deinit,
+    .sclk_gpio_write = wt588e02b_interface_sclk_gpio_write,
+    .mosi_gpio_init = wt588e02b_interface_mosi_gpio_init,
+    .mosi_gpio_deinit = wt588e02b_interface_mosi_gpio_deinit,
+    .mosi_gpio_write = wt588e02b_interface_mosi_gpio_write,
+    .miso_gpio_init = wt588e02b_interface_miso_gpio_init,
+    .miso_gpio_deinit = wt588e02b_interface_miso_gpio_deinit,
+    .miso_gpio_read = wt588e02b_interface_miso_gpio_read,
+    .cs_gpio_init = wt588e02b_interface_cs_gpio_init,
+    .cs_gpio_deinit = wt588e02b_interface_cs_gpio_deinit,
+    .cs_gpio_write = wt588e02b_interface_cs_gpio_write,
+    .bin_read_init = wt588e02b_interface_bin_read_init,
+    .bin_read = wt588e02b_interface_bin_read,
+    .bin_read_deinit = wt588e02b_interface_bin_read_deinit,
+    .delay_ms = wt588e02b_interface_delay_ms,
+    .delay_us = wt588e02b_interface_delay_us,
+    .debug_print = wt588e02b_interface_debug_print,
+    .timestamp_ms = wt588e02b_interface_timestamp_ms,
+    .lock = wt588e02b_interface_lock,
+    .unlock = wt588e02b_interface_unlock,
+#if (WT588E02B_INTERFACE_FRAME_TRANSFER != 0)
+    .frame_transfer = wt588e02b_interface_frame_transfer,
+#endif
+};
 
 /**
  * @brief  basic example init
@@ -51,24 +85,10 @@ uint8_t wt588e02b_basic_init(void)
     
     /* link driver */
     DRIVER_WT588E02B_LINK_INIT(&gs_handle, wt588e02b_handle_t);
-    DRIVER_WT588E02B_LINK_SCLK_GPIO_INIT(&gs_handle, wt588e02b_interface_sclk_gpio_init);
-    DRIVER_WT588E02B_LINK_SCLK_GPIO_DEINIT(&gs_handle, wt588e02b_interface_sclk_gpio_deinit);
-    DRIVER_WT588E02B_LINK_SCLK_GPIO_WRITE(&gs_handle, wt588e02b_interface_sclk_gpio_write);
-    DRIVER_WT588E02B_LINK_MOSI_GPIO_INIT(&gs_handle, wt588e02b_interface_mosi_gpio_init);
-    DRIVER_WT588E02B_LINK_MOSI_GPIO_DEINIT(&gs_handle, wt588e02b_interface_mosi_gpio_deinit);
-    DRIVER_WT588E02B_LINK_MOSI_GPIO_WRITE(&gs_handle, wt588e02b_interface_mosi_gpio_write);
-    DRIVER_WT588E02B_LINK_MISO_GPIO_INIT(&gs_handle, wt588e02b_interface_miso_gpio_init);
-    DRIVER_WT588E02B_LINK_MISO_GPIO_DEINIT(&gs_handle, wt588e02b_interface_miso_gpio_deinit);
-    DRIVER_WT588E02B_LINK_MISO_GPIO_READ(&gs_handle, wt588e02b_interface_miso_gpio_read);
-    DRIVER_WT588E02B_LINK_CS_GPIO_INIT(&gs_handle, wt588e02b_interface_cs_gpio_init);
-    DRIVER_WT588E02B_LINK_CS_GPIO_DEINIT(&gs_handle, wt588e02b_interface_cs_gpio_deinit);
-    DRIVER_WT588E02B_LINK_CS_GPIO_WRITE(&gs_handle, wt588e02b_interface_cs_gpio_write);
-    DRIVER_WT588E02B_LINK_BIN_READ_INIT(&gs_handle, wt588e02b_interface_bin_read_init);
-    DRIVER_WT588E02B_LINK_BIN_READ(&gs_handle, wt588e02b_interface_bin_read);
-    DRIVER_WT588E02B_LINK_BIN_READ_DEINIT(&gs_handle, wt588e02b_interface_bin_read_deinit);
-    DRIVER_WT588E02B_LINK_DELAY_MS(&gs_handle, wt588e02b_interface_delay_ms);
-    DRIVER_WT588E02B_LINK_DELAY_US(&gs_handle, wt588e02b_interface_delay_us);
-    DRIVER_WT588E02B_LINK_DEBUG_PRINT(&gs_handle, wt588e02b_interface_debug_print);
+    DRIVER_WT588E02B_LINK_OPS(&gs_handle, &gs_ops);
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    DRIVER_WT588E02B_LINK_BUFFER(&gs_handle, gs_buf);
+#endif
     
     /* init */
     res = wt588e02b_init(&gs_handle);
@@ -208,6 +228,7 @@ uint8_t wt588e02b_basic_set_vol(uint8_t vol)
     return 0;
 }
 
+#if (WT588E02B_FEATURE_LOOP != 0)
 /**
  * @brief     basic example play loop
  * @param[in] ind index
@@ -302,6 +323,7 @@ uint8_t wt588e02b_basic_play_loop_all(void)
     
     return 0;
 }
+#endif
 
 /**
  * @brief  basic example stop
@@ -324,6 +346,7 @@ uint8_t wt588e02b_basic_stop(void)
     return 0;
 }
 
+#if (WT588E02B_FEATURE_UPDATE != 0)
 /**
  * @brief     basic example update
  * @param[in] ind index
@@ -368,6 +391,7 @@ uint8_t wt588e02b_basic_update_all(char *path)
     
     return 0;
 }
+#endif
 
 /**
  * @brief  basic example deinit
@@ -83,6 +83,7 @@ uint8_t wt588e02b_basic_deinit(void);
  */
 uint8_t wt588e02b_basic_play(uint8_t ind);
 
+#if (WT588E02B_FEATURE_LOOP != 0)
 /**
  * @brief     basic example play loop
  * @param[in] ind index
@@ -111,6 +112,7 @@ uint8_t wt588e02b_basic_play_loop_advance(uint8_t ind);
  * @note   none
  */
 uint8_t wt588e02b_basic_play_loop_all(void);
+#endif
 
 /**
  * @brief     basic example play list
@@ -151,6 +153,7 @@ uint8_t wt588e02b_basic_stop(void);
  */
 uint8_t wt588e02b_basic_set_vol(uint8_t vol);
 
+#if (WT588E02B_FEATURE_UPDATE != 0)
 /**
  * @brief     basic example update
  * @param[in] ind index
@@ -171,6 +174,7 @@ uint8_t wt588e02b_basic_update(uint8_t ind, char *path);
  * @note      none
  */
 uint8_t wt588e02b_basic_update_all(char *path);
+#endif
 
 /**
  * @}
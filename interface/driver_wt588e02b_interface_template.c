@@ -246,6 +246,89 @@ uint8_t wt588e02b_interface_bin_read_deinit(void)
     return 0;
 }
 
+/**
+ * @brief  interface timestamp ms
+ * @return current time in ms
+ * @note   used by the duration profiler, it may wrap around
+ */
+uint32_t wt588e02b_interface_timestamp_ms(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface lock
+ * @param[in] wait 1 blocks until the lock is taken, 0 only tries once
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      used when several threads share the handle
+ */
+uint8_t wt588e02b_interface_lock(uint8_t wait)
+{
+    return 0;
+}
+
+/**
+ * @brief  interface unlock
+ * @return status code
+ *         - 0 success
+ *         - 1 unlock failed
+ * @note   none
+ */
+uint8_t wt588e02b_interface_unlock(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface frame transfer
+ * @param[in]  *tx pointer to the bytes to clock out
+ * @param[out] *rx pointer to a sampled byte buffer, NULL skips the miso sampling
+ * @param[in]  len byte number
+ * @param[in]  us half period of the clock in us
+ * @param[in]  gap_us idle time before every byte in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame transfer failed
+ * @note       cs is already low, every byte goes out msb first and miso is sampled after every falling edge,
+ *             it is only linked when WT588E02B_INTERFACE_FRAME_TRANSFER is 1, so a port without a waveform
+ *             engine keeps the bit by bit path, this stub fails so a wrong link is never silent
+ */
+uint8_t wt588e02b_interface_frame_transfer(uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t us, uint32_t gap_us)
+{
+    return 1;
+}
+
+/**
+ * @brief     interface cs gpio write of several chips
+ * @param[in] mask chip mask
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      only used by a shared bus, every cs in the mask should change with one gpio write,
+ *            it is only linked when the board wires several chips to one sclk and mosi
+ */
+uint8_t wt588e02b_interface_cs_gpio_write_mask(uint32_t mask, uint8_t data)
+{
+    return 1;
+}
+
+/**
+ * @brief      interface miso gpio read of several chips
+ * @param[out] *data pointer to a level mask buffer, one bit per chip
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       only used by a shared bus, every miso should be sampled with one gpio read,
+ *             it is only linked when the board wires several chips to one sclk and mosi
+ */
+uint8_t wt588e02b_interface_miso_gpio_read_mask(uint32_t *data)
+{
+    return 1;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -0,0 +1,604 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      wt588e02b_async.hpp
+ * @brief     wt588e02b async header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef WT588E02B_ASYNC_HPP
+#define WT588E02B_ASYNC_HPP
+
+#include "driver_wt588e02b.h"
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#if (WT588E02B_FEATURE_STEP == 0)
+#error "the async facade drives the commands through the step api, enable WT588E02B_FEATURE_STEP"
+#endif
+
+/**
+ * @defgroup wt588e02b_async wt588e02b async function
+ * @brief    wt588e02b c++20 coroutine facade modules
+ * @{
+ */
+
+namespace wt588e02b
+{
+
+/**
+ * @brief wt588e02b async poll definition
+ */
+constexpr uint32_t ASYNC_POLL_MS = 100;        /**< default busy poll period, the same as wt588e02b_basic_poll */
+
+/**
+ * @brief lazy coroutine task class definition
+ * @note  the body starts when the task is awaited and resumes the awaiting coroutine when it returns,
+ *        an exception in the body terminates, the results are the status codes of the c driver
+ */
+template <typename T>
+class [[nodiscard]] task
+{
+  public:
+    /**
+     * @brief task promise structure definition
+     */
+    struct promise_type
+    {
+        T value{};                                                            /**< returned value */
+        std::coroutine_handle<> continuation = std::noop_coroutine();         /**< awaiting coroutine */
+        
+        task get_return_object() noexcept
+        {
+            return task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+        
+        /**
+         * @brief final awaiter structure definition
+         */
+        struct final_awaiter
+        {
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+            {
+                return h.promise().continuation;                              /* symmetric transfer back */
+            }
+            void await_resume() noexcept
+            {
+            }
+        };
+        
+        final_awaiter final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_value(T v) noexcept
+        {
+            value = std::move(v);
+        }
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+    
+    task(task &&other) noexcept : m_handle(std::exchange(other.m_handle, {}))
+    {
+    }
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+    ~task()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+    {
+        m_handle.promise().continuation = continuation;                       /* resume the caller at the end */
+        
+        return m_handle;                                                      /* start the body */
+    }
+    T await_resume() noexcept
+    {
+        return std::move(m_handle.promise().value);
+    }
+    
+  private:
+    explicit task(std::coroutine_handle<promise_type> h) noexcept : m_handle(h)
+    {
+    }
+    
+    std::coroutine_handle<promise_type> m_handle;                             /**< coroutine frame */
+};
+
+/**
+ * @brief detached coroutine structure definition
+ * @note  the root of a coroutine tree, it starts at once and frees itself when it returns
+ */
+struct detached
+{
+    /**
+     * @brief detached promise structure definition
+     */
+    struct promise_type
+    {
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() noexcept
+        {
+        }
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief      start a task on the current thread
+ * @param[in]  t task to start
+ * @param[out] *result pointer to a result buffer, it can be NULL
+ * @return     detached root
+ * @note       the task runs until its first wait, the scheduler resumes it from then on
+ */
+template <typename T>
+detached spawn(task<T> t, T *result = nullptr)
+{
+    T value = co_await t;
+    
+    if (result != nullptr)
+    {
+        *result = value;
+    }
+}
+
+/**
+ * @brief scheduler class definition
+ * @note  a timer heap of suspended coroutines, the clock and the way to wait are given by the derived class,
+ *        all coroutines of one scheduler run on the thread which calls run or dispatch
+ */
+class scheduler
+{
+  public:
+    /**
+     * @brief sleep awaiter structure definition
+     */
+    struct sleep_awaiter
+    {
+        scheduler &sched;                                                     /**< owner scheduler */
+        uint64_t deadline_us;                                                 /**< wake up time */
+        
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            sched.resume_at(deadline_us, h);
+        }
+        void await_resume() const noexcept
+        {
+        }
+    };
+    
+    virtual ~scheduler() = default;
+    
+    /**
+     * @brief  get the scheduler time
+     * @return time in us
+     * @note   none
+     */
+    virtual uint64_t now_us() = 0;
+    
+    /**
+     * @brief     resume a coroutine at a time
+     * @param[in] deadline_us wake up time
+     * @param[in] h coroutine handle
+     * @note      coroutines with the same deadline are resumed in order
+     */
+    void resume_at(uint64_t deadline_us, std::coroutine_handle<> h);
+    
+    /**
+     * @brief     sleep for a while
+     * @param[in] us sleep time in us
+     * @return    awaiter
+     * @note      none
+     */
+    sleep_awaiter sleep_us(uint64_t us)
+    {
+        return sleep_awaiter{*this, now_us() + us};
+    }
+    
+    /**
+     * @brief     sleep until a time
+     * @param[in] deadline_us wake up time
+     * @return    awaiter
+     * @note      a deadline in the past only yields
+     */
+    sleep_awaiter sleep_until(uint64_t deadline_us)
+    {
+        return sleep_awaiter{*this, deadline_us};
+    }
+    
+    /**
+     * @brief  resume every due coroutine
+     * @note   it never waits, so it can be called from the event loop of the application
+     */
+    virtual void dispatch();
+    
+    /**
+     * @brief  run until no coroutine is waiting
+     * @note   none
+     */
+    void run();
+    
+    /**
+     * @brief  get the resumed coroutine number
+     * @return resumed number
+     * @note   none
+     */
+    uint64_t resumes() const noexcept
+    {
+        return m_resumes;
+    }
+    
+  protected:
+    /**
+     * @brief     wait until a time
+     * @param[in] deadline_us wake up time
+     * @note      it may return early, run checks the clock again
+     */
+    virtual void wait_until(uint64_t deadline_us) = 0;
+    
+    /**
+     * @brief     the earliest deadline changed
+     * @param[in] deadline_us earliest wake up time
+     * @note      none
+     */
+    virtual void earliest(uint64_t deadline_us)
+    {
+        (void)deadline_us;
+    }
+    
+  private:
+    /**
+     * @brief timer structure definition
+     */
+    struct timer
+    {
+        uint64_t deadline_us;                                                 /**< wake up time */
+        uint64_t seq;                                                         /**< insert order */
+        std::coroutine_handle<> handle;                                       /**< suspended coroutine */
+    };
+    
+    /**
+     * @brief timer order structure definition
+     */
+    struct later
+    {
+        bool operator()(const timer &a, const timer &b) const noexcept
+        {
+            return (a.deadline_us != b.deadline_us) ? (a.deadline_us > b.deadline_us) : (a.seq > b.seq);
+        }
+    };
+    
+    std::priority_queue<timer, std::vector<timer>, later> m_timers;           /**< timer heap */
+    uint64_t m_seq = 0;                                                       /**< next insert order */
+    uint64_t m_resumes = 0;                                                   /**< resumed number */
+};
+
+/**
+ * @brief virtual clock scheduler class definition
+ * @note  waiting only moves the clock forward, the mock chip clock or a bench clock can be plugged in,
+ *        time spent in the bit banged bytes moves the same clock through the delay hooks
+ */
+class virtual_scheduler : public scheduler
+{
+  public:
+    /**
+     * @brief     virtual scheduler constructor
+     * @param[in] *now pointer to a clock read function
+     * @param[in] *advance pointer to a clock advance function
+     * @note      none
+     */
+    virtual_scheduler(uint64_t (*now)(void), void (*advance)(uint64_t us)) : m_now(now), m_advance(advance)
+    {
+    }
+    uint64_t now_us() override
+    {
+        return m_now();
+    }
+    
+  protected:
+    void wait_until(uint64_t deadline_us) override;
+    
+  private:
+    uint64_t (*m_now)(void);                                                  /**< clock read */
+    void (*m_advance)(uint64_t us);                                           /**< clock advance */
+};
+
+/**
+ * @brief epoll scheduler class definition
+ * @note  one timerfd armed at the earliest deadline inside one epoll fd, an application with its own
+ *        event loop adds fd() to its loop and calls dispatch when it is readable instead of calling run
+ */
+class epoll_scheduler : public scheduler
+{
+  public:
+    epoll_scheduler();
+    ~epoll_scheduler() override;
+    epoll_scheduler(const epoll_scheduler &) = delete;
+    epoll_scheduler &operator=(const epoll_scheduler &) = delete;
+    
+    /**
+     * @brief  check the scheduler
+     * @return true if the epoll and timerfd were created
+     * @note   none
+     */
+    bool ok() const noexcept
+    {
+        return (m_epoll >= 0) && (m_timer >= 0);
+    }
+    
+    /**
+     * @brief  get the pollable fd
+     * @return epoll fd
+     * @note   it is readable when a deadline is due
+     */
+    int fd() const noexcept
+    {
+        return m_epoll;
+    }
+    uint64_t now_us() override;
+    void dispatch() override;
+    
+  protected:
+    void wait_until(uint64_t deadline_us) override;
+    void earliest(uint64_t deadline_us) override;
+    
+  private:
+    int m_epoll;                                                              /**< epoll fd */
+    int m_timer;                                                              /**< timerfd */
+};
+
+/**
+ * @brief async mutex class definition
+ * @note  serializes the frames of one chip between the coroutines of one scheduler, cs is held low
+ *        across waits, so a second frame must not start until the first one ends
+ */
+class async_mutex
+{
+  public:
+    /**
+     * @brief lock guard class definition
+     */
+    class guard
+    {
+      public:
+        explicit guard(async_mutex *mutex) noexcept : m_mutex(mutex)
+        {
+        }
+        guard(guard &&other) noexcept : m_mutex(std::exchange(other.m_mutex, nullptr))
+        {
+        }
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+        ~guard()
+        {
+            if (m_mutex != nullptr)
+            {
+                m_mutex->unlock();
+            }
+        }
+        
+      private:
+        async_mutex *m_mutex;                                                 /**< locked mutex */
+    };
+    
+    /**
+     * @brief lock awaiter structure definition
+     */
+    struct lock_awaiter
+    {
+        async_mutex &mutex;                                                   /**< mutex to lock */
+        
+        bool await_ready() noexcept
+        {
+            if (mutex.m_locked)
+            {
+                return false;
+            }
+            mutex.m_locked = true;                                            /* take it at once */
+            
+            return true;
+        }
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            mutex.m_waiters.push_back(h);                                     /* the owner hands it over */
+        }
+        guard await_resume() noexcept
+        {
+            return guard(&mutex);
+        }
+    };
+    
+    explicit async_mutex(scheduler &sched) noexcept : m_sched(sched)
+    {
+    }
+    
+    /**
+     * @brief  lock the mutex
+     * @return awaiter of a guard which unlocks when it is destroyed
+     * @note   waiters are served in order
+     */
+    lock_awaiter lock() noexcept
+    {
+        return lock_awaiter{*this};
+    }
+    
+  private:
+    void unlock();
+    
+    scheduler &m_sched;                                                       /**< scheduler of the waiters */
+    bool m_locked = false;                                                    /**< locked flag */
+    std::deque<std::coroutine_handle<>> m_waiters;                            /**< waiting coroutines */
+};
+
+/**
+ * @brief async device class definition
+ * @note  the commands are driven through the step api of the driver, the 5ms cs lead, the update gaps and
+ *        the busy polling are awaited on the scheduler instead of the delay hooks, the bytes themselves are
+ *        still clocked synchronously through the gpio hooks, so the thread only blocks for the bit banged bytes,
+ *        the handle lock is held while a command waits, so another thread using the blocking api waits for it
+ *        and the same thread must not drive the handle through the blocking api at the same time
+ */
+class device
+{
+  public:
+    /**
+     * @brief     async device constructor
+     * @param[in] &sched scheduler of the device
+     * @param[in] *handle pointer to an initialized wt588e02b handle structure
+     * @note      none
+     */
+    device(scheduler &sched, wt588e02b_handle_t *handle) noexcept : m_sched(sched), m_handle(handle), m_mutex(sched)
+    {
+    }
+    
+    /**
+     * @brief     play audio
+     * @param[in] ind index
+     * @return    status code
+     *            - 0 success
+     *            - 1 play failed
+     *            - 2 handle is NULL
+     *            - 3 handle is not initialized
+     *            - 4 ind > 0xDF
+     *            - 5 chip is busy
+     * @note      the same codes as wt588e02b_play
+     */
+    task<uint8_t> play(uint8_t ind);
+    
+    /**
+     * @brief  stop playing
+     * @return status code
+     *         - 0 success
+     *         - 1 stop failed
+     *         - 2 handle is NULL
+     *         - 3 handle is not initialized
+     * @note   none
+     */
+    task<uint8_t> stop();
+    
+    /**
+     * @brief     wait until the chip is idle
+     * @param[in] timeout_ms timeout in ms, 0 means no timeout
+     * @return    status code
+     *            - 0 success
+     *            - 1 check busy failed
+     *            - 2 handle is NULL
+     *            - 3 handle is not initialized
+     *            - 4 timeout
+     * @note      it sleeps one poll period before the first check, so a play which has just been sent
+     *            has raised busy before it is read
+     */
+    task<uint8_t> wait_idle(uint32_t timeout_ms = 0);
+    
+    /**
+     * @brief     update all audio
+     * @param[in] *path pointer to a path buffer
+     * @return    status code
+     *            - 0 success
+     *            - 1 update failed
+     *            - 2 handle is NULL
+     *            - 3 handle is not initialized
+     *            - 4 bin read init failed or the update is not linked
+     *            - 5 bin size is invalid
+     * @note      the same codes as wt588e02b_update_all, the chip is held for the whole update,
+     *            a linked frame_transfer sends the packets and the status reads as whole frames
+     */
+    task<uint8_t> update_all(char *path);
+    
+    /**
+     * @brief     set the busy poll period
+     * @param[in] ms poll period in ms
+     * @note      none
+     */
+    void set_poll(uint32_t ms) noexcept
+    {
+        m_poll_ms = (ms == 0) ? 1 : ms;
+    }
+    
+  private:
+    task<uint8_t> run(uint8_t res, wt588e02b_step_t *step);
+    uint8_t check(void) const noexcept;
+    
+    scheduler &m_sched;                                                       /**< scheduler */
+    wt588e02b_handle_t *m_handle;                                             /**< driver handle */
+    async_mutex m_mutex;                                                      /**< frame lock */
+    uint32_t m_poll_ms = ASYNC_POLL_MS;                                       /**< busy poll period */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
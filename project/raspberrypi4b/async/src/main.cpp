@@ -0,0 +1,951 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.cpp
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "wt588e02b_async.hpp"
+#include "driver_wt588e02b_interface.h"
+#include "driver_wt588e02b_mock.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <getopt.h>
+
+/**
+ * @brief async definition
+ */
+#define ASYNC_SELF_TEST_IND          3          /**< played index of the self test */
+#define ASYNC_SELF_TEST_TICK_US      1000       /**< ticker period of the self test */
+#define ASYNC_BENCH_PERIOD_MS        1000       /**< default play period of every device */
+#define ASYNC_BENCH_TIMES            10         /**< default plays of every device */
+
+static uint64_t gs_bench_now_us;                /**< bench virtual clock */
+static uint64_t gs_bench_blocked_us;            /**< time spent in the delay hooks */
+
+/**
+ * @brief     bench gpio init
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_async_bench_gpio(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     bench gpio write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_async_bench_write(uint8_t data)
+{
+    (void)data;
+    
+    return 0;
+}
+
+/**
+ * @brief      bench gpio read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       miso stays high, so the chips are never busy
+ */
+static uint8_t a_async_bench_read(uint8_t *data)
+{
+    *data = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     bench delay us
+ * @param[in] us time in us
+ * @note      the thread would block here, so the time is counted as blocked
+ */
+static void a_async_bench_delay_us(uint32_t us)
+{
+    gs_bench_now_us += us;
+    gs_bench_blocked_us += us;
+}
+
+/**
+ * @brief     bench delay ms
+ * @param[in] ms time in ms
+ * @note      none
+ */
+static void a_async_bench_delay_ms(uint32_t ms)
+{
+    a_async_bench_delay_us(ms * 1000);
+}
+
+/**
+ * @brief  bench timestamp ms
+ * @return time in ms
+ * @note   none
+ */
+static uint32_t a_async_bench_timestamp_ms(void)
+{
+    return (uint32_t)(gs_bench_now_us / 1000);
+}
+
+/**
+ * @brief  bench clock read
+ * @return time in us
+ * @note   none
+ */
+static uint64_t a_async_bench_now(void)
+{
+    return gs_bench_now_us;
+}
+
+/**
+ * @brief     bench clock advance
+ * @param[in] us time in us
+ * @note      the scheduler sleeps, so the time is not blocked
+ */
+static void a_async_bench_advance(uint64_t us)
+{
+    gs_bench_now_us += us;
+}
+
+/**
+ * @brief  mock clock read
+ * @return time in us
+ * @note   none
+ */
+static uint64_t a_async_mock_now(void)
+{
+    return wt588e02b_mock_timestamp_us();
+}
+
+/**
+ * @brief     mock clock advance
+ * @param[in] us time in us
+ * @note      the mock chip updates its busy level with the clock
+ */
+static void a_async_mock_advance(uint64_t us)
+{
+    wt588e02b_mock_delay_ms((uint32_t)(us / 1000));
+    wt588e02b_mock_delay_us((uint32_t)(us % 1000));
+}
+
+/**
+ * @brief bench ops table, no pin is touched and every delay moves the virtual clock
+ */
+static const wt588e02b_ops_t gs_bench_ops =
+{
+    a_async_bench_gpio, a_async_bench_gpio, a_async_bench_write,
+    a_async_bench_gpio, a_async_bench_gpio, a_async_bench_write,
+    a_async_bench_gpio, a_async_bench_gpio, a_async_bench_read,
+    a_async_bench_gpio, a_async_bench_gpio, a_async_bench_write,
+    a_async_bench_delay_ms, a_async_bench_delay_us,
+    wt588e02b_interface_debug_print,
+    NULL, NULL, NULL,
+    a_async_bench_timestamp_ms,
+    NULL, NULL,
+    NULL,
+};
+
+/**
+ * @brief gpio ops table of the raspberrypi4b
+ */
+static const wt588e02b_ops_t gs_gpio_ops =
+{
+    wt588e02b_interface_sclk_gpio_init, wt588e02b_interface_sclk_gpio_deinit, wt588e02b_interface_sclk_gpio_write,
+    wt588e02b_interface_mosi_gpio_init, wt588e02b_interface_mosi_gpio_deinit, wt588e02b_interface_mosi_gpio_write,
+    wt588e02b_interface_miso_gpio_init, wt588e02b_interface_miso_gpio_deinit, wt588e02b_interface_miso_gpio_read,
+    wt588e02b_interface_cs_gpio_init, wt588e02b_interface_cs_gpio_deinit, wt588e02b_interface_cs_gpio_write,
+    wt588e02b_interface_delay_ms, wt588e02b_interface_delay_us,
+    wt588e02b_interface_debug_print,
+    wt588e02b_interface_bin_read_init, wt588e02b_interface_bin_read, wt588e02b_interface_bin_read_deinit,
+    wt588e02b_interface_timestamp_ms,
+    wt588e02b_interface_lock, wt588e02b_interface_unlock,
+#if (WT588E02B_INTERFACE_FRAME_TRANSFER != 0)
+    wt588e02b_interface_frame_transfer,
+#else
+    NULL,
+#endif
+};
+
+/**
+ * @brief      sleep several times on a scheduler
+ * @param[in]  &sched scheduler
+ * @param[in]  us sleep time in us
+ * @param[in]  id sleeper id
+ * @param[out] *order pointer to a wake up order buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static wt588e02b::task<uint8_t> a_async_sleeper(wt588e02b::scheduler &sched, uint64_t us, uint8_t id, std::vector<uint8_t> *order)
+{
+    co_await sched.sleep_us(us);
+    order->push_back(id);
+    
+    co_return 0;
+}
+
+/**
+ * @brief      tick until a flag is set
+ * @param[in]  &sched scheduler
+ * @param[in]  *done pointer to a done flag
+ * @param[out] *ticks pointer to a tick number buffer
+ * @param[out] *late_us pointer to a max lateness buffer
+ * @return     status code
+ *             - 0 success
+ * @note       stands for the other work of the event loop
+ */
+static wt588e02b::task<uint8_t> a_async_ticker(wt588e02b::scheduler &sched, const uint8_t *done, uint32_t *ticks, uint64_t *late_us)
+{
+    uint64_t deadline;
+    
+    deadline = sched.now_us();
+    while (*done == 0)
+    {
+        deadline += ASYNC_SELF_TEST_TICK_US;
+        co_await sched.sleep_until(deadline);
+        if (sched.now_us() - deadline > *late_us)
+        {
+            *late_us = sched.now_us() - deadline;
+        }
+        (*ticks)++;
+        if (sched.now_us() > deadline + ASYNC_SELF_TEST_TICK_US)
+        {
+            deadline = sched.now_us();
+        }
+    }
+    
+    co_return 0;
+}
+
+/**
+ * @brief      run the self test sequence on the mock chip
+ * @param[in]  &sched scheduler
+ * @param[in]  &dev device
+ * @param[in]  *path pointer to an image path
+ * @param[out] *done pointer to a done flag
+ * @return     status code
+ *             - 0 success
+ *             - 1 test failed
+ * @note       none
+ */
+static wt588e02b::task<uint8_t> a_async_sequence(wt588e02b::scheduler &sched, wt588e02b::device &dev, char *path, uint8_t *done)
+{
+    uint8_t res;
+    uint64_t t;
+    wt588e02b_mock_state_t state;
+    
+    /* play */
+    t = sched.now_us();
+    res = co_await dev.play(ASYNC_SELF_TEST_IND);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: play failed.\n");
+        *done = 1;
+        
+        co_return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b-async: play took %u us.\n", (unsigned int)(sched.now_us() - t));
+    
+    /* a second play is refused while the first one plays */
+    co_await sched.sleep_us(50000);
+    res = co_await dev.play(ASYNC_SELF_TEST_IND + 1);
+    if (res != 5)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: busy check failed.\n");
+        *done = 1;
+        
+        co_return 1;
+    }
+    
+    /* wait idle */
+    res = co_await dev.wait_idle(5000);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.ind != ASYNC_SELF_TEST_IND) || (state.busy != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: wait idle failed.\n");
+        *done = 1;
+        
+        co_return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b-async: idle after %u ms.\n", (unsigned int)((sched.now_us() - t) / 1000));
+    
+    /* update all */
+    t = sched.now_us();
+    res = co_await dev.update_all(path);
+    *done = 1;
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: update all failed.\n");
+        
+        co_return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b-async: update all took %u ms.\n", (unsigned int)((sched.now_us() - t) / 1000));
+    
+    co_return 0;
+}
+
+/**
+ * @brief     self test
+ * @param[in] *path pointer to an image path
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      checks the epoll scheduler, then plays and updates the mock chip on its virtual clock
+ *            while a 1ms ticker shares the thread
+ */
+static uint8_t a_async_self_test(char *path)
+{
+    uint8_t res;
+    uint8_t seq;
+    uint8_t tick;
+    uint8_t done;
+    uint32_t ticks;
+    uint32_t size;
+    uint64_t late_us;
+    uint64_t start;
+    uint64_t t;
+    std::vector<uint8_t> order;
+    wt588e02b_handle_t handle;
+    wt588e02b_mock_state_t state;
+    wt588e02b_mock_config_t config;
+    
+    /* start self test */
+    wt588e02b_interface_debug_print("wt588e02b-async: start self test.\n");
+    
+    /* the epoll scheduler wakes the sleepers in deadline order */
+    {
+        wt588e02b::epoll_scheduler sched;
+        
+        if (!sched.ok())
+        {
+            wt588e02b_interface_debug_print("wt588e02b-async: epoll scheduler failed.\n");
+            
+            return 1;
+        }
+        start = sched.now_us();
+        wt588e02b::spawn(a_async_sleeper(sched, 3000, 3, &order), &res);
+        wt588e02b::spawn(a_async_sleeper(sched, 1000, 1, &order), &res);
+        wt588e02b::spawn(a_async_sleeper(sched, 2000, 2, &order), &res);
+        sched.run();
+        t = sched.now_us() - start;
+        if ((order.size() != 3) || (order[0] != 1) || (order[1] != 2) || (order[2] != 3) || (t < 3000))
+        {
+            wt588e02b_interface_debug_print("wt588e02b-async: epoll scheduler order failed.\n");
+            
+            return 1;
+        }
+        wt588e02b_interface_debug_print("wt588e02b-async: epoll scheduler woke 3 sleepers in order in %u us.\n", (unsigned int)t);
+    }
+    
+    /* the image must be a whole number of packets */
+    if (wt588e02b_interface_bin_read_init(path, &size) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: open %s failed.\n", path);
+        
+        return 1;
+    }
+    (void)wt588e02b_interface_bin_read_deinit();
+    
+    /* link the mock chip */
+    config.play_response_us = 2000;
+    config.stop_response_us = 1000;
+    config.jitter_us = 0;
+    config.clip_us = 300000;
+    wt588e02b_mock_init(&config);
+    DRIVER_WT588E02B_LINK_INIT(&handle, wt588e02b_handle_t);
+    wt588e02b_mock_link(&handle);
+    if (wt588e02b_init(&handle) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* play, wait idle and update with a ticker on the same thread */
+    {
+        wt588e02b::virtual_scheduler sched(a_async_mock_now, a_async_mock_advance);
+        wt588e02b::device dev(sched, &handle);
+        
+        done = 0;
+        ticks = 0;
+        late_us = 0;
+        seq = 1;
+        tick = 1;
+        dev.set_poll(10);
+        start = sched.now_us();
+        wt588e02b::spawn(a_async_sequence(sched, dev, path, &done), &seq);
+        wt588e02b::spawn(a_async_ticker(sched, &done, &ticks, &late_us), &tick);
+        sched.run();
+        t = sched.now_us() - start;
+        wt588e02b_mock_get_state(&state);
+        if ((seq != 0) || (tick != 0) || (state.errors != 0) || (state.packets != size / 512))
+        {
+            wt588e02b_interface_debug_print("wt588e02b-async: mock check failed, %u errors and %u of %u packets.\n",
+                                            (unsigned int)state.errors, (unsigned int)state.packets, (unsigned int)(size / 512));
+            (void)wt588e02b_deinit(&handle);
+            
+            return 1;
+        }
+        wt588e02b_interface_debug_print("wt588e02b-async: ticker ran %u of %u ticks, max late %u us.\n",
+                                        (unsigned int)ticks, (unsigned int)(t / ASYNC_SELF_TEST_TICK_US), (unsigned int)late_us);
+        wt588e02b_interface_debug_print("wt588e02b-async: %u frames, %u packets, %u errors.\n",
+                                        (unsigned int)state.frames, (unsigned int)state.packets, (unsigned int)state.errors);
+    }
+    (void)wt588e02b_deinit(&handle);
+    
+    /* finish self test */
+    wt588e02b_interface_debug_print("wt588e02b-async: finish self test.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief      play one device periodically
+ * @param[in]  &sched scheduler
+ * @param[in]  &dev device
+ * @param[in]  first_us first deadline
+ * @param[in]  period_us play period
+ * @param[in]  times play times
+ * @param[out] *late_us pointer to a max lateness buffer
+ * @param[out] *errors pointer to an error number buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static wt588e02b::task<uint8_t> a_async_player(wt588e02b::scheduler &sched, wt588e02b::device &dev, uint64_t first_us, uint64_t period_us,
+                                               uint32_t times, uint64_t *late_us, uint32_t *errors)
+{
+    uint32_t i;
+    uint64_t deadline;
+    
+    for (i = 0; i < times; i++)
+    {
+        deadline = first_us + period_us * i;
+        co_await sched.sleep_until(deadline);
+        if (sched.now_us() - deadline > *late_us)
+        {
+            *late_us = sched.now_us() - deadline;
+        }
+        if ((co_await dev.play((uint8_t)(i % 0xE0))) != 0)
+        {
+            (*errors)++;
+        }
+    }
+    
+    co_return 0;
+}
+
+/**
+ * @brief     bench one device number
+ * @param[in] devices device number
+ * @param[in] period_ms play period of every device
+ * @param[in] times plays of every device
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      none
+ */
+static uint8_t a_async_bench_run(uint32_t devices, uint32_t period_ms, uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t errors;
+    uint64_t late_us;
+    uint64_t start;
+    uint64_t total;
+    uint64_t plays;
+    uint64_t host_ns;
+    std::vector<wt588e02b_handle_t> handles(devices);
+    wt588e02b::virtual_scheduler sched(a_async_bench_now, a_async_bench_advance);
+    std::deque<wt588e02b::device> devs;
+    
+    /* init all chips with one ops table */
+    for (i = 0; i < devices; i++)
+    {
+        DRIVER_WT588E02B_LINK_INIT(&handles[i], wt588e02b_handle_t);
+        DRIVER_WT588E02B_LINK_OPS(&handles[i], &gs_bench_ops);
+        DRIVER_WT588E02B_LINK_BUFFER(&handles[i], NULL);
+        if (wt588e02b_init(&handles[i]) != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b-async: init failed.\n");
+            
+            return 1;
+        }
+        devs.emplace_back(sched, &handles[i]);
+    }
+    
+    /* spread the first plays over one period */
+    errors = 0;
+    late_us = 0;
+    gs_bench_blocked_us = 0;
+    start = sched.now_us();
+    for (i = 0; i < devices; i++)
+    {
+        wt588e02b::spawn(a_async_player(sched, devs[i], start + (uint64_t)period_ms * 1000 * i / devices,
+                                        (uint64_t)period_ms * 1000, times, &late_us, &errors), &res);
+    }
+    auto host = std::chrono::steady_clock::now();
+    sched.run();
+    host_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - host).count();
+    total = sched.now_us() - start;
+    plays = (uint64_t)devices * times;
+    wt588e02b_interface_debug_print("wt588e02b-async: %5u devices %6u plays blocked %4u ms/s max late %7u us host %4u ns/play.\n",
+                                    (unsigned int)devices, (unsigned int)plays,
+                                    (unsigned int)((total != 0) ? (gs_bench_blocked_us * 1000 / total) : 0),
+                                    (unsigned int)late_us, (unsigned int)(host_ns / plays));
+    for (i = 0; i < devices; i++)
+    {
+        (void)wt588e02b_deinit(&handles[i]);
+    }
+    if (errors != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: %u plays failed.\n", (unsigned int)errors);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bench
+ * @param[in] devices device number, 0 means a sweep
+ * @param[in] period_ms play period of every device
+ * @param[in] times plays of every device
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      the chips are no-op pins on a virtual clock, blocked is the thread time spent in the bit banged
+ *            bytes per second, the blocking driver also blocks in the 5ms cs lead
+ */
+static uint8_t a_async_bench(uint32_t devices, uint32_t period_ms, uint32_t times)
+{
+    uint32_t i;
+    uint64_t async_us;
+    uint64_t blocking_us;
+    wt588e02b_handle_t handle;
+    const uint32_t sweep[] = {1, 16, 64, 256, 512};
+    
+    /* start bench */
+    wt588e02b_interface_debug_print("wt588e02b-async: start bench, one play every %u ms per device.\n", (unsigned int)period_ms);
+    
+    /* blocked time of one play */
+    DRIVER_WT588E02B_LINK_INIT(&handle, wt588e02b_handle_t);
+    DRIVER_WT588E02B_LINK_OPS(&handle, &gs_bench_ops);
+    DRIVER_WT588E02B_LINK_BUFFER(&handle, NULL);
+    if (wt588e02b_init(&handle) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: init failed.\n");
+        
+        return 1;
+    }
+    gs_bench_blocked_us = 0;
+    if (wt588e02b_play(&handle, 0) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: play failed.\n");
+        (void)wt588e02b_deinit(&handle);
+        
+        return 1;
+    }
+    blocking_us = gs_bench_blocked_us;
+    {
+        uint8_t res = 1;
+        wt588e02b::virtual_scheduler sched(a_async_bench_now, a_async_bench_advance);
+        wt588e02b::device dev(sched, &handle);
+        
+        gs_bench_blocked_us = 0;
+        wt588e02b::spawn(dev.play(0), &res);
+        sched.run();
+        async_us = gs_bench_blocked_us;
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b-async: play failed.\n");
+            (void)wt588e02b_deinit(&handle);
+            
+            return 1;
+        }
+    }
+    (void)wt588e02b_deinit(&handle);
+    wt588e02b_interface_debug_print("wt588e02b-async: one play blocks %u us with the blocking api and %u us with the async api.\n",
+                                    (unsigned int)blocking_us, (unsigned int)async_us);
+    wt588e02b_interface_debug_print("wt588e02b-async: devices per thread at a %u ms period, blocking %u async %u.\n", (unsigned int)period_ms,
+                                    (unsigned int)((uint64_t)period_ms * 1000 / blocking_us), (unsigned int)((uint64_t)period_ms * 1000 / async_us));
+    
+    /* run the device numbers */
+    if (devices != 0)
+    {
+        if (a_async_bench_run(devices, period_ms, times) != 0)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        for (i = 0; i < sizeof(sweep) / sizeof(sweep[0]); i++)
+        {
+            if (a_async_bench_run(sweep[i], period_ms, times) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    
+    /* finish bench */
+    wt588e02b_interface_debug_print("wt588e02b-async: finish bench.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief     play and wait idle
+ * @param[in] &dev device
+ * @param[in] ind played index
+ * @return    status code
+ *            - 0 success
+ *            - others failed
+ * @note      none
+ */
+static wt588e02b::task<uint8_t> a_async_play_idle(wt588e02b::device &dev, uint8_t ind)
+{
+    uint8_t res;
+    
+    res = co_await dev.play(ind);
+    if (res != 0)
+    {
+        co_return res;
+    }
+    
+    co_return co_await dev.wait_idle();
+}
+
+/**
+ * @brief     run one command on the gpio chip
+ * @param[in] *path pointer to an image path, NULL plays
+ * @param[in] ind played index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the epoll scheduler sleeps in the kernel during the waits
+ */
+static uint8_t a_async_gpio(char *path, uint8_t ind)
+{
+    uint8_t res;
+    wt588e02b_handle_t handle;
+    wt588e02b::epoll_scheduler sched;
+    wt588e02b::device dev(sched, &handle);
+    
+    if (!sched.ok())
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: epoll scheduler failed.\n");
+        
+        return 1;
+    }
+    DRIVER_WT588E02B_LINK_INIT(&handle, wt588e02b_handle_t);
+    DRIVER_WT588E02B_LINK_OPS(&handle, &gs_gpio_ops);
+    if (wt588e02b_init(&handle) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: init failed.\n");
+        
+        return 1;
+    }
+    res = 1;
+    if (path != NULL)
+    {
+        wt588e02b::spawn(dev.update_all(path), &res);
+    }
+    else
+    {
+        wt588e02b::spawn(a_async_play_idle(dev, ind), &res);
+    }
+    sched.run();
+    (void)wt588e02b_deinit(&handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: run failed with %u.\n", (unsigned int)res);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b-async: ok.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief     async function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+static uint8_t wt588e02b_async(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"self-test", no_argument, NULL, 1},
+        {"bench", no_argument, NULL, 2},
+        {"file", required_argument, NULL, 3},
+        {"devices", required_argument, NULL, 4},
+        {"period", required_argument, NULL, 5},
+        {"times", required_argument, NULL, 6},
+        {"play", required_argument, NULL, 7},
+        {"update-all", required_argument, NULL, 8},
+        {NULL, 0, NULL, 0},
+    };
+    char file[256] = "bin/all.bin";
+    uint8_t help = 0;
+    uint8_t self_test = 0;
+    uint8_t bench = 0;
+    uint8_t play = 0;
+    uint8_t update = 0;
+    uint8_t ind = 0;
+    uint32_t devices = 0;
+    uint32_t period = ASYNC_BENCH_PERIOD_MS;
+    uint32_t times = ASYNC_BENCH_TIMES;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* self test */
+            case 1 :
+            {
+                self_test = 1;
+                
+                break;
+            }
+            
+            /* bench */
+            case 2 :
+            {
+                bench = 1;
+                
+                break;
+            }
+            
+            /* file */
+            case 3 :
+            {
+                memset(file, 0, sizeof(char) * 256);
+                strncpy(file, optarg, 255);
+                
+                break;
+            }
+            
+            /* devices */
+            case 4 :
+            {
+                devices = (uint32_t)atol(optarg);
+                if ((devices == 0) || (devices > 4096))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* period */
+            case 5 :
+            {
+                period = (uint32_t)atol(optarg);
+                if (period == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* times */
+            case 6 :
+            {
+                times = (uint32_t)atol(optarg);
+                if (times == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* play */
+            case 7 :
+            {
+                if (atol(optarg) > 0xDF)
+                {
+                    return 5;
+                }
+                ind = (uint8_t)atol(optarg);
+                play = 1;
+                
+                break;
+            }
+            
+            /* update all */
+            case 8 :
+            {
+                memset(file, 0, sizeof(char) * 256);
+                strncpy(file, optarg, 255);
+                update = 1;
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if ((help != 0) || ((self_test + bench + play + update) != 1))
+    {
+        wt588e02b_interface_debug_print("Usage:\n");
+        wt588e02b_interface_debug_print("  wt588e02b-async --self-test [--file=<path>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b-async --bench [--devices=<n>] [--period=<ms>] [--times=<n>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b-async --play=<ind>\n");
+        wt588e02b_interface_debug_print("  wt588e02b-async --update-all=<path>\n");
+        wt588e02b_interface_debug_print("  wt588e02b-async (-h | --help)\n");
+        wt588e02b_interface_debug_print("\n");
+        wt588e02b_interface_debug_print("Options:\n");
+        wt588e02b_interface_debug_print("      --bench                 Bench the devices served by one thread on a virtual clock.\n");
+        wt588e02b_interface_debug_print("      --devices=<n>           Set the bench device number.([default: a sweep])\n");
+        wt588e02b_interface_debug_print("      --file=<path>           Set the self test image.([default: bin/all.bin])\n");
+        wt588e02b_interface_debug_print("  -h, --help                  Show the help.\n");
+        wt588e02b_interface_debug_print("      --period=<ms>           Set the bench play period of every device.([default: %d])\n", ASYNC_BENCH_PERIOD_MS);
+        wt588e02b_interface_debug_print("      --play=<ind>            Play one index on the gpio chip and wait idle.\n");
+        wt588e02b_interface_debug_print("      --self-test             Run the scheduler and the mock chip self test.\n");
+        wt588e02b_interface_debug_print("      --times=<n>             Set the bench plays of every device.([default: %d])\n", ASYNC_BENCH_TIMES);
+        wt588e02b_interface_debug_print("      --update-all=<path>     Update the whole flash of the gpio chip.\n");
+        
+        return (help != 0) ? 0 : 5;
+    }
+    
+    /* self test */
+    if (self_test != 0)
+    {
+        if (a_async_self_test(file) != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b-async: self test failed.\n");
+            
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    /* bench */
+    if (bench != 0)
+    {
+        if (a_async_bench(devices, period, times) != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b-async: bench failed.\n");
+            
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    /* gpio chip */
+    return a_async_gpio((update != 0) ? file : NULL, ind);
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+    
+    res = wt588e02b_async(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: param is invalid.\n");
+    }
+    else
+    {
+        wt588e02b_interface_debug_print("wt588e02b-async: unknown status code.\n");
+    }
+    
+    return (res == 0) ? 0 : 1;
+}
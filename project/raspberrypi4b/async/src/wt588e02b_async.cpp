@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      wt588e02b_async.cpp
+ * @brief     wt588e02b async source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "wt588e02b_async.hpp"
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace wt588e02b
+{
+
+void scheduler::resume_at(uint64_t deadline_us, std::coroutine_handle<> h)
+{
+    uint64_t seq;
+    
+    seq = m_seq++;                                                           /* keep the order of equal deadlines */
+    m_timers.push(timer{deadline_us, seq, h});                               /* add the timer */
+    if (m_timers.top().seq == seq)                                           /* check the earliest */
+    {
+        earliest(deadline_us);                                               /* the new timer is the first one */
+    }
+}
+
+void scheduler::dispatch()
+{
+    std::coroutine_handle<> h;
+    
+    while ((!m_timers.empty()) && (m_timers.top().deadline_us <= now_us()))  /* resume all due timers */
+    {
+        h = m_timers.top().handle;                                           /* get the coroutine */
+        m_timers.pop();                                                      /* remove the timer */
+        m_resumes++;                                                         /* count it */
+        h.resume();                                                          /* run until its next wait */
+    }
+    if (!m_timers.empty())                                                   /* check the rest */
+    {
+        earliest(m_timers.top().deadline_us);                                /* arm the next deadline */
+    }
+}
+
+void scheduler::run()
+{
+    uint64_t deadline_us;
+    
+    while (!m_timers.empty())                                                /* run until no timer */
+    {
+        deadline_us = m_timers.top().deadline_us;                            /* get the earliest */
+        if (deadline_us > now_us())                                          /* check the time */
+        {
+            wait_until(deadline_us);                                         /* wait */
+        }
+        dispatch();                                                          /* resume the due coroutines */
+    }
+}
+
+void virtual_scheduler::wait_until(uint64_t deadline_us)
+{
+    uint64_t now;
+    
+    now = m_now();                                                           /* get the time */
+    if (deadline_us > now)                                                   /* check the time */
+    {
+        m_advance(deadline_us - now);                                        /* jump to the deadline */
+    }
+}
+
+epoll_scheduler::epoll_scheduler()
+{
+    struct epoll_event ev = {};
+    
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);                                  /* create the epoll */
+    m_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);   /* create the timer */
+    if ((m_epoll >= 0) && (m_timer >= 0))                                    /* check the fds */
+    {
+        ev.events = EPOLLIN;                                                 /* readable when due */
+        ev.data.fd = m_timer;                                                /* set the timer */
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_timer, &ev) != 0)            /* add the timer */
+        {
+            (void)close(m_timer);                                            /* close the timer */
+            m_timer = -1;                                                    /* mark failed */
+        }
+    }
+}
+
+epoll_scheduler::~epoll_scheduler()
+{
+    if (m_timer >= 0)                                                        /* check the timer */
+    {
+        (void)close(m_timer);                                                /* close the timer */
+    }
+    if (m_epoll >= 0)                                                        /* check the epoll */
+    {
+        (void)close(m_epoll);                                                /* close the epoll */
+    }
+}
+
+uint64_t epoll_scheduler::now_us()
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);                               /* the timerfd clock */
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+void epoll_scheduler::earliest(uint64_t deadline_us)
+{
+    struct itimerspec its = {};
+    
+    if (deadline_us == 0)                                                    /* a zero time disarms the timer */
+    {
+        deadline_us = 1;                                                     /* fire at once */
+    }
+    its.it_value.tv_sec = (time_t)(deadline_us / 1000000ULL);                /* set the second */
+    its.it_value.tv_nsec = (long)((deadline_us % 1000000ULL) * 1000ULL);     /* set the nanosecond */
+    (void)timerfd_settime(m_timer, TFD_TIMER_ABSTIME, &its, NULL);           /* rearming also clears the expirations */
+}
+
+void epoll_scheduler::dispatch()
+{
+    uint64_t expirations;
+    
+    (void)read(m_timer, &expirations, sizeof(expirations));                  /* clear the timer, it never blocks */
+    scheduler::dispatch();                                                   /* resume and arm the next deadline */
+}
+
+void epoll_scheduler::wait_until(uint64_t deadline_us)
+{
+    struct epoll_event ev;
+    
+    earliest(deadline_us);                                                   /* arm the timer */
+    (void)epoll_wait(m_epoll, &ev, 1, -1);                                   /* a signal returns early, run checks the clock again */
+}
+
+void async_mutex::unlock()
+{
+    std::coroutine_handle<> h;
+    
+    if (m_waiters.empty())                                                   /* check the waiters */
+    {
+        m_locked = false;                                                    /* free it */
+        
+        return;
+    }
+    h = m_waiters.front();                                                   /* the first waiter */
+    m_waiters.pop_front();                                                   /* remove it */
+    m_sched.resume_at(m_sched.now_us(), h);                                  /* it owns the lock when it runs */
+}
+
+uint8_t device::check(void) const noexcept
+{
+    if (m_handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (m_handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    return 0;                                                                /* success return 0 */
+}
+
+task<uint8_t> device::run(uint8_t res, wt588e02b_step_t *step)
+{
+    while ((res == 0) && (step->wait_us != 0))                               /* run until the last step */
+    {
+        co_await m_sched.sleep_us(step->wait_us);                            /* the lead or the gap without blocking */
+        res = wt588e02b_step(m_handle, step);                                /* run the next step */
+    }
+    
+    co_return res;                                                           /* return the result */
+}
+
+task<uint8_t> device::play(uint8_t ind)
+{
+    wt588e02b_step_t step;
+    
+    async_mutex::guard guard = co_await m_mutex.lock();                      /* own the chip */
+    
+    co_return co_await run(wt588e02b_step_play(m_handle, &step, ind), &step);
+}
+
+task<uint8_t> device::stop()
+{
+    wt588e02b_step_t step;
+    
+    async_mutex::guard guard = co_await m_mutex.lock();                      /* own the chip */
+    
+    co_return co_await run(wt588e02b_step_stop(m_handle, &step), &step);
+}
+
+task<uint8_t> device::wait_idle(uint32_t timeout_ms)
+{
+    uint8_t res;
+    uint64_t start;
+    wt588e02b_bool_t busy;
+    
+    res = check();                                                           /* check the handle */
+    if (res != 0)
+    {
+        co_return res;                                                       /* return error */
+    }
+    
+    start = m_sched.now_us();                                                /* save the start */
+    while (true)
+    {
+        co_await m_sched.sleep_us((uint64_t)m_poll_ms * 1000);               /* sleep one poll period */
+        {
+            async_mutex::guard guard = co_await m_mutex.lock();              /* miso is data inside a frame */
+            if (wt588e02b_check_busy(m_handle, &busy) != 0)                  /* read busy */
+            {
+                co_return 1;                                                 /* return error */
+            }
+        }
+        if (busy == WT588E02B_BOOL_FALSE)                                    /* check idle */
+        {
+            co_return 0;                                                     /* success return 0 */
+        }
+        if ((timeout_ms != 0) && ((m_sched.now_us() - start) >= (uint64_t)timeout_ms * 1000))
+        {
+            co_return 4;                                                     /* return timeout */
+        }
+    }
+}
+
+task<uint8_t> device::update_all(char *path)
+{
+    wt588e02b_step_t step;
+    
+    async_mutex::guard guard = co_await m_mutex.lock();                      /* own the chip for the whole update */
+    
+    co_return co_await run(wt588e02b_step_update_all(m_handle, &step, path), &step);
+}
+
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      daemon.h
+ * @brief     daemon header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup daemon daemon function
+ * @brief    voice prompt daemon modules
+ * @{
+ */
+
+/**
+ * @brief daemon default socket definition
+ */
+#define DAEMON_DEFAULT_SOCKET "/tmp/wt588e02b.sock"        /**< default unix socket path */
+
+/**
+ * @brief     daemon init
+ * @param[in] *path pointer to a socket path
+ * @param[in] mock 1 drives the mock chip instead of the gpio
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      initializes the chip once, binds the socket and starts the bus worker
+ */
+uint8_t daemon_init(const char *path, uint8_t mock);
+
+/**
+ * @brief  daemon run
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   serves the clients until daemon_stop is called
+ */
+uint8_t daemon_run(void);
+
+/**
+ * @brief daemon stop
+ * @note  safe to call from a signal handler
+ */
+void daemon_stop(void);
+
+/**
+ * @brief  daemon deinit
+ * @return status code
+ *         - 0 success
+ * @note   stops the worker, closes the clients and removes the socket
+ */
+uint8_t daemon_deinit(void);
+
+/**
+ * @brief      send one request to a running daemon
+ * @param[in]  *path pointer to a socket path
+ * @param[in]  *line pointer to a request line
+ * @param[out] *reply pointer to a reply buffer
+ * @param[in]  len reply buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ * @note       the request line has no newline, the reply has it stripped
+ */
+uint8_t daemon_request(const char *path, const char *line, char *reply, size_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
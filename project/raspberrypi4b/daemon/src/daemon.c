@@ -0,0 +1,1064 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      daemon.c
+ * @brief     daemon source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "daemon.h"
+#include "driver_wt588e02b_interface.h"
+#include "driver_wt588e02b_mock.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief daemon definition
+ */
+#define DAEMON_MAX_CLIENTS        32          /**< max connected clients */
+#define DAEMON_QUEUE_SIZE         256         /**< max queued requests */
+#define DAEMON_LINE_SIZE          128         /**< max request line length */
+#define DAEMON_LATENCY_SIZE       1024        /**< latency samples kept for the percentiles */
+#define DAEMON_LIST_MAX           40          /**< max indexes of one play list frame */
+#define DAEMON_PATH_SIZE          73          /**< max update file path length */
+#define DAEMON_REQUEST_TIMEOUT    60          /**< client reply timeout in s, an update takes seconds */
+
+/**
+ * @brief daemon command enumeration definition
+ */
+typedef enum
+{
+    DAEMON_CMD_PLAY       = 0x00,        /**< play one index */
+    DAEMON_CMD_LIST       = 0x01,        /**< play a list */
+    DAEMON_CMD_VOL        = 0x02,        /**< set the volume */
+    DAEMON_CMD_STOP       = 0x03,        /**< stop */
+    DAEMON_CMD_UPDATE     = 0x04,        /**< update one index */
+    DAEMON_CMD_UPDATE_ALL = 0x05,        /**< update all */
+    DAEMON_CMD_BUSY       = 0x06,        /**< read busy */
+    DAEMON_CMD_METRICS    = 0x07,        /**< read the metrics */
+} daemon_cmd_t;
+
+/**
+ * @brief daemon request structure definition
+ */
+typedef struct daemon_request_s
+{
+    uint8_t cmd;                           /**< command */
+    uint8_t len;                           /**< index number */
+    uint8_t arg[DAEMON_LIST_MAX];          /**< index, list or volume */
+    char path[DAEMON_PATH_SIZE];           /**< update file path */
+    uint16_t client;                       /**< client slot */
+    uint32_t gen;                          /**< client generation */
+    uint64_t t_us;                         /**< queued time */
+} daemon_request_t;
+
+/**
+ * @brief daemon client structure definition
+ */
+typedef struct daemon_client_s
+{
+    int fd;                                /**< socket, -1 means free */
+    uint32_t gen;                          /**< generation, bumped on close */
+    char line[DAEMON_LINE_SIZE];           /**< line buffer */
+    uint16_t len;                          /**< line length */
+    uint8_t overflow;                      /**< line too long */
+} daemon_client_t;
+
+/**
+ * @brief global var definition
+ */
+static wt588e02b_handle_t gs_handle;                                  /**< wt588e02b handle */
+static uint8_t gs_buf[512];                                           /**< update buffer */
+static daemon_client_t gs_client[DAEMON_MAX_CLIENTS];                 /**< clients */
+static pthread_mutex_t gs_client_mutex = PTHREAD_MUTEX_INITIALIZER;   /**< client mutex */
+static daemon_request_t gs_queue[DAEMON_QUEUE_SIZE];                  /**< request queue */
+static uint32_t gs_queue_head;                                        /**< queue head */
+static uint32_t gs_queue_count;                                       /**< queue depth */
+static pthread_mutex_t gs_queue_mutex = PTHREAD_MUTEX_INITIALIZER;    /**< queue mutex */
+static pthread_cond_t gs_queue_cond = PTHREAD_COND_INITIALIZER;       /**< queue condition */
+static daemon_request_t gs_batch[DAEMON_QUEUE_SIZE];                  /**< merged requests */
+static pthread_t gs_worker;                                           /**< bus worker */
+static uint8_t gs_worker_stop;                                        /**< worker stop flag */
+static int gs_listen = -1;                                            /**< listen socket */
+static int gs_wake[2] = {-1, -1};                                     /**< wake pipe */
+static volatile sig_atomic_t gs_stop;                                 /**< run stop flag */
+static char gs_path[sizeof(((struct sockaddr_un *)0)->sun_path)];     /**< socket path */
+static uint64_t gs_enqueued;                                          /**< queued requests */
+static uint64_t gs_rejected;                                          /**< requests refused on a full queue */
+static uint64_t gs_depth_sum;                                         /**< depth sum seen by new requests */
+static uint32_t gs_depth_max;                                         /**< max depth */
+static uint64_t gs_requests;                                          /**< finished requests */
+static uint64_t gs_batches;                                           /**< bus operations */
+static uint64_t gs_merged;                                            /**< requests merged into another */
+static uint64_t gs_errors;                                            /**< requests that failed */
+static uint32_t gs_latency[DAEMON_LATENCY_SIZE];                      /**< latency ring */
+static uint32_t gs_latency_sort[DAEMON_LATENCY_SIZE];                 /**< latency sort buffer */
+static uint64_t gs_latency_count;                                     /**< latency samples */
+static uint64_t gs_latency_sum;                                       /**< latency sum */
+static uint32_t gs_latency_max;                                       /**< max latency */
+
+/**
+ * @brief wt588e02b ops table, it is const and lives in flash
+ */
+static const wt588e02b_ops_t gs_ops =
+{
+    .sclk_gpio_init = wt588e02b_interface_sclk_gpio_init,
+    .sclk_gpio_deinit = wt588e02b_interface_sclk_gpio_deinit,
+    .sclk_gpio_write = wt588e02b_interface_sclk_gpio_write,
+    .mosi_gpio_init = wt588e02b_interface_mosi_gpio_init,
+    .mosi_gpio_deinit = wt588e02b_interface_mosi_gpio_deinit,
+    .mosi_gpio_write = wt588e02b_interface_mosi_gpio_write,
+    .miso_gpio_init = wt588e02b_interface_miso_gpio_init,
+    .miso_gpio_deinit = wt588e02b_interface_miso_gpio_deinit,
+    .miso_gpio_read = wt588e02b_interface_miso_gpio_read,
+    .cs_gpio_init = wt588e02b_interface_cs_gpio_init,
+    .cs_gpio_deinit = wt588e02b_interface_cs_gpio_deinit,
+    .cs_gpio_write = wt588e02b_interface_cs_gpio_write,
+    .bin_read_init = wt588e02b_interface_bin_read_init,
+    .bin_read = wt588e02b_interface_bin_read,
+    .bin_read_deinit = wt588e02b_interface_bin_read_deinit,
+    .delay_ms = wt588e02b_interface_delay_ms,
+    .delay_us = wt588e02b_interface_delay_us,
+    .debug_print = wt588e02b_interface_debug_print,
+    .timestamp_ms = wt588e02b_interface_timestamp_ms,
+    .lock = wt588e02b_interface_lock,
+    .unlock = wt588e02b_interface_unlock,
+};
+
+/**
+ * @brief  daemon clock
+ * @return current time in us
+ * @note   none
+ */
+static uint64_t a_daemon_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief     daemon reply
+ * @param[in] client client slot
+ * @param[in] gen client generation
+ * @param[in] *text pointer to a reply line
+ * @note      the reply is dropped when the client is gone or does not read
+ */
+static void a_daemon_reply(uint16_t client, uint32_t gen, const char *text)
+{
+    (void)pthread_mutex_lock(&gs_client_mutex);
+    if ((gs_client[client].fd >= 0) && (gs_client[client].gen == gen))
+    {
+        (void)send(gs_client[client].fd, text, strlen(text), MSG_NOSIGNAL);
+    }
+    (void)pthread_mutex_unlock(&gs_client_mutex);
+}
+
+/**
+ * @brief      daemon parse number
+ * @param[in]  *str pointer to a number string
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       range checks are left to the driver
+ */
+static uint8_t a_daemon_number(const char *str, uint8_t *value)
+{
+    char *end;
+    unsigned long v;
+    
+    if ((str == NULL) || (*str == '\0'))
+    {
+        return 1;
+    }
+    errno = 0;
+    v = strtoul(str, &end, 0);
+    if ((errno != 0) || (*end != '\0') || (v > 0xFF))
+    {
+        return 1;
+    }
+    *value = (uint8_t)v;
+    
+    return 0;
+}
+
+/**
+ * @brief      daemon parse
+ * @param[in]  *line pointer to a request line
+ * @param[out] *req pointer to a request structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       play <ind> | list <ind> ... | vol <vol> | stop | update <ind> <path> |
+ *             update-all <path> | busy | metrics
+ */
+static uint8_t a_daemon_parse(char *line, daemon_request_t *req)
+{
+    char *save;
+    char *cmd;
+    char *tok;
+    
+    /* get the command */
+    cmd = strtok_r(line, " \t", &save);
+    if (cmd == NULL)
+    {
+        return 1;
+    }
+    req->len = 0;
+    req->path[0] = '\0';
+    
+    /* parse the arguments */
+    if (strcmp(cmd, "play") == 0)
+    {
+        req->cmd = DAEMON_CMD_PLAY;
+        if (a_daemon_number(strtok_r(NULL, " \t", &save), &req->arg[0]) != 0)
+        {
+            return 1;
+        }
+        req->len = 1;
+    }
+    else if (strcmp(cmd, "list") == 0)
+    {
+        req->cmd = DAEMON_CMD_LIST;
+        while ((tok = strtok_r(NULL, " \t", &save)) != NULL)
+        {
+            if ((req->len >= DAEMON_LIST_MAX) || (a_daemon_number(tok, &req->arg[req->len]) != 0))
+            {
+                return 1;
+            }
+            req->len++;
+        }
+        if (req->len == 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp(cmd, "vol") == 0)
+    {
+        req->cmd = DAEMON_CMD_VOL;
+        if (a_daemon_number(strtok_r(NULL, " \t", &save), &req->arg[0]) != 0)
+        {
+            return 1;
+        }
+    }
+    else if (strcmp(cmd, "stop") == 0)
+    {
+        req->cmd = DAEMON_CMD_STOP;
+    }
+    else if ((strcmp(cmd, "update") == 0) || (strcmp(cmd, "update-all") == 0))
+    {
+        if (strcmp(cmd, "update") == 0)
+        {
+            req->cmd = DAEMON_CMD_UPDATE;
+            if (a_daemon_number(strtok_r(NULL, " \t", &save), &req->arg[0]) != 0)
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            req->cmd = DAEMON_CMD_UPDATE_ALL;
+        }
+        tok = strtok_r(NULL, " \t", &save);
+        if ((tok == NULL) || (strlen(tok) >= DAEMON_PATH_SIZE))
+        {
+            return 1;
+        }
+        strcpy(req->path, tok);
+    }
+    else if (strcmp(cmd, "busy") == 0)
+    {
+        req->cmd = DAEMON_CMD_BUSY;
+    }
+    else if (strcmp(cmd, "metrics") == 0)
+    {
+        req->cmd = DAEMON_CMD_METRICS;
+    }
+    else
+    {
+        return 1;
+    }
+    
+    /* no trailing argument */
+    if (strtok_r(NULL, " \t", &save) != NULL)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     daemon enqueue
+ * @param[in] *req pointer to a request structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      none
+ */
+static uint8_t a_daemon_enqueue(const daemon_request_t *req)
+{
+    (void)pthread_mutex_lock(&gs_queue_mutex);
+    if (gs_queue_count >= DAEMON_QUEUE_SIZE)
+    {
+        gs_rejected++;
+        (void)pthread_mutex_unlock(&gs_queue_mutex);
+        
+        return 1;
+    }
+    gs_queue[(gs_queue_head + gs_queue_count) % DAEMON_QUEUE_SIZE] = *req;
+    gs_depth_sum += gs_queue_count;
+    gs_queue_count++;
+    gs_enqueued++;
+    if (gs_queue_count > gs_depth_max)
+    {
+        gs_depth_max = gs_queue_count;
+    }
+    (void)pthread_cond_signal(&gs_queue_cond);
+    (void)pthread_mutex_unlock(&gs_queue_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief     daemon merge check
+ * @param[in] *first pointer to the first request of the batch
+ * @param[in] *next pointer to the queued request
+ * @param[in] total indexes in the batch
+ * @return    1 if next can join the batch
+ * @note      plays and lists join one play list frame, volumes keep the last one, stops collapse
+ */
+static uint8_t a_daemon_mergeable(const daemon_request_t *first, const daemon_request_t *next, uint32_t total)
+{
+    if ((first->cmd == DAEMON_CMD_PLAY) || (first->cmd == DAEMON_CMD_LIST))
+    {
+        return (((next->cmd == DAEMON_CMD_PLAY) || (next->cmd == DAEMON_CMD_LIST)) &&
+                (total + next->len <= DAEMON_LIST_MAX)) ? 1 : 0;
+    }
+    if ((first->cmd == DAEMON_CMD_VOL) || (first->cmd == DAEMON_CMD_STOP))
+    {
+        return (next->cmd == first->cmd) ? 1 : 0;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     daemon latency compare
+ * @param[in] *a pointer to the first sample
+ * @param[in] *b pointer to the second sample
+ * @return    compare result
+ * @note      none
+ */
+static int a_daemon_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief      daemon metrics
+ * @param[out] *text pointer to a text buffer
+ * @param[in]  len buffer length
+ * @note       called by the worker, which owns the latency samples
+ */
+static void a_daemon_metrics(char *text, size_t len)
+{
+    uint32_t n;
+    uint32_t depth;
+    uint32_t depth_max;
+    uint64_t enqueued;
+    uint64_t rejected;
+    uint64_t depth_sum;
+    wt588e02b_stats_t stats;
+    
+    /* copy the queue metrics */
+    (void)pthread_mutex_lock(&gs_queue_mutex);
+    depth = gs_queue_count;
+    depth_max = gs_depth_max;
+    enqueued = gs_enqueued;
+    rejected = gs_rejected;
+    depth_sum = gs_depth_sum;
+    (void)pthread_mutex_unlock(&gs_queue_mutex);
+    
+    /* sort the latest latency samples */
+    n = (gs_latency_count < DAEMON_LATENCY_SIZE) ? (uint32_t)gs_latency_count : DAEMON_LATENCY_SIZE;
+    memcpy(gs_latency_sort, gs_latency, n * sizeof(uint32_t));
+    qsort(gs_latency_sort, n, sizeof(uint32_t), a_daemon_compare);
+    memset(&stats, 0, sizeof(stats));
+    (void)wt588e02b_get_stats(&gs_handle, &stats);
+    
+    (void)snprintf(text, len, "ok requests=%llu batches=%llu merged=%llu errors=%llu rejected=%llu "
+                   "depth=%u depth_max=%u depth_mean=%.2f "
+                   "latency_mean_us=%llu latency_p50_us=%u latency_p95_us=%u latency_p99_us=%u latency_max_us=%u "
+                   "frames=%u skipped=%u\n",
+                   (unsigned long long)gs_requests, (unsigned long long)gs_batches,
+                   (unsigned long long)gs_merged, (unsigned long long)gs_errors, (unsigned long long)rejected,
+                   (unsigned int)depth, (unsigned int)depth_max,
+                   (enqueued != 0) ? (double)depth_sum / (double)enqueued : 0.0,
+                   (unsigned long long)((gs_latency_count != 0) ? gs_latency_sum / gs_latency_count : 0),
+                   (unsigned int)((n != 0) ? gs_latency_sort[(n * 50 + 99) / 100 - 1] : 0),
+                   (unsigned int)((n != 0) ? gs_latency_sort[(n * 95 + 99) / 100 - 1] : 0),
+                   (unsigned int)((n != 0) ? gs_latency_sort[(n * 99 + 99) / 100 - 1] : 0),
+                   (unsigned int)gs_latency_max, (unsigned int)stats.sent, (unsigned int)stats.skipped);
+}
+
+/**
+ * @brief     daemon execute
+ * @param[in] *batch pointer to the merged requests
+ * @param[in] n request number
+ * @note      one bus operation answers every request of the batch
+ */
+static void a_daemon_execute(daemon_request_t *batch, uint32_t n)
+{
+    uint8_t res;
+    uint8_t list[DAEMON_LIST_MAX];
+    uint32_t i;
+    uint32_t j;
+    uint32_t total;
+    uint32_t latency;
+    uint64_t now;
+    char text[512];
+    wt588e02b_bool_t enable;
+    
+    /* run the bus operation */
+    res = 0;
+    (void)snprintf(text, sizeof(text), "ok\n");
+    switch (batch[0].cmd)
+    {
+        case DAEMON_CMD_PLAY :
+        case DAEMON_CMD_LIST :
+        {
+            total = 0;
+            for (i = 0; i < n; i++)
+            {
+                for (j = 0; j < batch[i].len; j++)
+                {
+                    list[total++] = batch[i].arg[j];
+                }
+            }
+            if (total == 1)
+            {
+                res = wt588e02b_play(&gs_handle, list[0]);
+            }
+            else
+            {
+                res = wt588e02b_play_list(&gs_handle, list, (uint8_t)total);
+            }
+            
+            break;
+        }
+        case DAEMON_CMD_VOL :
+        {
+            res = wt588e02b_set_vol(&gs_handle, batch[n - 1].arg[0]);
+            
+            break;
+        }
+        case DAEMON_CMD_STOP :
+        {
+            res = wt588e02b_stop(&gs_handle);
+            
+            break;
+        }
+        case DAEMON_CMD_UPDATE :
+        {
+            res = wt588e02b_update(&gs_handle, batch[0].arg[0], batch[0].path);
+            
+            break;
+        }
+        case DAEMON_CMD_UPDATE_ALL :
+        {
+            res = wt588e02b_update_all(&gs_handle, batch[0].path);
+            
+            break;
+        }
+        case DAEMON_CMD_BUSY :
+        {
+            res = wt588e02b_check_busy(&gs_handle, &enable);
+            (void)snprintf(text, sizeof(text), "ok busy=%d\n", (enable == WT588E02B_BOOL_TRUE) ? 1 : 0);
+            
+            break;
+        }
+        default :
+        {
+            a_daemon_metrics(text, sizeof(text));
+            
+            break;
+        }
+    }
+    if (res != 0)
+    {
+        (void)snprintf(text, sizeof(text), "err %d\n", res);
+        gs_errors += n;
+    }
+    gs_batches++;
+    gs_requests += n;
+    gs_merged += n - 1;
+    
+    /* answer every request */
+    now = a_daemon_us();
+    for (i = 0; i < n; i++)
+    {
+        latency = (uint32_t)(now - batch[i].t_us);
+        gs_latency[gs_latency_count % DAEMON_LATENCY_SIZE] = latency;
+        gs_latency_count++;
+        gs_latency_sum += latency;
+        if (latency > gs_latency_max)
+        {
+            gs_latency_max = latency;
+        }
+        a_daemon_reply(batch[i].client, batch[i].gen, text);
+    }
+}
+
+/**
+ * @brief     daemon worker
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      the only thread that touches the bus
+ */
+static void *a_daemon_worker(void *arg)
+{
+    uint32_t n;
+    uint32_t total;
+    
+    (void)arg;
+    while (1)
+    {
+        /* wait for a request */
+        (void)pthread_mutex_lock(&gs_queue_mutex);
+        while ((gs_queue_count == 0) && (gs_worker_stop == 0))
+        {
+            (void)pthread_cond_wait(&gs_queue_cond, &gs_queue_mutex);
+        }
+        if (gs_queue_count == 0)
+        {
+            (void)pthread_mutex_unlock(&gs_queue_mutex);
+            
+            break;
+        }
+        
+        /* take the first request and everything that merges with it */
+        n = 0;
+        total = 0;
+        do
+        {
+            gs_batch[n] = gs_queue[gs_queue_head];
+            total += gs_batch[n].len;
+            n++;
+            gs_queue_head = (gs_queue_head + 1) % DAEMON_QUEUE_SIZE;
+            gs_queue_count--;
+        } while ((gs_queue_count != 0) && (a_daemon_mergeable(&gs_batch[0], &gs_queue[gs_queue_head], total) != 0));
+        (void)pthread_mutex_unlock(&gs_queue_mutex);
+        
+        /* run it */
+        a_daemon_execute(gs_batch, n);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     daemon close client
+ * @param[in] i client slot
+ * @note      the generation bump drops the replies still queued for it
+ */
+static void a_daemon_close(uint16_t i)
+{
+    (void)pthread_mutex_lock(&gs_client_mutex);
+    (void)close(gs_client[i].fd);
+    gs_client[i].fd = -1;
+    gs_client[i].gen++;
+    (void)pthread_mutex_unlock(&gs_client_mutex);
+}
+
+/**
+ * @brief     daemon line
+ * @param[in] i client slot
+ * @note      parses one complete line and queues it
+ */
+static void a_daemon_line(uint16_t i)
+{
+    daemon_request_t req;
+    daemon_client_t *client = &gs_client[i];
+    
+    /* strip the carriage return */
+    if ((client->len != 0) && (client->line[client->len - 1] == '\r'))
+    {
+        client->len--;
+    }
+    client->line[client->len] = '\0';
+    
+    /* parse and queue */
+    if ((client->overflow != 0) || (a_daemon_parse(client->line, &req) != 0))
+    {
+        a_daemon_reply(i, client->gen, "err parse\n");
+    }
+    else
+    {
+        req.client = i;
+        req.gen = client->gen;
+        req.t_us = a_daemon_us();
+        if (a_daemon_enqueue(&req) != 0)
+        {
+            a_daemon_reply(i, client->gen, "err full\n");
+        }
+    }
+    client->len = 0;
+    client->overflow = 0;
+}
+
+/**
+ * @brief     daemon receive
+ * @param[in] i client slot
+ * @note      none
+ */
+static void a_daemon_receive(uint16_t i)
+{
+    ssize_t r;
+    ssize_t k;
+    char buf[256];
+    daemon_client_t *client = &gs_client[i];
+    
+    r = recv(client->fd, buf, sizeof(buf), 0);
+    if (r == 0)
+    {
+        a_daemon_close(i);
+        
+        return;
+    }
+    if (r < 0)
+    {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        {
+            a_daemon_close(i);
+        }
+        
+        return;
+    }
+    for (k = 0; k < r; k++)
+    {
+        if (buf[k] == '\n')
+        {
+            a_daemon_line(i);
+        }
+        else if (client->len < DAEMON_LINE_SIZE - 1)
+        {
+            client->line[client->len++] = buf[k];
+        }
+        else
+        {
+            client->overflow = 1;
+        }
+    }
+}
+
+/**
+ * @brief  daemon accept
+ * @note   a client beyond the limit is closed right away
+ */
+static void a_daemon_accept(void)
+{
+    int fd;
+    uint16_t i;
+    
+    fd = accept(gs_listen, NULL, NULL);
+    if (fd < 0)
+    {
+        return;
+    }
+    (void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    (void)pthread_mutex_lock(&gs_client_mutex);
+    for (i = 0; i < DAEMON_MAX_CLIENTS; i++)
+    {
+        if (gs_client[i].fd < 0)
+        {
+            gs_client[i].fd = fd;
+            gs_client[i].len = 0;
+            gs_client[i].overflow = 0;
+            
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&gs_client_mutex);
+    if (i == DAEMON_MAX_CLIENTS)
+    {
+        (void)close(fd);
+    }
+}
+
+/**
+ * @brief     daemon link the handle
+ * @param[in] mock 1 links the mock chip
+ * @note      none
+ */
+static void a_daemon_link(uint8_t mock)
+{
+    wt588e02b_mock_config_t config;
+    
+    if (mock != 0)
+    {
+        config.play_response_us = 15000;
+        config.stop_response_us = 3000;
+        config.jitter_us = 2000;
+        config.clip_us = 200000;
+        wt588e02b_mock_init(&config);
+        wt588e02b_mock_link(&gs_handle);
+    }
+    else
+    {
+        DRIVER_WT588E02B_LINK_INIT(&gs_handle, wt588e02b_handle_t);
+        DRIVER_WT588E02B_LINK_OPS(&gs_handle, &gs_ops);
+        DRIVER_WT588E02B_LINK_BUFFER(&gs_handle, gs_buf);
+    }
+}
+
+/**
+ * @brief     daemon init
+ * @param[in] *path pointer to a socket path
+ * @param[in] mock 1 drives the mock chip instead of the gpio
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      initializes the chip once, binds the socket and starts the bus worker
+ */
+uint8_t daemon_init(const char *path, uint8_t mock)
+{
+    uint16_t i;
+    struct sockaddr_un addr;
+    
+    /* check the path */
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        wt588e02b_interface_debug_print("daemon: socket path is too long.\n");
+        
+        return 1;
+    }
+    strcpy(gs_path, path);
+    
+    /* init the chip once */
+    a_daemon_link(mock);
+    if (wt588e02b_init(&gs_handle) != 0)
+    {
+        wt588e02b_interface_debug_print("daemon: init failed.\n");
+        
+        return 1;
+    }
+    (void)wt588e02b_set_shadow(&gs_handle, WT588E02B_BOOL_TRUE);
+    
+    /* make the wake pipe */
+    if (pipe(gs_wake) != 0)
+    {
+        wt588e02b_interface_debug_print("daemon: pipe failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)fcntl(gs_wake[0], F_SETFL, fcntl(gs_wake[0], F_GETFL) | O_NONBLOCK);
+    (void)fcntl(gs_wake[1], F_SETFL, fcntl(gs_wake[1], F_GETFL) | O_NONBLOCK);
+    
+    /* bind the socket */
+    gs_listen = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (gs_listen < 0)
+    {
+        wt588e02b_interface_debug_print("daemon: socket failed.\n");
+        goto failed;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, gs_path);
+    (void)unlink(gs_path);
+    if ((bind(gs_listen, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(gs_listen, 16) != 0))
+    {
+        wt588e02b_interface_debug_print("daemon: bind %s failed.\n", gs_path);
+        goto failed;
+    }
+    
+    /* reset the state */
+    for (i = 0; i < DAEMON_MAX_CLIENTS; i++)
+    {
+        gs_client[i].fd = -1;
+        gs_client[i].gen = 0;
+    }
+    gs_queue_head = 0;
+    gs_queue_count = 0;
+    gs_enqueued = 0;
+    gs_rejected = 0;
+    gs_depth_sum = 0;
+    gs_depth_max = 0;
+    gs_requests = 0;
+    gs_batches = 0;
+    gs_merged = 0;
+    gs_errors = 0;
+    gs_latency_count = 0;
+    gs_latency_sum = 0;
+    gs_latency_max = 0;
+    gs_stop = 0;
+    gs_worker_stop = 0;
+    
+    /* start the worker */
+    if (pthread_create(&gs_worker, NULL, a_daemon_worker, NULL) != 0)
+    {
+        wt588e02b_interface_debug_print("daemon: create thread failed.\n");
+        goto failed;
+    }
+    
+    return 0;
+    
+    failed:
+    if (gs_listen >= 0)
+    {
+        (void)close(gs_listen);
+        gs_listen = -1;
+        (void)unlink(gs_path);
+    }
+    (void)close(gs_wake[0]);
+    (void)close(gs_wake[1]);
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    return 1;
+}
+
+/**
+ * @brief  daemon run
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   serves the clients until daemon_stop is called
+ */
+uint8_t daemon_run(void)
+{
+    int r;
+    nfds_t n;
+    nfds_t k;
+    uint16_t i;
+    char buf[16];
+    uint16_t slot[DAEMON_MAX_CLIENTS];
+    struct pollfd fds[DAEMON_MAX_CLIENTS + 2];
+    
+    while (gs_stop == 0)
+    {
+        /* collect the sockets */
+        fds[0].fd = gs_wake[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = gs_listen;
+        fds[1].events = POLLIN;
+        n = 2;
+        for (i = 0; i < DAEMON_MAX_CLIENTS; i++)
+        {
+            if (gs_client[i].fd >= 0)
+            {
+                fds[n].fd = gs_client[i].fd;
+                fds[n].events = POLLIN;
+                slot[n - 2] = i;
+                n++;
+            }
+        }
+        
+        /* wait */
+        r = poll(fds, n, -1);
+        if (r < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            wt588e02b_interface_debug_print("daemon: poll failed.\n");
+            
+            return 1;
+        }
+        
+        /* serve */
+        if ((fds[0].revents & POLLIN) != 0)
+        {
+            while (read(gs_wake[0], buf, sizeof(buf)) > 0)
+            {
+                
+            }
+        }
+        for (k = 2; k < n; k++)
+        {
+            if ((fds[k].revents & (POLLIN | POLLHUP | POLLERR)) != 0)
+            {
+                a_daemon_receive(slot[k - 2]);
+            }
+        }
+        if ((fds[1].revents & POLLIN) != 0)
+        {
+            a_daemon_accept();
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief daemon stop
+ * @note  safe to call from a signal handler
+ */
+void daemon_stop(void)
+{
+    gs_stop = 1;
+    if (gs_wake[1] >= 0)
+    {
+        (void)write(gs_wake[1], "x", 1);
+    }
+}
+
+/**
+ * @brief  daemon deinit
+ * @return status code
+ *         - 0 success
+ * @note   stops the worker, closes the clients and removes the socket
+ */
+uint8_t daemon_deinit(void)
+{
+    uint16_t i;
+    
+    /* stop the worker after the queued requests */
+    (void)pthread_mutex_lock(&gs_queue_mutex);
+    gs_worker_stop = 1;
+    (void)pthread_cond_signal(&gs_queue_cond);
+    (void)pthread_mutex_unlock(&gs_queue_mutex);
+    (void)pthread_join(gs_worker, NULL);
+    
+    /* close everything */
+    for (i = 0; i < DAEMON_MAX_CLIENTS; i++)
+    {
+        if (gs_client[i].fd >= 0)
+        {
+            a_daemon_close(i);
+        }
+    }
+    (void)close(gs_listen);
+    gs_listen = -1;
+    (void)unlink(gs_path);
+    (void)close(gs_wake[0]);
+    (void)close(gs_wake[1]);
+    gs_wake[0] = -1;
+    gs_wake[1] = -1;
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief      send one request to a running daemon
+ * @param[in]  *path pointer to a socket path
+ * @param[in]  *line pointer to a request line
+ * @param[out] *reply pointer to a reply buffer
+ * @param[in]  len reply buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ * @note       the request line has no newline, the reply has it stripped
+ */
+uint8_t daemon_request(const char *path, const char *line, char *reply, size_t len)
+{
+    int fd;
+    size_t got;
+    ssize_t r;
+    struct timeval tv;
+    struct sockaddr_un addr;
+    
+    /* check the params */
+    if ((strlen(path) >= sizeof(addr.sun_path)) || (len == 0))
+    {
+        return 1;
+    }
+    
+    /* connect */
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    tv.tv_sec = DAEMON_REQUEST_TIMEOUT;
+    tv.tv_usec = 0;
+    (void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* send the line */
+    if ((send(fd, line, strlen(line), MSG_NOSIGNAL) < 0) || (send(fd, "\n", 1, MSG_NOSIGNAL) < 0))
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* read one reply line */
+    got = 0;
+    while (got < len - 1)
+    {
+        r = recv(fd, &reply[got], 1, 0);
+        if (r <= 0)
+        {
+            (void)close(fd);
+            
+            return 1;
+        }
+        if (reply[got] == '\n')
+        {
+            break;
+        }
+        got++;
+    }
+    reply[got] = '\0';
+    (void)close(fd);
+    
+    return 0;
+}
@@ -0,0 +1,453 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     daemon main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "daemon.h"
+#include "driver_wt588e02b_interface.h"
+#include "driver_wt588e02b_mock.h"
+#include "wire.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief self test definition
+ */
+#define DAEMON_SELF_TEST_CLIENTS    8         /**< client threads */
+#define DAEMON_SELF_TEST_ROUNDS     20        /**< rounds per client */
+
+/**
+ * @brief self test request structure definition
+ */
+typedef struct daemon_self_test_s
+{
+    const char *line;                 /**< request line */
+    const char *reply;                /**< accepted reply prefix */
+    uint8_t busy;                     /**< 1 also accepts the busy codes, merged plays may answer either */
+} daemon_self_test_t;
+
+/**
+ * @brief self test global var definition
+ */
+static const daemon_self_test_t gs_script[] =
+{
+    {"vol 20", "ok", 0},
+    {"play 1", "ok", 1},
+    {"list 1 2 3", "ok", 1},
+    {"busy", "ok busy=", 0},
+    {"stop", "ok", 0},
+    {"vol 40", "ok", 0},
+    {"vol 300", "err parse", 0},
+    {"foo 1", "err parse", 0},
+};
+static const char *gs_socket;                /**< self test socket path */
+static uint32_t gs_failed;                   /**< self test failures */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief     signal handler
+ * @param[in] sig signal number
+ * @note      none
+ */
+static void a_daemon_signal(int sig)
+{
+    (void)sig;
+    daemon_stop();
+}
+
+/**
+ * @brief     daemon run thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      none
+ */
+static void *a_daemon_run_thread(void *arg)
+{
+    (void)arg;
+    (void)daemon_run();
+    
+    return NULL;
+}
+
+/**
+ * @brief     self test client thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      none
+ */
+static void *a_daemon_client_thread(void *arg)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t failed = 0;
+    char reply[512];
+    
+    (void)arg;
+    for (i = 0; i < DAEMON_SELF_TEST_ROUNDS; i++)
+    {
+        for (j = 0; j < sizeof(gs_script) / sizeof(gs_script[0]); j++)
+        {
+            if (daemon_request(gs_socket, gs_script[j].line, reply, sizeof(reply)) != 0)
+            {
+                wt588e02b_interface_debug_print("daemon: %s got no reply.\n", gs_script[j].line);
+                failed++;
+                
+                continue;
+            }
+            if ((strncmp(reply, gs_script[j].reply, strlen(gs_script[j].reply)) != 0) &&
+                ((gs_script[j].busy == 0) || ((strcmp(reply, "err 5") != 0) && (strcmp(reply, "err 6") != 0))))
+            {
+                wt588e02b_interface_debug_print("daemon: %s got %s.\n", gs_script[j].line, reply);
+                failed++;
+            }
+        }
+    }
+    (void)pthread_mutex_lock(&gs_mutex);
+    gs_failed += failed;
+    (void)pthread_mutex_unlock(&gs_mutex);
+    
+    return NULL;
+}
+
+/**
+ * @brief     daemon self test
+ * @param[in] *path pointer to a socket path
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs the daemon on the mock chip and hammers it from several clients
+ */
+static uint8_t a_daemon_self_test(const char *path)
+{
+    uint32_t i;
+    uint8_t res;
+    char reply[512];
+    pthread_t run;
+    pthread_t client[DAEMON_SELF_TEST_CLIENTS];
+    wt588e02b_mock_state_t state;
+    
+    /* start the daemon on the mock chip */
+    if (daemon_init(path, 1) != 0)
+    {
+        return 1;
+    }
+    if (pthread_create(&run, NULL, a_daemon_run_thread, NULL) != 0)
+    {
+        (void)daemon_deinit();
+        
+        return 1;
+    }
+    
+    /* run the clients */
+    wt588e02b_interface_debug_print("daemon: %d clients, %d rounds.\n", DAEMON_SELF_TEST_CLIENTS, DAEMON_SELF_TEST_ROUNDS);
+    gs_socket = path;
+    gs_failed = 0;
+    for (i = 0; i < DAEMON_SELF_TEST_CLIENTS; i++)
+    {
+        if (pthread_create(&client[i], NULL, a_daemon_client_thread, NULL) != 0)
+        {
+            break;
+        }
+    }
+    res = (i == DAEMON_SELF_TEST_CLIENTS) ? 0 : 1;
+    while (i > 0)
+    {
+        i--;
+        (void)pthread_join(client[i], NULL);
+    }
+    
+    /* print the metrics */
+    if (daemon_request(path, "metrics", reply, sizeof(reply)) != 0)
+    {
+        res = 1;
+    }
+    else
+    {
+        wt588e02b_interface_debug_print("daemon: %s.\n", reply);
+    }
+    
+    /* stop the daemon */
+    daemon_stop();
+    (void)pthread_join(run, NULL);
+    (void)daemon_deinit();
+    
+    /* check the bus */
+    wt588e02b_mock_get_state(&state);
+    wt588e02b_interface_debug_print("daemon: %d frames decoded, %d protocol errors, %d bad replies.\n",
+                                    state.frames, state.errors, gs_failed);
+    if ((state.errors != 0) || (gs_failed != 0))
+    {
+        res = 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     wt588e02b daemon full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t wt588e02bd(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"socket", required_argument, NULL, 1},
+        {"mock", no_argument, NULL, 2},
+        {"send", required_argument, NULL, 3},
+        {"self-test", no_argument, NULL, 4},
+        {"backend", required_argument, NULL, 5},
+        {NULL, 0, NULL, 0},
+    };
+    char path[108] = DAEMON_DEFAULT_SOCKET;
+    char line[128] = "";
+    char reply[512];
+    uint8_t mock = 0;
+    uint8_t self_test = 0;
+    uint8_t help = 0;
+    wire_backend_t backend = WIRE_BACKEND_GPIOD;
+    struct sigaction sa;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* socket path */
+            case 1 :
+            {
+                memset(path, 0, sizeof(char) * 108);
+                strncpy(path, optarg, 107);
+                
+                break;
+            }
+            
+            /* mock */
+            case 2 :
+            {
+                mock = 1;
+                
+                break;
+            }
+            
+            /* send */
+            case 3 :
+            {
+                memset(line, 0, sizeof(char) * 128);
+                strncpy(line, optarg, 127);
+                
+                break;
+            }
+            
+            /* self test */
+            case 4 :
+            {
+                self_test = 1;
+                
+                break;
+            }
+            
+            /* backend */
+            case 5 :
+            {
+                if (strcmp("gpiod", optarg) == 0)
+                {
+                    backend = WIRE_BACKEND_GPIOD;
+                }
+                else if (strcmp("gpiomem", optarg) == 0)
+                {
+                    backend = WIRE_BACKEND_GPIOMEM;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if (help != 0)
+    {
+        wt588e02b_interface_debug_print("Usage:\n");
+        wt588e02b_interface_debug_print("  wt588e02bd [--socket=<path>] [--mock] [--backend=<gpiod | gpiomem>]\n");
+        wt588e02b_interface_debug_print("  wt588e02bd [--socket=<path>] --send=<request>\n");
+        wt588e02b_interface_debug_print("  wt588e02bd [--socket=<path>] --self-test\n");
+        wt588e02b_interface_debug_print("  wt588e02bd (-h | --help)\n");
+        wt588e02b_interface_debug_print("\n");
+        wt588e02b_interface_debug_print("Requests:\n");
+        wt588e02b_interface_debug_print("  play <ind>                  play one index.\n");
+        wt588e02b_interface_debug_print("  list <ind> [<ind> ...]      play up to 40 indexes.\n");
+        wt588e02b_interface_debug_print("  vol <vol>                   set the volume.\n");
+        wt588e02b_interface_debug_print("  stop                        stop playing.\n");
+        wt588e02b_interface_debug_print("  update <ind> <path>         update one voice.\n");
+        wt588e02b_interface_debug_print("  update-all <path>           update the whole flash.\n");
+        wt588e02b_interface_debug_print("  busy                        read the busy pin.\n");
+        wt588e02b_interface_debug_print("  metrics                     read the latency and queue metrics.\n");
+        wt588e02b_interface_debug_print("\n");
+        wt588e02b_interface_debug_print("Options:\n");
+        wt588e02b_interface_debug_print("      --backend=<gpiod | gpiomem>\n");
+        wt588e02b_interface_debug_print("                              Set the gpio backend.([default: gpiod])\n");
+        wt588e02b_interface_debug_print("  -h, --help                  Show the help.\n");
+        wt588e02b_interface_debug_print("      --mock                  Drive the mock chip instead of the gpio.\n");
+        wt588e02b_interface_debug_print("      --self-test             Run the daemon on the mock chip with several clients.\n");
+        wt588e02b_interface_debug_print("      --send=<request>        Send one request to a running daemon.\n");
+        wt588e02b_interface_debug_print("      --socket=<path>         Set the unix socket path.([default: %s])\n", DAEMON_DEFAULT_SOCKET);
+        
+        return 0;
+    }
+    
+    /* client mode */
+    if (line[0] != '\0')
+    {
+        if (daemon_request(path, line, reply, sizeof(reply)) != 0)
+        {
+            wt588e02b_interface_debug_print("daemon: request failed.\n");
+            
+            return 1;
+        }
+        wt588e02b_interface_debug_print("%s\n", reply);
+        
+        return (strncmp(reply, "ok", 2) == 0) ? 0 : 1;
+    }
+    
+    /* self test */
+    if (self_test != 0)
+    {
+        if (a_daemon_self_test(path) != 0)
+        {
+            wt588e02b_interface_debug_print("daemon: self test failed.\n");
+            
+            return 1;
+        }
+        wt588e02b_interface_debug_print("daemon: self test passed.\n");
+        
+        return 0;
+    }
+    
+    /* run the daemon */
+    (void)wire_set_backend(backend, NULL);
+    if (daemon_init(path, mock) != 0)
+    {
+        return 1;
+    }
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = a_daemon_signal;
+    (void)sigaction(SIGINT, &sa, NULL);
+    (void)sigaction(SIGTERM, &sa, NULL);
+    wt588e02b_interface_debug_print("daemon: listening on %s.\n", path);
+    if (daemon_run() != 0)
+    {
+        (void)daemon_deinit();
+        
+        return 1;
+    }
+    (void)daemon_deinit();
+    wt588e02b_interface_debug_print("daemon: stopped.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+    
+    res = wt588e02bd(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        wt588e02b_interface_debug_print("wt588e02bd: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        wt588e02b_interface_debug_print("wt588e02bd: param is invalid.\n");
+    }
+    else
+    {
+        wt588e02b_interface_debug_print("wt588e02bd: unknown status code.\n");
+    }
+    
+    return (res == 0) ? 0 : 1;
+}
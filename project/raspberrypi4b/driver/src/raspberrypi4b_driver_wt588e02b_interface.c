@@ -36,9 +36,14 @@
 
 #include "driver_wt588e02b_interface.h"
 #include "wire.h"
+#include "delay.h"
+#include "rt.h"
 #include <stdarg.h>
+#include <time.h>
+#include <pthread.h>
 
 static FILE *gs_fp = NULL;                  /**< fp handle */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;    /**< handle mutex */
 
 /**
  * @brief  interface sclk gpio init
@@ -49,6 +54,9 @@ static FILE *gs_fp = NULL;                  /**< fp handle */
  */
 uint8_t wt588e02b_interface_sclk_gpio_init(void)
 {
+    /* calibrate the delay before the first transfer */
+    (void)delay_init();
+    
     return wire_clock_init();
 }
 
@@ -195,17 +203,17 @@ uint8_t wt588e02b_interface_cs_gpio_write(uint8_t data)
  */
 void wt588e02b_interface_delay_ms(uint32_t ms)
 {
-    usleep(1000 * ms);
+    delay_ms(ms);
 }
 
 /**
  * @brief     interface delay us
  * @param[in] us time
- * @note      none
+ * @note      usleep oversleeps by tens of us, the delay engine spins the short waits
  */
 void wt588e02b_interface_delay_us(uint32_t us)
 {
-    usleep(us);
+    delay_us(us);
 }
 
 /**
@@ -274,6 +282,97 @@ uint8_t wt588e02b_interface_bin_read_deinit(void)
     return 0;
 }
 
+/**
+ * @brief  interface timestamp ms
+ * @return current time in ms
+ * @note   used by the duration profiler, it may wrap around
+ */
+uint32_t wt588e02b_interface_timestamp_ms(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief     interface lock
+ * @param[in] wait 1 blocks until the lock is taken, 0 only tries once
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      a pthread mutex shared by all threads of the process,
+ *            the locked section is one transaction and runs in the rt mode when it is inited
+ */
+uint8_t wt588e02b_interface_lock(uint8_t wait)
+{
+    int res;
+    
+    if (wait != 0)                                  /* block */
+    {
+        res = pthread_mutex_lock(&gs_mutex);        /* lock */
+    }
+    else
+    {
+        res = pthread_mutex_trylock(&gs_mutex);     /* try once */
+    }
+    if (res != 0)                                   /* check result */
+    {
+        return 1;                                   /* return error */
+    }
+    rt_enter();                                     /* enter the transaction */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief  interface unlock
+ * @return status code
+ *         - 0 success
+ *         - 1 unlock failed
+ * @note   none
+ */
+uint8_t wt588e02b_interface_unlock(void)
+{
+    rt_exit();                                      /* exit the transaction */
+    if (pthread_mutex_unlock(&gs_mutex) != 0)       /* unlock */
+    {
+        return 1;                                   /* return error */
+    }
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief     interface cs gpio write of several chips
+ * @param[in] mask chip mask
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      chip 0 - 3 use the wire bank cs gpio 22 - 25, they change with one bulk line request
+ *            or one gpiomem store
+ */
+uint8_t wt588e02b_interface_cs_gpio_write_mask(uint32_t mask, uint8_t data)
+{
+    return wire_bank_cs_write(mask, data);
+}
+
+/**
+ * @brief      interface miso gpio read of several chips
+ * @param[out] *data pointer to a level mask buffer, one bit per chip
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       chip 0 - 3 use the wire bank miso gpio 5, 6, 13 and 19, they are sampled with one
+ *             bulk line request or one gpiomem load
+ */
+uint8_t wt588e02b_interface_miso_gpio_read_mask(uint32_t *data)
+{
+    return wire_bank_read(data);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
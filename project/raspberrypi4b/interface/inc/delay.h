@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      delay.h
+ * @brief     delay header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DELAY_H
+#define DELAY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup delay delay function
+ * @brief    high resolution delay modules
+ * @{
+ */
+
+/**
+ * @brief delay statistics structure definition
+ */
+typedef struct delay_stats_s
+{
+    uint32_t count;               /**< delays since the last clear */
+    uint64_t requested_ns;        /**< requested time */
+    uint32_t late_max_ns;         /**< worst wake-up after the deadline */
+} delay_stats_t;
+
+/**
+ * @brief  delay init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   measures how late clock_nanosleep wakes up and keeps that as the early-wake margin,
+ *         the first delay calls it when it is not called before
+ */
+uint8_t delay_init(void);
+
+/**
+ * @brief     delay us
+ * @param[in] us time
+ * @note      sleeps until the margin before the deadline, then spins on CLOCK_MONOTONIC_RAW,
+ *            waits shorter than the margin only spin, it never returns early
+ */
+void delay_us(uint32_t us);
+
+/**
+ * @brief     delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+void delay_ms(uint32_t ms);
+
+/**
+ * @brief  delay get the margin
+ * @return early-wake margin in ns
+ * @note   none
+ */
+uint32_t delay_get_margin_ns(void);
+
+/**
+ * @brief      delay get the statistics
+ * @param[out] *stats pointer to a statistics structure
+ * @note       none
+ */
+void delay_get_stats(delay_stats_t *stats);
+
+/**
+ * @brief delay clear the statistics
+ * @note  the statistics are plain counters, clear and read them from the thread that delays
+ */
+void delay_clear_stats(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpiomem.h
+ * @brief     gpiomem header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef GPIOMEM_H
+#define GPIOMEM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup gpiomem gpiomem function
+ * @brief    bcm2711 gpio register function modules
+ * @{
+ */
+
+/**
+ * @brief gpiomem register definition
+ */
+#define GPIOMEM_BLOCK_SIZE    4096        /**< mapped gpio block size */
+#define GPIOMEM_GPFSEL0       0x00        /**< function select 0, 3 bits per pin and 10 pins per register */
+#define GPIOMEM_GPSET0        0x1C        /**< output set 0, 1 sets the pin */
+#define GPIOMEM_GPCLR0        0x28        /**< output clear 0, 1 clears the pin */
+#define GPIOMEM_GPLEV0        0x34        /**< pin level 0 */
+#define GPIOMEM_MAX_PIN       58          /**< bcm2711 gpio number */
+
+/**
+ * @brief     gpiomem init
+ * @param[in] *window pointer to a register window, NULL maps /dev/gpiomem
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      an injected window is any GPIOMEM_BLOCK_SIZE bytes region laid out like the gpio block,
+ *            so the register writes can be checked without the hardware
+ */
+uint8_t gpiomem_init(volatile uint32_t *window);
+
+/**
+ * @brief  gpiomem deinit
+ * @return status code
+ *         - 0 success
+ * @note   an injected window is left to its owner
+ */
+uint8_t gpiomem_deinit(void);
+
+/**
+ * @brief     gpiomem set the pin mode
+ * @param[in] pin gpio pin
+ * @param[in] output 1 output, 0 input
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mode failed
+ * @note      none
+ */
+uint8_t gpiomem_set_mode(uint8_t pin, uint8_t output);
+
+/**
+ * @brief     gpiomem write the pin
+ * @param[in] pin gpio pin
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one store to the set or clear register
+ */
+uint8_t gpiomem_write(uint8_t pin, uint8_t value);
+
+/**
+ * @brief      gpiomem read the pin
+ * @param[in]  pin gpio pin
+ * @param[out] *value pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one load from the level register
+ */
+uint8_t gpiomem_read(uint8_t pin, uint8_t *value);
+
+/**
+ * @brief     gpiomem write several pins
+ * @param[in] mask pin mask of the gpio 0 - 31
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one store to the set or clear register, so every pin changes at the same time
+ */
+uint8_t gpiomem_write_mask(uint32_t mask, uint8_t value);
+
+/**
+ * @brief      gpiomem read several pins
+ * @param[out] *value pointer to a level mask buffer of the gpio 0 - 31
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one load from the level register
+ */
+uint8_t gpiomem_read_mask(uint32_t *value);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
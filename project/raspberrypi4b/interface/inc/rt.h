@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.h
+ * @brief     rt header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RT_H
+#define RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup rt rt function
+ * @brief    real-time transfer modules
+ * @{
+ */
+
+/**
+ * @brief rt config structure definition
+ */
+typedef struct rt_config_s
+{
+    int priority;                 /**< SCHED_FIFO priority of the transfers, 0 keeps the normal policy */
+    int cpu;                      /**< cpu the transfers are pinned to, -1 keeps the affinity */
+} rt_config_t;
+
+/**
+ * @brief rt statistics structure definition
+ */
+typedef struct rt_stats_s
+{
+    uint32_t transactions;        /**< transactions that waited at least once */
+    uint64_t stretch_sum_ns;      /**< time beyond the requested delays */
+    uint32_t stretch_max_ns;      /**< worst time beyond the requested delays of one transaction */
+    uint32_t late_max_ns;         /**< worst wake-up after a delay deadline */
+} rt_stats_t;
+
+/**
+ * @brief     rt init
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      with a priority the memory is locked with mlockall, this needs CAP_SYS_NICE and CAP_IPC_LOCK,
+ *            pin the transfers to a cpu removed from the scheduler with isolcpus to isolate them
+ */
+uint8_t rt_init(const rt_config_t *config);
+
+/**
+ * @brief  rt deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t rt_deinit(void);
+
+/**
+ * @brief rt enter a transaction
+ * @note  called with the bus lock held, it switches the calling thread to the rt policy
+ *        and starts the jitter measurement
+ */
+void rt_enter(void);
+
+/**
+ * @brief rt exit a transaction
+ * @note  called before the bus lock is released, it records the jitter and restores the thread
+ */
+void rt_exit(void);
+
+/**
+ * @brief      rt get the statistics
+ * @param[out] *stats pointer to a statistics structure
+ * @note       none
+ */
+void rt_get_stats(rt_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -51,12 +51,33 @@
  * @{
  */
 
+/**
+ * @brief wire backend enumeration definition
+ */
+typedef enum
+{
+    WIRE_BACKEND_GPIOD   = 0x00,        /**< libgpiod character device */
+    WIRE_BACKEND_GPIOMEM = 0x01,        /**< bcm2711 registers through /dev/gpiomem */
+} wire_backend_t;
+
+/**
+ * @brief     wire set the backend
+ * @param[in] backend gpio backend
+ * @param[in] *window pointer to a register window for the gpiomem backend, NULL maps /dev/gpiomem
+ * @return    status code
+ *            - 0 success
+ *            - 1 lines are in use
+ * @note      takes effect at the next first init
+ */
+uint8_t wire_set_backend(wire_backend_t backend, volatile uint32_t *window);
+
 /**
  * @brief  wire bus init
  * @return status code
  *         - 0 success
  *         - 1 init failed
- * @note   none
+ * @note   every init shares one chip, the lines are requested once by the first init
+ *         and released by the last deinit
  */
 uint8_t wire_init(void);
 
@@ -74,20 +95,10 @@ uint8_t wire_deinit(void);
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the line stays an input for its lifetime
  */
 uint8_t wire_read(uint8_t *value);
 
-/**
- * @brief     wire bus write data
- * @param[in] value write data
- * @return    status code
- *            - 0 success
- *             - 1 write failed
- * @note      none
- */
-uint8_t wire_write(uint8_t value);
-
 /**
  * @brief  wire bus init
  * @return status code
@@ -169,6 +180,30 @@ uint8_t wire_cs_deinit(void);
  */
 uint8_t wire_cs_write(uint8_t value);
 
+/**
+ * @brief     wire bank write the cs lines
+ * @param[in] mask chip mask
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the bank drives up to 4 chips on the shared clock and data lines, chip 0 - 3 use
+ *            the cs gpio 22 - 25 and the miso gpio 5, 6, 13 and 19, the first bank call after
+ *            a wire init requests the bank lines and the last deinit releases them,
+ *            every cs in the mask changes with one bulk request or one register store
+ */
+uint8_t wire_bank_cs_write(uint32_t mask, uint8_t value);
+
+/**
+ * @brief      wire bank read the miso lines
+ * @param[out] *value pointer to a level mask buffer, one bit per chip
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       every miso is sampled with one bulk request or one register load
+ */
+uint8_t wire_bank_read(uint32_t *value);
+
 /**
  * @}
  */
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      delay.c
+ * @brief     delay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "delay.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief delay calibration definition
+ */
+#define DELAY_CALIBRATION_TIMES      32             /**< calibration sleeps */
+#define DELAY_CALIBRATION_SLEEP_NS   200000         /**< calibration sleep length */
+#define DELAY_MARGIN_MIN_NS          5000           /**< min early-wake margin */
+#define DELAY_MARGIN_MAX_NS          500000         /**< max early-wake margin */
+#define DELAY_MARGIN_DEFAULT_NS      100000         /**< margin when the calibration fails */
+
+/**
+ * @brief global var definition
+ */
+static pthread_once_t gs_once = PTHREAD_ONCE_INIT;          /**< lazy init */
+static volatile uint32_t gs_margin_ns;                      /**< early-wake margin */
+static delay_stats_t gs_stats;                              /**< delay statistics */
+
+/**
+ * @brief  delay clock
+ * @return raw monotonic time in ns
+ * @note   CLOCK_MONOTONIC_RAW is not slewed by ntp
+ */
+static inline uint64_t a_delay_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     delay sleep
+ * @param[in] ns time
+ * @note      clock_nanosleep has no CLOCK_MONOTONIC_RAW, a relative sleep is used and the spin corrects the rest
+ */
+static void a_delay_sleep(uint64_t ns)
+{
+    struct timespec ts;
+    
+    ts.tv_sec = (time_t)(ns / 1000000000ULL);
+    ts.tv_nsec = (long)(ns % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) == EINTR)
+    {
+        
+    }
+}
+
+/**
+ * @brief     delay compare
+ * @param[in] *a pointer to the first sample
+ * @param[in] *b pointer to the second sample
+ * @return    compare result
+ * @note      none
+ */
+static int a_delay_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief delay calibrate
+ * @note  the margin is the 90th percentile of the measured oversleep
+ */
+static void a_delay_calibrate(void)
+{
+    uint32_t i;
+    uint64_t t;
+    uint64_t late[DELAY_CALIBRATION_TIMES];
+    uint64_t margin;
+    
+    /* measure the oversleep */
+    for (i = 0; i < DELAY_CALIBRATION_TIMES; i++)
+    {
+        t = a_delay_ns();
+        a_delay_sleep(DELAY_CALIBRATION_SLEEP_NS);
+        t = a_delay_ns() - t;
+        late[i] = (t > DELAY_CALIBRATION_SLEEP_NS) ? (t - DELAY_CALIBRATION_SLEEP_NS) : 0;
+    }
+    qsort(late, DELAY_CALIBRATION_TIMES, sizeof(uint64_t), a_delay_compare);
+    margin = late[DELAY_CALIBRATION_TIMES * 9 / 10];
+    
+    /* clamp */
+    if (margin < DELAY_MARGIN_MIN_NS)
+    {
+        margin = DELAY_MARGIN_MIN_NS;
+    }
+    if (margin > DELAY_MARGIN_MAX_NS)
+    {
+        margin = DELAY_MARGIN_MAX_NS;
+    }
+    gs_margin_ns = (uint32_t)margin;
+}
+
+/**
+ * @brief  delay init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   measures how late clock_nanosleep wakes up and keeps that as the early-wake margin,
+ *         the first delay calls it when it is not called before
+ */
+uint8_t delay_init(void)
+{
+    if (pthread_once(&gs_once, a_delay_calibrate) != 0)
+    {
+        gs_margin_ns = DELAY_MARGIN_DEFAULT_NS;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     delay us
+ * @param[in] us time
+ * @note      sleeps until the margin before the deadline, then spins on CLOCK_MONOTONIC_RAW,
+ *            waits shorter than the margin only spin, it never returns early
+ */
+void delay_us(uint32_t us)
+{
+    uint64_t now;
+    uint64_t end;
+    
+    /* calibrate once */
+    if (gs_margin_ns == 0)
+    {
+        (void)delay_init();
+    }
+    
+    /* get the deadline */
+    now = a_delay_ns();
+    end = now + (uint64_t)us * 1000;
+    
+    /* sleep the long part */
+    if (end > now + gs_margin_ns)
+    {
+        a_delay_sleep(end - now - gs_margin_ns);
+    }
+    
+    /* spin the rest */
+    do
+    {
+        now = a_delay_ns();
+    } while (now < end);
+    
+    /* update the statistics */
+    gs_stats.count++;
+    gs_stats.requested_ns += (uint64_t)us * 1000;
+    if (now - end > gs_stats.late_max_ns)
+    {
+        gs_stats.late_max_ns = (uint32_t)(now - end);
+    }
+}
+
+/**
+ * @brief     delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+void delay_ms(uint32_t ms)
+{
+    while (ms > 1000)
+    {
+        delay_us(1000000);
+        ms -= 1000;
+    }
+    delay_us(ms * 1000);
+}
+
+/**
+ * @brief  delay get the margin
+ * @return early-wake margin in ns
+ * @note   none
+ */
+uint32_t delay_get_margin_ns(void)
+{
+    return gs_margin_ns;
+}
+
+/**
+ * @brief      delay get the statistics
+ * @param[out] *stats pointer to a statistics structure
+ * @note       none
+ */
+void delay_get_stats(delay_stats_t *stats)
+{
+    *stats = gs_stats;
+}
+
+/**
+ * @brief delay clear the statistics
+ * @note  none
+ */
+void delay_clear_stats(void)
+{
+    gs_stats.count = 0;
+    gs_stats.requested_ns = 0;
+    gs_stats.late_max_ns = 0;
+}
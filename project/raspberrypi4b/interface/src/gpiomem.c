@@ -0,0 +1,249 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpiomem.c
+ * @brief     gpiomem source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpiomem.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief gpiomem device name definition
+ */
+#define GPIOMEM_DEVICE_NAME "/dev/gpiomem"        /**< gpiomem device name */
+
+/**
+ * @brief global var definition
+ */
+static volatile uint32_t *gs_reg;                 /**< register window */
+static uint8_t gs_mapped;                         /**< 1 if the window is mapped here */
+
+/**
+ * @brief     gpiomem register
+ * @param[in] offset register byte offset
+ * @param[in] pin gpio pin
+ * @return    pointer to the register of the pin bank
+ * @note      none
+ */
+static inline volatile uint32_t *a_gpiomem_reg(uint32_t offset, uint8_t pin)
+{
+    return &gs_reg[offset / 4 + pin / 32];
+}
+
+/**
+ * @brief     gpiomem init
+ * @param[in] *window pointer to a register window, NULL maps /dev/gpiomem
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      an injected window is any GPIOMEM_BLOCK_SIZE bytes region laid out like the gpio block,
+ *            so the register writes can be checked without the hardware
+ */
+uint8_t gpiomem_init(volatile uint32_t *window)
+{
+    int fd;
+    void *map;
+    
+    /* use the injected window */
+    if (window != NULL)
+    {
+        gs_reg = window;
+        gs_mapped = 0;
+        
+        return 0;
+    }
+    
+    /* open the gpiomem */
+    fd = open(GPIOMEM_DEVICE_NAME, O_RDWR | O_SYNC);
+    if (fd < 0)
+    {
+        perror("gpiomem: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* map the gpio block */
+    map = mmap(NULL, GPIOMEM_BLOCK_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED)
+    {
+        perror("gpiomem: map failed.\n");
+        
+        return 1;
+    }
+    gs_reg = (volatile uint32_t *)map;
+    gs_mapped = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  gpiomem deinit
+ * @return status code
+ *         - 0 success
+ * @note   an injected window is left to its owner
+ */
+uint8_t gpiomem_deinit(void)
+{
+    /* unmap the gpio block */
+    if ((gs_reg != NULL) && (gs_mapped != 0))
+    {
+        (void)munmap((void *)gs_reg, GPIOMEM_BLOCK_SIZE);
+    }
+    gs_reg = NULL;
+    gs_mapped = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpiomem set the pin mode
+ * @param[in] pin gpio pin
+ * @param[in] output 1 output, 0 input
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mode failed
+ * @note      none
+ */
+uint8_t gpiomem_set_mode(uint8_t pin, uint8_t output)
+{
+    volatile uint32_t *reg;
+    uint32_t shift;
+    
+    /* check the pin */
+    if ((gs_reg == NULL) || (pin >= GPIOMEM_MAX_PIN))
+    {
+        return 1;
+    }
+    
+    /* set the function select bits */
+    reg = &gs_reg[GPIOMEM_GPFSEL0 / 4 + pin / 10];
+    shift = (pin % 10) * 3;
+    *reg = (*reg & ~(7U << shift)) | ((output != 0) ? (1U << shift) : 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     gpiomem write the pin
+ * @param[in] pin gpio pin
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one store to the set or clear register
+ */
+uint8_t gpiomem_write(uint8_t pin, uint8_t value)
+{
+    /* check the pin */
+    if ((gs_reg == NULL) || (pin >= GPIOMEM_MAX_PIN))
+    {
+        return 1;
+    }
+    
+    /* set or clear */
+    *a_gpiomem_reg((value != 0) ? GPIOMEM_GPSET0 : GPIOMEM_GPCLR0, pin) = 1U << (pin % 32);
+    
+    return 0;
+}
+
+/**
+ * @brief      gpiomem read the pin
+ * @param[in]  pin gpio pin
+ * @param[out] *value pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one load from the level register
+ */
+uint8_t gpiomem_read(uint8_t pin, uint8_t *value)
+{
+    /* check the pin */
+    if ((gs_reg == NULL) || (pin >= GPIOMEM_MAX_PIN))
+    {
+        return 1;
+    }
+    
+    /* read the level */
+    *value = (uint8_t)((*a_gpiomem_reg(GPIOMEM_GPLEV0, pin) >> (pin % 32)) & 1);
+    
+    return 0;
+}
+
+/**
+ * @brief     gpiomem write several pins
+ * @param[in] mask pin mask of the gpio 0 - 31
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one store to the set or clear register, so every pin changes at the same time
+ */
+uint8_t gpiomem_write_mask(uint32_t mask, uint8_t value)
+{
+    /* check the window */
+    if (gs_reg == NULL)
+    {
+        return 1;
+    }
+    
+    /* set or clear */
+    gs_reg[((value != 0) ? GPIOMEM_GPSET0 : GPIOMEM_GPCLR0) / 4] = mask;
+    
+    return 0;
+}
+
+/**
+ * @brief      gpiomem read several pins
+ * @param[out] *value pointer to a level mask buffer of the gpio 0 - 31
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one load from the level register
+ */
+uint8_t gpiomem_read_mask(uint32_t *value)
+{
+    /* check the window */
+    if (gs_reg == NULL)
+    {
+        return 1;
+    }
+    
+    /* read the levels */
+    *value = gs_reg[GPIOMEM_GPLEV0 / 4];
+    
+    return 0;
+}
@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.c
+ * @brief     rt source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE                         /**< cpu_set_t and the pthread affinity calls */
+
+#include "rt.h"
+#include "delay.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+/**
+ * @brief global var definition
+ */
+static uint8_t gs_inited;                   /**< inited flag */
+static rt_config_t gs_config;               /**< rt config */
+static int gs_policy;                       /**< saved policy */
+static struct sched_param gs_param;         /**< saved priority */
+static cpu_set_t gs_cpus;                   /**< saved affinity */
+static uint8_t gs_switched;                 /**< 1 if the thread is switched */
+static uint64_t gs_start_ns;                /**< transaction start */
+static rt_stats_t gs_stats;                 /**< rt statistics */
+
+/**
+ * @brief  rt clock
+ * @return raw monotonic time in ns
+ * @note   none
+ */
+static uint64_t a_rt_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     rt init
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      with a priority the memory is locked with mlockall, this needs CAP_SYS_NICE and CAP_IPC_LOCK,
+ *            pin the transfers to a cpu removed from the scheduler with isolcpus to isolate them
+ */
+uint8_t rt_init(const rt_config_t *config)
+{
+    /* check the config */
+    if ((config->priority != 0) &&
+        ((config->priority < sched_get_priority_min(SCHED_FIFO)) ||
+         (config->priority > sched_get_priority_max(SCHED_FIFO))))
+    {
+        fprintf(stderr, "rt: priority is invalid.\n");
+        
+        return 1;
+    }
+    if ((config->cpu >= CPU_SETSIZE) || (config->cpu < -1))
+    {
+        fprintf(stderr, "rt: cpu is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* lock the memory so no page fault lands in a transfer */
+    if (config->priority != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            perror("rt: mlockall failed");
+            
+            return 1;
+        }
+    }
+    
+    /* calibrate the delay before the first transfer */
+    (void)delay_init();
+    gs_config = *config;
+    memset(&gs_stats, 0, sizeof(gs_stats));
+    gs_switched = 0;
+    gs_inited = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  rt deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t rt_deinit(void)
+{
+    if ((gs_inited != 0) && (gs_config.priority != 0))
+    {
+        (void)munlockall();
+    }
+    gs_inited = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief rt enter a transaction
+ * @note  called with the bus lock held, it switches the calling thread to the rt policy
+ *        and starts the jitter measurement
+ */
+void rt_enter(void)
+{
+    struct sched_param param;
+    cpu_set_t cpus;
+    pthread_t self;
+    
+    /* check the init */
+    if (gs_inited == 0)
+    {
+        return;
+    }
+    self = pthread_self();
+    
+    /* switch the thread */
+    gs_switched = 0;
+    if (gs_config.cpu >= 0)
+    {
+        if (pthread_getaffinity_np(self, sizeof(cpu_set_t), &gs_cpus) == 0)
+        {
+            CPU_ZERO(&cpus);
+            CPU_SET(gs_config.cpu, &cpus);
+            if (pthread_setaffinity_np(self, sizeof(cpu_set_t), &cpus) == 0)
+            {
+                gs_switched |= 1 << 0;
+            }
+        }
+    }
+    if (gs_config.priority != 0)
+    {
+        if (pthread_getschedparam(self, &gs_policy, &gs_param) == 0)
+        {
+            param.sched_priority = gs_config.priority;
+            if (pthread_setschedparam(self, SCHED_FIFO, &param) == 0)
+            {
+                gs_switched |= 1 << 1;
+            }
+        }
+    }
+    
+    /* start the measurement */
+    delay_clear_stats();
+    gs_start_ns = a_rt_ns();
+}
+
+/**
+ * @brief rt exit a transaction
+ * @note  called before the bus lock is released, it records the jitter and restores the thread
+ */
+void rt_exit(void)
+{
+    uint64_t elapsed;
+    uint64_t stretch;
+    delay_stats_t delay;
+    pthread_t self;
+    
+    /* check the init */
+    if (gs_inited == 0)
+    {
+        return;
+    }
+    
+    /* record the transaction */
+    elapsed = a_rt_ns() - gs_start_ns;
+    delay_get_stats(&delay);
+    if (delay.count != 0)
+    {
+        stretch = (elapsed > delay.requested_ns) ? (elapsed - delay.requested_ns) : 0;
+        gs_stats.transactions++;
+        gs_stats.stretch_sum_ns += stretch;
+        if (stretch > gs_stats.stretch_max_ns)
+        {
+            gs_stats.stretch_max_ns = (uint32_t)((stretch > 0xFFFFFFFFULL) ? 0xFFFFFFFFULL : stretch);
+        }
+        if (delay.late_max_ns > gs_stats.late_max_ns)
+        {
+            gs_stats.late_max_ns = delay.late_max_ns;
+        }
+    }
+    
+    /* restore the thread */
+    self = pthread_self();
+    if ((gs_switched & (1 << 1)) != 0)
+    {
+        (void)pthread_setschedparam(self, gs_policy, &gs_param);
+    }
+    if ((gs_switched & (1 << 0)) != 0)
+    {
+        (void)pthread_setaffinity_np(self, sizeof(cpu_set_t), &gs_cpus);
+    }
+    gs_switched = 0;
+}
+
+/**
+ * @brief      rt get the statistics
+ * @param[out] *stats pointer to a statistics structure
+ * @note       none
+ */
+void rt_get_stats(rt_stats_t *stats)
+{
+    *stats = gs_stats;
+}
@@ -35,6 +35,7 @@
  */
 
 #include "wire.h"
+#include "gpiomem.h"
 #include <gpiod.h>
 
 /**
@@ -50,149 +51,327 @@
 #define GPIO_DEVICE_DATA_LINE  10               /**< gpio data line */
 #define GPIO_DEVICE_CS_LINE    17               /**< gpio cs line */
 
+/**
+ * @brief gpio output index definition
+ */
+#define WIRE_OUTPUT_CLOCK      0                /**< clock index in the output request */
+#define WIRE_OUTPUT_DATA       1                /**< data index in the output request */
+#define WIRE_OUTPUT_CS         2                /**< cs index in the output request */
+#define WIRE_OUTPUT_NUM        3                /**< output line number */
+
+/**
+ * @brief gpio bank definition
+ * @note  chip n of a shared bus uses gs_bank_cs_pin[n] and gs_bank_miso_pin[n],
+ *        the bank shares the clock and data lines
+ */
+#define WIRE_BANK_NUM          4                /**< chip number of the bank */
+
+/**
+ * @brief wire context structure definition
+ */
+typedef struct wire_context_s
+{
+    wire_backend_t backend;                     /**< selected backend */
+    volatile uint32_t *window;                  /**< injected register window */
+    struct gpiod_chip *chip;                    /**< gpio chip handle */
+    struct gpiod_line_bulk output;              /**< clock, data and cs lines in one request */
+    struct gpiod_line *input;                   /**< miso line */
+    int value[WIRE_OUTPUT_NUM];                 /**< output levels */
+    uint8_t refcount;                           /**< line users */
+    struct gpiod_line_bulk bank_output;         /**< bank cs lines in one request */
+    struct gpiod_line_bulk bank_input;          /**< bank miso lines in one request */
+    int bank_value[WIRE_BANK_NUM];              /**< bank cs levels */
+    uint8_t bank_open;                          /**< 1 if the bank lines are requested */
+} wire_context_t;
+
 /**
  * @brief global var definition
  */
-static struct gpiod_chip *gs_chip;               /**< gpio chip handle */
-static struct gpiod_line *gs_line;               /**< gpio line handle */
-static struct gpiod_chip *gs_clock_chip;         /**< gpio clock chip handle */
-static struct gpiod_line *gs_clock_line;         /**< gpio clock line handle */
-static struct gpiod_chip *gs_data_chip;          /**< gpio data chip handle */
-static struct gpiod_line *gs_data_line;          /**< gpio data line handle */
-static struct gpiod_chip *gs_cs_chip;            /**< gpio cs chip handle */
-static struct gpiod_line *gs_cs_line;            /**< gpio cs line handle */
-static volatile uint8_t gs_read_write_flag;      /**< read write flag */
+static wire_context_t gs_context;               /**< wire context */
+static const uint8_t gs_output_pin[WIRE_OUTPUT_NUM] =
+{
+    GPIO_DEVICE_CLOCK_LINE, GPIO_DEVICE_DATA_LINE, GPIO_DEVICE_CS_LINE,
+};                                              /**< output pins */
+static const uint8_t gs_bank_cs_pin[WIRE_BANK_NUM] = {22, 23, 24, 25};        /**< bank cs pins */
+static const uint8_t gs_bank_miso_pin[WIRE_BANK_NUM] = {5, 6, 13, 19};        /**< bank miso pins */
 
 /**
- * @brief  wire bus init
+ * @brief  wire gpiomem open
  * @return status code
  *         - 0 success
- *         - 1 init failed
- * @note   none
+ *         - 1 open failed
+ * @note   the outputs are set high before they are switched to outputs
  */
-uint8_t wire_init(void)
+static uint8_t a_wire_gpiomem_open(void)
 {
+    uint8_t i;
+    
+    /* map the registers */
+    if (gpiomem_init(gs_context.window) != 0)
+    {
+        return 1;
+    }
+    
+    /* set the outputs high */
+    for (i = 0; i < WIRE_OUTPUT_NUM; i++)
+    {
+        gs_context.value[i] = 1;
+        (void)gpiomem_write(gs_output_pin[i], 1);
+        (void)gpiomem_set_mode(gs_output_pin[i], 1);
+    }
+    
+    /* set input */
+    (void)gpiomem_set_mode(GPIO_DEVICE_LINE, 0);
+    gs_context.refcount = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  wire open
+ * @return status code
+ *         - 0 success
+ *         - 1 open failed
+ * @note   the first user opens the chip and requests every line once with a fixed direction,
+ *         a bulk request sets all of its lines at once so the output levels are cached
+ */
+static uint8_t a_wire_open(void)
+{
+    unsigned int offset[WIRE_OUTPUT_NUM] = {GPIO_DEVICE_CLOCK_LINE, GPIO_DEVICE_DATA_LINE, GPIO_DEVICE_CS_LINE};
+    
+    /* check the users */
+    if (gs_context.refcount != 0)
+    {
+        gs_context.refcount++;
+        
+        return 0;
+    }
+    
+    /* check the backend */
+    if (gs_context.backend == WIRE_BACKEND_GPIOMEM)
+    {
+        return a_wire_gpiomem_open();
+    }
+    
     /* open the gpio group */
-    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_chip == NULL)
+    gs_context.chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (gs_context.chip == NULL)
     {
         perror("gpio: open failed.\n");
         
         return 1;
     }
     
-    /* get the gpio line */
-    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
-    if (gs_line == NULL) 
+    /* get the gpio lines */
+    if (gpiod_chip_get_lines(gs_context.chip, offset, WIRE_OUTPUT_NUM, &gs_context.output) != 0)
+    {
+        perror("gpio: get lines failed.\n");
+        gpiod_chip_close(gs_context.chip);
+        
+        return 1;
+    }
+    gs_context.input = gpiod_chip_get_line(gs_context.chip, GPIO_DEVICE_LINE);
+    if (gs_context.input == NULL)
     {
         perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
+        gpiod_chip_close(gs_context.chip);
         
         return 1;
     }
     
-    /* set the flag */
-    gs_read_write_flag = 2;
+    /* set the outputs high */
+    gs_context.value[WIRE_OUTPUT_CLOCK] = 1;
+    gs_context.value[WIRE_OUTPUT_DATA] = 1;
+    gs_context.value[WIRE_OUTPUT_CS] = 1;
+    if (gpiod_line_request_bulk_output(&gs_context.output, "gpio_output", gs_context.value) != 0)
+    {
+        perror("gpio: request output failed.\n");
+        gpiod_chip_close(gs_context.chip);
+        
+        return 1;
+    }
     
-    /* set high */
-    return wire_write(1);
+    /* set input */
+    if (gpiod_line_request_input(gs_context.input, "gpio_input") != 0)
+    {
+        perror("gpio: request input failed.\n");
+        gpiod_line_release_bulk(&gs_context.output);
+        gpiod_chip_close(gs_context.chip);
+        
+        return 1;
+    }
+    gs_context.refcount = 1;
+    
+    return 0;
 }
 
 /**
- * @brief  wire bus deint
+ * @brief  wire close
  * @return status code
  *         - 0 success
- * @note   none
+ * @note   the last user releases the lines, the bank lines included, and closes the chip
  */
-uint8_t wire_deinit(void)
+static uint8_t a_wire_close(void)
 {
+    /* check the users */
+    if (gs_context.refcount == 0)
+    {
+        return 0;
+    }
+    gs_context.refcount--;
+    if (gs_context.refcount != 0)
+    {
+        return 0;
+    }
+    
+    /* check the backend */
+    if (gs_context.backend == WIRE_BACKEND_GPIOMEM)
+    {
+        gs_context.bank_open = 0;
+        
+        return gpiomem_deinit();
+    }
+    
+    /* release the lines */
+    if (gs_context.bank_open != 0)
+    {
+        gpiod_line_release_bulk(&gs_context.bank_input);
+        gpiod_line_release_bulk(&gs_context.bank_output);
+        gs_context.bank_open = 0;
+    }
+    gpiod_line_release(gs_context.input);
+    gpiod_line_release_bulk(&gs_context.output);
+    
     /* close the chip */
-    gpiod_chip_close(gs_chip);
+    gpiod_chip_close(gs_context.chip);
     
     return 0;
 }
 
 /**
- * @brief      wire bus read data
- * @param[out] *value pointer to a data buffer
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief     wire output write
+ * @param[in] index output index
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
  */
-uint8_t wire_read(uint8_t *value)
+static uint8_t a_wire_output_write(uint8_t index, uint8_t value)
 {
-    int res;
-    
-    /* check the flag */
-    if (gs_read_write_flag != 0)
+    /* check the users */
+    if (gs_context.refcount == 0)
     {
-        /* check requested */
-        if (gpiod_line_is_requested(gs_line) != 0) 
-        {
-            /* release */
-            gpiod_line_release(gs_line);
-        }
-        
-        /* set input */
-        if (gpiod_line_request_input(gs_line, "gpio_input") != 0) 
-        {
-            return 1;
-        }
-        
-        /* flag read */
-        gs_read_write_flag = 0;
+        return 1;
     }
     
-    /* read the value */
-    res = gpiod_line_get_value(gs_line);
-    if (res < 0)
+    /* write the value */
+    gs_context.value[index] = (value != 0) ? 1 : 0;
+    if (gs_context.backend == WIRE_BACKEND_GPIOMEM)
+    {
+        return gpiomem_write(gs_output_pin[index], value);
+    }
+    if (gpiod_line_set_value_bulk(&gs_context.output, gs_context.value) != 0)
     {
         return 1;
     }
     
-    /* set the value */
-    *value = (uint8_t)(res);
-    
     return 0;
 }
 
 /**
- * @brief     wire bus write data
- * @param[in] value write data
- * @return    status code
- *            - 0 success
- *             - 1 write failed
- * @note      none
+ * @brief  wire bank open
+ * @return status code
+ *         - 0 success
+ *         - 1 open failed
+ * @note   the first bank call requests the bank lines on the open chip, the cs lines start high
  */
-uint8_t wire_write(uint8_t value)
+static uint8_t a_wire_bank_open(void)
 {
-    /* check the flag */
-    if (gs_read_write_flag != 1)
+    unsigned int cs[WIRE_BANK_NUM];
+    unsigned int miso[WIRE_BANK_NUM];
+    uint8_t i;
+    
+    /* check the users */
+    if (gs_context.refcount == 0)
+    {
+        return 1;
+    }
+    if (gs_context.bank_open != 0)
     {
-        /* check requested */
-        if (gpiod_line_is_requested(gs_line) != 0) 
+        return 0;
+    }
+    
+    /* check the backend */
+    if (gs_context.backend == WIRE_BACKEND_GPIOMEM)
+    {
+        for (i = 0; i < WIRE_BANK_NUM; i++)
         {
-            /* release */
-            gpiod_line_release(gs_line);
+            gs_context.bank_value[i] = 1;
+            (void)gpiomem_write(gs_bank_cs_pin[i], 1);
+            (void)gpiomem_set_mode(gs_bank_cs_pin[i], 1);
+            (void)gpiomem_set_mode(gs_bank_miso_pin[i], 0);
         }
+        gs_context.bank_open = 1;
         
-        /* set output */
-        if (gpiod_line_request_output(gs_line, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
-        {
-            return 1;
-        }
+        return 0;
+    }
+    
+    /* get the bank lines */
+    for (i = 0; i < WIRE_BANK_NUM; i++)
+    {
+        cs[i] = gs_bank_cs_pin[i];
+        miso[i] = gs_bank_miso_pin[i];
+        gs_context.bank_value[i] = 1;
+    }
+    if ((gpiod_chip_get_lines(gs_context.chip, cs, WIRE_BANK_NUM, &gs_context.bank_output) != 0) ||
+        (gpiod_chip_get_lines(gs_context.chip, miso, WIRE_BANK_NUM, &gs_context.bank_input) != 0))
+    {
+        perror("gpio: get bank lines failed.\n");
         
-        /* flag write */
-        gs_read_write_flag = 1;
+        return 1;
     }
     
-    /* set the value */
-    if (gpiod_line_set_value(gs_line, value) != 0)
+    /* request the bank lines */
+    if (gpiod_line_request_bulk_output(&gs_context.bank_output, "gpio_bank_output", gs_context.bank_value) != 0)
+    {
+        perror("gpio: request bank output failed.\n");
+        
+        return 1;
+    }
+    if (gpiod_line_request_bulk_input(&gs_context.bank_input, "gpio_bank_input") != 0)
+    {
+        perror("gpio: request bank input failed.\n");
+        gpiod_line_release_bulk(&gs_context.bank_output);
+        
+        return 1;
+    }
+    gs_context.bank_open = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     wire set the backend
+ * @param[in] backend gpio backend
+ * @param[in] *window pointer to a register window for the gpiomem backend, NULL maps /dev/gpiomem
+ * @return    status code
+ *            - 0 success
+ *            - 1 lines are in use
+ * @note      takes effect at the next first init
+ */
+uint8_t wire_set_backend(wire_backend_t backend, volatile uint32_t *window)
+{
+    /* check the users */
+    if (gs_context.refcount != 0)
     {
         return 1;
     }
     
+    /* set the backend */
+    gs_context.backend = backend;
+    gs_context.window = window;
+    
     return 0;
 }
 
@@ -203,29 +382,68 @@ uint8_t wire_write(uint8_t value)
  *         - 1 init failed
  * @note   none
  */
-uint8_t wire_clock_init(void)
+uint8_t wire_init(void)
 {
-    /* open the gpio group */
-    gs_clock_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_clock_chip == NULL)
+    return a_wire_open();
+}
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_deinit(void)
+{
+    return a_wire_close();
+}
+
+/**
+ * @brief      wire bus read data
+ * @param[out] *value pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t wire_read(uint8_t *value)
+{
+    int res;
+    
+    /* check the users */
+    if (gs_context.refcount == 0)
     {
-        perror("gpio: open failed.\n");
-        
         return 1;
     }
     
-    /* get the gpio line */
-    gs_clock_line = gpiod_chip_get_line(gs_clock_chip, GPIO_DEVICE_CLOCK_LINE);
-    if (gs_clock_line == NULL) 
+    /* read the value */
+    if (gs_context.backend == WIRE_BACKEND_GPIOMEM)
+    {
+        return gpiomem_read(GPIO_DEVICE_LINE, value);
+    }
+    res = gpiod_line_get_value(gs_context.input);
+    if (res < 0)
     {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_clock_chip);
-
         return 1;
     }
     
-    /* set output */
-    if (gpiod_line_request_output(gs_clock_line, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
+    /* set the value */
+    *value = (uint8_t)(res);
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t wire_clock_init(void)
+{
+    /* open the lines */
+    if (a_wire_open() != 0)
     {
         return 1;
     }
@@ -242,10 +460,7 @@ uint8_t wire_clock_init(void)
  */
 uint8_t wire_clock_deinit(void)
 {
-    /* close the chip */
-    gpiod_chip_close(gs_clock_chip);
-    
-    return 0;
+    return a_wire_close();
 }
 
 /**
@@ -258,13 +473,7 @@ uint8_t wire_clock_deinit(void)
  */
 uint8_t wire_clock_write(uint8_t value)
 {
-    /* write the value */
-    if (gpiod_line_set_value(gs_clock_line, value) != 0)
-    {
-        return 1;
-    }
-    
-    return 0;
+    return a_wire_output_write(WIRE_OUTPUT_CLOCK, value);
 }
 
 /**
@@ -276,27 +485,8 @@ uint8_t wire_clock_write(uint8_t value)
  */
 uint8_t wire_data_init(void)
 {
-    /* open the gpio group */
-    gs_data_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_data_chip == NULL)
-    {
-        perror("gpio: open failed.\n");
-        
-        return 1;
-    }
-    
-    /* get the gpio line */
-    gs_data_line = gpiod_chip_get_line(gs_data_chip, GPIO_DEVICE_DATA_LINE);
-    if (gs_data_line == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_data_chip);
-
-        return 1;
-    }
-    
-    /* set output */
-    if (gpiod_line_request_output(gs_data_line, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
+    /* open the lines */
+    if (a_wire_open() != 0)
     {
         return 1;
     }
@@ -313,10 +503,7 @@ uint8_t wire_data_init(void)
  */
 uint8_t wire_data_deinit(void)
 {
-    /* close the chip */
-    gpiod_chip_close(gs_data_chip);
-    
-    return 0;
+    return a_wire_close();
 }
 
 /**
@@ -329,13 +516,7 @@ uint8_t wire_data_deinit(void)
  */
 uint8_t wire_data_write(uint8_t value)
 {
-    /* write the value */
-    if (gpiod_line_set_value(gs_data_line, value) != 0)
-    {
-        return 1;
-    }
-    
-    return 0;
+    return a_wire_output_write(WIRE_OUTPUT_DATA, value);
 }
 
 /**
@@ -347,27 +528,8 @@ uint8_t wire_data_write(uint8_t value)
  */
 uint8_t wire_cs_init(void)
 {
-    /* open the gpio group */
-    gs_cs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_cs_chip == NULL)
-    {
-        perror("gpio: open failed.\n");
-        
-        return 1;
-    }
-    
-    /* get the gpio line */
-    gs_cs_line = gpiod_chip_get_line(gs_cs_chip, GPIO_DEVICE_CS_LINE);
-    if (gs_cs_line == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_cs_chip);
-
-        return 1;
-    }
-    
-    /* set output */
-    if (gpiod_line_request_output(gs_cs_line, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
+    /* open the lines */
+    if (a_wire_open() != 0)
     {
         return 1;
     }
@@ -384,10 +546,7 @@ uint8_t wire_cs_init(void)
  */
 uint8_t wire_cs_deinit(void)
 {
-    /* close the chip */
-    gpiod_chip_close(gs_cs_chip);
-    
-    return 0;
+    return a_wire_close();
 }
 
 /**
@@ -400,11 +559,103 @@ uint8_t wire_cs_deinit(void)
  */
 uint8_t wire_cs_write(uint8_t value)
 {
-    /* write the value */
-    if (gpiod_line_set_value(gs_cs_line, value) != 0)
+    return a_wire_output_write(WIRE_OUTPUT_CS, value);
+}
+
+/**
+ * @brief     wire bank write the cs lines
+ * @param[in] mask chip mask
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      every cs in the mask changes with one bulk request or one register store
+ */
+uint8_t wire_bank_cs_write(uint32_t mask, uint8_t value)
+{
+    uint32_t pins;
+    uint8_t i;
+    
+    /* open the bank */
+    if (a_wire_bank_open() != 0)
     {
         return 1;
     }
     
+    /* set the levels */
+    pins = 0;
+    for (i = 0; i < WIRE_BANK_NUM; i++)
+    {
+        if ((mask & (1UL << i)) != 0)
+        {
+            gs_context.bank_value[i] = (value != 0) ? 1 : 0;
+            pins |= 1UL << gs_bank_cs_pin[i];
+        }
+    }
+    
+    /* write the lines */
+    if (gs_context.backend == WIRE_BACKEND_GPIOMEM)
+    {
+        return gpiomem_write_mask(pins, value);
+    }
+    if (gpiod_line_set_value_bulk(&gs_context.bank_output, gs_context.bank_value) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      wire bank read the miso lines
+ * @param[out] *value pointer to a level mask buffer, one bit per chip
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       every miso is sampled with one bulk request or one register load
+ */
+uint8_t wire_bank_read(uint32_t *value)
+{
+    int level[WIRE_BANK_NUM];
+    uint32_t pins;
+    uint8_t i;
+    
+    /* open the bank */
+    if (a_wire_bank_open() != 0)
+    {
+        return 1;
+    }
+    
+    /* read the lines */
+    if (gs_context.backend == WIRE_BACKEND_GPIOMEM)
+    {
+        if (gpiomem_read_mask(&pins) != 0)
+        {
+            return 1;
+        }
+        for (i = 0; i < WIRE_BANK_NUM; i++)
+        {
+            level[i] = (int)((pins >> gs_bank_miso_pin[i]) & 1);
+        }
+    }
+    else if (gpiod_line_get_value_bulk(&gs_context.bank_input, level) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        
+    }
+    
+    /* set the mask */
+    *value = 0;
+    for (i = 0; i < WIRE_BANK_NUM; i++)
+    {
+        if (level[i] != 0)
+        {
+            *value |= 1UL << i;
+        }
+    }
+    
     return 0;
 }
@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     deferred log decoder main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_wt588e02b_log.h"
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief log decoder definition
+ */
+#define LOG_LINE_SIZE          512                                 /**< max text line length */
+#define LOG_PREFIX             "wt588e02b-log: "                   /**< record line prefix */
+
+/**
+ * @brief log message format table definition
+ * @note  the ids are stable, so the records of any driver revision decode with this table
+ */
+#define LOG_MESSAGE_FMT(ID, NAME, FMT)        [ID] = FMT,
+static const char *const gs_fmt[WT588E02B_LOG_MSG_END] =
+{
+    WT588E02B_LOG_MESSAGE_TABLE(LOG_MESSAGE_FMT)
+};
+#undef LOG_MESSAGE_FMT
+
+/**
+ * @brief     check a format string
+ * @param[in] *fmt pointer to a format string
+ * @return    1 if it has at most one integer conversion, otherwise 0
+ * @note      only such a format is expanded with the record argument
+ */
+static uint8_t a_log_fmt_safe(const char *fmt)
+{
+    uint32_t conv = 0;
+    
+    for (; *fmt != '\0'; fmt++)
+    {
+        if (*fmt != '%')
+        {
+            continue;
+        }
+        fmt++;
+        if (*fmt == '%')
+        {
+            continue;
+        }
+        if ((*fmt != 'd') && (*fmt != 'i') && (*fmt != 'u') && (*fmt != 'x') && (*fmt != 'X'))
+        {
+            return 0;
+        }
+        conv++;
+    }
+    
+    return (conv <= 1) ? 1 : 0;
+}
+
+/**
+ * @brief     decode one record line
+ * @param[in] *text pointer to the text after the prefix
+ * @return    status code
+ *            - 0 success
+ *            - 1 decode failed
+ * @note      none
+ */
+static uint8_t a_log_decode(const char *text)
+{
+    static const char *const level_name[] = {"NONE", "ERROR", "WARN", "DEBUG"};
+    unsigned int id;
+    unsigned int level;
+    unsigned int arg;
+    unsigned int ms;
+    
+    if (sscanf(text, "%x %x %x %x", &id, &level, &arg, &ms) != 4)
+    {
+        printf("wt588e02b-log: record %s is invalid.\n", text);
+        
+        return 1;
+    }
+    if ((id >= WT588E02B_LOG_MSG_END) || (gs_fmt[id] == NULL))
+    {
+        printf("wt588e02b-log: unknown message %u, arg 0x%08X.\n", id, arg);
+        
+        return 1;
+    }
+    printf("[%10u ms] %-5s msg %3u: ", ms, (level < 4) ? level_name[level] : "?", id);
+    if (a_log_fmt_safe(gs_fmt[id]) != 0)
+    {
+        printf(gs_fmt[id], (int)arg);
+    }
+    else
+    {
+        printf("%s", gs_fmt[id]);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     log decoder
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t wt588e02b_log(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    char buf[LOG_LINE_SIZE];
+    uint8_t help = 0;
+    uint8_t res;
+    size_t prefix;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if (help != 0)
+    {
+        printf("Usage:\n");
+        printf("  wt588e02b-log < <log>\n");
+        printf("  wt588e02b-log (-h | --help)\n");
+        printf("\n");
+        printf("Options:\n");
+        printf("  -h, --help    Show the help.\n");
+        
+        return 0;
+    }
+    
+    /* expand the records and pass the other lines */
+    res = 0;
+    prefix = strlen(LOG_PREFIX);
+    while (fgets(buf, LOG_LINE_SIZE, stdin) != NULL)
+    {
+        if (strncmp(buf, LOG_PREFIX, prefix) == 0)
+        {
+            if (a_log_decode(buf + prefix) != 0)
+            {
+                res = 1;
+            }
+        }
+        else
+        {
+            fputs(buf, stdout);
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+    
+    res = wt588e02b_log(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        printf("wt588e02b-log: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        printf("wt588e02b-log: param is invalid.\n");
+    }
+    else
+    {
+        printf("wt588e02b-log: unknown status code.\n");
+    }
+    
+    return (res == 0) ? 0 : 1;
+}
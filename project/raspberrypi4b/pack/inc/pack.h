@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pack.h
+ * @brief     voice image builder header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef PACK_H
+#define PACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup pack pack function
+ * @brief    voice image builder modules
+ * @{
+ */
+
+/**
+ * @brief pack definition
+ */
+#define PACK_MAX_VOICES        0xE0        /**< max voice number */
+#define PACK_MAX_LISTS         256         /**< max list number */
+#define PACK_MAX_LIST_DATA     512         /**< max list entries with the terminators */
+#define PACK_PATH_SIZE         256         /**< max voice path length */
+#define PACK_BLOCK_SIZE        512         /**< update packet size */
+
+/**
+ * @brief pack voice structure definition
+ */
+typedef struct pack_voice_s
+{
+    char path[PACK_PATH_SIZE];        /**< voice file path */
+    uint8_t *buf;                     /**< voice data, NULL when it was not reloaded */
+    uint32_t len;                     /**< voice length */
+    int64_t mtime;                    /**< voice file modification time in ns */
+    uint64_t hash;                    /**< voice data hash */
+    uint32_t offset;                  /**< slot offset in the image */
+    uint32_t slot;                    /**< slot length padded to the block size */
+    uint8_t changed;                  /**< 1 means the slot is written */
+} pack_voice_t;
+
+/**
+ * @brief pack structure definition
+ */
+typedef struct pack_s
+{
+    char version[16];                          /**< version string */
+    uint8_t vol;                               /**< default volume */
+    uint16_t voice_count;                      /**< voice number */
+    uint16_t list_count;                       /**< list number */
+    pack_voice_t voice[PACK_MAX_VOICES];       /**< voices */
+    uint16_t list_start[PACK_MAX_LISTS];       /**< first entry of every list */
+    uint16_t list_len[PACK_MAX_LISTS];         /**< index number of every list */
+    uint8_t list_ind[PACK_MAX_LIST_DATA];      /**< list entries */
+    uint16_t list_used;                        /**< used list entries with the terminators */
+    uint32_t size;                             /**< image size */
+    time_t stamp;                              /**< build date written to the header */
+} pack_t;
+
+/**
+ * @brief pack stats structure definition
+ */
+typedef struct pack_stats_s
+{
+    uint32_t voices;                  /**< voice number */
+    uint32_t loaded;                  /**< voice files read */
+    uint32_t written;                 /**< voice slots written */
+    uint32_t blocks;                  /**< image blocks */
+    uint32_t blocks_written;          /**< image blocks written */
+    uint8_t incremental;              /**< 1 means the old image was patched */
+    uint64_t us;                      /**< build time in us */
+} pack_stats_t;
+
+/**
+ * @brief     load a manifest
+ * @param[in] *pack pointer to a pack structure
+ * @param[in] *path pointer to a manifest path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 manifest is invalid
+ * @note      one directive per line, # starts a comment:
+ *            version <string>, volume <0-63>, voice <path> and list [<index> ...];
+ *            the voices are indexed in order and a relative path is relative to the manifest,
+ *            without any list every voice gets a list of its own
+ */
+uint8_t pack_manifest_load(pack_t *pack, const char *path);
+
+/**
+ * @brief      build an image
+ * @param[in]  *pack pointer to a pack structure
+ * @param[in]  *out pointer to an image path
+ * @param[in]  threads worker number, 0 uses one per cpu
+ * @param[in]  incremental 1 patches the old image when its layout still fits
+ * @param[out] *stats pointer to a pack stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 build failed
+ *             - 4 a voice file can't be read
+ *             - 5 the layout is too large
+ *             - 6 the image fails its own validation
+ * @note       the voices are read and hashed by the workers, the image is checked with
+ *             wt588e02b_image_open before anything is written, and <out>.hash receives
+ *             the voice and 512 bytes block hashes used by the next incremental build;
+ *             an incremental build keeps the old build date
+ */
+uint8_t pack_build(pack_t *pack, const char *out, uint8_t threads, uint8_t incremental, pack_stats_t *stats);
+
+/**
+ * @brief     free the loaded voices
+ * @param[in] *pack pointer to a pack structure
+ * @note      none
+ */
+void pack_free(pack_t *pack);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
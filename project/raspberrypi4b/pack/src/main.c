@@ -0,0 +1,562 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     voice image builder main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "pack.h"
+#include "driver_wt588e02b.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief self test definition
+ */
+#define PACK_SELF_TEST_THREADS        4             /**< self test workers */
+#define PACK_SELF_TEST_DIR            "/tmp/wt588e02b_pack"
+
+static pack_t gs_pack;        /**< pack */
+
+/**
+ * @brief      read a whole file
+ * @param[in]  *path pointer to a file path
+ * @param[out] *size pointer to a size buffer
+ * @return     pointer to the file data, NULL means failed
+ * @note       the caller frees the data
+ */
+static uint8_t *a_pack_read_file(const char *path, uint32_t *size)
+{
+    FILE *fp;
+    uint8_t *buf;
+    long len;
+    
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        return NULL;
+    }
+    if ((fseek(fp, 0, SEEK_END) != 0) || ((len = ftell(fp)) <= 0) || (fseek(fp, 0, SEEK_SET) != 0))
+    {
+        (void)fclose(fp);
+        
+        return NULL;
+    }
+    buf = (uint8_t *)malloc((size_t)len);
+    if ((buf != NULL) && (fread(buf, 1, (size_t)len, fp) != (size_t)len))
+    {
+        free(buf);
+        buf = NULL;
+    }
+    (void)fclose(fp);
+    *size = (uint32_t)len;
+    
+    return buf;
+}
+
+/**
+ * @brief     write a whole file
+ * @param[in] *path pointer to a file path
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_pack_write_file(const char *path, const uint8_t *buf, uint32_t len)
+{
+    FILE *fp;
+    
+    fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    if (fwrite(buf, 1, len, fp) != len)
+    {
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    
+    return (fclose(fp) == 0) ? 0 : 1;
+}
+
+/**
+ * @brief     print the build stats
+ * @param[in] *stats pointer to a pack stats structure
+ * @note      none
+ */
+static void a_pack_print(const pack_stats_t *stats)
+{
+    printf("pack: %u voices, %u read, %u written, %u of %u blocks written, %s build in %llu us.\n",
+           stats->voices, stats->loaded, stats->written, stats->blocks_written, stats->blocks,
+           (stats->incremental != 0) ? "incremental" : "full", (unsigned long long)stats->us);
+}
+
+/**
+ * @brief     count the differences of two images
+ * @param[in] *a pointer to the first image
+ * @param[in] *b pointer to the second image
+ * @param[in] size image size
+ * @return    different bytes outside the build date fields
+ * @note      none
+ */
+static uint32_t a_pack_diff(const uint8_t *a, const uint8_t *b, uint32_t size)
+{
+    uint32_t i;
+    uint32_t n = 0;
+    
+    for (i = 0; i < size; i++)
+    {
+        if (((i >= 0x28) && (i < 0x30)) || ((i >= 0x44) && (i < 0x48)))
+        {
+            continue;
+        }
+        if (a[i] != b[i])
+        {
+            n++;
+        }
+    }
+    
+    return n;
+}
+
+/**
+ * @brief     pack self test
+ * @param[in] *src pointer to a source image path
+ * @param[in] *dir pointer to a work directory
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      splits the source image into voice files, packs them again and
+ *            checks the full, the incremental and the unchanged builds
+ */
+static uint8_t a_pack_self_test(const char *src, const char *dir)
+{
+    char path[PACK_PATH_SIZE];
+    char out[PACK_PATH_SIZE];
+    uint8_t *buf;
+    uint8_t *img = NULL;
+    uint8_t ind[255];
+    uint8_t len;
+    uint8_t res = 1;
+    uint16_t i;
+    uint16_t j;
+    uint32_t size;
+    uint32_t img_size;
+    uint32_t trim;
+    uint32_t target;
+    uint32_t diff;
+    FILE *fp;
+    struct timespec ts[2];
+    wt588e02b_image_t image;
+    wt588e02b_image_voice_t voice;
+    pack_stats_t stats;
+    
+    /* split the source image */
+    buf = a_pack_read_file(src, &size);
+    if ((buf == NULL) || (wt588e02b_image_open(&image, buf, size) != 0))
+    {
+        printf("pack: %s is not a valid image.\n", src);
+        free(buf);
+        
+        return 1;
+    }
+    if ((mkdir(dir, 0755) != 0) && (errno != EEXIST))
+    {
+        printf("pack: mkdir %s failed.\n", dir);
+        free(buf);
+        
+        return 1;
+    }
+    (void)snprintf(path, sizeof(path), "%s/manifest.txt", dir);
+    fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        free(buf);
+        
+        return 1;
+    }
+    fprintf(fp, "# split from %s\nversion %s\nvolume %u\n", src, image.version, buf[0x14]);
+    for (i = 0; i < image.voice_count; i++)
+    {
+        (void)wt588e02b_image_get_voice(&image, i, &voice);
+        for (trim = voice.length; (trim > 1) && (voice.data[trim - 1] == 0); trim--)
+        {
+        }
+        (void)snprintf(path, sizeof(path), "%s/voice_%03u.t3z", dir, i);
+        if (a_pack_write_file(path, voice.data, trim) != 0)
+        {
+            (void)fclose(fp);
+            free(buf);
+            
+            return 1;
+        }
+        fprintf(fp, "voice voice_%03u.t3z\n", i);
+    }
+    for (i = 0; i < image.list_count; i++)
+    {
+        len = sizeof(ind);
+        (void)wt588e02b_image_get_list(&image, i, ind, &len);
+        fprintf(fp, "list");
+        for (j = 0; j < len; j++)
+        {
+            fprintf(fp, " %u", ind[j]);
+        }
+        fprintf(fp, "\n");
+    }
+    (void)fclose(fp);
+    printf("pack: split %u voices and %u lists of %s.\n", image.voice_count, image.list_count, src);
+    
+    /* full build */
+    (void)snprintf(path, sizeof(path), "%s/manifest.txt", dir);
+    (void)snprintf(out, sizeof(out), "%s/all.bin", dir);
+    (void)unlink(out);
+    if ((pack_manifest_load(&gs_pack, path) != 0) ||
+        (pack_build(&gs_pack, out, PACK_SELF_TEST_THREADS, 1, &stats) != 0))
+    {
+        goto exit;
+    }
+    a_pack_print(&stats);
+    img = a_pack_read_file(out, &img_size);
+    if ((img == NULL) || (img_size != size) || (stats.incremental != 0))
+    {
+        printf("pack: full build check failed.\n");
+        
+        goto exit;
+    }
+    diff = a_pack_diff(buf, img, size);
+    printf("pack: %u bytes differ from the source outside the build date.\n", diff);
+    if (diff != 0)
+    {
+        printf("pack: full build check failed.\n");
+        
+        goto exit;
+    }
+    free(img);
+    img = NULL;
+    pack_free(&gs_pack);
+    
+    /* change one byte of one voice */
+    target = image.voice_count / 2;
+    (void)wt588e02b_image_get_voice(&image, (uint16_t)target, &voice);
+    buf[voice.offset + 16] ^= 0x5A;
+    (void)snprintf(path, sizeof(path), "%s/voice_%03u.t3z", dir, target);
+    for (trim = voice.length; (trim > 1) && (voice.data[trim - 1] == 0); trim--)
+    {
+    }
+    if (a_pack_write_file(path, voice.data, trim) != 0)
+    {
+        goto exit;
+    }
+    (void)clock_gettime(CLOCK_REALTIME, &ts[0]);
+    ts[0].tv_sec += 1;
+    ts[1] = ts[0];
+    (void)utimensat(AT_FDCWD, path, ts, 0);
+    
+    /* incremental build */
+    (void)snprintf(path, sizeof(path), "%s/manifest.txt", dir);
+    if ((pack_manifest_load(&gs_pack, path) != 0) ||
+        (pack_build(&gs_pack, out, PACK_SELF_TEST_THREADS, 1, &stats) != 0))
+    {
+        goto exit;
+    }
+    a_pack_print(&stats);
+    img = a_pack_read_file(out, &img_size);
+    if ((img == NULL) || (img_size != size) || (stats.incremental == 0) || (stats.loaded != 1) ||
+        (stats.written != 1) || (stats.blocks_written != 1) || (a_pack_diff(buf, img, size) != 0))
+    {
+        printf("pack: incremental build check failed.\n");
+        
+        goto exit;
+    }
+    free(img);
+    img = NULL;
+    pack_free(&gs_pack);
+    
+    /* unchanged build */
+    if ((pack_manifest_load(&gs_pack, path) != 0) ||
+        (pack_build(&gs_pack, out, PACK_SELF_TEST_THREADS, 1, &stats) != 0))
+    {
+        goto exit;
+    }
+    a_pack_print(&stats);
+    if ((stats.incremental == 0) || (stats.loaded != 0) || (stats.blocks_written != 0))
+    {
+        printf("pack: unchanged build check failed.\n");
+        
+        goto exit;
+    }
+    res = 0;
+    
+    exit:
+    pack_free(&gs_pack);
+    free(img);
+    free(buf);
+    
+    return res;
+}
+
+/**
+ * @brief     wt588e02b pack full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t wt588e02b_pack(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "hm:o:";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"manifest", required_argument, NULL, 'm'},
+        {"output", required_argument, NULL, 'o'},
+        {"threads", required_argument, NULL, 1},
+        {"full", no_argument, NULL, 2},
+        {"self-test", no_argument, NULL, 3},
+        {"source", required_argument, NULL, 4},
+        {"dir", required_argument, NULL, 5},
+        {NULL, 0, NULL, 0},
+    };
+    char manifest[PACK_PATH_SIZE] = "";
+    char out[PACK_PATH_SIZE] = "all.bin";
+    char source[PACK_PATH_SIZE] = "bin/all.bin";
+    char dir[PACK_PATH_SIZE] = PACK_SELF_TEST_DIR;
+    uint8_t threads = 0;
+    uint8_t incremental = 1;
+    uint8_t self_test = 0;
+    uint8_t help = 0;
+    uint8_t res;
+    pack_stats_t stats;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* manifest */
+            case 'm' :
+            {
+                memset(manifest, 0, sizeof(char) * PACK_PATH_SIZE);
+                strncpy(manifest, optarg, PACK_PATH_SIZE - 1);
+                
+                break;
+            }
+            
+            /* output */
+            case 'o' :
+            {
+                memset(out, 0, sizeof(char) * PACK_PATH_SIZE);
+                strncpy(out, optarg, PACK_PATH_SIZE - 1);
+                
+                break;
+            }
+            
+            /* threads */
+            case 1 :
+            {
+                c = atoi(optarg);
+                if ((c < 0) || (c > 64))
+                {
+                    return 5;
+                }
+                threads = (uint8_t)c;
+                
+                break;
+            }
+            
+            /* full */
+            case 2 :
+            {
+                incremental = 0;
+                
+                break;
+            }
+            
+            /* self test */
+            case 3 :
+            {
+                self_test = 1;
+                
+                break;
+            }
+            
+            /* source */
+            case 4 :
+            {
+                memset(source, 0, sizeof(char) * PACK_PATH_SIZE);
+                strncpy(source, optarg, PACK_PATH_SIZE - 1);
+                
+                break;
+            }
+            
+            /* dir */
+            case 5 :
+            {
+                memset(dir, 0, sizeof(char) * PACK_PATH_SIZE);
+                strncpy(dir, optarg, PACK_PATH_SIZE - 1);
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if ((help != 0) || ((self_test == 0) && (manifest[0] == '\0')))
+    {
+        printf("Usage:\n");
+        printf("  wt588e02b-pack (-m <path> | --manifest=<path>) [-o <path> | --output=<path>] [--threads=<num>] [--full]\n");
+        printf("  wt588e02b-pack --self-test [--source=<path>] [--dir=<path>]\n");
+        printf("  wt588e02b-pack (-h | --help)\n");
+        printf("\n");
+        printf("Manifest:\n");
+        printf("  version <string>            set the version string.([default: 1.0.0])\n");
+        printf("  volume <vol>                set the default volume.([default: 63])\n");
+        printf("  voice <path>                add the next voice, a t3z file.\n");
+        printf("  list [<ind> ...]            add the next play list, one list per voice without any.\n");
+        printf("\n");
+        printf("Options:\n");
+        printf("      --dir=<path>            Set the self test directory.([default: %s])\n", PACK_SELF_TEST_DIR);
+        printf("      --full                  Rebuild the whole image instead of patching the changed voices.\n");
+        printf("  -h, --help                  Show the help.\n");
+        printf("  -m <path>, --manifest=<path>\n");
+        printf("                              Set the manifest path.\n");
+        printf("  -o <path>, --output=<path>  Set the image path, <path>.hash gets the block hashes.([default: all.bin])\n");
+        printf("      --self-test             Split an image into voices, pack them again and compare.\n");
+        printf("      --source=<path>         Set the self test image.([default: bin/all.bin])\n");
+        printf("      --threads=<num>         Set the worker number, 0 is one per cpu.([default: 0])\n");
+        
+        return 0;
+    }
+    
+    /* self test */
+    if (self_test != 0)
+    {
+        if (a_pack_self_test(source, dir) != 0)
+        {
+            printf("pack: self test failed.\n");
+            
+            return 1;
+        }
+        printf("pack: self test passed.\n");
+        
+        return 0;
+    }
+    
+    /* build */
+    res = pack_manifest_load(&gs_pack, manifest);
+    if (res == 0)
+    {
+        res = pack_build(&gs_pack, out, threads, incremental, &stats);
+    }
+    pack_free(&gs_pack);
+    if (res != 0)
+    {
+        return 1;
+    }
+    a_pack_print(&stats);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+    
+    res = wt588e02b_pack(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        printf("wt588e02b-pack: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        printf("wt588e02b-pack: param is invalid.\n");
+    }
+    else
+    {
+        printf("wt588e02b-pack: unknown status code.\n");
+    }
+    
+    return (res == 0) ? 0 : 1;
+}
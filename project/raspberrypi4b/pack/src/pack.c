@@ -0,0 +1,964 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pack.c
+ * @brief     voice image builder source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "pack.h"
+#include "driver_wt588e02b.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/**
+ * @brief pack layout definition
+ */
+#define PACK_PAIR_TABLE           0x0400        /**< voice pair table */
+#define PACK_LIST_TABLE           0x0800        /**< list pointer table */
+#define PACK_LIST_DATA            0x0C00        /**< list entries */
+#define PACK_VOICE_TABLE          0x1000        /**< voice offset table */
+#define PACK_RESERVED             0x1400        /**< reserved table */
+#define PACK_DATA                 0x1800        /**< first voice */
+#define PACK_TAG                  0x50          /**< tag string */
+#define PACK_TAG_END              0x70          /**< end of the 0xFF tag padding */
+#define PACK_MAX_SIZE             0xFFFFFF      /**< the header size field is 24 bits */
+#define PACK_LIST_END             0x00FF        /**< list terminator */
+#define PACK_HASH_MAGIC           "# wt588e02b pack 1"
+#define PACK_LINE_SIZE            512           /**< max manifest line length */
+#define PACK_HASH_CHUNK           64            /**< blocks hashed per job */
+#define PACK_MAX_THREADS          64            /**< max workers */
+
+/**
+ * @brief pack previous build structure definition
+ */
+typedef struct pack_old_s
+{
+    uint8_t valid;                              /**< 1 means the hash file was read */
+    uint32_t size;                              /**< image size */
+    int64_t stamp;                              /**< build date */
+    uint16_t voice_count;                       /**< voice number */
+    pack_voice_t voice[PACK_MAX_VOICES];        /**< voices, buf is unused */
+    uint64_t *block;                            /**< block hashes */
+    uint32_t blocks;                            /**< block number */
+} pack_old_t;
+
+/**
+ * @brief pack job structure definition
+ */
+typedef struct pack_job_s
+{
+    pthread_mutex_t mutex;                      /**< next item mutex */
+    uint32_t next;                              /**< next item */
+    uint32_t count;                             /**< item number */
+    uint8_t (*run)(struct pack_job_s *job, uint32_t i);        /**< item function */
+    pack_t *pack;                               /**< pack */
+    const pack_old_t *old;                      /**< previous build */
+    uint8_t *image;                             /**< image buffer */
+    uint64_t *block;                            /**< block hashes */
+    uint32_t loaded;                            /**< voice files read */
+    uint8_t failed;                             /**< 1 means an item failed */
+} pack_job_t;
+
+static pack_old_t gs_old;        /**< previous build */
+
+/**
+ * @brief     fnv-1a hash
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @return    hash
+ * @note      none
+ */
+static uint64_t a_pack_hash(const uint8_t *buf, uint32_t len)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    uint32_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        h ^= buf[i];
+        h *= 0x100000001B3ULL;
+    }
+    
+    return h;
+}
+
+/**
+ * @brief  pack clock
+ * @return current time in us
+ * @note   none
+ */
+static uint64_t a_pack_us(void)
+{
+    struct timeval tv;
+    
+    (void)gettimeofday(&tv, NULL);
+    
+    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+/**
+ * @brief     set a little endian value
+ * @param[in] *p pointer to a data buffer
+ * @param[in] value set value
+ * @param[in] len byte number
+ * @note      none
+ */
+static void a_pack_put(uint8_t *p, uint32_t value, uint8_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        p[i] = (uint8_t)((value >> (i * 8)) & 0xFF);
+    }
+}
+
+/**
+ * @brief     job worker thread
+ * @param[in] *arg pointer to a pack job structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_pack_worker(void *arg)
+{
+    pack_job_t *job = (pack_job_t *)arg;
+    uint32_t i;
+    
+    while (1)
+    {
+        (void)pthread_mutex_lock(&job->mutex);
+        i = job->next;
+        if (i < job->count)
+        {
+            job->next++;
+        }
+        (void)pthread_mutex_unlock(&job->mutex);
+        if (i >= job->count)
+        {
+            break;
+        }
+        if (job->run(job, i) != 0)
+        {
+            (void)pthread_mutex_lock(&job->mutex);
+            job->failed = 1;
+            (void)pthread_mutex_unlock(&job->mutex);
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     run a job on several workers
+ * @param[in] *job pointer to a pack job structure
+ * @param[in] count item number
+ * @param[in] threads worker number
+ * @param[in] *run pointer to an item function
+ * @return    status code
+ *            - 0 success
+ *            - 1 an item failed
+ * @note      the calling thread is one of the workers
+ */
+static uint8_t a_pack_run(pack_job_t *job, uint32_t count, uint8_t threads,
+                          uint8_t (*run)(pack_job_t *job, uint32_t i))
+{
+    pthread_t thread[PACK_MAX_THREADS];
+    uint8_t n;
+    
+    job->next = 0;
+    job->count = count;
+    job->run = run;
+    job->failed = 0;
+    for (n = 0; (n + 1 < threads) && (n < PACK_MAX_THREADS); n++)
+    {
+        if (pthread_create(&thread[n], NULL, a_pack_worker, job) != 0)
+        {
+            break;
+        }
+    }
+    (void)a_pack_worker(job);
+    while (n > 0)
+    {
+        n--;
+        (void)pthread_join(thread[n], NULL);
+    }
+    
+    return job->failed;
+}
+
+/**
+ * @brief     load one voice
+ * @param[in] *job pointer to a pack job structure
+ * @param[in] i voice index
+ * @return    status code
+ *            - 0 success
+ *            - 1 load failed
+ * @note      an unchanged file of the previous build is not read in an incremental build
+ */
+static uint8_t a_pack_load(pack_job_t *job, uint32_t i)
+{
+    pack_voice_t *voice = &job->pack->voice[i];
+    const pack_old_t *old = job->old;
+    struct stat st;
+    FILE *fp;
+    
+    /* check the file */
+    if (stat(voice->path, &st) != 0)
+    {
+        fprintf(stderr, "pack: stat %s failed, %s.\n", voice->path, strerror(errno));
+        
+        return 1;
+    }
+    if ((st.st_size <= 0) || (st.st_size > PACK_MAX_SIZE))
+    {
+        fprintf(stderr, "pack: %s has an invalid size.\n", voice->path);
+        
+        return 1;
+    }
+    voice->len = (uint32_t)st.st_size;
+    voice->mtime = (int64_t)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+    
+    /* reuse the previous hash */
+    if ((old != NULL) && (i < old->voice_count) &&
+        (strcmp(old->voice[i].path, voice->path) == 0) &&
+        (old->voice[i].len == voice->len) && (old->voice[i].mtime == voice->mtime))
+    {
+        voice->hash = old->voice[i].hash;
+        
+        return 0;
+    }
+    
+    /* read the file */
+    free(voice->buf);
+    voice->buf = (uint8_t *)malloc(voice->len);
+    if (voice->buf == NULL)
+    {
+        return 1;
+    }
+    fp = fopen(voice->path, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "pack: open %s failed, %s.\n", voice->path, strerror(errno));
+        
+        return 1;
+    }
+    if (fread(voice->buf, 1, voice->len, fp) != voice->len)
+    {
+        fprintf(stderr, "pack: read %s failed.\n", voice->path);
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    (void)fclose(fp);
+    voice->hash = a_pack_hash(voice->buf, voice->len);
+    (void)pthread_mutex_lock(&job->mutex);
+    job->loaded++;
+    (void)pthread_mutex_unlock(&job->mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief     hash a chunk of blocks
+ * @param[in] *job pointer to a pack job structure
+ * @param[in] i chunk index
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_pack_hash_chunk(pack_job_t *job, uint32_t i)
+{
+    uint32_t b;
+    uint32_t end;
+    
+    end = (i + 1) * PACK_HASH_CHUNK;
+    if (end > job->pack->size / PACK_BLOCK_SIZE)
+    {
+        end = job->pack->size / PACK_BLOCK_SIZE;
+    }
+    for (b = i * PACK_HASH_CHUNK; b < end; b++)
+    {
+        job->block[b] = a_pack_hash(&job->image[b * PACK_BLOCK_SIZE], PACK_BLOCK_SIZE);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     read the previous build
+ * @param[in] *path pointer to a hash file path
+ * @param[in] *old pointer to a pack previous build structure
+ * @note      a missing or broken hash file only disables the incremental build
+ */
+static void a_pack_old_load(const char *path, pack_old_t *old)
+{
+    FILE *fp;
+    char line[PACK_LINE_SIZE];
+    unsigned long long a;
+    unsigned long long b;
+    unsigned long long c;
+    unsigned long long d;
+    long long e;
+    unsigned long long f;
+    int n;
+    
+    free(old->block);
+    memset(old, 0, sizeof(pack_old_t));
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        return;
+    }
+    if ((fgets(line, sizeof(line), fp) == NULL) || (strncmp(line, PACK_HASH_MAGIC, strlen(PACK_HASH_MAGIC)) != 0))
+    {
+        (void)fclose(fp);
+        
+        return;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (sscanf(line, "image %llu %lld %llu", &a, &e, &b) == 3)
+        {
+            if ((a % PACK_BLOCK_SIZE != 0) || (a > PACK_MAX_SIZE) || (b > PACK_MAX_VOICES) || (old->block != NULL))
+            {
+                goto failed;
+            }
+            old->size = (uint32_t)a;
+            old->stamp = e;
+            old->voice_count = (uint16_t)b;
+            old->blocks = old->size / PACK_BLOCK_SIZE;
+            old->block = (uint64_t *)calloc(old->blocks + 1, sizeof(uint64_t));
+            if (old->block == NULL)
+            {
+                goto failed;
+            }
+        }
+        else if (sscanf(line, "voice %llu %llu %llu %llu %lld %llx %n", &a, &b, &c, &d, &e, &f, &n) == 6)
+        {
+            if (a >= old->voice_count)
+            {
+                goto failed;
+            }
+            old->voice[a].offset = (uint32_t)b;
+            old->voice[a].slot = (uint32_t)c;
+            old->voice[a].len = (uint32_t)d;
+            old->voice[a].mtime = e;
+            old->voice[a].hash = f;
+            strncpy(old->voice[a].path, &line[n], PACK_PATH_SIZE - 1);
+        }
+        else if (sscanf(line, "block %llu %llx", &a, &f) == 2)
+        {
+            if ((old->block == NULL) || (a >= old->blocks))
+            {
+                goto failed;
+            }
+            old->block[a] = f;
+        }
+        else
+        {
+            goto failed;
+        }
+    }
+    (void)fclose(fp);
+    old->valid = (old->block != NULL) ? 1 : 0;
+    
+    return;
+    
+    failed:
+    (void)fclose(fp);
+    free(old->block);
+    memset(old, 0, sizeof(pack_old_t));
+}
+
+/**
+ * @brief     write the hash file
+ * @param[in] *path pointer to a hash file path
+ * @param[in] *pack pointer to a pack structure
+ * @param[in] stamp build date
+ * @param[in] *block pointer to the block hashes
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      written to a temporary file and renamed
+ */
+static uint8_t a_pack_hash_write(const char *path, const pack_t *pack, int64_t stamp, const uint64_t *block)
+{
+    char tmp[PACK_PATH_SIZE + 8];
+    FILE *fp;
+    uint32_t i;
+    int res;
+    
+    (void)snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    fp = fopen(tmp, "w");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    fprintf(fp, "%s\n", PACK_HASH_MAGIC);
+    fprintf(fp, "image %u %lld %u\n", pack->size, (long long)stamp, pack->voice_count);
+    for (i = 0; i < pack->voice_count; i++)
+    {
+        fprintf(fp, "voice %u %u %u %u %lld %016llx %s\n", i, pack->voice[i].offset, pack->voice[i].slot,
+                pack->voice[i].len, (long long)pack->voice[i].mtime,
+                (unsigned long long)pack->voice[i].hash, pack->voice[i].path);
+    }
+    for (i = 0; i < pack->size / PACK_BLOCK_SIZE; i++)
+    {
+        fprintf(fp, "block %u %016llx\n", i, (unsigned long long)block[i]);
+    }
+    res = ferror(fp);
+    if ((fclose(fp) != 0) || (res != 0) || (rename(tmp, path) != 0))
+    {
+        (void)unlink(tmp);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     write the header and the tables
+ * @param[in] *pack pointer to a pack structure
+ * @param[in] *image pointer to an image buffer
+ * @param[in] stamp build date
+ * @note      the constant fields are the values the vendor tool writes
+ */
+static void a_pack_header(const pack_t *pack, uint8_t *image, time_t stamp)
+{
+    struct tm tm;
+    uint32_t i;
+    uint32_t addr;
+    
+    memset(image, 0, PACK_DATA);
+    
+    /* header */
+    a_pack_put(&image[0x00], 1, 2);                                         /* format */
+    a_pack_put(&image[0x02], PACK_LIST_TABLE, 2);                           /* list table */
+    a_pack_put(&image[0x06], PACK_VOICE_TABLE, 2);                          /* voice table */
+    a_pack_put(&image[0x0A], pack->list_count - 1, 2);                      /* last list */
+    a_pack_put(&image[0x0C], 6, 2);                                         /* unknown, always 6 */
+    a_pack_put(&image[0x12], pack->voice_count - 1, 2);                     /* last voice */
+    a_pack_put(&image[0x14], pack->vol, 2);                                 /* volume */
+    a_pack_put(&image[0x18], PACK_PAIR_TABLE, 4);                           /* pair table */
+    a_pack_put(&image[0x1C], PACK_DATA, 4);                                 /* first voice */
+    a_pack_put(&image[0x20], PACK_RESERVED, 4);                             /* reserved table */
+    a_pack_put(&image[0x24], 0x80, 2);                                      /* unknown, always 0x80 */
+    a_pack_put(&image[0x26], 1, 2);                                         /* unknown, always 1 */
+    (void)localtime_r(&stamp, &tm);
+    image[0x28] = (uint8_t)(tm.tm_mon + 1);                                 /* month */
+    image[0x29] = (uint8_t)(tm.tm_wday + 1);                                /* week day, sunday is 1 */
+    a_pack_put(&image[0x2A], (uint32_t)(tm.tm_year + 1900), 2);             /* year */
+    image[0x2C] = (uint8_t)tm.tm_mday;                                      /* day */
+    image[0x2D] = (uint8_t)tm.tm_hour;                                      /* hour */
+    image[0x2E] = (uint8_t)tm.tm_min;                                       /* minute */
+    memcpy(&image[0x30], pack->version, strlen(pack->version));            /* version */
+    a_pack_put(&image[0x41], pack->size, 3);                                /* image size */
+    image[0x48] = 0xFF;                                                     /* unknown */
+    image[0x49] = 0xFF;                                                     /* unknown */
+    image[0x4E] = 0x01;                                                     /* unknown */
+    memset(&image[PACK_TAG], 0xFF, PACK_TAG_END - PACK_TAG);                /* tag padding */
+    memcpy(&image[PACK_TAG], "LibDriver", 9);                               /* tag */
+    
+    /* voice pairs, voice offsets and lists */
+    for (i = 0; i < pack->voice_count; i++)
+    {
+        a_pack_put(&image[PACK_PAIR_TABLE + i * 4], i + 1, 2);
+        a_pack_put(&image[PACK_PAIR_TABLE + i * 4 + 2], i + 1, 2);
+        a_pack_put(&image[PACK_VOICE_TABLE + i * 4], pack->voice[i].offset, 4);
+    }
+    for (i = 0; i < pack->list_count; i++)
+    {
+        addr = PACK_LIST_DATA + pack->list_start[i] * 2;
+        a_pack_put(&image[PACK_LIST_TABLE + i * 4], addr, 4);
+    }
+    for (i = 0; i < pack->list_used; i++)
+    {
+        a_pack_put(&image[PACK_LIST_DATA + i * 2], pack->list_ind[i], 2);
+    }
+    for (i = 0; i < pack->list_count; i++)
+    {
+        a_pack_put(&image[PACK_LIST_DATA + (pack->list_start[i] + pack->list_len[i]) * 2], PACK_LIST_END, 2);
+    }
+}
+
+/**
+ * @brief     load a manifest
+ * @param[in] *pack pointer to a pack structure
+ * @param[in] *path pointer to a manifest path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 manifest is invalid
+ * @note      one directive per line, # starts a comment:
+ *            version <string>, volume <0-63>, voice <path> and list [<index> ...];
+ *            the voices are indexed in order and a relative path is relative to the manifest,
+ *            without any list every voice gets a list of its own
+ */
+uint8_t pack_manifest_load(pack_t *pack, const char *path)
+{
+    FILE *fp;
+    char line[PACK_LINE_SIZE];
+    char dir[PACK_PATH_SIZE];
+    char *p;
+    char *arg;
+    char *end;
+    const char *env;
+    uint32_t no = 0;
+    uint32_t i;
+    unsigned long v;
+    
+    memset(pack, 0, sizeof(pack_t));
+    strcpy(pack->version, "1.0.0");
+    pack->vol = 63;
+    env = getenv("SOURCE_DATE_EPOCH");
+    pack->stamp = (env != NULL) ? (time_t)strtoll(env, NULL, 10) : time(NULL);
+    
+    /* get the manifest directory */
+    memset(dir, 0, sizeof(dir));
+    strncpy(dir, path, PACK_PATH_SIZE - 1);
+    p = strrchr(dir, '/');
+    if (p != NULL)
+    {
+        p[1] = '\0';
+    }
+    else
+    {
+        dir[0] = '\0';
+    }
+    
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "pack: open %s failed, %s.\n", path, strerror(errno));
+        
+        return 1;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        no++;
+        p = strchr(line, '#');
+        if (p != NULL)
+        {
+            *p = '\0';
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        p = line + strspn(line, " \t");
+        if (*p == '\0')
+        {
+            continue;
+        }
+        arg = p + strcspn(p, " \t");
+        if (*arg != '\0')
+        {
+            *arg++ = '\0';
+            arg += strspn(arg, " \t");
+        }
+        end = arg + strlen(arg);
+        while ((end > arg) && ((end[-1] == ' ') || (end[-1] == '\t')))
+        {
+            *--end = '\0';
+        }
+        
+        if (strcmp(p, "version") == 0)
+        {
+            if ((*arg == '\0') || (strlen(arg) >= sizeof(pack->version)))
+            {
+                goto invalid;
+            }
+            strcpy(pack->version, arg);
+        }
+        else if (strcmp(p, "volume") == 0)
+        {
+            v = strtoul(arg, &end, 10);
+            if ((end == arg) || (*end != '\0') || (v > 0x3F))
+            {
+                goto invalid;
+            }
+            pack->vol = (uint8_t)v;
+        }
+        else if (strcmp(p, "voice") == 0)
+        {
+            if ((*arg == '\0') || (pack->voice_count >= PACK_MAX_VOICES))
+            {
+                goto invalid;
+            }
+            if (snprintf(pack->voice[pack->voice_count].path, PACK_PATH_SIZE, "%s%s",
+                         (arg[0] == '/') ? "" : dir, arg) >= PACK_PATH_SIZE)
+            {
+                goto invalid;
+            }
+            pack->voice_count++;
+        }
+        else if (strcmp(p, "list") == 0)
+        {
+            if (pack->list_count >= PACK_MAX_LISTS)
+            {
+                goto invalid;
+            }
+            pack->list_start[pack->list_count] = pack->list_used;
+            while (*arg != '\0')
+            {
+                v = strtoul(arg, &end, 10);
+                if ((end == arg) || (v >= PACK_MAX_VOICES) || (pack->list_len[pack->list_count] >= 0xFF) ||
+                    (pack->list_used + 2 > PACK_MAX_LIST_DATA))
+                {
+                    goto invalid;
+                }
+                pack->list_ind[pack->list_used++] = (uint8_t)v;
+                pack->list_len[pack->list_count]++;
+                arg = end + strspn(end, " \t");
+            }
+            if (pack->list_used + 1 > PACK_MAX_LIST_DATA)
+            {
+                goto invalid;
+            }
+            pack->list_used++;
+            pack->list_count++;
+        }
+        else
+        {
+            goto invalid;
+        }
+    }
+    (void)fclose(fp);
+    
+    /* check the voices and the lists */
+    if (pack->voice_count == 0)
+    {
+        fprintf(stderr, "pack: %s has no voice.\n", path);
+        
+        return 4;
+    }
+    if (pack->list_count == 0)
+    {
+        for (i = 0; i < pack->voice_count; i++)
+        {
+            pack->list_start[i] = (uint16_t)(i * 2);
+            pack->list_len[i] = 1;
+            pack->list_ind[i * 2] = (uint8_t)i;
+        }
+        pack->list_count = pack->voice_count;
+        pack->list_used = (uint16_t)(pack->voice_count * 2);
+    }
+    for (i = 0; i < pack->list_count; i++)
+    {
+        for (v = 0; v < pack->list_len[i]; v++)
+        {
+            if (pack->list_ind[pack->list_start[i] + v] >= pack->voice_count)
+            {
+                fprintf(stderr, "pack: list %u plays the missing voice %u.\n", i, pack->list_ind[pack->list_start[i] + v]);
+                
+                return 4;
+            }
+        }
+    }
+    
+    return 0;
+    
+    invalid:
+    fprintf(stderr, "pack: %s:%u is invalid.\n", path, no);
+    (void)fclose(fp);
+    
+    return 4;
+}
+
+/**
+ * @brief      build an image
+ * @param[in]  *pack pointer to a pack structure
+ * @param[in]  *out pointer to an image path
+ * @param[in]  threads worker number, 0 uses one per cpu
+ * @param[in]  incremental 1 patches the old image when its layout still fits
+ * @param[out] *stats pointer to a pack stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 build failed
+ *             - 4 a voice file can't be read
+ *             - 5 the layout is too large
+ *             - 6 the image fails its own validation
+ * @note       the voices are read and hashed by the workers, the image is checked with
+ *             wt588e02b_image_open before anything is written, and <out>.hash receives
+ *             the voice and 512 bytes block hashes used by the next incremental build;
+ *             an incremental build keeps the old build date
+ */
+uint8_t pack_build(pack_t *pack, const char *out, uint8_t threads, uint8_t incremental, pack_stats_t *stats)
+{
+    char hash_path[PACK_PATH_SIZE];
+    char tmp[PACK_PATH_SIZE + 8];
+    pack_job_t job;
+    wt588e02b_image_t image;
+    uint8_t *buf = NULL;
+    uint64_t *block = NULL;
+    uint64_t start;
+    uint32_t i;
+    uint32_t addr;
+    uint32_t blocks;
+    uint8_t patch;
+    uint8_t res = 1;
+    time_t stamp;
+    long n;
+    int fd = -1;
+    struct stat st;
+    
+    start = a_pack_us();
+    memset(stats, 0, sizeof(pack_stats_t));
+    if (threads == 0)
+    {
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (n > 0) ? (uint8_t)((n > PACK_MAX_THREADS) ? PACK_MAX_THREADS : n) : 1;
+    }
+    if (snprintf(hash_path, sizeof(hash_path), "%s.hash", out) >= (int)sizeof(hash_path))
+    {
+        return 1;
+    }
+    
+    /* read the previous build */
+    a_pack_old_load(hash_path, &gs_old);
+    if ((incremental == 0) || (stat(out, &st) != 0) || ((uint32_t)st.st_size != gs_old.size))
+    {
+        gs_old.valid = 0;
+    }
+    
+    /* read and hash the voices */
+    memset(&job, 0, sizeof(job));
+    (void)pthread_mutex_init(&job.mutex, NULL);
+    job.pack = pack;
+    job.old = (gs_old.valid != 0) ? &gs_old : NULL;
+    if (a_pack_run(&job, pack->voice_count, threads, a_pack_load) != 0)
+    {
+        res = 4;
+        
+        goto exit;
+    }
+    
+    /* lay out the voices */
+    addr = PACK_DATA;
+    for (i = 0; i < pack->voice_count; i++)
+    {
+        pack->voice[i].offset = addr;
+        pack->voice[i].slot = (pack->voice[i].len + PACK_BLOCK_SIZE - 1) / PACK_BLOCK_SIZE * PACK_BLOCK_SIZE;
+        addr += pack->voice[i].slot;
+        if (addr > PACK_MAX_SIZE)
+        {
+            fprintf(stderr, "pack: the image is larger than %d bytes.\n", PACK_MAX_SIZE);
+            res = 5;
+            
+            goto exit;
+        }
+    }
+    pack->size = addr;
+    blocks = pack->size / PACK_BLOCK_SIZE;
+    
+    /* patch the old image only when every voice keeps its slot */
+    patch = gs_old.valid;
+    if ((gs_old.size != pack->size) || (gs_old.voice_count != pack->voice_count))
+    {
+        patch = 0;
+    }
+    for (i = 0; (i < pack->voice_count) && (patch != 0); i++)
+    {
+        if ((gs_old.voice[i].offset != pack->voice[i].offset) || (gs_old.voice[i].slot != pack->voice[i].slot))
+        {
+            patch = 0;
+        }
+    }
+    if ((patch == 0) && (job.old != NULL))
+    {
+        /* the reused voices are needed after all */
+        job.old = NULL;
+        for (i = 0; i < pack->voice_count; i++)
+        {
+            if (pack->voice[i].buf != NULL)
+            {
+                continue;
+            }
+            if (a_pack_load(&job, i) != 0)
+            {
+                res = 4;
+                
+                goto exit;
+            }
+        }
+    }
+    
+    /* assemble the image */
+    buf = (uint8_t *)calloc(pack->size, 1);
+    block = (uint64_t *)calloc(blocks, sizeof(uint64_t));
+    if ((buf == NULL) || (block == NULL))
+    {
+        goto exit;
+    }
+    if (patch != 0)
+    {
+        fd = open(out, O_RDWR);
+        if ((fd < 0) || (pread(fd, buf, pack->size, 0) != (ssize_t)pack->size))
+        {
+            fprintf(stderr, "pack: read %s failed.\n", out);
+            
+            goto exit;
+        }
+        stamp = (time_t)gs_old.stamp;
+    }
+    else
+    {
+        stamp = pack->stamp;
+    }
+    a_pack_header(pack, buf, stamp);
+    for (i = 0; i < pack->voice_count; i++)
+    {
+        pack_voice_t *voice = &pack->voice[i];
+        
+        voice->changed = (uint8_t)((patch == 0) || (voice->hash != gs_old.voice[i].hash) ||
+                                   (voice->len != gs_old.voice[i].len));
+        if ((voice->changed == 0) || (voice->buf == NULL))
+        {
+            continue;
+        }
+        memcpy(&buf[voice->offset], voice->buf, voice->len);
+        memset(&buf[voice->offset + voice->len], 0, voice->slot - voice->len);
+        stats->written++;
+    }
+    
+    /* check the image before writing it */
+    if (wt588e02b_image_open(&image, buf, pack->size) != 0)
+    {
+        fprintf(stderr, "pack: the image fails its validation.\n");
+        res = 6;
+        
+        goto exit;
+    }
+    
+    /* hash the blocks */
+    job.image = buf;
+    job.block = block;
+    (void)a_pack_run(&job, (blocks + PACK_HASH_CHUNK - 1) / PACK_HASH_CHUNK, threads, a_pack_hash_chunk);
+    
+    /* write the image */
+    if (patch != 0)
+    {
+        for (i = 0; i < blocks; i++)
+        {
+            if (block[i] == gs_old.block[i])
+            {
+                continue;
+            }
+            if (pwrite(fd, &buf[i * PACK_BLOCK_SIZE], PACK_BLOCK_SIZE, (off_t)i * PACK_BLOCK_SIZE) != PACK_BLOCK_SIZE)
+            {
+                fprintf(stderr, "pack: write %s failed.\n", out);
+                
+                goto exit;
+            }
+            stats->blocks_written++;
+        }
+        if (fsync(fd) != 0)
+        {
+            goto exit;
+        }
+    }
+    else
+    {
+        (void)snprintf(tmp, sizeof(tmp), "%s.tmp", out);
+        fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if ((fd < 0) || (write(fd, buf, pack->size) != (ssize_t)pack->size) || (fsync(fd) != 0))
+        {
+            fprintf(stderr, "pack: write %s failed.\n", tmp);
+            if (fd >= 0)
+            {
+                (void)close(fd);
+                fd = -1;
+            }
+            (void)unlink(tmp);
+            
+            goto exit;
+        }
+        (void)close(fd);
+        fd = -1;
+        if (rename(tmp, out) != 0)
+        {
+            (void)unlink(tmp);
+            
+            goto exit;
+        }
+        stats->blocks_written = blocks;
+    }
+    
+    /* write the hashes */
+    if (a_pack_hash_write(hash_path, pack, (int64_t)stamp, block) != 0)
+    {
+        fprintf(stderr, "pack: write %s failed.\n", hash_path);
+        
+        goto exit;
+    }
+    stats->voices = pack->voice_count;
+    stats->loaded = job.loaded;
+    stats->blocks = blocks;
+    stats->incremental = patch;
+    stats->us = a_pack_us() - start;
+    res = 0;
+    
+    exit:
+    if (fd >= 0)
+    {
+        (void)close(fd);
+    }
+    free(buf);
+    free(block);
+    (void)pthread_mutex_destroy(&job.mutex);
+    
+    return res;
+}
+
+/**
+ * @brief     free the loaded voices
+ * @param[in] *pack pointer to a pack structure
+ * @note      none
+ */
+void pack_free(pack_t *pack)
+{
+    uint32_t i;
+    
+    for (i = 0; i < PACK_MAX_VOICES; i++)
+    {
+        free(pack->voice[i].buf);
+        pack->voice[i].buf = NULL;
+    }
+    free(gs_old.block);
+    memset(&gs_old, 0, sizeof(pack_old_t));
+}
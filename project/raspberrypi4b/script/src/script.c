@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      script.c
+ * @brief     script source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "script.h"
+#include "driver_wt588e02b_basic.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief  script clock
+ * @return monotonic time in us
+ * @note   none
+ */
+static uint64_t a_script_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief      script parse number
+ * @param[in]  *str pointer to a number string
+ * @param[in]  max max value
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       none
+ */
+static uint8_t a_script_number(const char *str, uint32_t max, uint32_t *value)
+{
+    char *end;
+    unsigned long v;
+    
+    if ((str == NULL) || (*str == '\0'))
+    {
+        return 1;
+    }
+    errno = 0;
+    v = strtoul(str, &end, 0);
+    if ((errno != 0) || (*end != '\0') || (v > max))
+    {
+        return 1;
+    }
+    *value = (uint32_t)v;
+    
+    return 0;
+}
+
+/**
+ * @brief     script command
+ * @param[in] *line pointer to a command line
+ * @return    status code
+ *            - 0 success
+ *            - 1 command failed
+ *            - 2 parse failed
+ * @note      none
+ */
+static uint8_t a_script_command(char *line)
+{
+    char *save;
+    char *cmd;
+    char *arg;
+    char *path;
+    uint8_t len;
+    uint8_t list[SCRIPT_MAX_LIST];
+    uint32_t value;
+    
+    /* get the command */
+    cmd = strtok_r(line, " \t", &save);
+    arg = strtok_r(NULL, " \t", &save);
+    
+    /* run the command */
+    if (strcmp(cmd, "play") == 0)
+    {
+        if (a_script_number(arg, 0xDF, &value) != 0)
+        {
+            return 2;
+        }
+        
+        return wt588e02b_basic_play((uint8_t)value);
+    }
+    else if (strcmp(cmd, "play-list") == 0)
+    {
+        len = 0;
+        while (arg != NULL)
+        {
+            if ((len >= SCRIPT_MAX_LIST) || (a_script_number(arg, 0xDF, &value) != 0))
+            {
+                return 2;
+            }
+            list[len++] = (uint8_t)value;
+            arg = strtok_r(NULL, " \t", &save);
+        }
+        if (len == 0)
+        {
+            return 2;
+        }
+        
+        return wt588e02b_basic_play_list(list, len);
+    }
+    else if (strcmp(cmd, "volume") == 0)
+    {
+        if (a_script_number(arg, 0x3F, &value) != 0)
+        {
+            return 2;
+        }
+        
+        return wt588e02b_basic_set_vol((uint8_t)value);
+    }
+    else if (strcmp(cmd, "stop") == 0)
+    {
+        return (arg != NULL) ? 2 : wt588e02b_basic_stop();
+    }
+    else if (strcmp(cmd, "wait-idle") == 0)
+    {
+        return (arg != NULL) ? 2 : wt588e02b_basic_poll();
+    }
+    else if (strcmp(cmd, "update") == 0)
+    {
+        path = strtok_r(NULL, " \t", &save);
+        if ((a_script_number(arg, 0xDF, &value) != 0) || (path == NULL))
+        {
+            return 2;
+        }
+        
+        return wt588e02b_basic_update((uint8_t)value, path);
+    }
+    else if (strcmp(cmd, "update-all") == 0)
+    {
+        if (arg == NULL)
+        {
+            return 2;
+        }
+        
+        return wt588e02b_basic_update_all(arg);
+    }
+    else if (strcmp(cmd, "sleep") == 0)
+    {
+        if (a_script_number(arg, 0xFFFFFFFFU, &value) != 0)
+        {
+            return 2;
+        }
+        wt588e02b_interface_delay_ms(value);
+        
+        return 0;
+    }
+    else
+    {
+        return 2;
+    }
+}
+
+/**
+ * @brief     script run
+ * @param[in] *fp pointer to an opened script file or stdin
+ * @param[in] *name pointer to a script name for the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      one command per line over one initialized handle, it stops at the first failed command,
+ *            play <ind> | play-list <ind> [<ind> ...] | volume <vol> | stop | wait-idle |
+ *            update <ind> <path> | update-all <path> | sleep <ms>, # starts a comment
+ */
+uint8_t script_run(FILE *fp, const char *name)
+{
+    uint8_t res;
+    uint32_t number;
+    uint32_t commands;
+    uint64_t start;
+    uint64_t t;
+    size_t len;
+    char *cmd;
+    char line[SCRIPT_MAX_LINE];
+    char text[SCRIPT_MAX_LINE];
+    
+    /* basic init once */
+    start = a_script_us();
+    if (wt588e02b_basic_init() != 0)
+    {
+        return 1;
+    }
+    t = a_script_us() - start;
+    wt588e02b_interface_debug_print("script: init in %u.%03u ms.\n", (unsigned int)(t / 1000), (unsigned int)(t % 1000));
+    
+    /* run every line */
+    res = 0;
+    number = 0;
+    commands = 0;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        number++;
+        
+        /* strip the comment and the blanks */
+        line[strcspn(line, "#\r\n")] = '\0';
+        cmd = line + strspn(line, " \t");
+        len = strlen(cmd);
+        while ((len != 0) && ((cmd[len - 1] == ' ') || (cmd[len - 1] == '\t')))
+        {
+            cmd[--len] = '\0';
+        }
+        if (len == 0)
+        {
+            continue;
+        }
+        
+        /* run the command */
+        strcpy(text, cmd);
+        commands++;
+        t = a_script_us();
+        res = a_script_command(cmd);
+        t = a_script_us() - t;
+        if (res == 2)
+        {
+            wt588e02b_interface_debug_print("script: %s:%u: %s is invalid.\n", name, (unsigned int)number, text);
+            
+            break;
+        }
+        wt588e02b_interface_debug_print("script: %s:%u: %s %s in %u.%03u ms.\n", name, (unsigned int)number, text,
+                                        (res == 0) ? "ok" : "failed",
+                                        (unsigned int)(t / 1000), (unsigned int)(t % 1000));
+        if (res != 0)
+        {
+            break;
+        }
+    }
+    
+    /* basic deinit */
+    (void)wt588e02b_basic_deinit();
+    t = a_script_us() - start;
+    wt588e02b_interface_debug_print("script: %u commands in %u.%03u ms.\n", (unsigned int)commands,
+                                    (unsigned int)(t / 1000), (unsigned int)(t % 1000));
+    
+    return (res == 0) ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      size.c
+ * @brief     size probe source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b.h"
+
+#ifndef WT588E02B_SIZE_BASELINE
+    #define WT588E02B_SIZE_BASELINE    0        /**< 1 measures the handle layout of the driver 1.0 */
+#endif
+
+#if (WT588E02B_SIZE_BASELINE != 0)
+
+/**
+ * @brief wt588e02b handle layout of the driver 1.0, every handle held its hooks and the update buffer
+ */
+typedef struct wt588e02b_size_baseline_s
+{
+    uint8_t (*sclk_gpio_init)(void);                                           /**< point to a sclk_gpio_init function address */
+    uint8_t (*sclk_gpio_deinit)(void);                                         /**< point to a sclk_gpio_deinit function address */
+    uint8_t (*sclk_gpio_write)(uint8_t data);                                  /**< point to a sclk_gpio_write function address */
+    uint8_t (*mosi_gpio_init)(void);                                           /**< point to a mosi_gpio_init function address */
+    uint8_t (*mosi_gpio_deinit)(void);                                         /**< point to a mosi_gpio_deinit function address */
+    uint8_t (*mosi_gpio_write)(uint8_t data);                                  /**< point to a mosi_gpio_write function address */
+    uint8_t (*miso_gpio_init)(void);                                           /**< point to a miso_gpio_init function address */
+    uint8_t (*miso_gpio_deinit)(void);                                         /**< point to a miso_gpio_deinit function address */
+    uint8_t (*miso_gpio_read)(uint8_t *data);                                  /**< point to a miso_gpio_read function address */
+    uint8_t (*cs_gpio_init)(void);                                             /**< point to a cs_gpio_init function address */
+    uint8_t (*cs_gpio_deinit)(void);                                           /**< point to a cs_gpio_deinit function address */
+    uint8_t (*cs_gpio_write)(uint8_t data);                                    /**< point to a cs_gpio_write function address */
+    void (*delay_ms)(uint32_t ms);                                             /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                             /**< point to a delay_us function address */
+    void (*debug_print)(const char *const fmt, ...);                           /**< point to a debug_print function address */
+    uint8_t (*bin_read_init)(char *name, uint32_t *size);                      /**< point to a bin_read_init function address */
+    uint8_t (*bin_read)(uint32_t addr, uint16_t size, uint8_t *buffer);        /**< point to a bin_read function address */
+    uint8_t (*bin_read_deinit)(void);                                          /**< point to a bin_read_deinit function address */
+    uint8_t inited;                                                            /**< inited flag */
+    uint16_t sum;                                                              /**< sum */
+    uint8_t buf[512];                                                          /**< inner buffer */
+} wt588e02b_size_baseline_t;
+
+/**
+ * @brief one baseline handle, the bss of this object is the ram used by every chip before the ops table split
+ */
+wt588e02b_size_baseline_t g_wt588e02b_size_handle;
+
+#else
+
+/**
+ * @brief one handle, the bss of this object is the ram used by every chip
+ */
+wt588e02b_handle_t g_wt588e02b_size_handle;
+
+#endif
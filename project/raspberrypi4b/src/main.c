@@ -36,9 +36,61 @@
 
 #include "driver_wt588e02b_play_test.h"
 #include "driver_wt588e02b_update_test.h"
+#include "driver_wt588e02b_latency_test.h"
+#include "driver_wt588e02b_stress_test.h"
+#include "driver_wt588e02b_wire_test.h"
+#include "driver_wt588e02b_gpiomem_test.h"
+#include "driver_wt588e02b_delay_test.h"
+#include "driver_wt588e02b_image_test.h"
+#include "driver_wt588e02b_log_test.h"
+#include "driver_wt588e02b_ops_test.h"
+#include "driver_wt588e02b_transfer_test.h"
+#include "driver_wt588e02b_bus_test.h"
+#include "driver_wt588e02b_coalesce_test.h"
+#include "driver_wt588e02b_duration_test.h"
+#include "driver_wt588e02b_shadow_test.h"
 #include "driver_wt588e02b_basic.h"
+#include "wire.h"
+#include "rt.h"
+#include "script.h"
 #include <getopt.h>
 #include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief global var definition
+ */
+static uint8_t gs_rt_report = 0;        /**< print the rt report */
+
+/**
+ * @brief  timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+static uint32_t a_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief rt report
+ * @note  prints the jitter observed per transaction
+ */
+static void a_rt_report(void)
+{
+    rt_stats_t stats;
+    
+    rt_get_stats(&stats);
+    wt588e02b_interface_debug_print("rt: %u transactions, stretch mean %u us max %u us, worst delay wake-up %u us late.\n",
+                                    (unsigned int)stats.transactions,
+                                    (unsigned int)((stats.transactions != 0) ? stats.stretch_sum_ns / stats.transactions / 1000 : 0),
+                                    (unsigned int)(stats.stretch_max_ns / 1000), (unsigned int)(stats.late_max_ns / 1000));
+    (void)rt_deinit();
+}
 
 /**
  * @brief     wt588e02b full function
@@ -66,6 +118,16 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         {"index", required_argument, NULL, 2},
         {"vol", required_argument, NULL, 3},
         {"list", required_argument, NULL, 4},
+        {"times", required_argument, NULL, 5},
+        {"mock", no_argument, NULL, 6},
+        {"format", required_argument, NULL, 7},
+        {"threads", required_argument, NULL, 8},
+        {"backend", required_argument, NULL, 9},
+        {"rt", no_argument, NULL, 10},
+        {"priority", required_argument, NULL, 11},
+        {"cpu", required_argument, NULL, 12},
+        {"jitter", no_argument, NULL, 13},
+        {"script", required_argument, NULL, 14},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
@@ -75,6 +137,15 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
     uint16_t number = 123;
     uint8_t number_len = 3;
     uint8_t list[63];
+    uint32_t times = 100;
+    uint8_t mock = 0;
+    uint32_t threads = 8;
+    wire_backend_t backend = WIRE_BACKEND_GPIOD;
+    uint8_t rt = 0;
+    uint8_t jitter = 0;
+    rt_config_t rt_config = {80, -1};
+    char script[SCRIPT_MAX_LINE] = "-";
+    wt588e02b_latency_format_t format = WT588E02B_LATENCY_FORMAT_CSV;
     
     /* if no params */
     if (argc == 1)
@@ -240,6 +311,123 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
                 break;
             }
             
+            /* times */
+            case 5 :
+            {
+                /* set the times */
+                times = atol(optarg);
+                
+                break;
+            }
+            
+            /* mock */
+            case 6 :
+            {
+                /* use the mock chip */
+                mock = 1;
+                
+                break;
+            }
+            
+            /* format */
+            case 7 :
+            {
+                /* set the format */
+                if (strcmp("csv", optarg) == 0)
+                {
+                    format = WT588E02B_LATENCY_FORMAT_CSV;
+                }
+                else if (strcmp("json", optarg) == 0)
+                {
+                    format = WT588E02B_LATENCY_FORMAT_JSON;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* threads */
+            case 8 :
+            {
+                /* set the threads */
+                threads = atol(optarg);
+                
+                break;
+            }
+            
+            /* backend */
+            case 9 :
+            {
+                /* set the backend */
+                if (strcmp("gpiod", optarg) == 0)
+                {
+                    backend = WIRE_BACKEND_GPIOD;
+                }
+                else if (strcmp("gpiomem", optarg) == 0)
+                {
+                    backend = WIRE_BACKEND_GPIOMEM;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* rt */
+            case 10 :
+            {
+                /* set the rt mode */
+                rt = 1;
+                
+                break;
+            }
+            
+            /* priority */
+            case 11 :
+            {
+                /* set the priority */
+                rt_config.priority = atoi(optarg);
+                
+                break;
+            }
+            
+            /* cpu */
+            case 12 :
+            {
+                /* set the cpu */
+                rt_config.cpu = atoi(optarg);
+                
+                break;
+            }
+            
+            /* jitter */
+            case 13 :
+            {
+                /* set the jitter report */
+                jitter = 1;
+                
+                break;
+            }
+            
+            /* script */
+            case 14 :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "script");
+                
+                /* set the script path */
+                memset(script, 0, sizeof(char) * SCRIPT_MAX_LINE);
+                strncpy(script, optarg, SCRIPT_MAX_LINE - 1);
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -253,6 +441,24 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
             }
         }
     } while (c != -1);
+    
+    /* select the gpio backend */
+    (void)wire_set_backend(backend, NULL);
+    
+    /* init the rt mode or only the jitter measurement */
+    if ((rt != 0) || (jitter != 0))
+    {
+        if (rt == 0)
+        {
+            rt_config.priority = 0;
+            rt_config.cpu = -1;
+        }
+        if (rt_init(&rt_config) != 0)
+        {
+            return 1;
+        }
+        gs_rt_report = 1;
+    }
 
     /* run the function */
     if (strcmp("t_play", type) == 0)
@@ -294,6 +500,209 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("t_latency", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the latency test */
+        res = wt588e02b_latency_test(index, times, format, (mock != 0) ? NULL : a_timestamp_us);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_stress", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the stress test */
+        res = wt588e02b_stress_test(threads, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_gpiomem", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the gpiomem test */
+        res = wt588e02b_gpiomem_test(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_delay", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the delay test */
+        res = wt588e02b_delay_test(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_image", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the image test */
+        res = wt588e02b_image_test(path);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_log", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the log test */
+        res = wt588e02b_log_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_ops", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the ops test */
+        res = wt588e02b_ops_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_transfer", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the transfer test */
+        res = wt588e02b_transfer_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_bus", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the bus test */
+        res = wt588e02b_bus_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_coalesce", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the coalesce test */
+        res = wt588e02b_coalesce_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_duration", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the duration test */
+        res = wt588e02b_duration_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_shadow", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the shadow test */
+        res = wt588e02b_shadow_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_wire", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the wire test */
+        res = wt588e02b_wire_test(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("script", type) == 0)
+    {
+        uint8_t res;
+        FILE *fp;
+        
+        /* open the script, - is stdin */
+        if (strcmp(script, "-") == 0)
+        {
+            fp = stdin;
+        }
+        else
+        {
+            fp = fopen(script, "r");
+            if (fp == NULL)
+            {
+                wt588e02b_interface_debug_print("wt588e02b: open %s failed.\n", script);
+                
+                return 1;
+            }
+        }
+        
+        /* run the script */
+        res = script_run(fp, (fp == stdin) ? "stdin" : script);
+        if (fp != stdin)
+        {
+            (void)fclose(fp);
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
     else if (strcmp("e_play", type) == 0)
     {
         uint8_t res;
@@ -586,6 +995,21 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         wt588e02b_interface_debug_print("  wt588e02b (-t play | --test=play) [--index=<index>]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-t update | --test=update) [--index=<index>] [--file=<path>]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-t update-all | --test=update-all) [--file=<path>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t latency | --test=latency) [--index=<index>] [--times=<num>] [--format=<csv | json>] [--mock]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t stress | --test=stress) [--threads=<num>] [--times=<num>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t wire | --test=wire) [--times=<num>] [--backend=<gpiod | gpiomem>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t gpiomem | --test=gpiomem) [--times=<num>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t delay | --test=delay) [--times=<num>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t image | --test=image) [--file=<path>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t log | --test=log)\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t ops | --test=ops)\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t transfer | --test=transfer)\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t bus | --test=bus)\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t coalesce | --test=coalesce)\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t duration | --test=duration)\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t shadow | --test=shadow)\n");
+        wt588e02b_interface_debug_print("  wt588e02b --script=<path | ->\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t <test> | -e <example>) [--rt] [--priority=<prio>] [--cpu=<cpu>] [--jitter]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e play | --example=play) [--index=<index>]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e play-list | --example=play-list) [--list=<number>]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e play-loop | --example=play-loop) [--index=<index>]\n");
@@ -597,18 +1021,31 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         wt588e02b_interface_debug_print("  wt588e02b (-e update-all | --example=update-all) [--file=<path>]\n");
         wt588e02b_interface_debug_print("\n");
         wt588e02b_interface_debug_print("Options:\n");
+        wt588e02b_interface_debug_print("      --backend=<gpiod | gpiomem>\n");
+        wt588e02b_interface_debug_print("                          Set the gpio backend.([default: gpiod])\n");
+        wt588e02b_interface_debug_print("      --cpu=<cpu>         Pin the rt transfers to a cpu, an isolcpus cpu isolates them.([default: none])\n");
         wt588e02b_interface_debug_print("  -e <play | play-list | play-loop | play-loop-advance | play-loop-all | stop | volume | update | update-all>,\n"); 
         wt588e02b_interface_debug_print("      --example=<play | play-list | play-loop | play-loop-advance | play-loop-all | stop | volume | update | update-all>\n");
         wt588e02b_interface_debug_print("                          Run the driver example.\n");
         wt588e02b_interface_debug_print("      --file=<path>       Set the bin file path.([default: update.bin])\n");
+        wt588e02b_interface_debug_print("      --format=<csv | json>\n");
+        wt588e02b_interface_debug_print("                          Set the latency report format.([default: csv])\n");
         wt588e02b_interface_debug_print("  -h, --help              Show the help.\n");
         wt588e02b_interface_debug_print("  -i, --information       Show the chip information.\n");
         wt588e02b_interface_debug_print("      --index=<index>     Set the index of the voice.([default: 0])\n");
+        wt588e02b_interface_debug_print("      --jitter            Report the jitter per transaction without the rt mode.\n");
         wt588e02b_interface_debug_print("      --list=<number>     Set the list of the voice.([default: 123])\n");
+        wt588e02b_interface_debug_print("      --mock              Run the latency test on the mock chip.\n");
         wt588e02b_interface_debug_print("      --vol=<volume>      Set the volume of the voice.([default: 63])\n");
         wt588e02b_interface_debug_print("  -p, --port              Display the pin connections of the current board.\n");
-        wt588e02b_interface_debug_print("  -t <play | update | update-all>, --test=<play | update | update-all>\n");
+        wt588e02b_interface_debug_print("      --priority=<prio>   Set the SCHED_FIFO priority of the rt transfers.([default: 80])\n");
+        wt588e02b_interface_debug_print("      --rt                Run every transfer with SCHED_FIFO and locked memory and report the jitter.\n");
+        wt588e02b_interface_debug_print("      --script=<path | ->\n");
+        wt588e02b_interface_debug_print("                          Run the commands of a script file or of stdin over one handle.\n");
+        wt588e02b_interface_debug_print("  -t <play | update | update-all | latency | stress | wire | gpiomem | delay | image | log | ops | transfer | bus | coalesce | duration | shadow>, --test=<play | update | update-all | latency | stress | wire | gpiomem | delay | image | log | ops | transfer | bus | coalesce | duration | shadow>\n");
         wt588e02b_interface_debug_print("                          Run the driver test.\n");
+        wt588e02b_interface_debug_print("      --threads=<num>     Set the stress test worker threads.([default: 8])\n");
+        wt588e02b_interface_debug_print("      --times=<num>       Set the latency test times, the stress test commands per thread, the wire test edges or the delay test samples.([default: 100])\n");
         
         return 0;
     }
@@ -659,6 +1096,10 @@ int main(uint8_t argc, char **argv)
     uint8_t res;
 
     res = wt588e02b(argc, argv);
+    if (gs_rt_report != 0)
+    {
+        a_rt_report();
+    }
     if (res == 0)
     {
         /* run success */
@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_delay_test.c
+ * @brief     driver wt588e02b delay test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_delay_test.h"
+#include "delay.h"
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief delay test range definition
+ */
+static const uint32_t gs_range_us[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000};
+
+/**
+ * @brief delay test error structure definition
+ */
+typedef struct delay_test_error_s
+{
+    uint64_t sum_ns;          /**< error sum */
+    uint64_t max_ns;          /**< max error */
+    uint32_t early;           /**< returns before the requested time */
+} delay_test_error_t;
+
+/**
+ * @brief  delay test clock
+ * @return raw monotonic time in ns
+ * @note   none
+ */
+static uint64_t a_wt588e02b_delay_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief         delay test measure
+ * @param[in]     us requested time
+ * @param[in]     engine 1 uses the delay engine, 0 uses usleep
+ * @param[in]     times samples
+ * @param[in,out] *error pointer to an error structure
+ * @note          none
+ */
+static void a_wt588e02b_delay_measure(uint32_t us, uint8_t engine, uint32_t times, delay_test_error_t *error)
+{
+    uint32_t i;
+    uint64_t t;
+    uint64_t want;
+    
+    want = (uint64_t)us * 1000;
+    error->sum_ns = 0;
+    error->max_ns = 0;
+    error->early = 0;
+    for (i = 0; i < times; i++)
+    {
+        t = a_wt588e02b_delay_ns();
+        if (engine != 0)
+        {
+            delay_us(us);
+        }
+        else
+        {
+            (void)usleep(us);
+        }
+        t = a_wt588e02b_delay_ns() - t;
+        if (t < want)
+        {
+            error->early++;
+            
+            continue;
+        }
+        t -= want;
+        error->sum_ns += t;
+        if (t > error->max_ns)
+        {
+            error->max_ns = t;
+        }
+    }
+}
+
+/**
+ * @brief     delay test
+ * @param[in] times samples per range
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      reports the achieved minus requested delay of the delay engine and of usleep
+ *            for every range, it fails when the engine returns early, no gpio is needed
+ */
+uint8_t wt588e02b_delay_test(uint32_t times)
+{
+    uint32_t i;
+    uint32_t early;
+    delay_test_error_t engine;
+    delay_test_error_t sleep;
+    
+    /* start the test */
+    wt588e02b_interface_debug_print("wt588e02b: start delay test.\n");
+    if (times == 0)
+    {
+        times = 1;
+    }
+    if (delay_init() != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: delay init failed.\n");
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: early-wake margin %u ns.\n", (unsigned int)delay_get_margin_ns());
+    
+    /* measure every range */
+    early = 0;
+    wt588e02b_interface_debug_print("delay_us,engine_mean_ns,engine_max_ns,usleep_mean_ns,usleep_max_ns\n");
+    for (i = 0; i < sizeof(gs_range_us) / sizeof(gs_range_us[0]); i++)
+    {
+        a_wt588e02b_delay_measure(gs_range_us[i], 1, times, &engine);
+        a_wt588e02b_delay_measure(gs_range_us[i], 0, times, &sleep);
+        early += engine.early;
+        wt588e02b_interface_debug_print("%u,%u,%u,%u,%u\n", (unsigned int)gs_range_us[i],
+                                        (unsigned int)(engine.sum_ns / times), (unsigned int)engine.max_ns,
+                                        (unsigned int)(sleep.sum_ns / times), (unsigned int)sleep.max_ns);
+    }
+    if (early != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: %u delays returned early.\n", (unsigned int)early);
+        wt588e02b_interface_debug_print("wt588e02b: delay check failed.\n");
+        
+        return 1;
+    }
+    
+    /* finish the test */
+    wt588e02b_interface_debug_print("wt588e02b: finish delay test.\n");
+    
+    return 0;
+}
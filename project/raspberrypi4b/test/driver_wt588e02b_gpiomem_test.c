@@ -0,0 +1,460 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_gpiomem_test.c
+ * @brief     driver wt588e02b gpiomem test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_gpiomem_test.h"
+#include "driver_wt588e02b_mock.h"
+#include "gpiomem.h"
+#include "wire.h"
+#include <sys/mman.h>
+#include <time.h>
+
+/**
+ * @brief gpiomem test pin definition
+ */
+#define GPIOMEM_TEST_MISO        9                                               /**< miso pin */
+#define GPIOMEM_TEST_MOSI        10                                              /**< mosi pin */
+#define GPIOMEM_TEST_SCLK        11                                              /**< sclk pin */
+#define GPIOMEM_TEST_CS          17                                              /**< cs pin */
+#define GPIOMEM_TEST_OUTPUTS     ((1U << GPIOMEM_TEST_MOSI) | (1U << GPIOMEM_TEST_SCLK) | \
+                                  (1U << GPIOMEM_TEST_CS))                        /**< output mask */
+#define GPIOMEM_TEST_BANK_CS     ((1U << 22) | (1U << 24))                       /**< bank cs pins of chip 0 and 2 */
+#define GPIOMEM_TEST_BANK_MISO   ((1U << 6) | (1U << 19))                        /**< bank miso pins of chip 1 and 3 */
+
+/**
+ * @brief global var definition
+ */
+static wt588e02b_handle_t gs_handle;        /**< wt588e02b handle */
+static volatile uint32_t *gs_window;        /**< register window */
+static uint32_t gs_level;                   /**< decoded pin levels */
+static uint32_t gs_stores;                  /**< decoded set and clear stores */
+static uint32_t gs_bad;                     /**< encoding errors */
+
+/**
+ * @brief  gpiomem test clock
+ * @return current time in ns
+ * @note   none
+ */
+static uint64_t a_wt588e02b_gpiomem_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     gpiomem test function select
+ * @param[in] pin gpio pin
+ * @return    function select bits of the pin
+ * @note      none
+ */
+static uint32_t a_wt588e02b_gpiomem_fsel(uint8_t pin)
+{
+    return (gs_window[GPIOMEM_GPFSEL0 / 4 + pin / 10] >> ((pin % 10) * 3)) & 7;
+}
+
+/**
+ * @brief gpiomem test checker
+ * @note  consumes the set and clear registers like the hardware does, checks the
+ *        pin modes and forwards every changed output level to the mock chip
+ */
+static void a_wt588e02b_gpiomem_check(void)
+{
+    uint32_t set;
+    uint32_t clr;
+    uint32_t level;
+    uint32_t changed;
+    
+    /* consume the stores */
+    set = gs_window[GPIOMEM_GPSET0 / 4];
+    clr = gs_window[GPIOMEM_GPCLR0 / 4];
+    gs_window[GPIOMEM_GPSET0 / 4] = 0;
+    gs_window[GPIOMEM_GPCLR0 / 4] = 0;
+    if ((set | clr) == 0)
+    {
+        return;
+    }
+    gs_stores++;
+    
+    /* check the encoding */
+    if (((set & clr) != 0) || (((set | clr) & ~GPIOMEM_TEST_OUTPUTS) != 0))
+    {
+        gs_bad++;
+    }
+    if ((a_wt588e02b_gpiomem_fsel(GPIOMEM_TEST_SCLK) != 1) || (a_wt588e02b_gpiomem_fsel(GPIOMEM_TEST_MOSI) != 1) ||
+        (a_wt588e02b_gpiomem_fsel(GPIOMEM_TEST_CS) != 1) || (a_wt588e02b_gpiomem_fsel(GPIOMEM_TEST_MISO) != 0))
+    {
+        gs_bad++;
+    }
+    
+    /* update the levels */
+    level = (gs_level | set) & ~clr;
+    changed = level ^ gs_level;
+    gs_level = level;
+    gs_window[GPIOMEM_GPLEV0 / 4] = (gs_window[GPIOMEM_GPLEV0 / 4] & (1U << GPIOMEM_TEST_MISO)) |
+                                    (level & GPIOMEM_TEST_OUTPUTS);
+    
+    /* forward to the mock */
+    if ((changed & (1U << GPIOMEM_TEST_CS)) != 0)
+    {
+        (void)wt588e02b_mock_cs_gpio_write((uint8_t)((level >> GPIOMEM_TEST_CS) & 1));
+    }
+    if ((changed & (1U << GPIOMEM_TEST_MOSI)) != 0)
+    {
+        (void)wt588e02b_mock_mosi_gpio_write((uint8_t)((level >> GPIOMEM_TEST_MOSI) & 1));
+    }
+    if (((changed & (1U << GPIOMEM_TEST_SCLK)) != 0) && (gs_stores > 1))        /* the mock resets with the clock low */
+    {
+        (void)wt588e02b_mock_sclk_gpio_write((uint8_t)((level >> GPIOMEM_TEST_SCLK) & 1));
+    }
+}
+
+/**
+ * @brief  gpiomem test sclk init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+static uint8_t a_wt588e02b_gpiomem_sclk_init(void)
+{
+    uint8_t res;
+    
+    res = wt588e02b_interface_sclk_gpio_init();
+    a_wt588e02b_gpiomem_check();
+    
+    return res;
+}
+
+/**
+ * @brief     gpiomem test sclk write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_gpiomem_sclk_write(uint8_t data)
+{
+    uint8_t res;
+    
+    res = wt588e02b_interface_sclk_gpio_write(data);
+    a_wt588e02b_gpiomem_check();
+    
+    return res;
+}
+
+/**
+ * @brief  gpiomem test mosi init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+static uint8_t a_wt588e02b_gpiomem_mosi_init(void)
+{
+    uint8_t res;
+    
+    res = wt588e02b_interface_mosi_gpio_init();
+    a_wt588e02b_gpiomem_check();
+    
+    return res;
+}
+
+/**
+ * @brief     gpiomem test mosi write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_gpiomem_mosi_write(uint8_t data)
+{
+    uint8_t res;
+    
+    res = wt588e02b_interface_mosi_gpio_write(data);
+    a_wt588e02b_gpiomem_check();
+    
+    return res;
+}
+
+/**
+ * @brief  gpiomem test cs init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+static uint8_t a_wt588e02b_gpiomem_cs_init(void)
+{
+    uint8_t res;
+    
+    res = wt588e02b_interface_cs_gpio_init();
+    a_wt588e02b_gpiomem_check();
+    
+    return res;
+}
+
+/**
+ * @brief     gpiomem test cs write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_gpiomem_cs_write(uint8_t data)
+{
+    uint8_t res;
+    
+    res = wt588e02b_interface_cs_gpio_write(data);
+    a_wt588e02b_gpiomem_check();
+    
+    return res;
+}
+
+/**
+ * @brief      gpiomem test miso read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the mock busy level is put into the level register before the backend reads it
+ */
+static uint8_t a_wt588e02b_gpiomem_miso_read(uint8_t *data)
+{
+    uint8_t level;
+    
+    (void)wt588e02b_mock_miso_gpio_read(&level);
+    gs_window[GPIOMEM_GPLEV0 / 4] = (gs_window[GPIOMEM_GPLEV0 / 4] & ~(1U << GPIOMEM_TEST_MISO)) |
+                                    ((uint32_t)level << GPIOMEM_TEST_MISO);
+    
+    return wt588e02b_interface_miso_gpio_read(data);
+}
+
+/**
+ * @brief  gpiomem test bank
+ * @return number of encoding errors
+ * @note   a chip mask must reach the set and clear registers as one store and
+ *         the miso levels must come from one load, so the bank chips see the same edge
+ */
+static uint32_t a_wt588e02b_gpiomem_bank(void)
+{
+    uint32_t bad;
+    uint32_t level;
+    uint8_t i;
+    
+    /* request the bank with every cs high */
+    bad = 0;
+    bad += (wt588e02b_interface_cs_gpio_write_mask(0x0F, 1) != 0) ? 1 : 0;
+    for (i = 0; i < 4; i++)
+    {
+        bad += (a_wt588e02b_gpiomem_fsel((uint8_t)(22 + i)) != 1) ? 1 : 0;
+    }
+    bad += (a_wt588e02b_gpiomem_fsel(5) != 0) ? 1 : 0;
+    bad += (a_wt588e02b_gpiomem_fsel(6) != 0) ? 1 : 0;
+    bad += (a_wt588e02b_gpiomem_fsel(13) != 0) ? 1 : 0;
+    bad += (a_wt588e02b_gpiomem_fsel(19) != 0) ? 1 : 0;
+    gs_window[GPIOMEM_GPSET0 / 4] = 0;
+    gs_window[GPIOMEM_GPCLR0 / 4] = 0;
+    
+    /* select chip 0 and 2 with one clear store */
+    bad += (wt588e02b_interface_cs_gpio_write_mask(0x05, 0) != 0) ? 1 : 0;
+    bad += (gs_window[GPIOMEM_GPCLR0 / 4] != GPIOMEM_TEST_BANK_CS) ? 1 : 0;
+    bad += (gs_window[GPIOMEM_GPSET0 / 4] != 0) ? 1 : 0;
+    gs_window[GPIOMEM_GPCLR0 / 4] = 0;
+    
+    /* release them with one set store */
+    bad += (wt588e02b_interface_cs_gpio_write_mask(0x05, 1) != 0) ? 1 : 0;
+    bad += (gs_window[GPIOMEM_GPSET0 / 4] != GPIOMEM_TEST_BANK_CS) ? 1 : 0;
+    bad += (gs_window[GPIOMEM_GPCLR0 / 4] != 0) ? 1 : 0;
+    gs_window[GPIOMEM_GPSET0 / 4] = 0;
+    
+    /* read chip 1 and 3 high */
+    gs_window[GPIOMEM_GPLEV0 / 4] = (gs_window[GPIOMEM_GPLEV0 / 4] & ~((1U << 5) | (1U << 13))) | GPIOMEM_TEST_BANK_MISO;
+    bad += (wt588e02b_interface_miso_gpio_read_mask(&level) != 0) ? 1 : 0;
+    bad += (level != 0x0A) ? 1 : 0;
+    gs_window[GPIOMEM_GPLEV0 / 4] &= ~GPIOMEM_TEST_BANK_MISO;
+    
+    return bad;
+}
+
+/**
+ * @brief gpiomem test ops table, the pins go through the register window and the rest is the mock chip
+ */
+static const wt588e02b_ops_t gs_ops =
+{
+    .sclk_gpio_init = a_wt588e02b_gpiomem_sclk_init,
+    .sclk_gpio_deinit = wt588e02b_interface_sclk_gpio_deinit,
+    .sclk_gpio_write = a_wt588e02b_gpiomem_sclk_write,
+    .mosi_gpio_init = a_wt588e02b_gpiomem_mosi_init,
+    .mosi_gpio_deinit = wt588e02b_interface_mosi_gpio_deinit,
+    .mosi_gpio_write = a_wt588e02b_gpiomem_mosi_write,
+    .miso_gpio_init = wt588e02b_interface_miso_gpio_init,
+    .miso_gpio_deinit = wt588e02b_interface_miso_gpio_deinit,
+    .miso_gpio_read = a_wt588e02b_gpiomem_miso_read,
+    .cs_gpio_init = a_wt588e02b_gpiomem_cs_init,
+    .cs_gpio_deinit = wt588e02b_interface_cs_gpio_deinit,
+    .cs_gpio_write = a_wt588e02b_gpiomem_cs_write,
+    .delay_ms = wt588e02b_mock_delay_ms,
+    .delay_us = wt588e02b_mock_delay_us,
+    .debug_print = wt588e02b_interface_debug_print,
+    .bin_read_init = wt588e02b_interface_bin_read_init,
+    .bin_read = wt588e02b_interface_bin_read,
+    .bin_read_deinit = wt588e02b_interface_bin_read_deinit,
+    .timestamp_ms = wt588e02b_mock_timestamp_ms,
+};
+
+/**
+ * @brief     gpiomem test
+ * @param[in] times command rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      drives the gpiomem backend on an anonymous register window, a checker decodes
+ *            every set and clear store into pin levels for the mock chip and answers the
+ *            level register from it, so the register encoding is checked without the hardware
+ */
+uint8_t wt588e02b_gpiomem_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t list[3];
+    uint32_t i;
+    uint32_t failed;
+    uint32_t bank;
+    uint64_t t;
+    uint64_t edge_ns;
+    void *map;
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+    wt588e02b_stats_t stats;
+    
+    /* start the test */
+    wt588e02b_interface_debug_print("wt588e02b: start gpiomem test.\n");
+    
+    /* make the register window */
+    map = mmap(NULL, GPIOMEM_BLOCK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: map window failed.\n");
+        
+        return 1;
+    }
+    gs_window = (volatile uint32_t *)map;
+    gs_level = 0;
+    gs_stores = 0;
+    gs_bad = 0;
+    if (wire_set_backend(WIRE_BACKEND_GPIOMEM, gs_window) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: set backend failed.\n");
+        (void)munmap(map, GPIOMEM_BLOCK_SIZE);
+        
+        return 1;
+    }
+    
+    /* link the backend through the checker */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = 200000;
+    wt588e02b_mock_init(&config);
+    DRIVER_WT588E02B_LINK_INIT(&gs_handle, wt588e02b_handle_t);
+    DRIVER_WT588E02B_LINK_OPS(&gs_handle, &gs_ops);
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        (void)wire_set_backend(WIRE_BACKEND_GPIOD, NULL);
+        (void)munmap(map, GPIOMEM_BLOCK_SIZE);
+        
+        return 1;
+    }
+    
+    /* run the commands */
+    failed = 0;
+    for (i = 0; i < times; i++)
+    {
+        list[0] = (uint8_t)(i % 0xE0);
+        list[1] = (uint8_t)((i + 1) % 0xE0);
+        list[2] = (uint8_t)((i + 2) % 0xE0);
+        failed += (wt588e02b_set_vol(&gs_handle, (uint8_t)(i % 0x40)) != 0) ? 1 : 0;
+        failed += (wt588e02b_play(&gs_handle, list[0]) != 0) ? 1 : 0;
+        failed += (wt588e02b_stop(&gs_handle) != 0) ? 1 : 0;
+        wt588e02b_mock_delay_ms(10);
+        failed += (wt588e02b_play_list(&gs_handle, list, 3) != 0) ? 1 : 0;
+        failed += (wt588e02b_stop(&gs_handle) != 0) ? 1 : 0;
+        wt588e02b_mock_delay_ms(10);
+    }
+    
+    /* collect the result */
+    (void)wt588e02b_get_stats(&gs_handle, &stats);
+    wt588e02b_mock_get_state(&state);
+    
+    /* check the bank mask stores */
+    bank = a_wt588e02b_gpiomem_bank();
+    
+    /* time the raw edges on the window */
+    t = a_wt588e02b_gpiomem_ns();
+    for (i = 0; i < times; i++)
+    {
+        (void)wt588e02b_interface_sclk_gpio_write((uint8_t)(i & 1));
+    }
+    edge_ns = (a_wt588e02b_gpiomem_ns() - t) * 1000 / ((times != 0) ? times : 1);
+    (void)wt588e02b_deinit(&gs_handle);
+    (void)wire_set_backend(WIRE_BACKEND_GPIOD, NULL);
+    (void)munmap(map, GPIOMEM_BLOCK_SIZE);
+    wt588e02b_interface_debug_print("wt588e02b: %u register stores decoded, %u encoding errors.\n",
+                                    (unsigned int)gs_stores, (unsigned int)gs_bad);
+    wt588e02b_interface_debug_print("wt588e02b: %u frames sent, %u decoded, %u protocol errors, %u call errors.\n",
+                                    (unsigned int)stats.sent, (unsigned int)state.frames,
+                                    (unsigned int)state.errors, (unsigned int)failed);
+    wt588e02b_interface_debug_print("wt588e02b: %u.%03u ns per edge on the window.\n",
+                                    (unsigned int)(edge_ns / 1000), (unsigned int)(edge_ns % 1000));
+    wt588e02b_interface_debug_print("wt588e02b: %u bank mask errors.\n", (unsigned int)bank);
+    if ((gs_bad != 0) || (state.errors != 0) || (failed != 0) || (state.frames != stats.sent) || (bank != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: gpiomem check failed.\n");
+        
+        return 1;
+    }
+    
+    /* finish the test */
+    wt588e02b_interface_debug_print("wt588e02b: finish gpiomem test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,471 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_stress_test.c
+ * @brief     driver wt588e02b stress test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_stress_test.h"
+#include "driver_wt588e02b_mock.h"
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+/**
+ * @brief stress test definition
+ */
+#define WT588E02B_STRESS_MOCK_PLAY_US        15000         /**< mock play response */
+#define WT588E02B_STRESS_MOCK_STOP_US        3000          /**< mock stop response */
+#define WT588E02B_STRESS_MOCK_JITTER_US      2000          /**< mock jitter */
+#define WT588E02B_STRESS_MOCK_CLIP_US        200000        /**< mock clip length */
+
+/**
+ * @brief stress worker structure definition
+ */
+typedef struct wt588e02b_stress_worker_s
+{
+    pthread_t thread;        /**< thread */
+    uint32_t seed;           /**< command seed */
+    uint32_t times;          /**< command number */
+    uint32_t ok;             /**< accepted commands */
+    uint32_t busy;           /**< commands refused because the chip was busy */
+    uint32_t failed;         /**< failed commands */
+} wt588e02b_stress_worker_t;
+
+/**
+ * @brief stress result structure definition
+ */
+typedef struct wt588e02b_stress_result_s
+{
+    uint64_t ns;             /**< wall time */
+    uint32_t calls;          /**< api calls */
+    uint32_t failed;         /**< failed api calls */
+    uint32_t polls;          /**< lock-free busy checks */
+    uint32_t sent;           /**< frames the driver sent */
+    uint32_t frames;         /**< frames the mock decoded */
+    uint32_t errors;         /**< mock protocol errors */
+    uint64_t locks;          /**< lock acquisitions */
+    uint64_t contended;      /**< acquisitions that had to wait */
+    uint64_t wait_ns;        /**< total wait time */
+} wt588e02b_stress_result_t;
+
+static wt588e02b_handle_t gs_handle;                                           /**< wt588e02b handle */
+static wt588e02b_ops_t gs_ops;                                                 /**< mock ops with the stress print and lock */
+static wt588e02b_stress_worker_t gs_worker[WT588E02B_STRESS_TEST_MAX_THREADS]; /**< workers */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;                   /**< handle mutex */
+static pthread_mutex_t gs_done_mutex = PTHREAD_MUTEX_INITIALIZER;              /**< done flag mutex */
+static uint8_t gs_done;                                                        /**< workers finished */
+static uint32_t gs_polls;                                                      /**< busy checks */
+static uint64_t gs_locks;                                                      /**< lock acquisitions */
+static uint64_t gs_contended;                                                  /**< contended acquisitions */
+static uint64_t gs_wait_ns;                                                    /**< total wait time */
+
+/**
+ * @brief  stress clock
+ * @return current time in ns
+ * @note   none
+ */
+static uint64_t a_wt588e02b_stress_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     stress lock
+ * @param[in] wait 1 blocks until the lock is taken, 0 only tries once
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      counts the acquisitions that had to wait and the time spent waiting
+ */
+static uint8_t a_wt588e02b_stress_lock(uint8_t wait)
+{
+    uint64_t t;
+    
+    if (pthread_mutex_trylock(&gs_mutex) == 0)
+    {
+        gs_locks++;
+        
+        return 0;
+    }
+    if (wait == 0)
+    {
+        return 1;
+    }
+    t = a_wt588e02b_stress_ns();
+    if (pthread_mutex_lock(&gs_mutex) != 0)
+    {
+        return 1;
+    }
+    gs_wait_ns += a_wt588e02b_stress_ns() - t;
+    gs_contended++;
+    gs_locks++;
+    
+    return 0;
+}
+
+/**
+ * @brief  stress unlock
+ * @return status code
+ *         - 0 success
+ *         - 1 unlock failed
+ * @note   none
+ */
+static uint8_t a_wt588e02b_stress_unlock(void)
+{
+    if (pthread_mutex_unlock(&gs_mutex) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     stress print
+ * @param[in] fmt format data
+ * @note      the driver reports every busy refusal, keep the workers quiet
+ */
+static void a_wt588e02b_stress_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     stress worker
+ * @param[in] *arg pointer to a worker structure
+ * @return    NULL
+ * @note      sends a random mix of volume, play, play list and stop
+ */
+static void *a_wt588e02b_stress_worker(void *arg)
+{
+    uint8_t res;
+    uint8_t list[2];
+    uint32_t i;
+    wt588e02b_stress_worker_t *worker = (wt588e02b_stress_worker_t *)arg;
+    
+    for (i = 0; i < worker->times; i++)
+    {
+        worker->seed = worker->seed * 1103515245U + 12345U;
+        switch ((worker->seed >> 16) % 4)
+        {
+            case 0 :
+            {
+                res = wt588e02b_set_vol(&gs_handle, (uint8_t)((worker->seed >> 8) % 64));
+                
+                break;
+            }
+            case 1 :
+            {
+                res = wt588e02b_play(&gs_handle, (uint8_t)((worker->seed >> 8) % 8));
+                
+                break;
+            }
+            case 2 :
+            {
+                list[0] = (uint8_t)((worker->seed >> 8) % 8);
+                list[1] = (uint8_t)((worker->seed >> 12) % 8);
+                res = wt588e02b_play_list(&gs_handle, list, 2);
+                if (res == 6)
+                {
+                    res = 5;
+                }
+                
+                break;
+            }
+            default :
+            {
+                res = wt588e02b_stop(&gs_handle);
+                
+                break;
+            }
+        }
+        if (res == 0)
+        {
+            worker->ok++;
+        }
+        else if (res == 5)
+        {
+            worker->busy++;
+        }
+        else
+        {
+            worker->failed++;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     stress poller
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      checks busy without the lock until the workers are done
+ */
+static void *a_wt588e02b_stress_poller(void *arg)
+{
+    uint8_t done;
+    wt588e02b_bool_t enable;
+    
+    (void)arg;
+    do
+    {
+        (void)wt588e02b_check_busy(&gs_handle, &enable);
+        gs_polls++;
+        (void)sched_yield();
+        (void)pthread_mutex_lock(&gs_done_mutex);
+        done = gs_done;
+        (void)pthread_mutex_unlock(&gs_done_mutex);
+    } while (done == 0);
+    
+    return NULL;
+}
+
+/**
+ * @brief      stress run
+ * @param[in]  threads worker thread number
+ * @param[in]  times commands per worker
+ * @param[in]  locked 1 links the lock hooks
+ * @param[out] *result pointer to a result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_wt588e02b_stress_run(uint32_t threads, uint32_t times, uint8_t locked,
+                                      wt588e02b_stress_result_t *result)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t started;
+    uint64_t t;
+    pthread_t poller;
+    wt588e02b_stats_t stats;
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+    
+    /* link the mock */
+    config.play_response_us = WT588E02B_STRESS_MOCK_PLAY_US;
+    config.stop_response_us = WT588E02B_STRESS_MOCK_STOP_US;
+    config.jitter_us = WT588E02B_STRESS_MOCK_JITTER_US;
+    config.clip_us = WT588E02B_STRESS_MOCK_CLIP_US;
+    wt588e02b_mock_init(&config);
+    wt588e02b_mock_link(&gs_handle);
+    gs_ops = *gs_handle.ops;
+    gs_ops.debug_print = a_wt588e02b_stress_print;
+    if (locked != 0)
+    {
+        gs_ops.lock = a_wt588e02b_stress_lock;
+        gs_ops.unlock = a_wt588e02b_stress_unlock;
+    }
+    DRIVER_WT588E02B_LINK_OPS(&gs_handle, &gs_ops);
+    
+    /* init */
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        
+        return 1;
+    }
+    res = wt588e02b_set_shadow(&gs_handle, WT588E02B_BOOL_TRUE);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: set shadow failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_done = 0;
+    gs_polls = 0;
+    gs_locks = 0;
+    gs_contended = 0;
+    gs_wait_ns = 0;
+    for (i = 0; i < threads; i++)
+    {
+        gs_worker[i].seed = i * 7919U + 1U;
+        gs_worker[i].times = times;
+        gs_worker[i].ok = 0;
+        gs_worker[i].busy = 0;
+        gs_worker[i].failed = 0;
+    }
+    
+    /* start the poller and the workers */
+    t = a_wt588e02b_stress_ns();
+    if (pthread_create(&poller, NULL, a_wt588e02b_stress_poller, NULL) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: create thread failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (started = 0; started < threads; started++)
+    {
+        if (pthread_create(&gs_worker[started].thread, NULL, a_wt588e02b_stress_worker, &gs_worker[started]) != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: create thread failed.\n");
+            
+            break;
+        }
+    }
+    for (i = 0; i < started; i++)
+    {
+        (void)pthread_join(gs_worker[i].thread, NULL);
+    }
+    (void)pthread_mutex_lock(&gs_done_mutex);
+    gs_done = 1;
+    (void)pthread_mutex_unlock(&gs_done_mutex);
+    (void)pthread_join(poller, NULL);
+    result->ns = a_wt588e02b_stress_ns() - t;
+    if (started != threads)
+    {
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* collect the result */
+    (void)wt588e02b_get_stats(&gs_handle, &stats);
+    wt588e02b_mock_get_state(&state);
+    result->calls = threads * times;
+    result->failed = 0;
+    for (i = 0; i < threads; i++)
+    {
+        result->failed += gs_worker[i].failed;
+    }
+    result->polls = gs_polls;
+    result->sent = stats.sent;
+    result->frames = state.frames;
+    result->errors = state.errors;
+    result->locks = gs_locks;
+    result->contended = gs_contended;
+    result->wait_ns = gs_wait_ns;
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     stress test
+ * @param[in] threads worker thread number
+ * @param[in] times commands per worker
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs on the mock chip, the workers share one handle and a poller checks busy without the lock,
+ *            a run without the lock shows that the mock catches interleaved frames,
+ *            the locked run must keep every frame intact and reports the lock contention
+ */
+uint8_t wt588e02b_stress_test(uint32_t threads, uint32_t times)
+{
+    uint8_t res;
+    wt588e02b_stress_result_t single;
+    wt588e02b_stress_result_t single_locked;
+    wt588e02b_stress_result_t unlocked;
+    wt588e02b_stress_result_t locked;
+    
+    /* check params */
+    if ((threads == 0) || (threads > WT588E02B_STRESS_TEST_MAX_THREADS) || (times == 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: threads or times is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* start stress test */
+    wt588e02b_interface_debug_print("wt588e02b: start stress test.\n");
+    wt588e02b_interface_debug_print("wt588e02b: %u threads x %u commands on the mock chip.\n",
+                                    (unsigned int)threads, (unsigned int)times);
+    
+    /* uncontended lock cost */
+    res = a_wt588e02b_stress_run(1, times * threads, 0, &single);
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = a_wt588e02b_stress_run(1, times * threads, 1, &single_locked);
+    if (res != 0)
+    {
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: one thread %u ns per call, %u ns with the lock.\n",
+                                    (unsigned int)(single.ns / single.calls),
+                                    (unsigned int)(single_locked.ns / single_locked.calls));
+    
+    /* control run without the lock */
+    res = a_wt588e02b_stress_run(threads, times, 0, &unlocked);
+    if (res != 0)
+    {
+        return 1;
+    }
+    if ((unlocked.errors != 0) || (unlocked.frames != unlocked.sent))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: without the lock the mock caught %u protocol errors, %u of %u frames arrived.\n",
+                                        (unsigned int)unlocked.errors, (unsigned int)unlocked.frames, (unsigned int)unlocked.sent);
+    }
+    else
+    {
+        wt588e02b_interface_debug_print("wt588e02b: without the lock no interleaving was seen in this run.\n");
+    }
+    
+    /* locked run */
+    res = a_wt588e02b_stress_run(threads, times, 1, &locked);
+    if (res != 0)
+    {
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: with the lock %u frames sent, %u decoded, %u protocol errors, %u call errors.\n",
+                                    (unsigned int)locked.sent, (unsigned int)locked.frames,
+                                    (unsigned int)locked.errors, (unsigned int)locked.failed);
+    wt588e02b_interface_debug_print("wt588e02b: %u of %u lock acquisitions waited, mean wait %u us, %u lock-free busy checks.\n",
+                                    (unsigned int)locked.contended, (unsigned int)locked.locks,
+                                    (unsigned int)((locked.contended != 0) ? (locked.wait_ns / locked.contended / 1000) : 0),
+                                    (unsigned int)locked.polls);
+    wt588e02b_interface_debug_print("wt588e02b: %u ns per call over %u threads.\n",
+                                    (unsigned int)(locked.ns / locked.calls), (unsigned int)threads);
+    if ((locked.errors != 0) || (locked.failed != 0) || (locked.frames != locked.sent))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: stress check failed.\n");
+        
+        return 1;
+    }
+    
+    /* finish stress test */
+    wt588e02b_interface_debug_print("wt588e02b: finish stress test.\n");
+    
+    return 0;
+}
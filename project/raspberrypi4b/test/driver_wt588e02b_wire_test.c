@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_wire_test.c
+ * @brief     driver wt588e02b wire test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_wire_test.h"
+#include "wire.h"
+#include <gpiod.h>
+#include <time.h>
+
+/**
+ * @brief wire test definition
+ */
+#define WIRE_TEST_DEVICE_NAME    "/dev/gpiochip0"        /**< gpio device name */
+#define WIRE_TEST_MISO_LINE      9                       /**< miso line */
+#define WIRE_TEST_CLOCK_LINE     11                      /**< clock line */
+
+/**
+ * @brief  wire test clock
+ * @return current time in ns
+ * @note   none
+ */
+static uint64_t a_wt588e02b_wire_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief      wire test legacy backend
+ * @param[in]  times edges per measurement
+ * @param[out] *edge_ns pointer to an edge cost buffer
+ * @param[out] *flip_ns pointer to a read with direction flip cost buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       replays the old backend, one request per line and a release and
+ *             re-request whenever the miso line changes direction
+ */
+static uint8_t a_wt588e02b_wire_legacy(uint32_t times, uint64_t *edge_ns, uint64_t *flip_ns)
+{
+    uint32_t i;
+    uint64_t t;
+    struct gpiod_chip *chip;
+    struct gpiod_line *clock;
+    struct gpiod_line *miso;
+    
+    /* open the gpio group */
+    chip = gpiod_chip_open(WIRE_TEST_DEVICE_NAME);
+    if (chip == NULL)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: open gpio failed.\n");
+        
+        return 1;
+    }
+    clock = gpiod_chip_get_line(chip, WIRE_TEST_CLOCK_LINE);
+    miso = gpiod_chip_get_line(chip, WIRE_TEST_MISO_LINE);
+    if ((clock == NULL) || (miso == NULL) ||
+        (gpiod_line_request_output(clock, "gpio_output", 1) != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: request line failed.\n");
+        gpiod_chip_close(chip);
+        
+        return 1;
+    }
+    
+    /* clock edges on a single line request */
+    t = a_wt588e02b_wire_ns();
+    for (i = 0; i < times; i++)
+    {
+        (void)gpiod_line_set_value(clock, (int)(i & 1));
+    }
+    *edge_ns = (a_wt588e02b_wire_ns() - t) / times;
+    
+    /* reads that flip the miso direction every time */
+    t = a_wt588e02b_wire_ns();
+    for (i = 0; i < times; i++)
+    {
+        if (gpiod_line_is_requested(miso) != 0)
+        {
+            gpiod_line_release(miso);
+        }
+        if (gpiod_line_request_output(miso, "gpio_output", 1) != 0)
+        {
+            break;
+        }
+        gpiod_line_release(miso);
+        if (gpiod_line_request_input(miso, "gpio_input") != 0)
+        {
+            break;
+        }
+        (void)gpiod_line_get_value(miso);
+    }
+    *flip_ns = (a_wt588e02b_wire_ns() - t) / times;
+    
+    /* close the chip */
+    gpiod_chip_close(chip);
+    if (i != times)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: request line failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     wire test
+ * @param[in] times edges per measurement
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      measures the per-edge and per-read cost of the old per-line requests with a
+ *            release and re-request on every direction flip against the persistent wire backend,
+ *            it needs the real gpio and the chip can stay unconnected
+ */
+uint8_t wt588e02b_wire_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t value;
+    uint32_t i;
+    uint64_t t;
+    uint64_t legacy_edge_ns;
+    uint64_t legacy_flip_ns;
+    uint64_t edge_ns;
+    uint64_t read_ns;
+    
+    /* start the test */
+    wt588e02b_interface_debug_print("wt588e02b: start wire test.\n");
+    if (times == 0)
+    {
+        times = 1;
+    }
+    
+    /* measure the legacy backend */
+    if (a_wt588e02b_wire_legacy(times, &legacy_edge_ns, &legacy_flip_ns) != 0)
+    {
+        return 1;
+    }
+    
+    /* open every line once */
+    if ((wire_clock_init() != 0) || (wire_init() != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: wire init failed.\n");
+        (void)wire_clock_deinit();
+        
+        return 1;
+    }
+    
+    /* clock edges on the bulk request */
+    res = 0;
+    t = a_wt588e02b_wire_ns();
+    for (i = 0; i < times; i++)
+    {
+        res |= wire_clock_write((uint8_t)(i & 1));
+    }
+    edge_ns = (a_wt588e02b_wire_ns() - t) / times;
+    
+    /* reads on the input line */
+    t = a_wt588e02b_wire_ns();
+    for (i = 0; i < times; i++)
+    {
+        res |= wire_read(&value);
+    }
+    read_ns = (a_wt588e02b_wire_ns() - t) / times;
+    
+    /* close the lines */
+    (void)wire_deinit();
+    (void)wire_clock_deinit();
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: wire access failed.\n");
+        
+        return 1;
+    }
+    
+    /* report */
+    wt588e02b_interface_debug_print("wt588e02b: %d edges per measurement.\n", times);
+    wt588e02b_interface_debug_print("wt588e02b: before %d ns per edge, %d ns per read with a direction flip.\n",
+                                    (uint32_t)legacy_edge_ns, (uint32_t)legacy_flip_ns);
+    wt588e02b_interface_debug_print("wt588e02b: after %d ns per edge, %d ns per read.\n",
+                                    (uint32_t)edge_ns, (uint32_t)read_ns);
+    
+    /* finish the test */
+    wt588e02b_interface_debug_print("wt588e02b: finish wire test.\n");
+    
+    return 0;
+}
@@ -36,16 +36,23 @@
 
 #include "driver_wt588e02b_interface.h"
 #include "delay.h"
-#include "ff.h"
+#include "binfile.h"
+#include "stream.h"
 #include "wire.h"
+#include "wave.h"
 #include "uart.h"
 #include <stdarg.h>
+#include <string.h>
 
 /**
- * @brief fs var definition
+ * @brief bin source definition
  */
-FATFS g_fs;        /**< fatfs handle */
-FIL g_file;        /**< fs handle */
+#define BIN_STREAM_PREFIX        "uart:"        /**< path prefix of the uart stream */
+
+/**
+ * @brief bin source var definition
+ */
+static uint8_t gs_bin_stream;        /**< 1 if the bin is streamed over the uart */
 
 /**
  * @brief  interface sclk gpio init
@@ -56,7 +63,12 @@ FIL g_file;        /**< fs handle */
  */
 uint8_t wt588e02b_interface_sclk_gpio_init(void)
 {
-    return wire_clock_init();
+    if (wire_clock_init() != 0)
+    {
+        return 1;
+    }
+    
+    return wave_init();
 }
 
 /**
@@ -68,6 +80,8 @@ uint8_t wt588e02b_interface_sclk_gpio_init(void)
  */
 uint8_t wt588e02b_interface_sclk_gpio_deinit(void)
 {
+    (void)wave_deinit();
+    
     return wire_clock_deinit();
 }
 
@@ -222,25 +236,20 @@ void wt588e02b_interface_delay_us(uint32_t us)
  * @return     status code
  *             - 0 success
  *             - 1 bin read init failed
- * @note       none
+ * @note       a name starting with "uart:" streams the bin from the host over the shell uart,
+ *             otherwise the volume stays mounted across updates and a cluster link map table is built for the file
  */
 uint8_t wt588e02b_interface_bin_read_init(char *name, uint32_t *size)
 {
-    FRESULT res;
-    
-    res = f_mount(&g_fs, "0:", 1);
-    if (res != FR_OK)
+    if (strncmp(name, BIN_STREAM_PREFIX, strlen(BIN_STREAM_PREFIX)) == 0)
     {
-        return 1;
+        gs_bin_stream = 1;
+        
+        return stream_open(size);
     }
-    res = f_open(&g_file, name, FA_READ);
-    if (res != FR_OK)
-    {
-        return 1;
-    }
-    *size = f_size(&g_file);
+    gs_bin_stream = 0;
     
-    return 0;
+    return binfile_open(name, size);
 }
 
 /**
@@ -251,25 +260,16 @@ uint8_t wt588e02b_interface_bin_read_init(char *name, uint32_t *size)
  * @return     status code
  *             - 0 success
  *             - 1 bin read failed
- * @note       none
+ * @note       reads are served from a prefetch buffer filled by multi block reads or from the uart stream
  */
 uint8_t wt588e02b_interface_bin_read(uint32_t addr, uint16_t size, uint8_t *buffer)
 {
-    FRESULT res;
-    UINT bw;
-    
-    res = f_lseek(&g_file, addr);
-    if (res != FR_OK)
+    if (gs_bin_stream != 0)
     {
-        return 1;
-    }
-    res = f_read(&g_file, buffer, size, &bw);
-    if (res != FR_OK)
-    {
-        return 1;
+        return stream_read(addr, size, buffer);
     }
     
-    return 0;
+    return binfile_read(addr, size, buffer);
 }
 
 /**
@@ -277,26 +277,101 @@ uint8_t wt588e02b_interface_bin_read(uint32_t addr, uint16_t size, uint8_t *buff
  * @return status code
  *         - 0 success
  *         - 1 bin read deinit failed
- * @note   none
+ * @note   the volume stays mounted
  */
 uint8_t wt588e02b_interface_bin_read_deinit(void)
 {
-    FRESULT res;
-    
-    res = f_close(&g_file);
-    if (res != FR_OK)
+    if (gs_bin_stream != 0)
     {
-        return 1;
-    }
-    res = f_unmount("0:");
-    if (res != FR_OK)
-    {
-        return 1;
+        gs_bin_stream = 0;
+        
+        return stream_close();
     }
     
+    return binfile_close();
+}
+
+/**
+ * @brief  interface timestamp ms
+ * @return current time in ms
+ * @note   used by the duration profiler, it may wrap around
+ */
+uint32_t wt588e02b_interface_timestamp_ms(void)
+{
+    return HAL_GetTick();
+}
+
+/**
+ * @brief     interface lock
+ * @param[in] wait 1 blocks until the lock is taken, 0 only tries once
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      the firmware drives the chip from one context, so nothing is locked
+ */
+uint8_t wt588e02b_interface_lock(uint8_t wait)
+{
+    (void)wait;
+    
     return 0;
 }
 
+/**
+ * @brief  interface unlock
+ * @return status code
+ *         - 0 success
+ *         - 1 unlock failed
+ * @note   none
+ */
+uint8_t wt588e02b_interface_unlock(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface frame transfer
+ * @param[in]  *tx pointer to the bytes to clock out
+ * @param[out] *rx pointer to a sampled byte buffer, NULL skips the miso sampling
+ * @param[in]  len byte number
+ * @param[in]  us half period of the clock in us
+ * @param[in]  gap_us idle time before every byte in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame transfer failed
+ * @note       tim1 and dma2 clock the frame while the cpu sleeps
+ */
+uint8_t wt588e02b_interface_frame_transfer(uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t us, uint32_t gap_us)
+{
+    return wave_transfer(tx, rx, len, us, gap_us);
+}
+
+/**
+ * @brief     interface cs gpio write of several chips
+ * @param[in] mask chip mask
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      chip 0 - 3 use the cs PE0 - PE3, they change with one BSRR store
+ */
+uint8_t wt588e02b_interface_cs_gpio_write_mask(uint32_t mask, uint8_t data)
+{
+    return wire_bank_cs_write(mask, data);
+}
+
+/**
+ * @brief      interface miso gpio read of several chips
+ * @param[out] *data pointer to a level mask buffer, one bit per chip
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       chip 0 - 3 use the miso PE8 - PE11, they are sampled with one IDR load
+ */
+uint8_t wt588e02b_interface_miso_gpio_read_mask(uint32_t *data)
+{
+    return wire_bank_read(data);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
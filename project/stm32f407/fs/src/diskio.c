@@ -193,21 +193,21 @@ DRESULT disk_ioctl (
                 }
                 case GET_SECTOR_SIZE :
                 {
-                    *(DWORD*)buff = 512; 
+                    *(WORD*)buff = 512; 
                     stat = RES_OK;
                     
                     break; 
                 }
                 case GET_BLOCK_SIZE :
                 {
-                    *(WORD*)buff = sdio_get_card_info()->LogBlockSize;
+                    *(DWORD*)buff = sdio_get_card_info()->LogBlockSize;
                     stat = RES_OK;
                     
                     break;
                 }                    
                 case GET_SECTOR_COUNT:
                 {
-                    *(DWORD*)buff = sdio_get_card_info()->LogBlockNbr;
+                    *(LBA_t*)buff = sdio_get_card_info()->LogBlockNbr;
                     stat = RES_OK;
                     
                     break;
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      binfile.h
+ * @brief     binfile header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef BINFILE_H
+#define BINFILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup binfile binfile function
+ * @brief    binfile function modules
+ * @{
+ */
+
+/**
+ * @brief binfile size definition
+ */
+#define BINFILE_PREFETCH_SIZE        (16 * 512)        /**< 16 sectors, one multi block read */
+#define BINFILE_CLMT_SIZE            64                /**< link map table items, 31 fragments */
+
+/**
+ * @brief binfile info structure definition
+ */
+typedef struct binfile_info_s
+{
+    uint8_t fast_seek;         /**< 1 if the link map table was built */
+    uint32_t fragments;        /**< file fragments */
+    uint32_t mounts;           /**< volume mounts */
+    uint32_t refills;          /**< prefetch refills */
+    uint32_t hits;             /**< prefetch hits */
+} binfile_info_t;
+
+/**
+ * @brief      binfile open
+ * @param[in]  *name pointer to a name buffer
+ * @param[out] *size pointer to a file size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       the volume is mounted on the first open and stays mounted,
+ *             a failed open remounts the volume once and retries
+ */
+uint8_t binfile_open(char *name, uint32_t *size);
+
+/**
+ * @brief      binfile read
+ * @param[in]  addr file address
+ * @param[in]  size read size
+ * @param[out] *buf pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       reads are served from a sector aligned prefetch buffer, a miss refills the whole
+ *             buffer with one f_read which fatfs turns into one multi block disk read,
+ *             reads larger than half of the prefetch buffer go directly into buf
+ */
+uint8_t binfile_read(uint32_t addr, uint16_t size, uint8_t *buf);
+
+/**
+ * @brief  binfile close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   the volume stays mounted
+ */
+uint8_t binfile_close(void);
+
+/**
+ * @brief  binfile unmount
+ * @return status code
+ *         - 0 success
+ *         - 1 unmount failed
+ * @note   none
+ */
+uint8_t binfile_unmount(void);
+
+/**
+ * @brief      binfile get the info
+ * @param[out] *info pointer to an info structure
+ * @note       none
+ */
+void binfile_get_info(binfile_info_t *info);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
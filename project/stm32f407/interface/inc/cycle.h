@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      cycle.h
+ * @brief     cycle header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef CYCLE_H
+#define CYCLE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup cycle cycle function
+ * @brief    cycle counter arithmetic modules
+ * @{
+ */
+
+/**
+ * @brief cycle definition
+ */
+#define CYCLE_MAX_WAIT        0x7FFFFFFFUL        /**< longest wait one compare can time */
+
+/**
+ * @brief     cycle get the elapsed cycles
+ * @param[in] start counter at the start
+ * @param[in] now counter now
+ * @return    elapsed cycles
+ * @note      the unsigned difference is right across one counter wrap
+ */
+static inline uint32_t cycle_elapsed(uint32_t start, uint32_t now)
+{
+    return now - start;
+}
+
+/**
+ * @brief     cycle check the wait is over
+ * @param[in] start counter at the start
+ * @param[in] now counter now
+ * @param[in] cycles wait cycles
+ * @return    1 if expired, 0 if not
+ * @note      cycles must not be larger than CYCLE_MAX_WAIT
+ */
+static inline uint8_t cycle_expired(uint32_t start, uint32_t now, uint32_t cycles)
+{
+    return (uint8_t)(cycle_elapsed(start, now) >= cycles);
+}
+
+/**
+ * @brief     cycle convert us to the wait cycles
+ * @param[in] us time in us
+ * @param[in] fac cycles per us
+ * @param[in] offset calibrated call overhead in cycles
+ * @return    wait cycles
+ * @note      the overhead is taken off and the result is clamped to 0 and CYCLE_MAX_WAIT
+ */
+static inline uint32_t cycle_from_us(uint32_t us, uint32_t fac, uint32_t offset)
+{
+    uint64_t cycles;
+    
+    cycles = (uint64_t)us * fac;
+    if (cycles <= offset)
+    {
+        return 0;
+    }
+    cycles -= offset;
+    if (cycles > CYCLE_MAX_WAIT)
+    {
+        return CYCLE_MAX_WAIT;
+    }
+    
+    return (uint32_t)cycles;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -49,14 +49,34 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief delay backend definition
+ * @note  1 waits on the dwt cycle counter, 0 polls the systick counter
+ */
+#ifndef DELAY_USE_DWT
+    #define DELAY_USE_DWT        1
+#endif
+
+/**
+ * @brief delay dwt definition
+ */
+#define DELAY_DWT_CHUNK_US        1000000        /**< longest single dwt wait in us */
+
 /**
  * @brief  delay clock init
  * @return status code
  *         - 0 success
- * @note   none
+ * @note   it starts the dwt cycle counter and calibrates the call overhead
  */
 uint8_t delay_init(void);
 
+/**
+ * @brief  delay get the calibrated call overhead
+ * @return overhead in cycles
+ * @note   0 with the systick backend
+ */
+uint32_t delay_get_offset(void);
+
 /**
  * @brief     delay us
  * @param[in] us time
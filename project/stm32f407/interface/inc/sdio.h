@@ -55,8 +55,9 @@
  *         - 0 success
  *         - 1 init failed
  *         - 2 get card information failed
- *         - 3 set 4 wire bus failed
- * @note   none
+ *         - 3 set 1 wire bus failed
+ * @note   the 4 wire bus is used when the card supports it, otherwise the 1 wire bus is kept,
+ *         the clock is raised to 48MHz when the card accepts the high speed switch
  */
 uint8_t sdio_init(void);
 
@@ -78,7 +79,7 @@ uint8_t sdio_deinit(void);
  *            - 0 success
  *            - 1 write failed
  *            - 2 write timeout
- * @note      none
+ * @note      a buffer which is not word aligned is written sector by sector through a bounce buffer
  */
 uint8_t sdio_write(uint32_t sector, uint8_t *buf, uint32_t cnt);
 
@@ -91,10 +92,19 @@ uint8_t sdio_write(uint32_t sector, uint8_t *buf, uint32_t cnt);
  *             - 0 success
  *             - 1 read failed
  *             - 2 read timeout
- * @note       none
+ * @note       cnt sectors are read with one multi block dma transaction,
+ *             a buffer which is not word aligned is read sector by sector through a bounce buffer
  */
 uint8_t sdio_read(uint32_t sector, uint8_t *buf, uint32_t cnt);
 
+/**
+ * @brief      sdio get the bus config
+ * @param[out] *width pointer to a bus width buffer
+ * @param[out] *clock_khz pointer to a bus clock buffer
+ * @note       none
+ */
+void sdio_get_bus(uint8_t *width, uint32_t *clock_khz);
+
 /**
  * @brief  sdio get sd handle
  * @return pointer to a sd handle
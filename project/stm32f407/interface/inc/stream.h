@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      stream.h
+ * @brief     stream header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup stream stream function
+ * @brief    uart image stream modules
+ * @{
+ */
+
+/**
+ * @brief stream size definition
+ */
+#define STREAM_RING_SIZE          2048        /**< dma ring size, holds more than two frames */
+#define STREAM_CHUNK_SIZE         512         /**< max payload, one update packet */
+#define STREAM_TIMEOUT_MS         1000        /**< frame timeout before the request is repeated */
+#define STREAM_RETRY              8           /**< max repeated requests of one frame */
+
+/**
+ * @brief stream frame definition
+ * @note  host frame:   0x5A, type, seq(le16), len(le16), payload, crc16(le16) over type..payload
+ *        device reply: 0xA5, code, seq(le16)
+ *        seq 0 is the size frame with a le32 image size, seq n is the data frame of bytes (n - 1) * 512 ...
+ */
+#define STREAM_SYNC_FRAME         0x5A        /**< host frame sync */
+#define STREAM_SYNC_REPLY         0xA5        /**< device reply sync */
+#define STREAM_HEAD_SIZE          6           /**< frame head size */
+#define STREAM_TYPE_SIZE          0x01        /**< size frame */
+#define STREAM_TYPE_DATA          0x02        /**< data frame */
+#define STREAM_TYPE_ABORT         0x03        /**< abort frame */
+#define STREAM_REPLY_REQUEST      'R'         /**< request the frame seq */
+#define STREAM_REPLY_DONE         'D'         /**< all frames consumed */
+#define STREAM_REPLY_ERROR        'E'         /**< stream aborted */
+
+/**
+ * @brief stream stats structure definition
+ */
+typedef struct stream_stats_s
+{
+    uint32_t bytes;             /**< received payload bytes */
+    uint32_t frames;            /**< accepted data frames */
+    uint32_t retries;           /**< repeated requests */
+    uint32_t crc_errors;        /**< crc errors */
+    uint32_t ms;                /**< open to close time in ms */
+} stream_stats_t;
+
+/**
+ * @brief     stream crc16
+ * @param[in] crc crc of the previous data, 0xFFFF at the start
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc16
+ * @note      crc16 ccitt, poly 0x1021, msb first
+ */
+static inline uint16_t stream_crc16(uint16_t crc, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint8_t j;
+    
+    for (i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)buf[i] << 8;
+        for (j = 0; j < 8; j++)
+        {
+            crc = ((crc & 0x8000) != 0) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    
+    return crc;
+}
+
+/**
+ * @brief      stream open
+ * @param[out] *size pointer to an image size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       the receiving is switched to the circular dma ring and the size frame is requested
+ */
+uint8_t stream_open(uint32_t *size);
+
+/**
+ * @brief      stream read
+ * @param[in]  addr image address
+ * @param[in]  size read size
+ * @param[out] *buf pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       reads must be sequential, the next frame is requested as soon as one is accepted
+ *             so that it is received while the caller programs the chip
+ */
+uint8_t stream_read(uint32_t addr, uint16_t size, uint8_t *buf);
+
+/**
+ * @brief  stream close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   the host gets done when all frames were consumed, otherwise error
+ */
+uint8_t stream_close(void);
+
+/**
+ * @brief      stream get the stats
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void stream_get_stats(stream_stats_t *stats);
+
+/**
+ * @brief     stream port open
+ * @param[in] *ring pointer to a ring buffer
+ * @param[in] len ring length
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      implemented by the platform, the port fills the ring circularly
+ */
+uint8_t stream_port_open(uint8_t *ring, uint16_t len);
+
+/**
+ * @brief  stream port get the ring write position
+ * @return write position
+ * @note   implemented by the platform
+ */
+uint16_t stream_port_position(void);
+
+/**
+ * @brief     stream port write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      implemented by the platform
+ */
+uint8_t stream_port_write(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  stream port close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   implemented by the platform
+ */
+uint8_t stream_port_close(void);
+
+/**
+ * @brief  stream port get the time
+ * @return time in ms
+ * @note   implemented by the platform
+ */
+uint32_t stream_port_ms(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -129,6 +129,34 @@ void uart_set_tx_done(void);
  */
 void uart_irq_handler(void);
 
+/**
+ * @brief     uart start the circular dma receiving
+ * @param[in] *buf pointer to a ring buffer
+ * @param[in] len ring buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the interrupt receiving is stopped, the shell buffer gets nothing until the dma receiving is stopped,
+ *            dma2 stream2 channel 4 is used
+ */
+uint8_t uart_rx_dma_start(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  uart get the circular dma write position
+ * @return write position in the ring buffer
+ * @note   none
+ */
+uint16_t uart_rx_dma_position(void);
+
+/**
+ * @brief  uart stop the circular dma receiving
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   the interrupt receiving is restarted with an empty shell buffer
+ */
+uint8_t uart_rx_dma_stop(void);
+
 /**
  * @brief     uart2 init with 8 data bits, 1 stop bit and no parity
  * @param[in] baud baud rate
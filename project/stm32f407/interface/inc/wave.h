@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      wave.h
+ * @brief     wave header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef WAVE_H
+#define WAVE_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup wave wave function
+ * @brief    wave function modules
+ * @{
+ */
+
+/**
+ * @brief wave chunk definition
+ */
+#define WAVE_CHUNK_BYTES        8         /**< bytes rendered per half buffer */
+#define WAVE_GAP_MAX            16        /**< max idle slots before a byte */
+#define WAVE_MIN_TICKS          64        /**< min timer ticks per slot */
+
+/**
+ * @brief wave mode enumeration definition
+ */
+typedef enum
+{
+    WAVE_MODE_GPIO = 0x00,        /**< the cpu clocks every bit */
+    WAVE_MODE_DMA  = 0x01,        /**< tim1 and dma2 clock the rendered words */
+} wave_mode_t;
+
+/**
+ * @brief wave stats structure definition
+ */
+typedef struct wave_stats_s
+{
+    uint32_t frames;              /**< transferred frames */
+    uint32_t fallbacks;           /**< dma frames clocked by the cpu */
+    uint64_t busy_cycles;         /**< cpu cycles spent on the frames */
+    uint32_t busy_max;            /**< max cpu cycles of one frame */
+    uint64_t wire_cycles;         /**< core cycles the frames took on the wire */
+} wave_stats_t;
+
+/**
+ * @brief  wave init
+ * @return status code
+ *         - 0 success
+ * @note   SCLK is PA0, MOSI is PA1 and MISO is PA8, tim1 update drives dma2 stream5 into GPIOA->BSRR
+ *         and tim1 cc1 drives dma2 stream1 from GPIOA->IDR, the gpio is set up by the wire functions
+ */
+uint8_t wave_init(void);
+
+/**
+ * @brief  wave deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wave_deinit(void);
+
+/**
+ * @brief     wave set the mode
+ * @param[in] mode wave mode
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wave_set_mode(wave_mode_t mode);
+
+/**
+ * @brief      wave transfer a frame
+ * @param[in]  *tx pointer to the bytes to clock out
+ * @param[out] *rx pointer to a sampled byte buffer, NULL skips the miso sampling
+ * @param[in]  len byte number
+ * @param[in]  us half period of the clock in us
+ * @param[in]  gap_us idle time before every byte in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 transfer failed
+ * @note       a frame the timer can not pace falls back to the cpu
+ */
+uint8_t wave_transfer(uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t us, uint32_t gap_us);
+
+/**
+ * @brief      wave get the stats
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void wave_get_stats(wave_stats_t *stats);
+
+/**
+ * @brief wave clear the stats
+ * @note  none
+ */
+void wave_clear_stats(void);
+
+/**
+ * @brief wave irq handler
+ * @note  call it in DMA2_Stream1_IRQHandler
+ */
+void wave_irq_handler(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
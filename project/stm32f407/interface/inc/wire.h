@@ -158,6 +158,35 @@ uint8_t wire_cs_deinit(void);
  */
 uint8_t wire_cs_write(uint8_t value);
 
+/**
+ * @brief  wire bank deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_bank_deinit(void);
+
+/**
+ * @brief     wire bank write the cs lines
+ * @param[in] mask chip mask
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ * @note      the bank drives up to 4 chips on the shared PA0 clock and PA1 data lines,
+ *            chip 0 - 3 use the cs PE0 - PE3 and the miso PE8 - PE11, the first bank call sets them up,
+ *            every cs in the mask changes with one BSRR store
+ */
+uint8_t wire_bank_cs_write(uint32_t mask, uint8_t value);
+
+/**
+ * @brief      wire bank read the miso lines
+ * @param[out] *value pointer to a level mask buffer, one bit per chip
+ * @return     status code
+ *             - 0 success
+ * @note       every miso is sampled with one IDR load
+ */
+uint8_t wire_bank_read(uint32_t *value);
+
 /**
  * @}
  */
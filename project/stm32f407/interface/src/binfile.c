@@ -0,0 +1,249 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      binfile.c
+ * @brief     binfile source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "binfile.h"
+#include "ff.h"
+#include <string.h>
+
+/**
+ * @brief binfile var definition
+ */
+static FATFS gs_fs;                                          /**< fatfs handle */
+static FIL gs_file;                                          /**< fs handle */
+static DWORD gs_clmt[BINFILE_CLMT_SIZE];                     /**< cluster link map table */
+static uint32_t gs_prefetch[BINFILE_PREFETCH_SIZE / 4];      /**< word aligned prefetch buffer */
+static uint32_t gs_prefetch_addr;                            /**< prefetch file address */
+static uint32_t gs_prefetch_len;                             /**< prefetch valid length */
+static uint8_t gs_mounted;                                   /**< mounted flag */
+static binfile_info_t gs_info;                               /**< binfile info */
+
+/**
+ * @brief  binfile mount the volume
+ * @return status code
+ *         - 0 success
+ *         - 1 mount failed
+ * @note   none
+ */
+static uint8_t a_binfile_mount(void)
+{
+    if (gs_mounted != 0)
+    {
+        return 0;
+    }
+    if (f_mount(&gs_fs, "0:", 1) != FR_OK)
+    {
+        return 1;
+    }
+    gs_mounted = 1;
+    gs_info.mounts++;
+    
+    return 0;
+}
+
+/**
+ * @brief      binfile open
+ * @param[in]  *name pointer to a name buffer
+ * @param[out] *size pointer to a file size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       the volume is mounted on the first open and stays mounted,
+ *             a failed open remounts the volume once and retries
+ */
+uint8_t binfile_open(char *name, uint32_t *size)
+{
+    FRESULT res;
+    
+    /* mount once */
+    if (a_binfile_mount() != 0)
+    {
+        return 1;
+    }
+    
+    /* open the file */
+    res = f_open(&gs_file, name, FA_READ);
+    if (res != FR_OK)
+    {
+        /* the card may have been changed, remount and retry */
+        (void)binfile_unmount();
+        if (a_binfile_mount() != 0)
+        {
+            return 1;
+        }
+        res = f_open(&gs_file, name, FA_READ);
+        if (res != FR_OK)
+        {
+            return 1;
+        }
+    }
+    *size = f_size(&gs_file);
+    
+    /* build the cluster link map table, plain seeks are used if it is too small */
+    gs_clmt[0] = BINFILE_CLMT_SIZE;
+    gs_file.cltbl = gs_clmt;
+    res = f_lseek(&gs_file, CREATE_LINKMAP);
+    if (res != FR_OK)
+    {
+        gs_file.cltbl = NULL;
+    }
+    gs_info.fast_seek = (res == FR_OK) ? 1 : 0;
+    gs_info.fragments = (gs_clmt[0] - 1) / 2;
+    
+    /* invalidate the prefetch buffer */
+    gs_prefetch_addr = 0;
+    gs_prefetch_len = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      binfile read
+ * @param[in]  addr file address
+ * @param[in]  size read size
+ * @param[out] *buf pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       reads are served from a sector aligned prefetch buffer, a miss refills the whole
+ *             buffer with one f_read which fatfs turns into one multi block disk read,
+ *             reads larger than half of the prefetch buffer go directly into buf
+ */
+uint8_t binfile_read(uint32_t addr, uint16_t size, uint8_t *buf)
+{
+    UINT bw;
+    
+    /* large read, read directly */
+    if (size > BINFILE_PREFETCH_SIZE / 2)
+    {
+        if (f_lseek(&gs_file, addr) != FR_OK)
+        {
+            return 1;
+        }
+        if (f_read(&gs_file, buf, size, &bw) != FR_OK)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    /* refill the prefetch buffer on a miss */
+    if ((addr < gs_prefetch_addr) || (addr + size > gs_prefetch_addr + gs_prefetch_len))
+    {
+        gs_prefetch_addr = addr & ~(uint32_t)(512 - 1);
+        gs_prefetch_len = 0;
+        if (f_lseek(&gs_file, gs_prefetch_addr) != FR_OK)
+        {
+            return 1;
+        }
+        if (f_read(&gs_file, gs_prefetch, BINFILE_PREFETCH_SIZE, &bw) != FR_OK)
+        {
+            return 1;
+        }
+        gs_prefetch_len = bw;
+        gs_info.refills++;
+    }
+    else
+    {
+        gs_info.hits++;
+    }
+    
+    /* clip at the end of file */
+    if (addr >= gs_prefetch_addr + gs_prefetch_len)
+    {
+        return 0;
+    }
+    if (addr + size > gs_prefetch_addr + gs_prefetch_len)
+    {
+        size = (uint16_t)(gs_prefetch_addr + gs_prefetch_len - addr);
+    }
+    
+    /* copy from the prefetch buffer */
+    memcpy(buf, (uint8_t *)gs_prefetch + (addr - gs_prefetch_addr), size);
+    
+    return 0;
+}
+
+/**
+ * @brief  binfile close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   the volume stays mounted
+ */
+uint8_t binfile_close(void)
+{
+    gs_prefetch_len = 0;
+    if (f_close(&gs_file) != FR_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  binfile unmount
+ * @return status code
+ *         - 0 success
+ *         - 1 unmount failed
+ * @note   none
+ */
+uint8_t binfile_unmount(void)
+{
+    if (gs_mounted == 0)
+    {
+        return 0;
+    }
+    gs_mounted = 0;
+    if (f_unmount("0:") != FR_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      binfile get the info
+ * @param[out] *info pointer to an info structure
+ * @note       none
+ */
+void binfile_get_info(binfile_info_t *info)
+{
+    *info = gs_info;
+}
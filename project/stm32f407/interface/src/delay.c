@@ -35,8 +35,76 @@
  */
 
 #include "delay.h"
+#include "cycle.h"
 
 static volatile uint32_t gs_fac_us = 0;        /**< fac cnt */
+static volatile uint32_t gs_offset = 0;        /**< call overhead in cycles */
+
+#if (DELAY_USE_DWT == 1)
+
+/**
+ * @brief     delay dwt wait
+ * @param[in] start cycle counter at the call
+ * @param[in] us time
+ * @note      none
+ */
+static void a_delay_dwt_wait(uint32_t start, uint32_t us)
+{
+    uint32_t cycles;
+    
+    /* wait long delays in chunks the counter compare can time */
+    while (us > DELAY_DWT_CHUNK_US)
+    {
+        cycles = cycle_from_us(DELAY_DWT_CHUNK_US, gs_fac_us, 0);
+        while (cycle_expired(start, DWT->CYCCNT, cycles) == 0)
+        {
+            
+        }
+        start += cycles;
+        us -= DELAY_DWT_CHUNK_US;
+    }
+    
+    /* the last chunk pays the call overhead */
+    cycles = cycle_from_us(us, gs_fac_us, gs_offset);
+    while (cycle_expired(start, DWT->CYCCNT, cycles) == 0)
+    {
+        
+    }
+}
+
+/**
+ * @brief  delay calibrate the call overhead
+ * @return overhead in cycles
+ * @note   the smallest overshoot of a 1us delay over 16 runs
+ */
+static uint32_t a_delay_dwt_calibrate(void)
+{
+    uint32_t i;
+    uint32_t start;
+    uint32_t cost;
+    uint32_t best;
+    
+    gs_offset = 0;
+    best = 0xFFFFFFFFUL;
+    for (i = 0; i < 16; i++)
+    {
+        start = DWT->CYCCNT;
+        delay_us(1);
+        cost = cycle_elapsed(start, DWT->CYCCNT);
+        if (cost < best)
+        {
+            best = cost;
+        }
+    }
+    if (best <= gs_fac_us)
+    {
+        return 0;
+    }
+    
+    return best - gs_fac_us;
+}
+
+#endif
 
 /**
  * @brief  delay clock init
@@ -52,9 +120,32 @@ uint8_t delay_init(void)
     /* set fac */
     gs_fac_us = 168;
     
+    /* start the cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+#if (DELAY_USE_DWT == 1)
+    /* one cycle per core clock */
+    gs_fac_us = SystemCoreClock / 1000000;
+    
+    /* calibrate the call overhead */
+    gs_offset = a_delay_dwt_calibrate();
+#endif
+    
     return 0;
 }
 
+/**
+ * @brief  delay get the calibrated call overhead
+ * @return overhead in cycles
+ * @note   0 with the systick backend
+ */
+uint32_t delay_get_offset(void)
+{
+    return gs_offset;
+}
+
 /**
  * @brief     delay us
  * @param[in] us time
@@ -62,6 +153,10 @@ uint8_t delay_init(void)
  */
 void delay_us(uint32_t us)
 {
+#if (DELAY_USE_DWT == 1)
+    /* take the counter first, so the overhead is inside the wait */
+    a_delay_dwt_wait(DWT->CYCCNT, us);
+#else
     uint32_t ticks;
     uint32_t told;
     uint32_t tnow;
@@ -95,6 +190,7 @@ void delay_us(uint32_t us)
             }
         }
     }
+#endif
 }
 
 /**
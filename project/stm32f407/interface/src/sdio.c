@@ -35,6 +35,17 @@
  */
 
 #include "sdio.h"
+#include <string.h>
+
+/**
+ * @brief sdio switch definition
+ */
+#define SDIO_SWITCH_HIGH_SPEED      0x80FFFFF1U        /**< cmd6 set group 1 to the high speed function */
+#define SDIO_SWITCH_STATUS_SIZE     64                 /**< cmd6 switch status size in bytes */
+#define SDIO_CCC_SWITCH             (1U << 10)         /**< card command class 10 */
+#define SDIO_DEFAULT_SPEED_KHZ      24000              /**< 48MHz / (0 + 2) */
+#define SDIO_HIGH_SPEED_KHZ         48000              /**< 48MHz bypass */
+#define SDIO_WAIT_TIMEOUT           1000               /**< wait timeout in ms */
 
 /**
  * @brief sdio var definition
@@ -45,6 +56,152 @@ SD_HandleTypeDef g_sd_handle;                /**< sd handle */
 HAL_SD_CardInfoTypeDef g_card_info;          /**< card information */
 DMA_HandleTypeDef g_sd_tx_dma_handle;        /**< sd tx dma handle */
 DMA_HandleTypeDef g_sd_rx_dma_handle;        /**< sd rx dma handle */
+static uint8_t gs_bus_width;                 /**< bus width */
+static uint32_t gs_clock_khz;                /**< bus clock in khz */
+static uint32_t gs_bounce[128];              /**< word aligned bounce sector */
+
+/**
+ * @brief  sdio switch the card to the high speed mode
+ * @return status code
+ *         - 0 success
+ *         - 1 switch failed
+ * @note   the card is switched with cmd6 and the 64 bytes switch status is read by polling,
+ *         group 1 must report the high speed function as selected
+ */
+static uint8_t a_sdio_high_speed(void)
+{
+    HAL_SD_CardCSDTypeDef csd;
+    SDIO_DataInitTypeDef config;
+    uint32_t status[SDIO_SWITCH_STATUS_SIZE / 4];
+    uint32_t index = 0;
+    uint32_t tickstart;
+    uint32_t err;
+    
+    /* cmd6 needs the switch command class and a sd 1.10 or later card */
+    if ((HAL_SD_GetCardCSD(&g_sd_handle, &csd) != HAL_OK) ||
+        ((csd.CardComdClasses & SDIO_CCC_SWITCH) == 0) ||
+        (g_card_info.CardVersion != CARD_V2_X))
+    {
+        return 1;
+    }
+    
+    /* set block size to the switch status size */
+    err = SDMMC_CmdBlockLength(g_sd_handle.Instance, SDIO_SWITCH_STATUS_SIZE);
+    if (err != HAL_SD_ERROR_NONE)
+    {
+        return 1;
+    }
+    
+    /* config the data path */
+    config.DataTimeOut = SDMMC_DATATIMEOUT;
+    config.DataLength = SDIO_SWITCH_STATUS_SIZE;
+    config.DataBlockSize = SDIO_DATABLOCK_SIZE_64B;
+    config.TransferDir = SDIO_TRANSFER_DIR_TO_SDIO;
+    config.TransferMode = SDIO_TRANSFER_MODE_BLOCK;
+    config.DPSM = SDIO_DPSM_ENABLE;
+    (void)SDIO_ConfigData(g_sd_handle.Instance, &config);
+    
+    /* send cmd6 */
+    err = SDMMC_CmdSwitch(g_sd_handle.Instance, SDIO_SWITCH_HIGH_SPEED);
+    if (err != HAL_SD_ERROR_NONE)
+    {
+        goto restore;
+    }
+    
+    /* read the switch status, it always fits in the fifo */
+    tickstart = HAL_GetTick();
+    while (!__HAL_SD_GET_FLAG(&g_sd_handle, SDIO_FLAG_RXOVERR | SDIO_FLAG_DCRCFAIL | 
+                              SDIO_FLAG_DTIMEOUT | SDIO_FLAG_DATAEND))
+    {
+        if (__HAL_SD_GET_FLAG(&g_sd_handle, SDIO_FLAG_RXDAVL) && (index < SDIO_SWITCH_STATUS_SIZE / 4))
+        {
+            status[index] = SDIO_ReadFIFO(g_sd_handle.Instance);
+            index++;
+        }
+        if ((HAL_GetTick() - tickstart) >= SDIO_WAIT_TIMEOUT)
+        {
+            err = HAL_SD_ERROR_TIMEOUT;
+            
+            goto restore;
+        }
+    }
+    if (__HAL_SD_GET_FLAG(&g_sd_handle, SDIO_FLAG_RXOVERR | SDIO_FLAG_DCRCFAIL | SDIO_FLAG_DTIMEOUT))
+    {
+        err = HAL_SD_ERROR_DATA_CRC_FAIL;
+        
+        goto restore;
+    }
+    
+    /* drain the fifo */
+    while (__HAL_SD_GET_FLAG(&g_sd_handle, SDIO_FLAG_RXDAVL) && (index < SDIO_SWITCH_STATUS_SIZE / 4))
+    {
+        status[index] = SDIO_ReadFIFO(g_sd_handle.Instance);
+        index++;
+    }
+    
+    /* bits 379:376 are the group 1 result, byte 16 in the big endian status */
+    if ((index != SDIO_SWITCH_STATUS_SIZE / 4) || ((((uint8_t *)status)[16] & 0x0F) != 0x01))
+    {
+        err = HAL_SD_ERROR_UNSUPPORTED_FEATURE;
+    }
+    
+    restore:
+    
+    /* clear the static flags and restore the block size */
+    __HAL_SD_CLEAR_FLAG(&g_sd_handle, SDIO_STATIC_FLAGS);
+    if (SDMMC_CmdBlockLength(g_sd_handle.Instance, BLOCKSIZE) != HAL_SD_ERROR_NONE)
+    {
+        return 1;
+    }
+    
+    return (err == HAL_SD_ERROR_NONE) ? 0 : 1;
+}
+
+/**
+ * @brief  sdio wait until the card is ready for the next command
+ * @return status code
+ *         - 0 success
+ *         - 1 wait timeout
+ * @note   the card state is checked before a command instead of after each transfer,
+ *         so the busy time of a transfer overlaps with the caller's work
+ */
+static uint8_t a_sdio_wait_ready(void)
+{
+    uint32_t tickstart = HAL_GetTick();
+    
+    while (HAL_SD_GetCardState(&g_sd_handle) != HAL_SD_CARD_TRANSFER)
+    {
+        if ((HAL_GetTick() - tickstart) >= SDIO_WAIT_TIMEOUT)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sdio wait the dma done flag
+ * @param[in] *done pointer to a done flag
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait timeout
+ * @note      none
+ */
+static uint8_t a_sdio_wait_done(volatile uint8_t *done)
+{
+    uint32_t tickstart = HAL_GetTick();
+    
+    while (*done == 0)
+    {
+        if ((HAL_GetTick() - tickstart) >= SDIO_WAIT_TIMEOUT)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
 
 /**
  * @brief  sdio bus init
@@ -52,8 +209,9 @@ DMA_HandleTypeDef g_sd_rx_dma_handle;        /**< sd rx dma handle */
  *         - 0 success
  *         - 1 init failed
  *         - 2 get card information failed
- *         - 3 set 4 wire bus failed
- * @note   none
+ *         - 3 set 1 wire bus failed
+ * @note   the 4 wire bus is used when the card supports it, otherwise the 1 wire bus is kept,
+ *         the clock is raised to 48MHz when the card accepts the high speed switch
  */
 uint8_t sdio_init(void)
 {
@@ -66,6 +224,8 @@ uint8_t sdio_init(void)
     g_sd_handle.Init.BusWide = SDIO_BUS_WIDE_1B;
     g_sd_handle.Init.HardwareFlowControl = SDIO_HARDWARE_FLOW_CONTROL_DISABLE;
     g_sd_handle.Init.ClockDiv = SDIO_TRANSFER_CLK_DIV;
+    gs_bus_width = 1;
+    gs_clock_khz = SDIO_DEFAULT_SPEED_KHZ;
     
     /* sd init */
     res = HAL_SD_Init(&g_sd_handle);
@@ -81,11 +241,29 @@ uint8_t sdio_init(void)
         return 2;
     }
     
+    /* switch to the high speed mode, the clock is changed by the bus wide config */
+    if (a_sdio_high_speed() == 0)
+    {
+        g_sd_handle.Init.ClockBypass = SDIO_CLOCK_BYPASS_ENABLE;
+        gs_clock_khz = SDIO_HIGH_SPEED_KHZ;
+    }
+    
     /* set sdio bus wide 4b */
-    res = HAL_SD_ConfigWideBusOperation(&g_sd_handle, SDIO_BUS_WIDE_1B);
-    if(res != HAL_OK)
+    res = HAL_SD_ConfigWideBusOperation(&g_sd_handle, SDIO_BUS_WIDE_4B);
+    if (res == HAL_OK)
+    {
+        gs_bus_width = 4;
+    }
+    else
     {
-        return 3;
+        /* clear the error and fall back to 1b */
+        g_sd_handle.ErrorCode = HAL_SD_ERROR_NONE;
+        g_sd_handle.State = HAL_SD_STATE_READY;
+        res = HAL_SD_ConfigWideBusOperation(&g_sd_handle, SDIO_BUS_WIDE_1B);
+        if(res != HAL_OK)
+        {
+            return 3;
+        }
     }
     
     return 0;
@@ -119,52 +297,56 @@ uint8_t sdio_deinit(void)
  *             - 0 success
  *             - 1 read failed
  *             - 2 read timeout
- * @note       none
+ * @note       cnt sectors are read with one multi block dma transaction,
+ *             a buffer which is not word aligned is read sector by sector through a bounce buffer
  */
 uint8_t sdio_read(uint32_t sector, uint8_t *buf, uint32_t cnt)
 {
     HAL_StatusTypeDef res;
-    uint32_t timeout = 1000;
+    uint32_t i;
     
-    /* set rx done 0 */
-    g_sd_rx_done = 0;
-    
-    /* read blocks */
-    res = HAL_SD_ReadBlocks_DMA(&g_sd_handle, (uint8_t*)buf, sector, cnt);
-    if (res == HAL_OK)
+    /* the dma needs a word aligned buffer */
+    if (((uint32_t)buf & 0x3) != 0)
     {
-        while (1)
+        for (i = 0; i < cnt; i++)
         {
-            /* if rx done */
-            if (g_sd_rx_done != 0)
-            {
-                break;
-            }
-            else
+            uint8_t r;
+            
+            /* read one sector */
+            r = sdio_read(sector + i, (uint8_t *)gs_bounce, 1);
+            if (r != 0)
             {
-                timeout--;
-                
-                /* if timeout */
-                if (timeout == 0)
-                {
-                    return 2;
-                }
+                return r;
             }
-            HAL_Delay(1);
-        }
-        
-        /* wait finished */
-        while (HAL_SD_GetCardState(&g_sd_handle) != HAL_SD_CARD_TRANSFER)
-        {
-            
+            memcpy(buf + i * BLOCKSIZE, gs_bounce, BLOCKSIZE);
         }
         
         return 0;
     }
-    else
+    
+    /* wait the last command finished */
+    if (a_sdio_wait_ready() != 0)
+    {
+        return 2;
+    }
+    
+    /* set rx done 0 */
+    g_sd_rx_done = 0;
+    
+    /* read blocks */
+    res = HAL_SD_ReadBlocks_DMA(&g_sd_handle, (uint8_t*)buf, sector, cnt);
+    if (res != HAL_OK)
     {
         return 1;
     }
+    
+    /* wait rx done */
+    if (a_sdio_wait_done(&g_sd_rx_done) != 0)
+    {
+        return 2;
+    }
+    
+    return 0;
 }
 
 /**
@@ -176,52 +358,67 @@ uint8_t sdio_read(uint32_t sector, uint8_t *buf, uint32_t cnt)
  *            - 0 success
  *            - 1 write failed
  *            - 2 write timeout
- * @note      none
+ * @note      a buffer which is not word aligned is written sector by sector through a bounce buffer
  */
 uint8_t sdio_write(uint32_t sector, uint8_t *buf, uint32_t cnt)
 {
     HAL_StatusTypeDef res;
-    uint32_t timeout = 1000;
-    
-    /* set tx done 0 */
-    g_sd_tx_done = 0;
+    uint32_t i;
     
-    /* write blocks */
-    res = HAL_SD_WriteBlocks_DMA(&g_sd_handle, (uint8_t*)buf, sector, cnt);
-    if (res == HAL_OK)
+    /* the dma needs a word aligned buffer */
+    if (((uint32_t)buf & 0x3) != 0)
     {
-        while (1)
+        for (i = 0; i < cnt; i++)
         {
-            /* if tx done */
-            if (g_sd_tx_done != 0)
-            {
-                break;
-            }
-            else
+            uint8_t r;
+            
+            /* write one sector */
+            memcpy(gs_bounce, buf + i * BLOCKSIZE, BLOCKSIZE);
+            r = sdio_write(sector + i, (uint8_t *)gs_bounce, 1);
+            if (r != 0)
             {
-                timeout--;
-                
-                /* if timeout */
-                if (timeout == 0)
-                {
-                    return 2;
-                }
+                return r;
             }
-            HAL_Delay(1); 
-        }
-        
-        /* wait finished */
-        while (HAL_SD_GetCardState(&g_sd_handle) != HAL_SD_CARD_TRANSFER)
-        {
-            
         }
         
         return 0;
     }
-    else
+    
+    /* wait the last command finished */
+    if (a_sdio_wait_ready() != 0)
+    {
+        return 2;
+    }
+    
+    /* set tx done 0 */
+    g_sd_tx_done = 0;
+    
+    /* write blocks */
+    res = HAL_SD_WriteBlocks_DMA(&g_sd_handle, (uint8_t*)buf, sector, cnt);
+    if (res != HAL_OK)
     {
         return 1;
     }
+    
+    /* wait tx done */
+    if (a_sdio_wait_done(&g_sd_tx_done) != 0)
+    {
+        return 2;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      sdio get the bus config
+ * @param[out] *width pointer to a bus width buffer
+ * @param[out] *clock_khz pointer to a bus clock buffer
+ * @note       none
+ */
+void sdio_get_bus(uint8_t *width, uint32_t *clock_khz)
+{
+    *width = gs_bus_width;
+    *clock_khz = gs_clock_khz;
 }
 
 /**
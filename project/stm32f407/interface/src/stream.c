@@ -0,0 +1,425 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      stream.c
+ * @brief     stream source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "stream.h"
+#include <string.h>
+
+/**
+ * @brief stream frame status definition
+ */
+#define STREAM_FRAME_OK          0        /**< frame accepted */
+#define STREAM_FRAME_WAIT        1        /**< frame not complete */
+#define STREAM_FRAME_CRC         2        /**< crc error */
+
+/**
+ * @brief stream var definition
+ */
+static uint8_t gs_ring[STREAM_RING_SIZE];         /**< dma ring */
+static uint16_t gs_tail;                          /**< ring read position */
+static uint8_t gs_chunk[STREAM_CHUNK_SIZE];       /**< current chunk */
+static uint16_t gs_chunk_len;                     /**< current chunk length */
+static uint32_t gs_chunk_addr;                    /**< current chunk image address */
+static uint32_t gs_size;                          /**< image size */
+static uint16_t gs_seq;                           /**< next frame seq */
+static uint16_t gs_last;                          /**< last frame seq */
+static int32_t gs_requested;                      /**< last requested seq, -1 for none */
+static uint32_t gs_start;                         /**< open time */
+static stream_stats_t gs_stats;                   /**< stats */
+
+/**
+ * @brief     stream send a reply
+ * @param[in] code reply code
+ * @param[in] seq frame seq
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_stream_reply(uint8_t code, uint16_t seq)
+{
+    uint8_t buf[4];
+    
+    buf[0] = STREAM_SYNC_REPLY;
+    buf[1] = code;
+    buf[2] = (uint8_t)(seq >> 0);
+    buf[3] = (uint8_t)(seq >> 8);
+    
+    return stream_port_write(buf, 4);
+}
+
+/**
+ * @brief  stream get the available bytes
+ * @return available bytes
+ * @note   none
+ */
+static uint16_t a_stream_available(void)
+{
+    return (uint16_t)((stream_port_position() + STREAM_RING_SIZE - gs_tail) % STREAM_RING_SIZE);
+}
+
+/**
+ * @brief     stream peek one byte
+ * @param[in] offset offset from the read position
+ * @return    ring byte
+ * @note      none
+ */
+static uint8_t a_stream_peek(uint16_t offset)
+{
+    return gs_ring[(gs_tail + offset) % STREAM_RING_SIZE];
+}
+
+/**
+ * @brief     stream skip bytes
+ * @param[in] len skip length
+ * @note      none
+ */
+static void a_stream_skip(uint16_t len)
+{
+    gs_tail = (uint16_t)((gs_tail + len) % STREAM_RING_SIZE);
+}
+
+/**
+ * @brief      stream parse one frame
+ * @param[in]  seq wanted seq
+ * @param[out] *type pointer to a frame type buffer
+ * @param[out] *len pointer to a payload length buffer
+ * @return     frame status
+ * @note       the payload of the wanted frame is copied to the chunk buffer,
+ *             frames with another seq are repeated frames and are dropped,
+ *             a bad frame drops the whole ring since the host only sends what was requested
+ */
+static uint8_t a_stream_frame(uint16_t seq, uint8_t *type, uint16_t *len)
+{
+    while (1)
+    {
+        uint16_t avail;
+        uint16_t fseq;
+        uint16_t flen;
+        uint16_t crc;
+        uint16_t i;
+        uint8_t b;
+        
+        /* find the sync */
+        avail = a_stream_available();
+        while ((avail != 0) && (a_stream_peek(0) != STREAM_SYNC_FRAME))
+        {
+            a_stream_skip(1);
+            avail--;
+        }
+        if (avail < STREAM_HEAD_SIZE)
+        {
+            return STREAM_FRAME_WAIT;
+        }
+        
+        /* check the head */
+        flen = (uint16_t)(a_stream_peek(4) | (a_stream_peek(5) << 8));
+        if (flen > STREAM_CHUNK_SIZE)
+        {
+            a_stream_skip(avail);
+            gs_stats.crc_errors++;
+            
+            return STREAM_FRAME_CRC;
+        }
+        if (avail < STREAM_HEAD_SIZE + flen + 2)
+        {
+            return STREAM_FRAME_WAIT;
+        }
+        
+        /* check the crc */
+        crc = 0xFFFF;
+        for (i = 1; i < STREAM_HEAD_SIZE + flen; i++)
+        {
+            b = a_stream_peek(i);
+            crc = stream_crc16(crc, &b, 1);
+        }
+        if (crc != (uint16_t)(a_stream_peek(STREAM_HEAD_SIZE + flen) | 
+                              (a_stream_peek(STREAM_HEAD_SIZE + flen + 1) << 8)))
+        {
+            a_stream_skip(avail);
+            gs_stats.crc_errors++;
+            
+            return STREAM_FRAME_CRC;
+        }
+        
+        /* drop a repeated frame */
+        fseq = (uint16_t)(a_stream_peek(2) | (a_stream_peek(3) << 8));
+        *type = a_stream_peek(1);
+        if ((fseq != seq) && (*type != STREAM_TYPE_ABORT))
+        {
+            a_stream_skip(STREAM_HEAD_SIZE + flen + 2);
+            
+            continue;
+        }
+        
+        /* copy the payload */
+        for (i = 0; i < flen; i++)
+        {
+            gs_chunk[i] = a_stream_peek(STREAM_HEAD_SIZE + i);
+        }
+        a_stream_skip(STREAM_HEAD_SIZE + flen + 2);
+        *len = flen;
+        
+        return STREAM_FRAME_OK;
+    }
+}
+
+/**
+ * @brief      stream get one frame
+ * @param[in]  seq frame seq
+ * @param[in]  type wanted frame type
+ * @param[out] *len pointer to a payload length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the frame is requested again after a crc error or a timeout
+ */
+static uint8_t a_stream_get(uint16_t seq, uint8_t type, uint16_t *len)
+{
+    uint32_t start;
+    uint8_t retry;
+    uint8_t t;
+    uint8_t res;
+    
+    /* request the frame if it was not requested ahead */
+    if (gs_requested != (int32_t)seq)
+    {
+        if (a_stream_reply(STREAM_REPLY_REQUEST, seq) != 0)
+        {
+            return 1;
+        }
+        gs_requested = seq;
+    }
+    
+    retry = 0;
+    start = stream_port_ms();
+    while (1)
+    {
+        res = a_stream_frame(seq, &t, len);
+        if (res == STREAM_FRAME_OK)
+        {
+            if (t != type)
+            {
+                return 1;
+            }
+            return 0;
+        }
+        if ((res == STREAM_FRAME_CRC) || ((stream_port_ms() - start) >= STREAM_TIMEOUT_MS))
+        {
+            /* request again */
+            retry++;
+            if (retry > STREAM_RETRY)
+            {
+                return 1;
+            }
+            gs_stats.retries++;
+            if (a_stream_reply(STREAM_REPLY_REQUEST, seq) != 0)
+            {
+                return 1;
+            }
+            start = stream_port_ms();
+        }
+    }
+}
+
+/**
+ * @brief      stream open
+ * @param[out] *size pointer to an image size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       the receiving is switched to the circular dma ring and the size frame is requested
+ */
+uint8_t stream_open(uint32_t *size)
+{
+    uint16_t len;
+    
+    /* init the state */
+    memset(&gs_stats, 0, sizeof(gs_stats));
+    gs_tail = 0;
+    gs_chunk_len = 0;
+    gs_chunk_addr = 0;
+    gs_requested = -1;
+    gs_start = stream_port_ms();
+    
+    /* open the port */
+    if (stream_port_open(gs_ring, STREAM_RING_SIZE) != 0)
+    {
+        return 1;
+    }
+    
+    /* get the size frame */
+    if ((a_stream_get(0, STREAM_TYPE_SIZE, &len) != 0) || (len != 4))
+    {
+        (void)a_stream_reply(STREAM_REPLY_ERROR, 0);
+        (void)stream_port_close();
+        
+        return 1;
+    }
+    gs_size = (uint32_t)gs_chunk[0] | ((uint32_t)gs_chunk[1] << 8) | 
+              ((uint32_t)gs_chunk[2] << 16) | ((uint32_t)gs_chunk[3] << 24);
+    if (gs_size > (uint32_t)0xFFFF * STREAM_CHUNK_SIZE)
+    {
+        (void)a_stream_reply(STREAM_REPLY_ERROR, 0);
+        (void)stream_port_close();
+        
+        return 1;
+    }
+    gs_last = (uint16_t)((gs_size + STREAM_CHUNK_SIZE - 1) / STREAM_CHUNK_SIZE);
+    gs_seq = 1;
+    *size = gs_size;
+    
+    /* request the first data frame ahead */
+    if (gs_last != 0)
+    {
+        if (a_stream_reply(STREAM_REPLY_REQUEST, 1) != 0)
+        {
+            (void)stream_port_close();
+            
+            return 1;
+        }
+        gs_requested = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      stream read
+ * @param[in]  addr image address
+ * @param[in]  size read size
+ * @param[out] *buf pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       reads must be sequential, the next frame is requested as soon as one is accepted
+ *             so that it is received while the caller programs the chip
+ */
+uint8_t stream_read(uint32_t addr, uint16_t size, uint8_t *buf)
+{
+    uint16_t len;
+    uint16_t n;
+    
+    while (size != 0)
+    {
+        /* get the next chunk */
+        if (addr >= gs_chunk_addr + gs_chunk_len)
+        {
+            if ((addr != gs_chunk_addr + gs_chunk_len) || (gs_seq > gs_last))
+            {
+                return 1;
+            }
+            if (a_stream_get(gs_seq, STREAM_TYPE_DATA, &len) != 0)
+            {
+                return 1;
+            }
+            if ((len != STREAM_CHUNK_SIZE) && (gs_seq != gs_last))
+            {
+                return 1;
+            }
+            gs_chunk_addr = addr;
+            gs_chunk_len = len;
+            gs_stats.bytes += len;
+            gs_stats.frames++;
+            gs_seq++;
+            
+            /* request the next frame ahead */
+            if (gs_seq <= gs_last)
+            {
+                if (a_stream_reply(STREAM_REPLY_REQUEST, gs_seq) != 0)
+                {
+                    return 1;
+                }
+                gs_requested = gs_seq;
+            }
+        }
+        else if (addr < gs_chunk_addr)
+        {
+            return 1;
+        }
+        
+        /* copy from the chunk */
+        n = (uint16_t)(gs_chunk_addr + gs_chunk_len - addr);
+        n = (n < size) ? n : size;
+        memcpy(buf, &gs_chunk[addr - gs_chunk_addr], n);
+        buf += n;
+        addr += n;
+        size -= n;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  stream close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   the host gets done when all frames were consumed, otherwise error
+ */
+uint8_t stream_close(void)
+{
+    uint8_t res;
+    
+    /* report to the host */
+    if (gs_seq > gs_last)
+    {
+        res = a_stream_reply(STREAM_REPLY_DONE, gs_last);
+    }
+    else
+    {
+        res = a_stream_reply(STREAM_REPLY_ERROR, gs_seq);
+    }
+    gs_stats.ms = stream_port_ms() - gs_start;
+    
+    /* close the port */
+    if (stream_port_close() != 0)
+    {
+        res = 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      stream get the stats
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void stream_get_stats(stream_stats_t *stats)
+{
+    *stats = gs_stats;
+}
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      stream_port.c
+ * @brief     stream port source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "stream.h"
+#include "uart.h"
+
+/**
+ * @brief     stream port open
+ * @param[in] *ring pointer to a ring buffer
+ * @param[in] len ring length
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      usart1 receives into the ring with dma2 stream2
+ */
+uint8_t stream_port_open(uint8_t *ring, uint16_t len)
+{
+    return uart_rx_dma_start(ring, len);
+}
+
+/**
+ * @brief  stream port get the ring write position
+ * @return write position
+ * @note   none
+ */
+uint16_t stream_port_position(void)
+{
+    return uart_rx_dma_position();
+}
+
+/**
+ * @brief     stream port write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t stream_port_write(uint8_t *buf, uint16_t len)
+{
+    return uart_write(buf, len);
+}
+
+/**
+ * @brief  stream port close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   the shell receiving is restarted
+ */
+uint8_t stream_port_close(void)
+{
+    return uart_rx_dma_stop();
+}
+
+/**
+ * @brief  stream port get the time
+ * @return time in ms
+ * @note   none
+ */
+uint32_t stream_port_ms(void)
+{
+    return HAL_GetTick();
+}
@@ -47,6 +47,8 @@ uint8_t g_uart_rx_buffer[UART_MAX_LEN];        /**< uart rx buffer */
 uint8_t g_uart_buffer;                         /**< uart one buffer */
 volatile uint16_t g_uart_point;                /**< uart rx point */
 volatile uint8_t g_uart_tx_done;               /**< uart tx done flag */
+DMA_HandleTypeDef g_uart_rx_dma_handle;        /**< uart rx dma handle */
+static uint16_t gs_uart_rx_dma_len;            /**< uart rx dma ring length */
 
 /**
  * @brief uart2 var definition
@@ -417,6 +419,97 @@ void uart_irq_handler(void)
     (void)HAL_UART_Receive_IT(&g_uart_handle, (uint8_t *)&g_uart_buffer, 1);
 }
 
+/**
+ * @brief     uart start the circular dma receiving
+ * @param[in] *buf pointer to a ring buffer
+ * @param[in] len ring buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the interrupt receiving is stopped, the shell buffer gets nothing until the dma receiving is stopped,
+ *            dma2 stream2 channel 4 is used
+ */
+uint8_t uart_rx_dma_start(uint8_t *buf, uint16_t len)
+{
+    /* stop the interrupt receiving */
+    if (HAL_UART_AbortReceive(&g_uart_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* dma init */
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    g_uart_rx_dma_handle.Instance = DMA2_Stream2;
+    g_uart_rx_dma_handle.Init.Channel = DMA_CHANNEL_4;
+    g_uart_rx_dma_handle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    g_uart_rx_dma_handle.Init.PeriphInc = DMA_PINC_DISABLE;
+    g_uart_rx_dma_handle.Init.MemInc = DMA_MINC_ENABLE;
+    g_uart_rx_dma_handle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    g_uart_rx_dma_handle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    g_uart_rx_dma_handle.Init.Mode = DMA_CIRCULAR;
+    g_uart_rx_dma_handle.Init.Priority = DMA_PRIORITY_HIGH;
+    g_uart_rx_dma_handle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&g_uart_rx_dma_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* start the dma without interrupts, the position is polled */
+    gs_uart_rx_dma_len = len;
+    if (HAL_DMA_Start(&g_uart_rx_dma_handle, (uint32_t)&g_uart_handle.Instance->DR, (uint32_t)buf, len) != HAL_OK)
+    {
+        (void)HAL_DMA_DeInit(&g_uart_rx_dma_handle);
+        
+        return 1;
+    }
+    
+    /* clear the overrun and enable the dma request */
+    __HAL_UART_CLEAR_OREFLAG(&g_uart_handle);
+    SET_BIT(g_uart_handle.Instance->CR3, USART_CR3_DMAR);
+    
+    return 0;
+}
+
+/**
+ * @brief  uart get the circular dma write position
+ * @return write position in the ring buffer
+ * @note   none
+ */
+uint16_t uart_rx_dma_position(void)
+{
+    return (uint16_t)(gs_uart_rx_dma_len - __HAL_DMA_GET_COUNTER(&g_uart_rx_dma_handle));
+}
+
+/**
+ * @brief  uart stop the circular dma receiving
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   the interrupt receiving is restarted with an empty shell buffer
+ */
+uint8_t uart_rx_dma_stop(void)
+{
+    uint8_t res = 0;
+    
+    /* disable the dma request and stop the dma */
+    CLEAR_BIT(g_uart_handle.Instance->CR3, USART_CR3_DMAR);
+    if (HAL_DMA_Abort(&g_uart_rx_dma_handle) != HAL_OK)
+    {
+        res = 1;
+    }
+    (void)HAL_DMA_DeInit(&g_uart_rx_dma_handle);
+    
+    /* restart the interrupt receiving */
+    __HAL_UART_CLEAR_OREFLAG(&g_uart_handle);
+    g_uart_point = 0;
+    if (HAL_UART_Receive_IT(&g_uart_handle, (uint8_t *)&g_uart_buffer, 1) != HAL_OK)
+    {
+        res = 1;
+    }
+    
+    return res;
+}
+
 /**
  * @brief uart2 irq handler
  * @note  none
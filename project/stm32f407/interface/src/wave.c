@@ -0,0 +1,527 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      wave.c
+ * @brief     wave source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "wave.h"
+#include "delay.h"
+#include "wire.h"
+#include <string.h>
+
+/**
+ * @brief wave pin definition
+ */
+#define WAVE_SCLK_SET          (1UL << 0)                 /**< PA0 set */
+#define WAVE_SCLK_RESET        (1UL << 16)                /**< PA0 reset */
+#define WAVE_MOSI_SET          (1UL << 1)                 /**< PA1 set */
+#define WAVE_MOSI_RESET        (1UL << 17)                /**< PA1 reset */
+#define WAVE_MISO_PIN          (1UL << 8)                 /**< PA8 level */
+#define WAVE_HOLD              0UL                        /**< bsrr word that changes nothing */
+
+/**
+ * @brief wave buffer definition
+ */
+#define WAVE_HALF_MAX          (WAVE_CHUNK_BYTES * (16 + WAVE_GAP_MAX))        /**< max words of one half */
+
+/**
+ * @brief wave dma flag definition
+ */
+#define WAVE_RX_FLAGS          (DMA_LIFCR_CFEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CTEIF1 | \
+                                DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTCIF1)
+#define WAVE_TX_FLAGS          (DMA_HIFCR_CFEIF5 | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CTEIF5 | \
+                                DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTCIF5)
+
+/**
+ * @brief wave var definition
+ */
+static uint32_t gs_tx_buf[2 * WAVE_HALF_MAX];            /**< bsrr words, two halves */
+static uint16_t gs_rx_buf[2 * WAVE_HALF_MAX];            /**< idr samples, two halves */
+static wave_mode_t gs_mode = WAVE_MODE_DMA;              /**< wave mode */
+static uint8_t gs_inited = 0;                            /**< inited flag */
+static wave_stats_t gs_stats;                            /**< wave stats */
+static uint8_t *gs_tx;                                   /**< frame tx bytes */
+static uint8_t *gs_rx;                                   /**< frame rx bytes */
+static uint16_t gs_len;                                  /**< frame length */
+static uint32_t gs_gap;                                  /**< idle slots before a byte */
+static uint32_t gs_words;                                /**< words of one byte */
+static uint32_t gs_half;                                 /**< words of one half */
+static uint32_t gs_chunks;                               /**< chunks of the frame */
+static volatile uint32_t gs_decoded;                     /**< decoded chunks */
+static volatile uint32_t gs_isr_cycles;                  /**< cycles spent in the irq */
+static volatile uint8_t gs_done;                         /**< frame done flag */
+static volatile uint8_t gs_error;                        /**< frame error flag */
+
+/**
+ * @brief  wave get the timer clock
+ * @return tim1 input clock in hz
+ * @note   apb2 timers run at twice pclk2 when apb2 is divided
+ */
+static uint32_t a_wave_timer_clock(void)
+{
+    uint32_t clk;
+    
+    clk = HAL_RCC_GetPCLK2Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1)
+    {
+        clk *= 2;
+    }
+    
+    return clk;
+}
+
+/**
+ * @brief     wave render one chunk
+ * @param[in] *buf pointer to a half buffer
+ * @param[in] chunk chunk number of the frame
+ * @note      chunks past the frame end are rendered as hold words
+ */
+static void a_wave_render(uint32_t *buf, uint32_t chunk)
+{
+    uint32_t b;
+    uint32_t i;
+    uint32_t k;
+    uint32_t *p;
+    uint8_t data;
+    
+    for (b = 0; b < WAVE_CHUNK_BYTES; b++)
+    {
+        p = buf + b * gs_words;
+        i = chunk * WAVE_CHUNK_BYTES + b;
+        if (i >= gs_len)
+        {
+            for (k = 0; k < gs_words; k++)
+            {
+                p[k] = WAVE_HOLD;
+            }
+            
+            continue;
+        }
+        
+        /* idle before the byte, the last idle word sets the mosi of the msb */
+        data = gs_tx[i];
+        for (k = 0; k < gs_gap; k++)
+        {
+            p[k] = WAVE_HOLD;
+        }
+        p[gs_gap - 1] = ((data & 0x80) != 0) ? WAVE_MOSI_SET : WAVE_MOSI_RESET;
+        p += gs_gap;
+        
+        /* msb first, the rising edge only sets sclk and every falling edge sets the mosi of the next bit,
+           so mosi is stable for one slot before the chip samples it like the gpio path */
+        for (k = 0; k < 8; k++)
+        {
+            p[2 * k] = WAVE_SCLK_SET;
+            p[2 * k + 1] = WAVE_SCLK_RESET;
+            if (k < 7)
+            {
+                p[2 * k + 1] |= ((data & (0x40 >> k)) != 0) ? WAVE_MOSI_SET : WAVE_MOSI_RESET;
+            }
+        }
+    }
+}
+
+/**
+ * @brief     wave decode one chunk
+ * @param[in] *buf pointer to a half buffer
+ * @param[in] chunk chunk number of the frame
+ * @note      the sample of every low slot is the bit
+ */
+static void a_wave_decode(const uint16_t *buf, uint32_t chunk)
+{
+    uint32_t b;
+    uint32_t i;
+    uint32_t k;
+    const uint16_t *p;
+    uint8_t data;
+    
+    if (gs_rx == NULL)
+    {
+        return;
+    }
+    for (b = 0; b < WAVE_CHUNK_BYTES; b++)
+    {
+        i = chunk * WAVE_CHUNK_BYTES + b;
+        if (i >= gs_len)
+        {
+            break;
+        }
+        p = buf + b * gs_words + gs_gap;
+        data = 0;
+        for (k = 0; k < 8; k++)
+        {
+            if ((p[2 * k + 1] & WAVE_MISO_PIN) != 0)
+            {
+                data |= (uint8_t)(0x80 >> k);
+            }
+        }
+        gs_rx[i] = data;
+    }
+}
+
+/**
+ * @brief wave stop the engine
+ * @note  none
+ */
+static void a_wave_stop(void)
+{
+    TIM1->CR1 = 0;
+    TIM1->DIER = 0;
+    DMA2_Stream5->CR &= ~DMA_SxCR_EN;
+    DMA2_Stream1->CR &= ~DMA_SxCR_EN;
+    while (((DMA2_Stream5->CR & DMA_SxCR_EN) != 0) || ((DMA2_Stream1->CR & DMA_SxCR_EN) != 0))
+    {
+        
+    }
+    DMA2->HIFCR = WAVE_TX_FLAGS;
+    DMA2->LIFCR = WAVE_RX_FLAGS;
+}
+
+/**
+ * @brief      wave transfer a frame with the cpu
+ * @param[in]  *tx pointer to the bytes to clock out
+ * @param[out] *rx pointer to a sampled byte buffer
+ * @param[in]  len byte number
+ * @param[in]  us half period of the clock in us
+ * @param[in]  gap_us idle time before every byte in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 transfer failed
+ * @note       none
+ */
+static uint8_t a_wave_gpio_transfer(uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t us, uint32_t gap_us)
+{
+    uint8_t miso;
+    uint16_t i;
+    uint8_t k;
+    
+    for (i = 0; i < len; i++)
+    {
+        delay_us(gap_us);
+        if (rx != NULL)
+        {
+            rx[i] = 0;
+        }
+        for (k = 0; k < 8; k++)
+        {
+            (void)wire_data_write((tx[i] >> (7 - k)) & 0x01);
+            (void)wire_clock_write(1);
+            delay_us(us);
+            (void)wire_clock_write(0);
+            if (rx != NULL)
+            {
+                (void)wire_read(&miso);
+                rx[i] |= (uint8_t)((miso & 0x01) << (7 - k));
+            }
+            delay_us(us);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  wave init
+ * @return status code
+ *         - 0 success
+ * @note   SCLK is PA0, MOSI is PA1 and MISO is PA8, tim1 update drives dma2 stream5 into GPIOA->BSRR
+ *         and tim1 cc1 drives dma2 stream1 from GPIOA->IDR, the gpio is set up by the wire functions
+ */
+uint8_t wave_init(void)
+{
+    /* enable the cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    /* enable tim1 and dma2 clock */
+    __HAL_RCC_TIM1_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    
+    /* the samples complete the chunks, so only the rx stream interrupts */
+    HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+    
+    /* set inited */
+    gs_inited = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  wave deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wave_deinit(void)
+{
+    /* stop the engine */
+    a_wave_stop();
+    HAL_NVIC_DisableIRQ(DMA2_Stream1_IRQn);
+    __HAL_RCC_TIM1_CLK_DISABLE();
+    
+    /* clear inited */
+    gs_inited = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     wave set the mode
+ * @param[in] mode wave mode
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wave_set_mode(wave_mode_t mode)
+{
+    gs_mode = mode;
+    
+    return 0;
+}
+
+/**
+ * @brief      wave transfer a frame
+ * @param[in]  *tx pointer to the bytes to clock out
+ * @param[out] *rx pointer to a sampled byte buffer, NULL skips the miso sampling
+ * @param[in]  len byte number
+ * @param[in]  us half period of the clock in us
+ * @param[in]  gap_us idle time before every byte in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 transfer failed
+ * @note       a frame the timer can not pace falls back to the cpu
+ */
+uint8_t wave_transfer(uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t us, uint32_t gap_us)
+{
+    uint8_t res;
+    uint32_t clk;
+    uint32_t ticks;
+    uint32_t start;
+    uint32_t busy;
+    uint32_t timeout;
+    uint32_t tick;
+    
+    if (len == 0)
+    {
+        return 0;
+    }
+    
+    /* get the slot size */
+    clk = a_wave_timer_clock();
+    ticks = us * (clk / 1000000);
+    gs_gap = (gap_us + us - 1) / us;
+    if (gs_gap == 0)
+    {
+        gs_gap = 1;                                      /* the msb needs one low slot of mosi setup */
+    }
+    
+    /* the cpu clocks what the engine can not pace */
+    start = DWT->CYCCNT;
+    if ((gs_mode != WAVE_MODE_DMA) || (gs_inited == 0) ||
+        (ticks < WAVE_MIN_TICKS) || (ticks > 65536) || (gs_gap > WAVE_GAP_MAX))
+    {
+        res = a_wave_gpio_transfer(tx, rx, len, us, gap_us);
+        busy = DWT->CYCCNT - start;
+        if (gs_mode == WAVE_MODE_DMA)
+        {
+            gs_stats.fallbacks++;
+        }
+        gs_stats.frames++;
+        gs_stats.busy_cycles += busy;
+        gs_stats.wire_cycles += busy;
+        if (busy > gs_stats.busy_max)
+        {
+            gs_stats.busy_max = busy;
+        }
+        
+        return res;
+    }
+    
+    /* set the frame */
+    gs_tx = tx;
+    gs_rx = rx;
+    gs_len = len;
+    gs_words = 16 + gs_gap;
+    gs_half = WAVE_CHUNK_BYTES * gs_words;
+    gs_chunks = (len + WAVE_CHUNK_BYTES - 1) / WAVE_CHUNK_BYTES;
+    gs_decoded = 0;
+    gs_isr_cycles = 0;
+    gs_done = 0;
+    gs_error = 0;
+    
+    /* render the first two chunks */
+    a_wave_render(&gs_tx_buf[0], 0);
+    a_wave_render(&gs_tx_buf[gs_half], 1);
+    
+    /* one slot per update, the sample in the middle of the slot */
+    TIM1->CR1 = 0;
+    TIM1->DIER = 0;
+    TIM1->PSC = 0;
+    TIM1->ARR = ticks - 1;
+    TIM1->CCR1 = ticks / 2;
+    TIM1->CCMR1 = 0;
+    TIM1->SR = 0;
+    
+    /* the first update comes one tick after the start */
+    TIM1->CNT = ticks - 1;
+    
+    /* tx stream, memory to GPIOA->BSRR, direct mode */
+    DMA2_Stream5->CR = 0;
+    DMA2->HIFCR = WAVE_TX_FLAGS;
+    DMA2_Stream5->PAR = (uint32_t)&GPIOA->BSRR;
+    DMA2_Stream5->M0AR = (uint32_t)gs_tx_buf;
+    DMA2_Stream5->NDTR = 2 * gs_half;
+    DMA2_Stream5->FCR = 0;
+    DMA2_Stream5->CR = (6UL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 |
+                       DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_DIR_0 | DMA_SxCR_EN;
+    
+    /* rx stream, GPIOA->IDR to memory, direct mode */
+    DMA2_Stream1->CR = 0;
+    DMA2->LIFCR = WAVE_RX_FLAGS;
+    DMA2_Stream1->PAR = (uint32_t)&GPIOA->IDR;
+    DMA2_Stream1->M0AR = (uint32_t)gs_rx_buf;
+    DMA2_Stream1->NDTR = 2 * gs_half;
+    DMA2_Stream1->FCR = 0;
+    DMA2_Stream1->CR = (6UL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL_1 | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 |
+                       DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE | DMA_SxCR_TEIE |
+                       DMA_SxCR_EN;
+    
+    /* start */
+    TIM1->DIER = TIM_DIER_UDE | TIM_DIER_CC1DE;
+    TIM1->CR1 = TIM_CR1_CEN;
+    busy = DWT->CYCCNT - start;
+    
+    /* sleep until the last chunk is sampled */
+    timeout = (uint32_t)(((uint64_t)gs_chunks * gs_half * ticks) / (clk / 1000)) + 10;
+    tick = HAL_GetTick();
+    while (gs_done == 0)
+    {
+        if ((HAL_GetTick() - tick) > timeout)
+        {
+            a_wave_stop();
+            gs_error = 1;
+            
+            break;
+        }
+        __WFI();
+    }
+    
+    /* update the stats */
+    busy += gs_isr_cycles;
+    gs_stats.frames++;
+    gs_stats.busy_cycles += busy;
+    gs_stats.wire_cycles += ((uint64_t)gs_chunks * gs_half * ticks * SystemCoreClock) / clk;
+    if (busy > gs_stats.busy_max)
+    {
+        gs_stats.busy_max = busy;
+    }
+    if (gs_error != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      wave get the stats
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void wave_get_stats(wave_stats_t *stats)
+{
+    *stats = gs_stats;
+}
+
+/**
+ * @brief wave clear the stats
+ * @note  none
+ */
+void wave_clear_stats(void)
+{
+    memset(&gs_stats, 0, sizeof(wave_stats_t));
+}
+
+/**
+ * @brief wave irq handler
+ * @note  call it in DMA2_Stream1_IRQHandler
+ */
+void wave_irq_handler(void)
+{
+    uint32_t start;
+    uint32_t flags;
+    uint32_t half;
+    
+    start = DWT->CYCCNT;
+    flags = DMA2->LISR;
+    DMA2->LIFCR = flags & WAVE_RX_FLAGS;
+    
+    /* a bus error or a missed half stops the frame */
+    if (((flags & DMA_LISR_TEIF1) != 0) || ((DMA2->HISR & DMA_HISR_TEIF5) != 0) ||
+        (((flags & DMA_LISR_HTIF1) != 0) && ((flags & DMA_LISR_TCIF1) != 0)))
+    {
+        a_wave_stop();
+        gs_error = 1;
+        gs_done = 1;
+        gs_isr_cycles += DWT->CYCCNT - start;
+        
+        return;
+    }
+    if ((flags & DMA_LISR_HTIF1) != 0)
+    {
+        half = 0;
+    }
+    else if ((flags & DMA_LISR_TCIF1) != 0)
+    {
+        half = gs_half;
+    }
+    else
+    {
+        return;
+    }
+    
+    /* the half is sampled and its words are sent, decode it and render the chunk after the next */
+    a_wave_decode(&gs_rx_buf[half], gs_decoded);
+    gs_decoded++;
+    if (gs_decoded >= gs_chunks)
+    {
+        a_wave_stop();
+        gs_done = 1;
+    }
+    else
+    {
+        a_wave_render(&gs_tx_buf[half], gs_decoded + 1);
+    }
+    gs_isr_cycles += DWT->CYCCNT - start;
+}
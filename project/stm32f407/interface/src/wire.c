@@ -55,6 +55,56 @@
 #define DQ_OUT                 PAout(8)
 #define DQ_IN                  PAin(8)
 
+/**
+ * @brief wire bank definition
+ * @note  chip n of a shared bus uses the cs PEn and the miso PE(n + 8)
+ */
+#define WIRE_BANK_NUM          4                                                      /**< chip number of the bank */
+#define WIRE_BANK_CS_PIN       (GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3)     /**< bank cs pins */
+#define WIRE_BANK_MISO_PIN     (GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10 | GPIO_PIN_11)   /**< bank miso pins */
+#define WIRE_BANK_MISO_SHIFT   8                                                      /**< first bank miso pin */
+
+/**
+ * @brief global var definition
+ */
+static uint8_t gs_bank_inited;        /**< 1 if the bank gpio is set up */
+
+/**
+ * @brief  wire bank init
+ * @return status code
+ *         - 0 success
+ * @note   the cs lines start high
+ */
+static uint8_t a_wire_bank_init(void)
+{
+    GPIO_InitTypeDef GPIO_Initure;
+    
+    /* check the bank */
+    if (gs_bank_inited != 0)
+    {
+        return 0;
+    }
+    
+    /* enable gpio clock */
+    __HAL_RCC_GPIOE_CLK_ENABLE();
+    
+    /* gpio init */
+    GPIOE->BSRR = WIRE_BANK_CS_PIN;
+    GPIO_Initure.Pin = WIRE_BANK_CS_PIN;
+    GPIO_Initure.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_Initure.Pull = GPIO_PULLUP;
+    GPIO_Initure.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOE, &GPIO_Initure);
+    GPIO_Initure.Pin = WIRE_BANK_MISO_PIN;
+    GPIO_Initure.Mode = GPIO_MODE_INPUT;
+    GPIO_Initure.Pull = GPIO_PULLUP;
+    GPIO_Initure.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOE, &GPIO_Initure);
+    gs_bank_inited = 1;
+    
+    return 0;
+}
+
 /**
  * @brief  wire bus init
  * @return status code
@@ -316,3 +366,61 @@ uint8_t wire_cs_write(uint8_t value)
     
     return 0;
 }
+
+/**
+ * @brief  wire bank deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_bank_deinit(void)
+{
+    /* gpio deinit */
+    if (gs_bank_inited != 0)
+    {
+        HAL_GPIO_DeInit(GPIOE, WIRE_BANK_CS_PIN | WIRE_BANK_MISO_PIN);
+        gs_bank_inited = 0;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bank write the cs lines
+ * @param[in] mask chip mask
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ * @note      one BSRR store, so every cs in the mask changes at the same time
+ */
+uint8_t wire_bank_cs_write(uint32_t mask, uint8_t value)
+{
+    uint32_t pins;
+    
+    /* set up the bank */
+    (void)a_wire_bank_init();
+    
+    /* set or reset */
+    pins = mask & ((1UL << WIRE_BANK_NUM) - 1);
+    GPIOE->BSRR = (value != 0) ? pins : (pins << 16);
+    
+    return 0;
+}
+
+/**
+ * @brief      wire bank read the miso lines
+ * @param[out] *value pointer to a level mask buffer, one bit per chip
+ * @return     status code
+ *             - 0 success
+ * @note       one IDR load
+ */
+uint8_t wire_bank_read(uint32_t *value)
+{
+    /* set up the bank */
+    (void)a_wire_bank_init();
+    
+    /* read the levels */
+    *value = (GPIOE->IDR >> WIRE_BANK_MISO_SHIFT) & ((1UL << WIRE_BANK_NUM) - 1);
+    
+    return 0;
+}
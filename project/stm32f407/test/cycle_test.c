@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      cycle_test.c
+ * @brief     cycle test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "cycle.h"
+#include <stdio.h>
+
+/**
+ * @brief test var definition
+ */
+static uint32_t gs_failed = 0;        /**< failed checks */
+
+/**
+ * @brief     test check one value
+ * @param[in] *name pointer to a check name
+ * @param[in] value got value
+ * @param[in] expect expected value
+ * @note      none
+ */
+static void a_cycle_test_check(const char *name, uint32_t value, uint32_t expect)
+{
+    if (value != expect)
+    {
+        printf("cycle: %s is 0x%08lX, expect 0x%08lX.\n", name, (unsigned long)value, (unsigned long)expect);
+        gs_failed++;
+    }
+}
+
+/**
+ * @brief     test wait on a simulated counter
+ * @param[in] start counter at the start
+ * @param[in] cycles wait cycles
+ * @param[in] step counter step per poll
+ * @return    counter when the wait ends
+ * @note      none
+ */
+static uint32_t a_cycle_test_wait(uint32_t start, uint32_t cycles, uint32_t step)
+{
+    uint32_t now;
+    
+    now = start;
+    while (cycle_expired(start, now, cycles) == 0)
+    {
+        now += step;
+    }
+    
+    return now;
+}
+
+/**
+ * @brief  cycle test main
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   build it on the host, cc -I interface/inc test/cycle_test.c -o cycle_test
+ */
+int main(void)
+{
+    const uint32_t starts[] = {0x00000000UL, 0x7FFFFFF0UL, 0xFFFFFF00UL, 0xFFFFFFFFUL};
+    uint32_t i;
+    uint32_t end;
+    
+    /* elapsed across the wrap */
+    a_cycle_test_check("elapsed no wrap", cycle_elapsed(100, 436), 336);
+    a_cycle_test_check("elapsed wrap", cycle_elapsed(0xFFFFFF00UL, 0x00000050UL), 0x150);
+    a_cycle_test_check("elapsed full wrap", cycle_elapsed(0x12345678UL, 0x12345677UL), 0xFFFFFFFFUL);
+    
+    /* expired around the end */
+    a_cycle_test_check("expired before", cycle_expired(0xFFFFFFF0UL, 0x0000000EUL, 0x1F), 0);
+    a_cycle_test_check("expired at", cycle_expired(0xFFFFFFF0UL, 0x0000000FUL, 0x1F), 1);
+    a_cycle_test_check("expired after", cycle_expired(0xFFFFFFF0UL, 0x00000010UL, 0x1F), 1);
+    a_cycle_test_check("expired zero", cycle_expired(0xFFFFFFFFUL, 0xFFFFFFFFUL, 0), 1);
+    a_cycle_test_check("expired max", cycle_expired(0x80000000UL, 0xFFFFFFFFUL, CYCLE_MAX_WAIT), 1);
+    
+    /* us to cycles with the overhead */
+    a_cycle_test_check("from us 2", cycle_from_us(2, 168, 20), 316);
+    a_cycle_test_check("from us 0", cycle_from_us(0, 168, 20), 0);
+    a_cycle_test_check("from us under offset", cycle_from_us(1, 168, 200), 0);
+    a_cycle_test_check("from us at offset", cycle_from_us(1, 168, 168), 0);
+    a_cycle_test_check("from us 1s", cycle_from_us(1000000, 168, 0), 168000000UL);
+    a_cycle_test_check("from us clamp", cycle_from_us(0xFFFFFFFFUL, 168, 0), CYCLE_MAX_WAIT);
+    
+    /* simulated waits that cross the wrap */
+    for (i = 0; i < sizeof(starts) / sizeof(starts[0]); i++)
+    {
+        end = a_cycle_test_wait(starts[i], 336, 1);
+        a_cycle_test_check("wait step 1", cycle_elapsed(starts[i], end), 336);
+        end = a_cycle_test_wait(starts[i], 336, 5);
+        a_cycle_test_check("wait step 5", cycle_elapsed(starts[i], end), 340);
+        end = a_cycle_test_wait(starts[i], CYCLE_MAX_WAIT, 0x01000000UL);
+        a_cycle_test_check("wait max", cycle_elapsed(starts[i], end), 0x80000000UL);
+    }
+    
+    if (gs_failed != 0)
+    {
+        printf("cycle: %lu checks failed.\n", (unsigned long)gs_failed);
+        
+        return 1;
+    }
+    printf("cycle: all checks passed.\n");
+    
+    return 0;
+}
@@ -0,0 +1,346 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      fs_bench.c
+ * @brief     fs bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "binfile.h"
+#include "ff.h"
+#include "sdio.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_IMAGE_SECTORS        262144             /**< 128MB sparse image */
+#define BENCH_CLUSTER_SIZE         (32 * 1024)        /**< 32KB clusters as on a typical card */
+#define BENCH_FILE_SIZE            (2 * 1024 * 1024)  /**< 2MB file */
+#define BENCH_CHUNK_SIZE           (128 * 1024)       /**< interleave chunk, 16 fragments */
+#define BENCH_UPDATES              4                  /**< updates per path */
+
+/**
+ * @brief bench var definition
+ */
+static FATFS gs_fs;                      /**< fatfs handle */
+static FIL gs_file;                      /**< fs handle */
+static FIL gs_filler;                    /**< filler handle */
+static uint8_t gs_buf[512];              /**< driver buffer */
+static uint8_t gs_chunk[BENCH_CHUNK_SIZE];  /**< chunk buffer */
+
+/**
+ * @brief     bench pattern byte
+ * @param[in] addr file address
+ * @return    pattern byte
+ * @note      none
+ */
+static uint8_t a_bench_pattern(uint32_t addr)
+{
+    return (uint8_t)((addr >> 9) ^ (addr * 7));
+}
+
+/**
+ * @brief  bench get the time
+ * @return time in us
+ * @note   none
+ */
+static uint64_t a_bench_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief     bench format the image and write a fragmented file
+ * @param[in] *name pointer to a file name
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      the file is interleaved with a filler file so that its clusters are not contiguous
+ */
+static uint8_t a_bench_create(const char *name)
+{
+    static uint8_t work[FF_MAX_SS];
+    const MKFS_PARM opt = {FM_ANY, 0, 0, 0, BENCH_CLUSTER_SIZE};
+    uint32_t addr;
+    uint32_t i;
+    UINT bw;
+    
+    /* format */
+    if (f_mkfs("0:", &opt, work, sizeof(work)) != FR_OK)
+    {
+        return 1;
+    }
+    if (f_mount(&gs_fs, "0:", 1) != FR_OK)
+    {
+        return 1;
+    }
+    if (f_open(&gs_file, name, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    {
+        return 1;
+    }
+    if (f_open(&gs_filler, "filler.bin", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    {
+        return 1;
+    }
+    
+    /* interleave the file with the filler */
+    for (addr = 0; addr < BENCH_FILE_SIZE; addr += BENCH_CHUNK_SIZE)
+    {
+        for (i = 0; i < BENCH_CHUNK_SIZE; i++)
+        {
+            gs_chunk[i] = a_bench_pattern(addr + i);
+        }
+        if (f_write(&gs_file, gs_chunk, BENCH_CHUNK_SIZE, &bw) != FR_OK || f_sync(&gs_file) != FR_OK)
+        {
+            return 1;
+        }
+        if (f_write(&gs_filler, gs_chunk, BENCH_CHUNK_SIZE, &bw) != FR_OK || f_sync(&gs_filler) != FR_OK)
+        {
+            return 1;
+        }
+    }
+    
+    /* close */
+    (void)f_close(&gs_filler);
+    (void)f_close(&gs_file);
+    (void)f_unmount("0:");
+    
+    return 0;
+}
+
+/**
+ * @brief     bench check a driver block
+ * @param[in] addr file address
+ * @param[in] len block length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_bench_check(uint32_t addr, uint32_t len)
+{
+    uint32_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        if (gs_buf[i] != a_bench_pattern(addr + i))
+        {
+            printf("fs_bench: data error at 0x%08X.\n", (unsigned int)(addr + i));
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bench run the old bin read path
+ * @param[in] *name pointer to a file name
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      mount per update, f_lseek and f_read per block, no link map table
+ */
+static uint8_t a_bench_plain(const char *name)
+{
+    uint32_t size;
+    uint32_t addr;
+    uint32_t u;
+    UINT bw;
+    
+    for (u = 0; u < BENCH_UPDATES; u++)
+    {
+        if (f_mount(&gs_fs, "0:", 1) != FR_OK)
+        {
+            return 1;
+        }
+        if (f_open(&gs_file, name, FA_READ) != FR_OK)
+        {
+            return 1;
+        }
+        size = (uint32_t)f_size(&gs_file);
+        for (addr = 0; addr < size; addr += 512)
+        {
+            if (f_lseek(&gs_file, addr) != FR_OK || f_read(&gs_file, gs_buf, 512, &bw) != FR_OK)
+            {
+                return 1;
+            }
+            if (a_bench_check(addr, bw) != 0)
+            {
+                return 1;
+            }
+        }
+        (void)f_close(&gs_file);
+        (void)f_unmount("0:");
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bench run the binfile path
+ * @param[in] *name pointer to a file name
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_bench_binfile(const char *name)
+{
+    uint32_t size;
+    uint32_t addr;
+    uint32_t u;
+    
+    for (u = 0; u < BENCH_UPDATES; u++)
+    {
+        if (binfile_open((char *)name, &size) != 0)
+        {
+            return 1;
+        }
+        for (addr = 0; addr < size; addr += 512)
+        {
+            if (binfile_read(addr, 512, gs_buf) != 0)
+            {
+                return 1;
+            }
+            if (a_bench_check(addr, (size - addr < 512) ? (size - addr) : 512) != 0)
+            {
+                return 1;
+            }
+        }
+        (void)binfile_close();
+    }
+    (void)binfile_unmount();
+    
+    return 0;
+}
+
+/**
+ * @brief     bench report one path
+ * @param[in] *path_name pointer to a path name
+ * @param[in] us used time in us
+ * @note      none
+ */
+static void a_bench_report(const char *path_name, uint64_t us)
+{
+    sdio_host_stats_t stats;
+    
+    sdio_host_get_stats(&stats);
+    printf("fs_bench: %-8s %6u disk reads %7u sectors %8u us per update.\n", path_name,
+           (unsigned int)(stats.reads / BENCH_UPDATES), (unsigned int)(stats.sectors / BENCH_UPDATES),
+           (unsigned int)(us / BENCH_UPDATES));
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      fs_bench <image> [file], a fresh image with a fragmented update.bin is built
+ *            when no file is given
+ */
+int main(int argc, char **argv)
+{
+    const char *name = "update.bin";
+    binfile_info_t info;
+    uint64_t start;
+    
+    if (argc < 2)
+    {
+        printf("usage: fs_bench <image> [file]\n");
+        
+        return 1;
+    }
+    
+    /* attach the image */
+    if (argc > 2)
+    {
+        name = argv[2];
+        if (sdio_host_open(argv[1], 0) != 0)
+        {
+            printf("fs_bench: open %s failed.\n", argv[1]);
+            
+            return 1;
+        }
+    }
+    else
+    {
+        if (sdio_host_open(argv[1], BENCH_IMAGE_SECTORS) != 0 || a_bench_create(name) != 0)
+        {
+            printf("fs_bench: create %s failed.\n", argv[1]);
+            
+            return 1;
+        }
+    }
+    
+    /* old path */
+    sdio_host_clear_stats();
+    start = a_bench_us();
+    if (a_bench_plain(name) != 0)
+    {
+        printf("fs_bench: plain read failed.\n");
+        sdio_host_close();
+        
+        return 1;
+    }
+    a_bench_report("plain", a_bench_us() - start);
+    
+    /* binfile path */
+    sdio_host_clear_stats();
+    start = a_bench_us();
+    if (a_bench_binfile(name) != 0)
+    {
+        printf("fs_bench: binfile read failed.\n");
+        sdio_host_close();
+        
+        return 1;
+    }
+    a_bench_report("binfile", a_bench_us() - start);
+    binfile_get_info(&info);
+    printf("fs_bench: fast seek %s, %u fragments, %u mounts, %u refills, %u hits.\n",
+           (info.fast_seek != 0) ? "on" : "off", (unsigned int)info.fragments, (unsigned int)info.mounts,
+           (unsigned int)info.refills, (unsigned int)info.hits);
+    
+    sdio_host_close();
+    
+    return 0;
+}
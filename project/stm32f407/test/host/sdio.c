@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sdio.c
+ * @brief     sdio host source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "sdio.h"
+#include <stdio.h>
+
+/**
+ * @brief sdio host var definition
+ */
+static FILE *gs_image = NULL;                     /**< image file */
+static HAL_SD_CardInfoTypeDef gs_card_info;       /**< card information */
+static sdio_host_stats_t gs_stats;                /**< stats */
+
+/**
+ * @brief     sdio host attach a disk image
+ * @param[in] *path pointer to an image path
+ * @param[in] sectors image size in sectors, 0 keeps the current size
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the image is created when it does not exist
+ */
+uint8_t sdio_host_open(const char *path, uint32_t sectors)
+{
+    long size;
+    
+    /* open or create the image */
+    gs_image = fopen(path, "r+b");
+    if (gs_image == NULL)
+    {
+        gs_image = fopen(path, "w+b");
+        if (gs_image == NULL)
+        {
+            return 1;
+        }
+    }
+    
+    /* grow the image */
+    if (sectors != 0)
+    {
+        if (fseek(gs_image, (long)sectors * 512 - 1, SEEK_SET) != 0 || fputc(0, gs_image) == EOF)
+        {
+            sdio_host_close();
+            
+            return 1;
+        }
+    }
+    
+    /* get the size */
+    if (fseek(gs_image, 0, SEEK_END) != 0)
+    {
+        sdio_host_close();
+        
+        return 1;
+    }
+    size = ftell(gs_image);
+    gs_card_info.LogBlockNbr = (uint32_t)(size / 512);
+    gs_card_info.LogBlockSize = 512;
+    
+    return 0;
+}
+
+/**
+ * @brief sdio host detach the disk image
+ * @note  none
+ */
+void sdio_host_close(void)
+{
+    if (gs_image != NULL)
+    {
+        (void)fclose(gs_image);
+        gs_image = NULL;
+    }
+}
+
+/**
+ * @brief      sdio host get the stats
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void sdio_host_get_stats(sdio_host_stats_t *stats)
+{
+    *stats = gs_stats;
+}
+
+/**
+ * @brief sdio host clear the stats
+ * @note  none
+ */
+void sdio_host_clear_stats(void)
+{
+    gs_stats.reads = 0;
+    gs_stats.sectors = 0;
+}
+
+/**
+ * @brief  sdio bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t sdio_init(void)
+{
+    return (gs_image != NULL) ? 0 : 1;
+}
+
+/**
+ * @brief  sdio bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t sdio_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     sdio write
+ * @param[in] sector write first sector
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] cnt data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sdio_write(uint32_t sector, uint8_t *buf, uint32_t cnt)
+{
+    if (gs_image == NULL || sector + cnt > gs_card_info.LogBlockNbr)
+    {
+        return 1;
+    }
+    if (fseek(gs_image, (long)sector * 512, SEEK_SET) != 0)
+    {
+        return 1;
+    }
+    if (fwrite(buf, 512, cnt, gs_image) != cnt)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      sdio read
+ * @param[in]  sector read first sector
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  cnt data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one call is counted as one multi block command
+ */
+uint8_t sdio_read(uint32_t sector, uint8_t *buf, uint32_t cnt)
+{
+    if (gs_image == NULL || sector + cnt > gs_card_info.LogBlockNbr)
+    {
+        return 1;
+    }
+    if (fseek(gs_image, (long)sector * 512, SEEK_SET) != 0)
+    {
+        return 1;
+    }
+    if (fread(buf, 512, cnt, gs_image) != cnt)
+    {
+        return 1;
+    }
+    gs_stats.reads++;
+    gs_stats.sectors += cnt;
+    
+    return 0;
+}
+
+/**
+ * @brief  sdio get card info handle
+ * @return pointer to a card info handle
+ * @note   none
+ */
+HAL_SD_CardInfoTypeDef* sdio_get_card_info(void)
+{
+    return &gs_card_info;
+}
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sdio.h
+ * @brief     sdio host header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef SDIO_H
+#define SDIO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup sdio_host sdio host function
+ * @brief    sdio host function modules
+ * @{
+ */
+
+/**
+ * @brief sdio host card info structure definition
+ * @note  the fields used by diskio, named as in the hal
+ */
+typedef struct
+{
+    uint32_t LogBlockNbr;         /**< logical capacity in blocks */
+    uint32_t LogBlockSize;        /**< logical block size in bytes */
+} HAL_SD_CardInfoTypeDef;
+
+/**
+ * @brief sdio host stats structure definition
+ */
+typedef struct sdio_host_stats_s
+{
+    uint32_t reads;           /**< read commands */
+    uint32_t sectors;         /**< read sectors */
+} sdio_host_stats_t;
+
+/**
+ * @brief     sdio host attach a disk image
+ * @param[in] *path pointer to an image path
+ * @param[in] sectors image size in sectors, 0 keeps the current size
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the image is created when it does not exist
+ */
+uint8_t sdio_host_open(const char *path, uint32_t sectors);
+
+/**
+ * @brief sdio host detach the disk image
+ * @note  none
+ */
+void sdio_host_close(void);
+
+/**
+ * @brief      sdio host get the stats
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void sdio_host_get_stats(sdio_host_stats_t *stats);
+
+/**
+ * @brief sdio host clear the stats
+ * @note  none
+ */
+void sdio_host_clear_stats(void);
+
+/**
+ * @brief  sdio bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t sdio_init(void);
+
+/**
+ * @brief  sdio bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t sdio_deinit(void);
+
+/**
+ * @brief     sdio write
+ * @param[in] sector write first sector
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] cnt data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sdio_write(uint32_t sector, uint8_t *buf, uint32_t cnt);
+
+/**
+ * @brief      sdio read
+ * @param[in]  sector read first sector
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  cnt data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one call is counted as one multi block command
+ */
+uint8_t sdio_read(uint32_t sector, uint8_t *buf, uint32_t cnt);
+
+/**
+ * @brief  sdio get card info handle
+ * @return pointer to a card info handle
+ * @note   none
+ */
+HAL_SD_CardInfoTypeDef* sdio_get_card_info(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,310 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      stream_device.c
+ * @brief     stream device source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+#include "stream.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief device var definition
+ */
+static int gs_fd = -1;                       /**< pty master */
+static uint8_t *gs_ring = NULL;              /**< port ring */
+static uint16_t gs_ring_len;                 /**< port ring length */
+static uint16_t gs_pos;                      /**< port ring write position */
+static uint32_t gs_baud = 115200;            /**< emulated line rate */
+static uint64_t gs_rx_bytes;                 /**< received bytes */
+static uint32_t gs_rx_start;                 /**< receiving start */
+static uint8_t gs_buf[512];                  /**< driver buffer */
+
+/**
+ * @brief  stream port get the time
+ * @return time in ms
+ * @note   none
+ */
+uint32_t stream_port_ms(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief     stream port open
+ * @param[in] *ring pointer to a ring buffer
+ * @param[in] len ring length
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t stream_port_open(uint8_t *ring, uint16_t len)
+{
+    gs_ring = ring;
+    gs_ring_len = len;
+    gs_pos = 0;
+    gs_rx_bytes = 0;
+    gs_rx_start = stream_port_ms();
+    
+    return 0;
+}
+
+/**
+ * @brief  stream port get the ring write position
+ * @return write position
+ * @note   the pty is drained into the ring no faster than the emulated line rate,
+ *         10 bits per byte
+ */
+uint16_t stream_port_position(void)
+{
+    uint64_t allowed;
+    uint8_t buf[256];
+    ssize_t r;
+    size_t n;
+    ssize_t i;
+    
+    /* bytes the line could have carried so far */
+    allowed = (uint64_t)(stream_port_ms() - gs_rx_start) * gs_baud / 10000 + 16;
+    if (allowed <= gs_rx_bytes)
+    {
+        return gs_pos;
+    }
+    n = (size_t)(allowed - gs_rx_bytes);
+    n = (n < sizeof(buf)) ? n : sizeof(buf);
+    
+    /* move the pty data into the ring like the dma does */
+    r = read(gs_fd, buf, n);
+    for (i = 0; i < r; i++)
+    {
+        gs_ring[gs_pos] = buf[i];
+        gs_pos = (uint16_t)((gs_pos + 1) % gs_ring_len);
+    }
+    if (r > 0)
+    {
+        gs_rx_bytes += (uint64_t)r;
+    }
+    
+    return gs_pos;
+}
+
+/**
+ * @brief     stream port write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t stream_port_write(uint8_t *buf, uint16_t len)
+{
+    return (write(gs_fd, buf, len) == (ssize_t)len) ? 0 : 1;
+}
+
+/**
+ * @brief  stream port close
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t stream_port_close(void)
+{
+    gs_ring = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief     device print to the pty like the board shell
+ * @param[in] *str pointer to a string
+ * @note      none
+ */
+static void a_device_print(const char *str)
+{
+    (void)stream_port_write((uint8_t *)str, (uint16_t)strlen(str));
+}
+
+/**
+ * @brief      device wait for a command line
+ * @param[out] *line pointer to a line buffer
+ * @param[in]  len line buffer length
+ * @note       the line ends when the pty is idle for 20ms, as uart_read does
+ */
+static void a_device_command(char *line, size_t len)
+{
+    size_t n = 0;
+    uint32_t last = 0;
+    char c;
+    
+    while (1)
+    {
+        if (read(gs_fd, &c, 1) == 1)
+        {
+            if (n + 1 < len)
+            {
+                line[n++] = c;
+            }
+            last = stream_port_ms();
+        }
+        else
+        {
+            if ((n != 0) && ((stream_port_ms() - last) >= 20))
+            {
+                break;
+            }
+            (void)usleep(1000);
+        }
+    }
+    line[n] = 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      stream_device [--baud=<rate>] [--packet-ms=<ms>], it stands in for the board on a pty,
+ *            reads the streamed image like the driver update does and reports the checksum and the throughput
+ */
+int main(int argc, char **argv)
+{
+    struct termios tio;
+    stream_stats_t stats;
+    uint32_t packet_ms = 17;
+    uint32_t size;
+    uint32_t addr;
+    uint32_t sum = 0;
+    uint32_t n;
+    uint32_t i;
+    char line[256];
+    int slave;
+    int a;
+    
+    /* parse the args */
+    for (a = 1; a < argc; a++)
+    {
+        if (strncmp(argv[a], "--baud=", 7) == 0)
+        {
+            gs_baud = (uint32_t)strtoul(argv[a] + 7, NULL, 10);
+        }
+        else if (strncmp(argv[a], "--packet-ms=", 12) == 0)
+        {
+            packet_ms = (uint32_t)strtoul(argv[a] + 12, NULL, 10);
+        }
+        else
+        {
+            printf("usage: stream_device [--baud=<rate>] [--packet-ms=<ms>]\n");
+            
+            return 1;
+        }
+    }
+    
+    /* open the pty, the slave is kept open in raw mode */
+    gs_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((gs_fd < 0) || (grantpt(gs_fd) != 0) || (unlockpt(gs_fd) != 0))
+    {
+        printf("stream_device: open pty failed.\n");
+        
+        return 1;
+    }
+    slave = open(ptsname(gs_fd), O_RDWR | O_NOCTTY);
+    if ((slave < 0) || (tcgetattr(slave, &tio) != 0))
+    {
+        printf("stream_device: open pty slave failed.\n");
+        
+        return 1;
+    }
+    cfmakeraw(&tio);
+    (void)tcsetattr(slave, TCSANOW, &tio);
+    (void)fcntl(gs_fd, F_SETFL, fcntl(gs_fd, F_GETFL) | O_NONBLOCK);
+    printf("stream_device: pty is %s.\n", ptsname(gs_fd));
+    fflush(stdout);
+    
+    /* wait for the command */
+    a_device_command(line, sizeof(line));
+    printf("stream_device: command is \"%s\".\n", line);
+    
+    /* read the image as the update does */
+    if (stream_open(&size) != 0)
+    {
+        printf("stream_device: stream open failed.\n");
+        a_device_print("wt588e02b: bin read init failed.\n");
+        
+        return 1;
+    }
+    for (addr = 0; addr < size; addr += n)
+    {
+        n = ((size - addr) < 512) ? (size - addr) : 512;
+        (void)usleep(packet_ms * 1000);
+        if (stream_read(addr, (uint16_t)n, gs_buf) != 0)
+        {
+            printf("stream_device: stream read failed at %u.\n", (unsigned int)addr);
+            (void)stream_close();
+            a_device_print("wt588e02b: bin read failed.\n");
+            
+            return 1;
+        }
+        for (i = 0; i < n; i++)
+        {
+            sum += gs_buf[i];
+        }
+    }
+    (void)stream_close();
+    a_device_print("wt588e02b: update end.\n");
+    
+    /* report */
+    stream_get_stats(&stats);
+    printf("stream_device: %u bytes, sum 0x%08X.\n", (unsigned int)size, (unsigned int)sum);
+    printf("stream_device: %u frames in %ums, %uB/s, %u retries, %u crc errors.\n", (unsigned int)stats.frames,
+           (unsigned int)stats.ms, (unsigned int)((stats.ms != 0) ? (uint64_t)stats.bytes * 1000 / stats.ms : 0),
+           (unsigned int)stats.retries, (unsigned int)stats.crc_errors);
+    (void)usleep(200000);
+    (void)close(slave);
+    (void)close(gs_fd);
+    
+    return 0;
+}
@@ -0,0 +1,352 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      uart_send.c
+ * @brief     uart send source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#define _DEFAULT_SOURCE
+#include "stream.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief send definition
+ */
+#define SEND_IDLE_MS        5000        /**< give up after this silence */
+
+/**
+ * @brief send var definition
+ */
+static uint8_t *gs_image = NULL;        /**< image data */
+static uint32_t gs_size;                /**< image size */
+static uint8_t *gs_sent = NULL;         /**< transmissions per seq */
+
+/**
+ * @brief  send get the time
+ * @return time in ms
+ * @note   none
+ */
+static uint32_t a_send_ms(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief     send map the baud rate
+ * @param[in] baud baud rate
+ * @return    termios speed, B0 if unsupported
+ * @note      none
+ */
+static speed_t a_send_speed(uint32_t baud)
+{
+    switch (baud)
+    {
+        case 9600 : return B9600;
+        case 19200 : return B19200;
+        case 38400 : return B38400;
+        case 57600 : return B57600;
+        case 115200 : return B115200;
+        case 230400 : return B230400;
+        case 460800 : return B460800;
+        case 921600 : return B921600;
+        default : return B0;
+    }
+}
+
+/**
+ * @brief     send one frame
+ * @param[in] fd tty
+ * @param[in] seq requested seq
+ * @param[in] corrupt corrupt the first transmission of every corrupt-th frame, 0 for none
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_send_frame(int fd, uint16_t seq, uint32_t corrupt)
+{
+    uint8_t frame[STREAM_HEAD_SIZE + STREAM_CHUNK_SIZE + 2];
+    uint16_t len;
+    uint16_t crc;
+    uint32_t addr;
+    
+    /* fill the frame */
+    frame[0] = STREAM_SYNC_FRAME;
+    frame[2] = (uint8_t)(seq >> 0);
+    frame[3] = (uint8_t)(seq >> 8);
+    if (seq == 0)
+    {
+        frame[1] = STREAM_TYPE_SIZE;
+        len = 4;
+        frame[6] = (uint8_t)(gs_size >> 0);
+        frame[7] = (uint8_t)(gs_size >> 8);
+        frame[8] = (uint8_t)(gs_size >> 16);
+        frame[9] = (uint8_t)(gs_size >> 24);
+    }
+    else
+    {
+        addr = (uint32_t)(seq - 1) * STREAM_CHUNK_SIZE;
+        if (addr >= gs_size)
+        {
+            return 1;
+        }
+        frame[1] = STREAM_TYPE_DATA;
+        len = (uint16_t)(((gs_size - addr) < STREAM_CHUNK_SIZE) ? (gs_size - addr) : STREAM_CHUNK_SIZE);
+        memcpy(&frame[STREAM_HEAD_SIZE], &gs_image[addr], len);
+    }
+    frame[4] = (uint8_t)(len >> 0);
+    frame[5] = (uint8_t)(len >> 8);
+    crc = stream_crc16(0xFFFF, &frame[1], STREAM_HEAD_SIZE - 1 + len);
+    frame[STREAM_HEAD_SIZE + len] = (uint8_t)(crc >> 0);
+    frame[STREAM_HEAD_SIZE + len + 1] = (uint8_t)(crc >> 8);
+    
+    /* inject an error */
+    if ((corrupt != 0) && (seq != 0) && ((seq % corrupt) == 0) && (gs_sent[seq] == 0))
+    {
+        frame[STREAM_HEAD_SIZE] ^= 0x01;
+    }
+    if (gs_sent[seq] < 0xFF)
+    {
+        gs_sent[seq]++;
+    }
+    
+    return (write(fd, frame, STREAM_HEAD_SIZE + len + 2) == (ssize_t)(STREAM_HEAD_SIZE + len + 2)) ? 0 : 1;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      uart_send <tty> <file> [--baud=<rate>] [--command=<line>] [--corrupt=<n>]
+ */
+int main(int argc, char **argv)
+{
+    const char *command = "wt588e02b -e update-all --file=uart:";
+    struct termios tio;
+    struct pollfd pfd;
+    uint32_t baud = 115200;
+    uint32_t corrupt = 0;
+    uint32_t frames = 0;
+    uint32_t resends = 0;
+    uint32_t start = 0;
+    uint32_t last;
+    uint32_t done = 0;
+    uint32_t chunks;
+    uint8_t reply[4];
+    uint8_t reply_len = 0;
+    uint8_t failed = 0;
+    FILE *f;
+    int fd;
+    int a;
+    
+    if (argc < 3)
+    {
+        printf("usage: uart_send <tty> <file> [--baud=<rate>] [--command=<line>] [--corrupt=<n>]\n");
+        
+        return 1;
+    }
+    for (a = 3; a < argc; a++)
+    {
+        if (strncmp(argv[a], "--baud=", 7) == 0)
+        {
+            baud = (uint32_t)strtoul(argv[a] + 7, NULL, 10);
+        }
+        else if (strncmp(argv[a], "--command=", 10) == 0)
+        {
+            command = argv[a] + 10;
+        }
+        else if (strncmp(argv[a], "--corrupt=", 10) == 0)
+        {
+            corrupt = (uint32_t)strtoul(argv[a] + 10, NULL, 10);
+        }
+        else
+        {
+            printf("uart_send: unknown option %s.\n", argv[a]);
+            
+            return 1;
+        }
+    }
+    
+    /* load the image */
+    f = fopen(argv[2], "rb");
+    if (f == NULL)
+    {
+        printf("uart_send: open %s failed.\n", argv[2]);
+        
+        return 1;
+    }
+    (void)fseek(f, 0, SEEK_END);
+    gs_size = (uint32_t)ftell(f);
+    (void)fseek(f, 0, SEEK_SET);
+    chunks = (gs_size + STREAM_CHUNK_SIZE - 1) / STREAM_CHUNK_SIZE;
+    gs_image = malloc(gs_size + 1);
+    gs_sent = calloc(chunks + 1, 1);
+    if ((gs_image == NULL) || (gs_sent == NULL) || (fread(gs_image, 1, gs_size, f) != gs_size) || (chunks > 0xFFFF))
+    {
+        printf("uart_send: read %s failed.\n", argv[2]);
+        (void)fclose(f);
+        
+        return 1;
+    }
+    (void)fclose(f);
+    
+    /* open the tty in raw mode */
+    fd = open(argv[1], O_RDWR | O_NOCTTY);
+    if ((fd < 0) || (tcgetattr(fd, &tio) != 0) || (a_send_speed(baud) == B0))
+    {
+        printf("uart_send: open %s failed.\n", argv[1]);
+        
+        return 1;
+    }
+    cfmakeraw(&tio);
+    (void)cfsetispeed(&tio, a_send_speed(baud));
+    (void)cfsetospeed(&tio, a_send_speed(baud));
+    (void)tcsetattr(fd, TCSANOW, &tio);
+    (void)tcflush(fd, TCIOFLUSH);
+    
+    /* send the shell command, the shell takes a line without the line end */
+    if ((command[0] != 0) && (write(fd, command, strlen(command)) != (ssize_t)strlen(command)))
+    {
+        printf("uart_send: write %s failed.\n", argv[1]);
+        
+        return 1;
+    }
+    
+    /* serve the requests, the other bytes are the shell text */
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    last = a_send_ms();
+    while ((a_send_ms() - last) < ((done != 0) ? 300 : SEND_IDLE_MS))
+    {
+        uint8_t buf[256];
+        ssize_t r;
+        ssize_t i;
+        
+        if (poll(&pfd, 1, 50) <= 0)
+        {
+            continue;
+        }
+        r = read(fd, buf, sizeof(buf));
+        if (r <= 0)
+        {
+            break;
+        }
+        last = a_send_ms();
+        for (i = 0; i < r; i++)
+        {
+            if ((reply_len == 0) && (buf[i] != STREAM_SYNC_REPLY))
+            {
+                (void)putchar(buf[i]);
+                
+                continue;
+            }
+            reply[reply_len++] = buf[i];
+            if (reply_len < 4)
+            {
+                continue;
+            }
+            reply_len = 0;
+            
+            /* run the reply */
+            if (reply[1] == STREAM_REPLY_REQUEST)
+            {
+                uint16_t seq = (uint16_t)(reply[2] | (reply[3] << 8));
+                
+                if (seq > chunks)
+                {
+                    failed = 1;
+                    done = a_send_ms();
+                    
+                    continue;
+                }
+                if (seq == 0 && start == 0)
+                {
+                    start = a_send_ms();
+                }
+                if (gs_sent[seq] != 0)
+                {
+                    resends++;
+                }
+                else if (seq != 0)
+                {
+                    frames++;
+                }
+                if (a_send_frame(fd, seq, corrupt) != 0)
+                {
+                    failed = 1;
+                    done = a_send_ms();
+                }
+            }
+            else if (reply[1] == STREAM_REPLY_DONE)
+            {
+                done = a_send_ms();
+            }
+            else
+            {
+                failed = 1;
+                done = a_send_ms();
+            }
+        }
+        fflush(stdout);
+    }
+    
+    /* report */
+    if ((done == 0) || (failed != 0))
+    {
+        printf("\nuart_send: upload failed after %u frames.\n", (unsigned int)frames);
+        
+        return 1;
+    }
+    printf("\nuart_send: %u bytes in %ums, %uB/s, %u frames, %u resends.\n", (unsigned int)gs_size,
+           (unsigned int)(done - start), (unsigned int)((done != start) ? (uint64_t)gs_size * 1000 / (done - start) : 0),
+           (unsigned int)frames, (unsigned int)resends);
+    (void)close(fd);
+    free(gs_image);
+    free(gs_sent);
+    
+    return 0;
+}
@@ -36,11 +36,16 @@
 
 #include "driver_wt588e02b_play_test.h"
 #include "driver_wt588e02b_update_test.h"
+#include "driver_wt588e02b_image_test.h"
 #include "driver_wt588e02b_basic.h"
 #include "shell.h"
 #include "clock.h"
 #include "delay.h"
+#include "sdio.h"
+#include "binfile.h"
+#include "stream.h"
 #include "uart.h"
+#include "wave.h"
 #include "getopt.h"
 #include <stdlib.h>
 
@@ -49,6 +54,186 @@
  */
 uint8_t g_buf[256];                        /**< uart buffer */
 uint16_t volatile g_len;                   /**< uart buffer length */
+static uint32_t gs_sd_buf[16 * 128];       /**< sd bench buffer */
+
+/**
+ * @brief wave report
+ * @note  none
+ */
+static void a_wave_report(void)
+{
+    wave_stats_t stats;
+    
+    /* get the stats */
+    wave_get_stats(&stats);
+    if (stats.frames == 0)
+    {
+        return;
+    }
+    
+    /* print the cycles per frame */
+    wt588e02b_interface_debug_print("wt588e02b: wave %d frames, %d fallbacks.\n", stats.frames, stats.fallbacks);
+    wt588e02b_interface_debug_print("wt588e02b: wave %d cpu cycles per frame, max %d.\n",
+                                    (uint32_t)(stats.busy_cycles / stats.frames), stats.busy_max);
+    wt588e02b_interface_debug_print("wt588e02b: wave %d wire cycles per frame.\n",
+                                    (uint32_t)(stats.wire_cycles / stats.frames));
+}
+
+/**
+ * @brief     stream report
+ * @param[in] *path pointer to a bin file path
+ * @note      only a bin streamed over the uart is reported
+ */
+static void a_stream_report(char *path)
+{
+    stream_stats_t stats;
+    
+    /* check the source */
+    if (strncmp(path, "uart:", 5) != 0)
+    {
+        return;
+    }
+    
+    /* print the throughput */
+    stream_get_stats(&stats);
+    wt588e02b_interface_debug_print("wt588e02b: stream %d bytes %d frames in %dms, %dB/s.\n", stats.bytes, stats.frames, 
+                                    stats.ms, (stats.ms != 0) ? (uint32_t)((uint64_t)stats.bytes * 1000 / stats.ms) : 0);
+    wt588e02b_interface_debug_print("wt588e02b: stream %d retries, %d crc errors.\n", stats.retries, stats.crc_errors);
+}
+
+/**
+ * @brief     delay bench
+ * @param[in] times samples per delay
+ * @note      the error is the achieved minus the requested delay in core cycles
+ */
+static void a_delay_bench(uint32_t times)
+{
+    const uint32_t us[] = {1, 2, 5, 10, 20, 100, 1000};
+    uint32_t fac;
+    uint32_t i;
+    uint32_t j;
+    
+    /* print the backend */
+    fac = SystemCoreClock / 1000000;
+    wt588e02b_interface_debug_print("wt588e02b: delay backend is %s, offset is %d cycles.\n",
+                                    (DELAY_USE_DWT == 1) ? "dwt" : "systick", delay_get_offset());
+    
+    for (i = 0; i < sizeof(us) / sizeof(us[0]); i++)
+    {
+        int32_t err;
+        int32_t min;
+        int32_t max;
+        int64_t sum;
+        uint32_t start;
+        
+        min = INT32_MAX;
+        max = INT32_MIN;
+        sum = 0;
+        for (j = 0; j < times; j++)
+        {
+            start = DWT->CYCCNT;
+            delay_us(us[i]);
+            err = (int32_t)(DWT->CYCCNT - start) - (int32_t)(us[i] * fac);
+            min = (err < min) ? err : min;
+            max = (err > max) ? err : max;
+            sum += err;
+        }
+        wt588e02b_interface_debug_print("wt588e02b: delay %dus error min %d max %d mean %d cycles.\n",
+                                        us[i], min, max, (int32_t)(sum / (int64_t)times));
+    }
+}
+
+/**
+ * @brief     sd read speed
+ * @param[in] bytes read bytes
+ * @param[in] ms used time in ms
+ * @return    speed in KB/s
+ * @note      none
+ */
+static uint32_t a_sd_speed(uint32_t bytes, uint32_t ms)
+{
+    if (ms == 0)
+    {
+        ms = 1;
+    }
+    
+    return (uint32_t)(((uint64_t)bytes * 1000) / ((uint64_t)ms * 1024));
+}
+
+/**
+ * @brief     sd bench
+ * @param[in] *path pointer to a bin file path
+ * @param[in] times reads per raw case
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_sd_bench(char *path, uint32_t times)
+{
+    const uint32_t cnt[] = {1, 16};
+    binfile_info_t info;
+    uint8_t width;
+    uint32_t clock_khz;
+    uint32_t size;
+    uint32_t start;
+    uint32_t addr;
+    uint32_t i;
+    uint32_t j;
+    
+    /* mount and open the file */
+    if (wt588e02b_interface_bin_read_init(path, &size) != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: open %s failed.\n", path);
+        
+        return 1;
+    }
+    
+    /* print the bus */
+    sdio_get_bus(&width, &clock_khz);
+    wt588e02b_interface_debug_print("wt588e02b: sd bus is %d bit, clock is %dkHz.\n", width, clock_khz);
+    
+    /* raw reads */
+    for (i = 0; i < sizeof(cnt) / sizeof(cnt[0]); i++)
+    {
+        start = HAL_GetTick();
+        for (j = 0; j < times; j++)
+        {
+            if (sdio_read(j * cnt[i], (uint8_t *)gs_sd_buf, cnt[i]) != 0)
+            {
+                wt588e02b_interface_debug_print("wt588e02b: sd read failed.\n");
+                (void)wt588e02b_interface_bin_read_deinit();
+                
+                return 1;
+            }
+        }
+        wt588e02b_interface_debug_print("wt588e02b: sd raw %d sector reads %dKB/s.\n",
+                                        cnt[i], a_sd_speed(times * cnt[i] * 512, HAL_GetTick() - start));
+    }
+    
+    /* file reads through the update path */
+    start = HAL_GetTick();
+    for (addr = 0; addr < size; addr += 512)
+    {
+        if (wt588e02b_interface_bin_read(addr, 512, (uint8_t *)gs_sd_buf) != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: bin read failed.\n");
+            (void)wt588e02b_interface_bin_read_deinit();
+            
+            return 1;
+        }
+    }
+    wt588e02b_interface_debug_print("wt588e02b: sd file %d bytes %dKB/s.\n",
+                                    size, a_sd_speed(size, HAL_GetTick() - start));
+    binfile_get_info(&info);
+    wt588e02b_interface_debug_print("wt588e02b: sd fast seek %s, %d fragments, %d mounts.\n",
+                                    (info.fast_seek != 0) ? "on" : "off", info.fragments, info.mounts);
+    
+    /* close the file */
+    (void)wt588e02b_interface_bin_read_deinit();
+    
+    return 0;
+}
 
 /**
  * @brief     wt588e02b full function
@@ -76,6 +261,8 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         {"index", required_argument, NULL, 2},
         {"vol", required_argument, NULL, 3},
         {"list", required_argument, NULL, 4},
+        {"wave", required_argument, NULL, 5},
+        {"times", required_argument, NULL, 6},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
@@ -85,6 +272,8 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
     uint16_t number = 123;
     uint8_t number_len = 3;
     uint8_t list[63];
+    wave_mode_t mode = WAVE_MODE_DMA;
+    uint32_t times = 1000;
     
     /* if no params */
     if (argc == 1)
@@ -250,6 +439,39 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
                 break;
             }
             
+            /* wave */
+            case 5 :
+            {
+                /* set the wave mode */
+                if (strcmp("dma", optarg) == 0)
+                {
+                    mode = WAVE_MODE_DMA;
+                }
+                else if (strcmp("gpio", optarg) == 0)
+                {
+                    mode = WAVE_MODE_GPIO;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* times */
+            case 6 :
+            {
+                /* set the times */
+                times = atol(optarg);
+                if (times == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -263,6 +485,10 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
             }
         }
     } while (c != -1);
+    
+    /* set the wave mode */
+    (void)wave_set_mode(mode);
+    wave_clear_stats();
 
     /* run the function */
     if (strcmp("t_play", type) == 0)
@@ -289,6 +515,9 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
             return 1;
         }
         
+        a_wave_report();
+        a_stream_report(path);
+        
         return 0;
     }
     else if (strcmp("t_update-all", type) == 0)
@@ -302,6 +531,46 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
             return 1;
         }
         
+        a_wave_report();
+        a_stream_report(path);
+        
+        return 0;
+    }
+    else if (strcmp("t_image", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the image test */
+        res = wt588e02b_image_test(path);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_delay", type) == 0)
+    {
+        /* run the delay bench */
+        wt588e02b_interface_debug_print("wt588e02b: start delay test.\n");
+        a_delay_bench(times);
+        wt588e02b_interface_debug_print("wt588e02b: finish delay test.\n");
+        
+        return 0;
+    }
+    else if (strcmp("t_sd", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the sd bench */
+        wt588e02b_interface_debug_print("wt588e02b: start sd test.\n");
+        res = a_sd_bench(path, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        wt588e02b_interface_debug_print("wt588e02b: finish sd test.\n");
+        
         return 0;
     }
     else if (strcmp("e_play", type) == 0)
@@ -549,6 +818,8 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         
         /* output */
         wt588e02b_interface_debug_print("wt588e02b: update end.\n");
+        a_wave_report();
+        a_stream_report(path);
         
         /* deinit */
         (void)wt588e02b_basic_deinit();
@@ -580,6 +851,8 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         
         /* output */
         wt588e02b_interface_debug_print("wt588e02b: update end.\n");
+        a_wave_report();
+        a_stream_report(path);
         
         /* deinit */
         (void)wt588e02b_basic_deinit();
@@ -594,8 +867,11 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         wt588e02b_interface_debug_print("  wt588e02b (-h | --help)\n");
         wt588e02b_interface_debug_print("  wt588e02b (-p | --port)\n");
         wt588e02b_interface_debug_print("  wt588e02b (-t play | --test=play) [--index=<index>]\n");
-        wt588e02b_interface_debug_print("  wt588e02b (-t update | --test=update) [--index=<index>] [--file=<path>]\n");
-        wt588e02b_interface_debug_print("  wt588e02b (-t update-all | --test=update-all) [--file=<path>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t update | --test=update) [--index=<index>] [--file=<path>] [--wave=<dma | gpio>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t update-all | --test=update-all) [--file=<path>] [--wave=<dma | gpio>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t delay | --test=delay) [--times=<num>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t sd | --test=sd) [--file=<path>] [--times=<num>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-t image | --test=image) [--file=<path>]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e play | --example=play) [--index=<index>]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e play-list | --example=play-list) [--list=<number>]\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e play-loop | --example=play-loop) [--index=<index>]\n");
@@ -603,22 +879,24 @@ uint8_t wt588e02b(uint8_t argc, char **argv)
         wt588e02b_interface_debug_print("  wt588e02b (-e play-loop-all | --example=play-loop-all)\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e stop | --example=stop)\n");
         wt588e02b_interface_debug_print("  wt588e02b (-e volume | --example=volume) [--vol=<volume>]\n");
-        wt588e02b_interface_debug_print("  wt588e02b (-e update | --example=update) [--index=<index>] [--file=<path>]\n");
-        wt588e02b_interface_debug_print("  wt588e02b (-e update-all | --example=update-all) [--file=<path>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-e update | --example=update) [--index=<index>] [--file=<path>] [--wave=<dma | gpio>]\n");
+        wt588e02b_interface_debug_print("  wt588e02b (-e update-all | --example=update-all) [--file=<path>] [--wave=<dma | gpio>]\n");
         wt588e02b_interface_debug_print("\n");
         wt588e02b_interface_debug_print("Options:\n");
         wt588e02b_interface_debug_print("  -e <play | play-list | play-loop | play-loop-advance | play-loop-all | stop | volume | update | update-all>,\n"); 
         wt588e02b_interface_debug_print("      --example=<play | play-list | play-loop | play-loop-advance | play-loop-all | stop | volume | update | update-all>\n");
         wt588e02b_interface_debug_print("                          Run the driver example.\n");
-        wt588e02b_interface_debug_print("      --file=<path>       Set the bin file path.([default: update.bin])\n");
+        wt588e02b_interface_debug_print("      --file=<path>       Set the bin file path, uart: streams it from the host.([default: update.bin])\n");
         wt588e02b_interface_debug_print("  -h, --help              Show the help.\n");
         wt588e02b_interface_debug_print("  -i, --information       Show the chip information.\n");
         wt588e02b_interface_debug_print("      --index=<index>     Set the index of the voice.([default: 0])\n");
         wt588e02b_interface_debug_print("      --list=<number>     Set the list of the voice.([default: 123])\n");
         wt588e02b_interface_debug_print("      --vol=<volume>      Set the volume of the voice.([default: 63])\n");
         wt588e02b_interface_debug_print("  -p, --port              Display the pin connections of the current board.\n");
-        wt588e02b_interface_debug_print("  -t <play | update | update-all>, --test=<play | update | update-all>\n");
+        wt588e02b_interface_debug_print("  -t <play | update | update-all | delay | sd | image>, --test=<play | update | update-all | delay | sd | image>\n");
         wt588e02b_interface_debug_print("                          Run the driver test.\n");
+        wt588e02b_interface_debug_print("      --times=<num>       Set the delay test samples or the sd test reads.([default: 1000])\n");
+        wt588e02b_interface_debug_print("      --wave=<dma | gpio> Clock the update frames with tim1 and dma2 or with the cpu.([default: dma])\n");
         
         return 0;
     }
@@ -37,6 +37,7 @@
 #include "stm32f4xx_it.h"
 #include "sdio.h"
 #include "uart.h"
+#include "wave.h"
 
 /**
  * @brief nmi handler
@@ -231,6 +232,16 @@ void DMA2_Stream3_IRQHandler(void)
     HAL_DMA_IRQHandler(sdio_get_handle()->hdmarx);
 }
 
+/**
+ * @brief dma2 stream1 irq handler
+ * @note  none
+ */
+void DMA2_Stream1_IRQHandler(void)
+{
+    /* run the wave irq handler */
+    wave_irq_handler();
+}
+
 /**
  * @brief sd irq handler
  * @note  none
@@ -62,628 +62,922 @@
 #define WT588E02B_COMMAND_UPDATE_END           0xEF        /**< update end command */
 
 /**
- * @brief      check busy
- * @param[in]  *handle pointer to a wt588e02b handle structure
- * @param[out] *busy pointer to a busy buffer
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief duration profiler definition
  */
-static uint8_t a_wt588e02b_check_busy(wt588e02b_handle_t *handle, uint8_t *busy)
+#define WT588E02B_DURATION_IDLE                0x00        /**< no measurement */
+#define WT588E02B_DURATION_WAIT                0x01        /**< wait for busy */
+#define WT588E02B_DURATION_BUSY                0x02        /**< busy seen */
+#define WT588E02B_DURATION_WAIT_TIMEOUT        500         /**< max 500ms from the frame to busy */
+#define WT588E02B_DURATION_WEIGHT              8           /**< moving average weight */
+#define WT588E02B_DURATION_MAGIC0              0x57        /**< 'W' */
+#define WT588E02B_DURATION_MAGIC1              0x44        /**< 'D' */
+#define WT588E02B_DURATION_VERSION             0x02        /**< record format version, 2 times from the busy edge */
+#define WT588E02B_DURATION_RECORD_SIZE         11          /**< record size */
+
+/**
+ * @brief shadow state definition
+ */
+#define WT588E02B_SHADOW_VOL                   0x01        /**< volume is valid */
+#define WT588E02B_SHADOW_LOOP                  0x02        /**< loop mode and index are valid */
+#define WT588E02B_SHADOW_PENDING               0x80        /**< a command is on the bus */
+#define WT588E02B_SHADOW_BUSY_UNKNOWN          0x00        /**< busy level is unknown */
+#define WT588E02B_SHADOW_BUSY_BUSY             0x01        /**< busy seen after the last command */
+#define WT588E02B_SHADOW_BUSY_IDLE             0x02        /**< chip is known idle */
+#define WT588E02B_SHADOW_BUSY_STOPPED          0x03        /**< stop sent */
+#define WT588E02B_FRAME_US(n)                  (5000 + (n) * 1600)        /**< 5ms lead and 16 x 100us per byte */
+
+/**
+ * @brief coalescing definition
+ */
+#define WT588E02B_COALESCE_MAX                 40                                      /**< max play list length */
+#define WT588E02B_COALESCE_SAVED_US            (WT588E02B_FRAME_US(2) - 1600)          /**< a merged index costs one byte instead of a frame */
+
+/**
+ * @brief frame part definition
+ */
+#define WT588E02B_FRAME_HEAD                   0x01        /**< sclk low and cs low */
+#define WT588E02B_FRAME_TAIL                   0x02        /**< bytes after the lead and cs high */
+#define WT588E02B_FRAME_ALL                    0x03        /**< head, 5ms lead and tail */
+#define WT588E02B_FRAME_LEAD_US                5000        /**< cs low to the first byte */
+
+/**
+ * @brief step state definition
+ */
+#define WT588E02B_STEP_IDLE                    0x00        /**< no command */
+#define WT588E02B_STEP_PLAY                    0x01        /**< play tail */
+#define WT588E02B_STEP_STOP                    0x02        /**< stop tail */
+#define WT588E02B_STEP_UPDATE_ALL              0x03        /**< update all tail */
+#define WT588E02B_STEP_UPDATE_READ             0x04        /**< packet read and status head */
+#define WT588E02B_STEP_UPDATE_STATUS           0x05        /**< status tail and sum check */
+#define WT588E02B_STEP_UPDATE_PACK             0x06        /**< packet frame */
+#define WT588E02B_STEP_UPDATE_END              0x07        /**< update end tail */
+
+/**
+ * @brief image definition
+ */
+#define WT588E02B_IMAGE_HEADER_SIZE            0x60        /**< header size with the tag */
+#define WT588E02B_IMAGE_LIST_TABLE             0x02        /**< u16 list pointer table offset */
+#define WT588E02B_IMAGE_VOICE_TABLE            0x06        /**< u16 voice offset table offset */
+#define WT588E02B_IMAGE_LIST_LAST              0x0A        /**< u16 last list number */
+#define WT588E02B_IMAGE_VOICE_LAST             0x12        /**< u16 last voice index */
+#define WT588E02B_IMAGE_DATA                   0x1C        /**< u32 first voice offset */
+#define WT588E02B_IMAGE_VERSION                0x30        /**< version string */
+#define WT588E02B_IMAGE_VERSION_SIZE           16          /**< version string field size */
+#define WT588E02B_IMAGE_SIZE                   0x41        /**< u24 image size */
+#define WT588E02B_IMAGE_TAG                    0x50        /**< tag string */
+#define WT588E02B_IMAGE_LIST_END               0x00FF      /**< list terminator */
+#define WT588E02B_IMAGE_T3Z_MAGIC              0xA5        /**< first byte of a t3z voice */
+#define WT588E02B_IMAGE_BLOCK_SIZE             512         /**< update packet size */
+
+/**
+ * @brief log ring check definition
+ */
+#if ((WT588E02B_LOG_SIZE == 0) || ((WT588E02B_LOG_SIZE & (WT588E02B_LOG_SIZE - 1)) != 0) || (WT588E02B_LOG_SIZE > 128))
+    #error "WT588E02B_LOG_SIZE must be a power of 2 up to 128"
+#endif
+
+/**
+ * @brief log ring atomic definition
+ * @note  without the gnu builtins the ring keeps one writer context
+ */
+#if defined(__GNUC__) && !defined(__CC_ARM)
+    #define WT588E02B_LOG_BARRIER()            __sync_synchronize()                              /**< full memory barrier */
+    #define WT588E02B_LOG_CAS(P, O, N)         __sync_bool_compare_and_swap((P), (O), (N))       /**< atomic compare and swap */
+    #define WT588E02B_LOG_INC(P)               (void)__sync_fetch_and_add((P), 1)                /**< atomic increment */
+#else
+    #define WT588E02B_LOG_BARRIER()                                                              /**< volatile ordering on a single core */
+    #define WT588E02B_LOG_CAS(P, O, N)         ((*(P) == (O)) ? ((*(P) = (N)), 1) : 0)           /**< plain compare and swap */
+    #define WT588E02B_LOG_INC(P)               ((*(P))++)                                        /**< plain increment */
+#endif
+
+/**
+ * @brief log site definition
+ * @note  the message id of wt588e02b_log_message_t is stored in the record, the format string is only
+ *        used when the ring is disabled and is not compiled into the image without the string feature
+ */
+#if (WT588E02B_LOG_LEVEL >= WT588E02B_LOG_LEVEL_ERROR)
+    #define WT588E02B_ERR(HANDLE, MSG)                a_wt588e02b_log((HANDLE)->log, (HANDLE)->ops->debug_print, WT588E02B_LOG_LEVEL_ERROR, WT588E02B_LOG_MSG_##MSG, 0)
+    #define WT588E02B_ERR_ARG(HANDLE, MSG, ARG)       a_wt588e02b_log((HANDLE)->log, (HANDLE)->ops->debug_print, WT588E02B_LOG_LEVEL_ERROR, WT588E02B_LOG_MSG_##MSG, (uint32_t)(ARG))
+    #define WT588E02B_BUS_ERR(BUS, MSG)               a_wt588e02b_log((BUS)->log, (BUS)->debug_print, WT588E02B_LOG_LEVEL_ERROR, WT588E02B_LOG_MSG_##MSG, 0)
+    #define WT588E02B_BUS_ERR_ARG(BUS, MSG, ARG)      a_wt588e02b_log((BUS)->log, (BUS)->debug_print, WT588E02B_LOG_LEVEL_ERROR, WT588E02B_LOG_MSG_##MSG, (uint32_t)(ARG))
+#else
+    #define WT588E02B_ERR(HANDLE, MSG)                ((void)0)
+    #define WT588E02B_ERR_ARG(HANDLE, MSG, ARG)       ((void)0)
+    #define WT588E02B_BUS_ERR(BUS, MSG)               ((void)0)
+    #define WT588E02B_BUS_ERR_ARG(BUS, MSG, ARG)      ((void)0)
+#endif
+#if (WT588E02B_LOG_LEVEL >= WT588E02B_LOG_LEVEL_WARN)
+    #define WT588E02B_WARN(HANDLE, MSG)               a_wt588e02b_log((HANDLE)->log, (HANDLE)->ops->debug_print, WT588E02B_LOG_LEVEL_WARN, WT588E02B_LOG_MSG_##MSG, 0)
+#else
+    #define WT588E02B_WARN(HANDLE, MSG)               ((void)0)
+#endif
+#if (WT588E02B_LOG_LEVEL >= WT588E02B_LOG_LEVEL_DEBUG)
+    #define WT588E02B_DBG_ARG(HANDLE, MSG, ARG)       a_wt588e02b_log((HANDLE)->log, (HANDLE)->ops->debug_print, WT588E02B_LOG_LEVEL_DEBUG, WT588E02B_LOG_MSG_##MSG, (uint32_t)(ARG))
+    #define WT588E02B_BUS_DBG_ARG(BUS, MSG, ARG)      a_wt588e02b_log((BUS)->log, (BUS)->debug_print, WT588E02B_LOG_LEVEL_DEBUG, WT588E02B_LOG_MSG_##MSG, (uint32_t)(ARG))
+#else
+    #define WT588E02B_DBG_ARG(HANDLE, MSG, ARG)       ((void)0)
+    #define WT588E02B_BUS_DBG_ARG(BUS, MSG, ARG)      ((void)0)
+#endif
+
+/**
+ * @brief log format table definition
+ */
+#if ((WT588E02B_LOG_LEVEL > WT588E02B_LOG_LEVEL_NONE) && (WT588E02B_FEATURE_STRING != 0))
+#define WT588E02B_LOG_MESSAGE_FMT(ID, NAME, FMT)      [ID] = FMT,
+static const char *const gs_wt588e02b_log_fmt[WT588E02B_LOG_MSG_END] =
 {
-    uint8_t res;
-    uint8_t miso;
+    WT588E02B_LOG_MESSAGE_TABLE(WT588E02B_LOG_MESSAGE_FMT)
+};
+#undef WT588E02B_LOG_MESSAGE_FMT
+#endif
+
+/**
+ * @brief     write a log site
+ * @param[in] *log pointer to a log ring, NULL prints the message
+ * @param[in] *print pointer to a debug_print function
+ * @param[in] level log level
+ * @param[in] id message id
+ * @param[in] arg message argument
+ * @note      a writer reserves its slot by moving the head atomically and commits it with the stamp,
+ *            so writers from several threads or an interrupt never share a slot;
+ *            a full ring drops the new record and counts it, so the writer never waits
+ */
+#if (WT588E02B_LOG_LEVEL > WT588E02B_LOG_LEVEL_NONE)
+static void a_wt588e02b_log(wt588e02b_log_t *log, void (*print)(const char *const fmt, ...),
+                            uint8_t level, uint16_t id, uint32_t arg)
+{
+    uint32_t head;
+    wt588e02b_log_record_t *r;
     
-    res = handle->miso_gpio_read(&miso);        /* read data */
-    if (res != 0)                               /* check result */
+    if (log == NULL)                                                               /* check the ring */
     {
-        return 1;                               /* return error */
+#if (WT588E02B_FEATURE_STRING != 0)
+        print(gs_wt588e02b_log_fmt[id], arg);                                      /* format now */
+#else
+        print("wt588e02b: message %d arg %d.\n", id, (int)arg);                    /* print the message id */
+#endif
+        
+        return;                                                                    /* return */
     }
-    if (miso != 0)                              /* check busy */
+    
+    do
     {
-        *busy = 0;                              /* no busy */
-    }
-    else
+        head = log->head;                                                          /* get head */
+        if ((head - log->tail) >= WT588E02B_LOG_SIZE)                              /* check full */
+        {
+            WT588E02B_LOG_INC(&log->lost);                                         /* count the dropped record */
+            
+            return;                                                                /* return */
+        }
+    } while (WT588E02B_LOG_CAS(&log->head, head, head + 1) == 0);                  /* reserve the slot */
+    r = &log->record[head & (WT588E02B_LOG_SIZE - 1)];                             /* get slot */
+    r->id = id;                                                                    /* set id */
+    r->level = level;                                                              /* set level */
+    r->arg = arg;                                                                  /* set arg */
+    r->ms = (log->timestamp_ms != NULL) ? log->timestamp_ms() : 0;                 /* set timestamp */
+    WT588E02B_LOG_BARRIER();                                                       /* publish the record before the stamp */
+    *(volatile uint8_t *)&r->seq = (uint8_t)(head + 1);                            /* commit */
+}
+#endif
+
+/**
+ * @brief     sclk write
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      an attached chip shares the sclk of the bus
+ */
+static uint8_t a_wt588e02b_sclk_write(wt588e02b_handle_t *handle, uint8_t data)
+{
+    if (handle->bus != NULL)                                 /* on a shared bus */
     {
-        *busy = 1;                              /* busy */
+        return handle->bus->sclk_gpio_write(data);           /* write the bus sclk */
     }
     
-    return 0;                                   /* return error */
+    return handle->ops->sclk_gpio_write(data);               /* write the own sclk */
 }
 
 /**
- * @brief     write with no cs
+ * @brief     mosi write
  * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] us delay us in writing
- * @param[in] data input data
+ * @param[in] data written data
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      an attached chip shares the mosi of the bus
  */
-static uint8_t a_wt588e02b_write_with_no_cs(wt588e02b_handle_t *handle, uint32_t us, uint8_t data)
+static uint8_t a_wt588e02b_mosi_write(wt588e02b_handle_t *handle, uint8_t data)
 {
-    uint8_t res;
-    uint8_t mosi;
-    uint8_t i;
-    
-    for (i = 0; i < 8; i++)                         /* loop 8 bits */
+    if (handle->bus != NULL)                                 /* on a shared bus */
     {
-        mosi = (data >> (7 - i)) & 0x01;            /* get output bit */
-        
-        res = handle->mosi_gpio_write(mosi);        /* write one bit */
-        if (res != 0)                               /* check result */
-        {
-            return 1;                               /* return error */
-        }
-        res = handle->sclk_gpio_write(1);           /* set sclk high */
-        if (res != 0)                               /* check result */
-        {
-            return 1;                               /* return error */
-        }
-        handle->delay_us(us);                       /* delay us */
-        res = handle->sclk_gpio_write(0);           /* set sclk low */
-        if (res != 0)                               /* check result */
-        {
-            return 1;                               /* return error */
-        }
-        handle->delay_us(us);                       /* delay us */
+        return handle->bus->mosi_gpio_write(data);           /* write the bus mosi */
     }
     
-    return 0;                                       /* return error */
+    return handle->ops->mosi_gpio_write(data);               /* write the own mosi */
 }
 
 /**
- * @brief      read with no cs
- * @param[in]  *handle pointer to a wt588e02b handle structure
- * @param[in]  us delay us in reading
- * @param[out] *data pointer to a data buffer
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief     duration start
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @note      none
  */
-static uint8_t a_wt588e02b_read_with_no_cs(wt588e02b_handle_t *handle, uint32_t us, uint8_t *data)
+static void a_wt588e02b_duration_start(wt588e02b_handle_t *handle, uint8_t ind)
 {
-    uint8_t res;
-    uint8_t miso;
-    uint8_t i;
-    
-    res = handle->mosi_gpio_write(0);               /* set low */
-    if (res != 0)                                   /* check result */
+#if (WT588E02B_FEATURE_DURATION != 0)
+    if ((handle->duration_table == NULL) || (handle->ops->timestamp_ms == NULL))   /* check the profiler */
     {
-        return 1;                                   /* return error */
-    }
-    *data = 0;                                      /* init 0 */
-    for (i = 0; i < 8; i++)                         /* loop 8 bits */
-    {
-        res = handle->sclk_gpio_write(1);           /* set sclk high */
-        if (res != 0)                               /* check result */
-        {
-            return 1;                               /* return error */
-        }
-        handle->delay_us(us);                       /* delay us */
-        res = handle->sclk_gpio_write(0);           /* set sclk low */
-        if (res != 0)                               /* check result */
-        {
-            return 1;                               /* return error */
-        }
-        res = handle->miso_gpio_read(&miso);        /* read data */
-        if (res != 0)                               /* check result */
-        {
-            return 1;                               /* return error */
-        }
-        if (miso != 0)                              /* check 1 */
-        {
-            *data |= 1 << (7 - i);                  /* set bit */
-        }
-        handle->delay_us(us);                       /* delay us */
+        return;                                                                    /* profiler is disabled */
     }
-    
-    return 0;                                       /* return error */
+
+    handle->duration_table->ind = ind;                                             /* save index */
+    handle->duration_table->start = handle->ops->timestamp_ms();                   /* save start time */
+    handle->duration_table->state = WT588E02B_DURATION_WAIT;                       /* wait for busy */
+#else
+    (void)handle;                                                                  /* no profiler is compiled */
+    (void)ind;                                                                     /* no profiler is compiled */
+#endif
 }
 
 /**
- * @brief      update get status
- * @param[in]  *handle pointer to a wt588e02b handle structure
- * @param[out] *sum pointer to a sum buffer
- * @return     status code
- *             - 0 success
- *             - 1 update get status failed
- * @note       none
+ * @brief     duration update
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] busy busy level
+ * @note      a sample runs from the first busy sample to the first idle sample, so the frame to busy
+ *            latency is not counted and the error is the busy polling period
  */
-static uint8_t a_update_get_status(wt588e02b_handle_t *handle, uint16_t *sum)
+static void a_wt588e02b_duration_update(wt588e02b_handle_t *handle, uint8_t busy)
 {
-    uint8_t res;
-    uint8_t data1;
-    uint8_t data2;
-    
-    *sum = 0;                                                                               /* init 0 */
-    res = handle->sclk_gpio_write(0);                                                       /* set sclk low */
-    if (res != 0)                                                                           /* check result */
+#if (WT588E02B_FEATURE_DURATION != 0)
+    wt588e02b_duration_entry_t *entry;
+    uint32_t elapsed;
+    float x;
+    float delta;
+    float alpha;
+
+    if ((handle->duration_table == NULL) || (handle->ops->timestamp_ms == NULL) || /* check the profiler */
+        (handle->duration_table->state == WT588E02B_DURATION_IDLE))                /* check the state */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                        /* sclk gpio write failed */
-        
-        return 1;                                                                           /* return error */
+        return;                                                                    /* nothing to do */
     }
-    res = handle->cs_gpio_write(0);                                                         /* set cs low */
-    if (res != 0)                                                                           /* check result */
+
+    elapsed = handle->ops->timestamp_ms() - handle->duration_table->start;         /* get elapsed time */
+    if (busy != 0)                                                                 /* check busy */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                          /* cs gpio write failed */
-        
-        return 1;                                                                           /* return error */
+        if (handle->duration_table->state == WT588E02B_DURATION_WAIT)              /* first busy sample */
+        {
+            handle->duration_table->start += elapsed;                              /* restart at the busy edge */
+            handle->duration_table->state = WT588E02B_DURATION_BUSY;               /* busy seen */
+        }
+
+        return;                                                                    /* wait for idle */
     }
-    handle->delay_ms(5);                                                                    /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 20, WT588E02B_COMMAND_UPDATE_STATUS);        /* write command */
-    if (res != 0)                                                                           /* check result */
+    if (handle->duration_table->state == WT588E02B_DURATION_WAIT)                  /* busy not seen yet */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                       /* write with no cs failed */
-        
-        return 1;                                                                           /* return error */
+        if (elapsed > WT588E02B_DURATION_WAIT_TIMEOUT)                             /* check timeout */
+        {
+            handle->duration_table->state = WT588E02B_DURATION_IDLE;               /* drop the sample */
+        }
+
+        return;                                                                    /* wait for busy */
     }
-    handle->delay_us(20);                                                                   /* delay 20us */
-    res = a_wt588e02b_read_with_no_cs(handle, 20, &data1);                                  /* read one byte */
-    if (res != 0)                                                                           /* check result */
+
+    entry = &handle->duration_table->entry[handle->duration_table->ind];           /* get the entry */
+    if (entry->count < 0xFFFFU)                                                    /* check saturation */
     {
-        handle->debug_print("wt588e02b: read with no cs failed.\n");                        /* read with no cs failed */
-        
-        return 1;                                                                           /* return error */
+        entry->count++;                                                            /* count++ */
     }
-    handle->delay_us(20);                                                                   /* delay 20us */
-    res = a_wt588e02b_read_with_no_cs(handle, 20, &data2);                                  /* read one byte */
-    if (res != 0)                                                                           /* check result */
+    if (entry->count < WT588E02B_DURATION_WEIGHT)                                  /* warm up */
     {
-        handle->debug_print("wt588e02b: read2 with no cs failed.\n");                        /* read with no cs failed */
-        
-        return 1;                                                                           /* return error */
+        alpha = 1.0f / (float)(entry->count);                                      /* cumulative average */
     }
-    *sum = (uint16_t)((uint16_t)(data2) << 8) | data1;                                      /* get sum */
-    res = handle->cs_gpio_write(1);                                                         /* set cs high */
-    if (res != 0)                                                                           /* check result */
+    else
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                          /* cs gpio write failed */
-        
-        return 1;                                                                           /* return error */
+        alpha = 1.0f / (float)(WT588E02B_DURATION_WEIGHT);                         /* moving average */
+    }
+    x = (float)(elapsed);                                                          /* convert to float */
+    delta = x - entry->mean_ms;                                                    /* get delta */
+    entry->mean_ms += alpha * delta;                                               /* update mean */
+    entry->var_ms2 = (1.0f - alpha) * (entry->var_ms2 + alpha * delta * delta);    /* update variance */
+    handle->duration_table->state = WT588E02B_DURATION_IDLE;                       /* measurement done */
+#else
+    (void)handle;                                                                  /* no profiler is compiled */
+    (void)busy;                                                                    /* no profiler is compiled */
+#endif
+}
+
+/**
+ * @brief     duration stop
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @note      drops the running sample
+ */
+static void a_wt588e02b_duration_stop(wt588e02b_handle_t *handle)
+{
+#if (WT588E02B_FEATURE_DURATION != 0)
+    if (handle->duration_table != NULL)                                            /* check the profiler */
+    {
+        handle->duration_table->state = WT588E02B_DURATION_IDLE;                   /* stop the profiler */
     }
-    
-    return 0;                                                                               /* success return 0 */
+#else
+    (void)handle;                                                                  /* no profiler is compiled */
+#endif
 }
 
 /**
- * @brief     update
+ * @brief     shadow reset
  * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] addr input address
- * @return    status code
- *            - 0 success
- *            - 1 update failed
  * @note      none
  */
-static uint8_t a_update(wt588e02b_handle_t *handle, uint8_t addr)
+static void a_wt588e02b_shadow_reset(wt588e02b_handle_t *handle)
 {
-    uint8_t res;
-    
-    handle->sum = 0;                                                                     /* init 0 */
-    res = handle->sclk_gpio_write(0);                                                    /* set sclk low */
-    if (res != 0)                                                                        /* check result */
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    handle->shadow_valid = 0;                                    /* nothing is valid */
+    handle->shadow_busy = WT588E02B_SHADOW_BUSY_UNKNOWN;         /* busy level is unknown */
+#else
+    (void)handle;                                                /* no shadow state is compiled */
+#endif
+}
+
+#if (WT588E02B_FEATURE_SHADOW != 0)
+/**
+ * @brief     shadow hit
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] flag shadow valid flag
+ * @return    1 if the cached item can be trusted
+ * @note      none
+ */
+static uint8_t a_wt588e02b_shadow_hit(wt588e02b_handle_t *handle, uint8_t flag)
+{
+    if ((handle->shadow_enable == 0) ||                              /* check enable */
+        ((handle->shadow_valid & WT588E02B_SHADOW_PENDING) != 0) ||  /* last command failed */
+        ((handle->shadow_valid & flag) == 0))                        /* check the item */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                     /* sclk gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        return 0;                                                    /* miss */
     }
-    res = handle->cs_gpio_write(0);                                                      /* set cs low */
-    if (res != 0)                                                                        /* check result */
+    
+    return 1;                                                        /* hit */
+}
+#endif
+
+/**
+ * @brief     shadow volume hit
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] vol volume
+ * @return    1 if the chip already holds the volume
+ * @note      none
+ */
+static uint8_t a_wt588e02b_shadow_vol_hit(wt588e02b_handle_t *handle, uint8_t vol)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    if ((a_wt588e02b_shadow_hit(handle, WT588E02B_SHADOW_VOL) == 0) ||  /* check the volume */
+        (handle->shadow_vol != vol))                                    /* check the value */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        return 0;                                                       /* miss */
     }
-    handle->delay_ms(5);                                                                 /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_UPDATE_ADDR);      /* write command */
-    if (res != 0)                                                                        /* check result */
+    
+    return 1;                                                           /* hit */
+#else
+    (void)handle;                                                       /* no shadow state is compiled */
+    (void)vol;                                                          /* no shadow state is compiled */
+    
+    return 0;                                                           /* miss */
+#endif
+}
+
+/**
+ * @brief     shadow loop hit
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] loop loop mode, 0 means stop
+ * @param[in] ind index, only checked by the single index loops
+ * @return    1 if the command would not change the chip
+ * @note      a stop is only redundant on a known idle chip,
+ *            a loop is only redundant while the chip is not known idle
+ */
+static uint8_t a_wt588e02b_shadow_loop_hit(wt588e02b_handle_t *handle, uint8_t loop, uint8_t ind)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    if ((a_wt588e02b_shadow_hit(handle, WT588E02B_SHADOW_LOOP) == 0) ||        /* check the loop state */
+        (handle->shadow_loop != loop))                                         /* check the mode */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
+        return 0;                                                              /* miss */
     }
-    handle->sum += WT588E02B_COMMAND_UPDATE_ADDR;                                        /* add sum */
-    handle->delay_us(20);                                                                /* delay 20us */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, addr);                               /* write command */
-    if (res != 0)                                                                        /* check result */
+    if (loop == 0)                                                             /* stop */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
+        return (handle->shadow_busy == WT588E02B_SHADOW_BUSY_IDLE) ? 1 : 0;    /* known idle */
     }
-    handle->sum += addr;                                                                 /* add sum */
-    res = handle->cs_gpio_write(1);                                                      /* set cs high */
-    if (res != 0)                                                                        /* check result */
+    if ((loop != 0x03) && (handle->shadow_ind != ind))                         /* check the index */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        return 0;                                                              /* miss */
     }
     
-    return 0;                                                                            /* success return 0 */
+    return (handle->shadow_busy != WT588E02B_SHADOW_BUSY_IDLE) ? 1 : 0;        /* still looping */
+#else
+    (void)handle;                                                              /* no shadow state is compiled */
+    (void)loop;                                                                /* no shadow state is compiled */
+    (void)ind;                                                                 /* no shadow state is compiled */
+    
+    return 0;                                                                  /* miss */
+#endif
 }
 
 /**
- * @brief     update all
+ * @brief     shadow skip
  * @param[in] *handle pointer to a wt588e02b handle structure
- * @return    status code
- *            - 0 success
- *            - 1 update all failed
+ * @param[in] len skipped frame length
  * @note      none
  */
-static uint8_t a_update_all(wt588e02b_handle_t *handle)
+static void a_wt588e02b_shadow_skip(wt588e02b_handle_t *handle, uint8_t len)
 {
-    uint8_t res;
-    
-    handle->sum = 0;                                                                     /* init 0 */
-    res = handle->sclk_gpio_write(0);                                                    /* set sclk low */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                     /* sclk gpio write failed */
-        
-        return 1;                                                                        /* return error */
-    }
-    res = handle->cs_gpio_write(0);                                                      /* set cs low */
-    if (res != 0)                                                                        /* check result */
+#if (WT588E02B_FEATURE_STATS != 0)
+    handle->stats.skipped++;                                     /* skipped++ */
+    handle->stats.saved_us += WT588E02B_FRAME_US(len);           /* add the saved time */
+#else
+    (void)handle;                                                /* no stats are compiled */
+    (void)len;                                                   /* no stats are compiled */
+#endif
+}
+
+/**
+ * @brief     shadow begin
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @note      a command left pending by a failed transfer invalidates everything
+ */
+static void a_wt588e02b_shadow_begin(wt588e02b_handle_t *handle)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    if ((handle->shadow_valid & WT588E02B_SHADOW_PENDING) != 0)        /* last command failed */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        a_wt588e02b_shadow_reset(handle);                              /* drop the shadow state */
     }
-    handle->delay_ms(5);                                                                 /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_UPDATE_ALL);       /* write command */
-    if (res != 0)                                                                        /* check result */
+    handle->shadow_valid |= WT588E02B_SHADOW_PENDING;                  /* set pending */
+#else
+    (void)handle;                                                      /* no shadow state is compiled */
+#endif
+}
+
+/**
+ * @brief     shadow volume
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] vol written volume
+ * @note      none
+ */
+static void a_wt588e02b_shadow_vol(wt588e02b_handle_t *handle, uint8_t vol)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    handle->shadow_vol = vol;                                    /* save volume */
+    handle->shadow_valid |= WT588E02B_SHADOW_VOL;                /* volume is valid */
+#else
+    (void)handle;                                                /* no shadow state is compiled */
+    (void)vol;                                                   /* no shadow state is compiled */
+#endif
+}
+
+/**
+ * @brief     shadow loop
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] loop written loop mode, 0 means no loop
+ * @param[in] ind written index
+ * @param[in] busy busy level after the command
+ * @note      none
+ */
+static void a_wt588e02b_shadow_loop(wt588e02b_handle_t *handle, uint8_t loop, uint8_t ind, uint8_t busy)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    handle->shadow_loop = loop;                                  /* save loop mode */
+    handle->shadow_ind = ind;                                    /* save index */
+    handle->shadow_valid |= WT588E02B_SHADOW_LOOP;               /* loop state is valid */
+    handle->shadow_busy = busy;                                  /* save busy level */
+#else
+    (void)handle;                                                /* no shadow state is compiled */
+    (void)loop;                                                  /* no shadow state is compiled */
+    (void)ind;                                                   /* no shadow state is compiled */
+    (void)busy;                                                  /* no shadow state is compiled */
+#endif
+}
+
+/**
+ * @brief     shadow end
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @note      none
+ */
+static void a_wt588e02b_shadow_end(wt588e02b_handle_t *handle)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    handle->shadow_valid &= (uint8_t)(~WT588E02B_SHADOW_PENDING);        /* clear pending */
+#endif
+#if (WT588E02B_FEATURE_STATS != 0)
+    handle->stats.sent++;                                                /* sent++ */
+#endif
+    (void)handle;                                                        /* maybe unused */
+}
+
+/**
+ * @brief     shadow busy
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] busy busy level
+ * @note      idle only proves the chip stopped after busy was seen or a stop was sent
+ */
+static void a_wt588e02b_shadow_busy(wt588e02b_handle_t *handle, uint8_t busy)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    if (busy != 0)                                                           /* check busy */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
+        handle->shadow_busy = WT588E02B_SHADOW_BUSY_BUSY;                    /* busy seen */
     }
-    handle->sum += WT588E02B_COMMAND_UPDATE_ALL;                                         /* add sum */
-    handle->delay_us(20);                                                                /* delay 20us */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, 0xFF);                               /* write command */
-    if (res != 0)                                                                        /* check result */
+    else if ((handle->shadow_busy == WT588E02B_SHADOW_BUSY_BUSY) ||
+             (handle->shadow_busy == WT588E02B_SHADOW_BUSY_STOPPED))         /* check the state */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
+        handle->shadow_busy = WT588E02B_SHADOW_BUSY_IDLE;                    /* known idle */
     }
-    handle->sum += 0xFF;                                                                 /* add sum */
-    res = handle->cs_gpio_write(1);                                                      /* set cs high */
-    if (res != 0)                                                                        /* check result */
+    else
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
+
     }
-    
-    return 0;                                                                            /* success return 0 */
+#else
+    (void)handle;                                                            /* no shadow state is compiled */
+    (void)busy;                                                              /* no shadow state is compiled */
+#endif
 }
 
 /**
- * @brief     update end
+ * @brief     lock
  * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] wait 1 blocks until the lock is taken, 0 only tries once
  * @return    status code
  *            - 0 success
- *            - 1 update end failed
+ *            - 1 lock failed
+ * @note      a chip on a shared bus always uses the bus lock, no linked lock means single thread use
+ */
+static uint8_t a_wt588e02b_lock(wt588e02b_handle_t *handle, uint8_t wait)
+{
+    if (handle->bus != NULL)                                 /* on a shared bus */
+    {
+        if (handle->bus->lock == NULL)                       /* check the bus lock */
+        {
+            return 0;                                        /* no lock */
+        }
+
+        return handle->bus->lock(wait);                      /* lock the bus */
+    }
+    if (handle->ops->lock == NULL)                           /* check the lock */
+    {
+        return 0;                                            /* no lock */
+    }
+
+    return handle->ops->lock(wait);                          /* lock the chip */
+}
+
+/**
+ * @brief     unlock
+ * @param[in] *handle pointer to a wt588e02b handle structure
  * @note      none
  */
-static uint8_t a_update_end(wt588e02b_handle_t *handle)
+static void a_wt588e02b_unlock(wt588e02b_handle_t *handle)
 {
-    uint8_t res;
-    
-    res = handle->sclk_gpio_write(0);                                                    /* set sclk low */
-    if (res != 0)                                                                        /* check result */
+    if (handle->bus != NULL)                                 /* on a shared bus */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                     /* sclk gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        if (handle->bus->unlock != NULL)                     /* check the bus unlock */
+        {
+            (void)handle->bus->unlock();                     /* unlock the bus */
+        }
     }
-    res = handle->cs_gpio_write(0);                                                      /* set cs low */
-    if (res != 0)                                                                        /* check result */
+    else if (handle->ops->unlock != NULL)                    /* check the unlock */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        (void)handle->ops->unlock();                         /* unlock the chip */
     }
-    handle->delay_ms(5);                                                                 /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_UPDATE_END);       /* write command */
-    if (res != 0)                                                                        /* check result */
+    else
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
+
     }
-    res = handle->cs_gpio_write(1);                                                      /* set cs high */
-    if (res != 0)                                                                        /* check result */
+}
+
+/**
+ * @brief     bus lock
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_bus_lock(wt588e02b_bus_t *bus)
+{
+    if (bus->lock == NULL)                                   /* check the lock */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        return 0;                                            /* no lock */
     }
-    
-    return 0;                                                                            /* success return 0 */
+
+    return bus->lock(1);                                     /* lock the bus */
 }
 
 /**
- * @brief     update send pack
- * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] *buf pointer to a buffer address
- * @param[in] len buffer length
+ * @brief     bus unlock
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @note      none
+ */
+static void a_wt588e02b_bus_unlock(wt588e02b_bus_t *bus)
+{
+    if (bus->unlock != NULL)                                 /* check the unlock */
+    {
+        (void)bus->unlock();                                 /* unlock the bus */
+    }
+}
+
+/**
+ * @brief     bus cs write
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @param[in] data written data
  * @return    status code
  *            - 0 success
- *            - 1 update send pack failed
+ *            - 1 write failed
  * @note      none
  */
-static uint8_t a_update_send_pack(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len)
+static uint8_t a_wt588e02b_bus_cs_write(wt588e02b_bus_t *bus, uint32_t mask, uint8_t data)
 {
-    uint8_t res;
-    uint16_t check;
-    uint16_t i;
+    uint8_t i;
     
-    handle->sum = 0;                                                             /* init 0 */
-    res = handle->sclk_gpio_write(0);                                            /* set sclk low */
-    if (res != 0)                                                                /* check result */
+    if (bus->cs_gpio_write_mask != NULL)                                 /* check the mask hook */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");             /* sclk gpio write failed */
-        
-        return 1;                                                                /* return error */
+        return bus->cs_gpio_write_mask(mask, data);                      /* write all cs at once */
     }
-    res = handle->cs_gpio_write(0);                                              /* set cs low */
-    if (res != 0)                                                                /* check result */
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                         /* loop all chips */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");               /* cs gpio write failed */
-        
-        return 1;                                                                /* return error */
+        if ((mask & (1UL << i)) != 0)                                    /* check the chip */
+        {
+            if (bus->chip[i]->ops->cs_gpio_write(data) != 0)             /* write cs */
+            {
+                return 1;                                                /* return error */
+            }
+        }
     }
-    for (i = 0; i < len; i++)                                                    /* loop all */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     bus write byte
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] us delay us in writing
+ * @param[in] data input data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one sclk or mosi write drives every chip on the bus
+ */
+static uint8_t a_wt588e02b_bus_write_byte(wt588e02b_bus_t *bus, uint32_t us, uint8_t data)
+{
+    uint8_t i;
+    
+    for (i = 0; i < 8; i++)                                            /* loop 8 bits */
     {
-        handle->delay_us(20);
-        res = a_wt588e02b_write_with_no_cs(handle, 2, buf[i]);                   /* write command */
-        if (res != 0)                                                            /* check result */
+        if (bus->mosi_gpio_write((data >> (7 - i)) & 0x01) != 0)       /* write one bit */
         {
-            handle->debug_print("wt588e02b: write with no cs failed.\n");        /* write with no cs failed */
-            
-            return 1;                                                            /* return error */
+            return 1;                                                  /* return error */
         }
-        if ((i % 2) != 0)                                                        /* the second */
+        if (bus->sclk_gpio_write(1) != 0)                              /* set sclk high */
         {
-            check = check | ((uint16_t)(buf[i]) << 8);                           /* set sum */
-            handle->sum += check;                                                /* add sum */
+            return 1;                                                  /* return error */
         }
-        else
+        bus->delay_us(us);                                             /* delay us */
+        if (bus->sclk_gpio_write(0) != 0)                              /* set sclk low */
         {
-            check = buf[i];                                                      /* set sum */
+            return 1;                                                  /* return error */
         }
-    }
-    res = handle->cs_gpio_write(1);                                              /* set cs high */
-    if (res != 0)                                                                /* check result */
-    {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");               /* cs gpio write failed */
-        
-        return 1;                                                                /* return error */
+        bus->delay_us(us);                                             /* delay us */
     }
     
-    return 0;                                                                    /* success return 0 */
+    return 0;                                                          /* success return 0 */
 }
 
 /**
- * @brief     play audio
- * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] ind index
+ * @brief     bus frame
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] len frame length
+ * @param[in] lead_ms delay ms after cs low, 0 means a data packet
+ * @param[in] gap_us delay us between bytes
+ * @param[in] us delay us in writing
  * @return    status code
  *            - 0 success
- *            - 1 play failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 ind > 0xDF
- *            - 5 chip is busy
- * @note      ind > 0xDF
+ *            - 1 frame failed
+ * @note      a data packet also waits gap_us before the first byte
  */
-uint8_t wt588e02b_play(wt588e02b_handle_t *handle, uint8_t ind)
+static uint8_t a_wt588e02b_bus_frame(wt588e02b_bus_t *bus, uint32_t mask, const uint8_t *buf, uint16_t len,
+                                     uint32_t lead_ms, uint32_t gap_us, uint32_t us)
 {
     uint8_t res;
-    uint8_t busy;
-    
-    if (handle == NULL)                                                             /* check handle */
-    {
-        return 2;                                                                   /* return error */
-    }
-    if (handle->inited != 1)                                                        /* check handle initialization */
-    {
-        return 3;                                                                   /* return error */
-    }
-    if (ind > 0xDF)                                                                 /* check result */
-    {
-        handle->debug_print("wt588e02b: ind > 0xDF.\n");                            /* ind > 0xDF */
-        
-        return 4;                                                                   /* return error */
-    }
-    res = a_wt588e02b_check_busy(handle, &busy);                                    /* read busy */
-    if (res != 0)                                                                   /* check result */
-    {
-        handle->debug_print("wt588e02b: check busy failed.\n");                     /* check busy failed */
-        
-        return 1;                                                                   /* return error */
-    }
-    if (busy != 0)                                                                  /* check busy */
-    {
-        handle->debug_print("wt588e02b: chip is busy.\n");                          /* chip is busy */
-        
-        return 5;                                                                   /* return error */
-    }
+    uint16_t i;
     
-    res = handle->sclk_gpio_write(0);                                               /* set sclk low */
-    if (res != 0)                                                                   /* check result */
+    res = bus->sclk_gpio_write(0);                                                 /* set sclk low */
+    if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                /* sclk gpio write failed */
+        WT588E02B_BUS_ERR(bus, SCLK_GPIO_WRITE_FAILED);                            /* sclk gpio write failed */
         
-        return 1;                                                                   /* return error */
+        return 1;                                                                  /* return error */
     }
-    res = handle->cs_gpio_write(0);                                                 /* set cs low */
-    if (res != 0)                                                                   /* check result */
+    res = a_wt588e02b_bus_cs_write(bus, mask, 0);                                  /* set cs low */
+    if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                  /* cs gpio write failed */
+        WT588E02B_BUS_ERR(bus, CS_GPIO_WRITE_FAILED);                              /* cs gpio write failed */
+        (void)a_wt588e02b_bus_cs_write(bus, mask, 1);                              /* release cs */
         
-        return 1;                                                                   /* return error */
+        return 1;                                                                  /* return error */
     }
-    handle->delay_ms(5);                                                            /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY);        /* write command */
-    if (res != 0)                                                                   /* check result */
+    if (lead_ms != 0)                                                              /* check lead */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");               /* write with no cs failed */
-        
-        return 1;                                                                   /* return error */
+        bus->delay_ms(lead_ms);                                                    /* delay ms */
     }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, ind);                           /* write command */
-    if (res != 0)                                                                   /* check result */
+    for (i = 0; i < len; i++)                                                      /* loop all bytes */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");               /* write with no cs failed */
-        
-        return 1;                                                                   /* return error */
+        if ((gap_us != 0) && ((i != 0) || (lead_ms == 0)))                         /* check gap */
+        {
+            bus->delay_us(gap_us);                                                 /* delay us */
+        }
+        res = a_wt588e02b_bus_write_byte(bus, us, buf[i]);                         /* write one byte */
+        if (res != 0)                                                              /* check result */
+        {
+            WT588E02B_BUS_ERR(bus, WRITE_WITH_NO_CS_FAILED);                       /* write with no cs failed */
+            (void)a_wt588e02b_bus_cs_write(bus, mask, 1);                          /* release cs */
+            
+            return 1;                                                              /* return error */
+        }
     }
-    res = handle->cs_gpio_write(1);                                                 /* set cs high */
-    if (res != 0)                                                                   /* check result */
+    res = a_wt588e02b_bus_cs_write(bus, mask, 1);                                  /* set cs high */
+    if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                  /* cs gpio write failed */
+        WT588E02B_BUS_ERR(bus, CS_GPIO_WRITE_FAILED);                              /* cs gpio write failed */
         
-        return 1;                                                                   /* return error */
+        return 1;                                                                  /* return error */
     }
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                                      /* success return 0 */
 }
 
+#if (WT588E02B_FEATURE_UPDATE != 0)
 /**
- * @brief     set the volume
- * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] vol volume
- * @return    status code
- *            - 0 success
- *            - 1 set vol failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 vol > 0x3F
- * @note      vol > 0x3F
+ * @brief      bus read miso
+ * @param[in]  *bus pointer to a wt588e02b bus structure
+ * @param[in]  mask chip mask
+ * @param[out] *data pointer to a level mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
  */
-uint8_t wt588e02b_set_vol(wt588e02b_handle_t *handle, uint8_t vol)
+static uint8_t a_wt588e02b_bus_miso_read(wt588e02b_bus_t *bus, uint32_t mask, uint32_t *data)
 {
-    uint8_t res;
+    uint8_t i;
+    uint8_t level;
     
-    if (handle == NULL)                                                            /* check handle */
-    {
-        return 2;                                                                  /* return error */
-    }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (bus->miso_gpio_read_mask != NULL)                                /* check the mask hook */
     {
-        return 3;                                                                  /* return error */
+        return bus->miso_gpio_read_mask(data);                           /* read all miso at once */
     }
-    if (vol > 0x3F)                                                                /* check result */
+    *data = 0;                                                           /* init 0 */
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                         /* loop all chips */
     {
-        handle->debug_print("wt588e02b: vol > 0x3F.\n");                           /* vol > 0x3F */
-        
-        return 4;                                                                  /* return error */
+        if ((mask & (1UL << i)) != 0)                                    /* check the chip */
+        {
+            if (bus->chip[i]->ops->miso_gpio_read(&level) != 0)          /* read miso */
+            {
+                return 1;                                                /* return error */
+            }
+            if (level != 0)                                              /* check level */
+            {
+                *data |= 1UL << i;                                       /* set bit */
+            }
+        }
     }
     
-    res = handle->sclk_gpio_write(0);                                              /* set sclk low */
-    if (res != 0)                                                                  /* check result */
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      bus update get status
+ * @param[in]  *bus pointer to a wt588e02b bus structure
+ * @param[in]  mask chip mask
+ * @param[out] *sum pointer to a sum array with one entry per chip
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ * @note       every chip shifts its own sum out on its own miso in the same clocks
+ */
+static uint8_t a_wt588e02b_bus_get_status(wt588e02b_bus_t *bus, uint32_t mask, uint16_t *sum)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t k;
+    uint32_t level;
+    
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                   /* loop all chips */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");               /* sclk gpio write failed */
-        
-        return 1;                                                                  /* return error */
+        sum[i] = 0;                                                                /* init 0 */
     }
-    res = handle->cs_gpio_write(0);                                                /* set cs low */
+    res = bus->sclk_gpio_write(0);                                                 /* set sclk low */
     if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                 /* cs gpio write failed */
+        WT588E02B_BUS_ERR(bus, SCLK_GPIO_WRITE_FAILED);                            /* sclk gpio write failed */
         
         return 1;                                                                  /* return error */
     }
-    handle->delay_ms(5);                                                           /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_VOL);        /* write command */
+    res = a_wt588e02b_bus_cs_write(bus, mask, 0);                                  /* set cs low */
     if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");              /* write with no cs failed */
+        WT588E02B_BUS_ERR(bus, CS_GPIO_WRITE_FAILED);                              /* cs gpio write failed */
+        (void)a_wt588e02b_bus_cs_write(bus, mask, 1);                              /* release cs */
         
         return 1;                                                                  /* return error */
     }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, vol);                          /* write command */
-    if (res != 0)                                                                  /* check result */
+    bus->delay_ms(5);                                                              /* delay 5ms */
+    res = a_wt588e02b_bus_write_byte(bus, 20, WT588E02B_COMMAND_UPDATE_STATUS);    /* write command */
+    if (res == 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");              /* write with no cs failed */
-        
-        return 1;                                                                  /* return error */
+        res = bus->mosi_gpio_write(0);                                             /* set low */
     }
-    res = handle->cs_gpio_write(1);                                                /* set cs high */
-    if (res != 0)                                                                  /* check result */
+    for (k = 0; (k < 16) && (res == 0); k++)                                       /* read 2 bytes */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                 /* cs gpio write failed */
-        
-        return 1;                                                                  /* return error */
-    }
-    
-    return 0;                                                                      /* success return 0 */
-}
-
-/**
- * @brief     stop audio
- * @param[in] *handle pointer to a wt588e02b handle structure
- * @return    status code
- *            - 0 success
- *            - 1 stop failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t wt588e02b_stop(wt588e02b_handle_t *handle)
-{
-    uint8_t res;
-    
-    if (handle == NULL)                                                            /* check handle */
-    {
-        return 2;                                                                  /* return error */
-    }
-    if (handle->inited != 1)                                                       /* check handle initialization */
-    {
-        return 3;                                                                  /* return error */
+        if ((k % 8) == 0)                                                          /* new byte */
+        {
+            bus->delay_us(20);                                                     /* delay 20us */
+        }
+        res = bus->sclk_gpio_write(1);                                             /* set sclk high */
+        if (res != 0)                                                              /* check result */
+        {
+            break;                                                                 /* break */
+        }
+        bus->delay_us(20);                                                         /* delay 20us */
+        res = bus->sclk_gpio_write(0);                                             /* set sclk low */
+        if (res != 0)                                                              /* check result */
+        {
+            break;                                                                 /* break */
+        }
+        res = a_wt588e02b_bus_miso_read(bus, mask, &level);                        /* read all miso */
+        if (res != 0)                                                              /* check result */
+        {
+            break;                                                                 /* break */
+        }
+        for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                               /* loop all chips */
+        {
+            if ((level & (1UL << i)) != 0)                                         /* check 1 */
+            {
+                sum[i] |= (uint16_t)(1U << ((k < 8) ? (7 - k) : (15 - (k - 8))));  /* low byte first */
+            }
+        }
+        bus->delay_us(20);                                                         /* delay 20us */
     }
-    
-    res = handle->sclk_gpio_write(0);                                              /* set sclk low */
     if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");               /* sclk gpio write failed */
+        WT588E02B_BUS_ERR(bus, READ_WITH_NO_CS_FAILED);                            /* read with no cs failed */
+        (void)a_wt588e02b_bus_cs_write(bus, mask, 1);                              /* release cs */
         
         return 1;                                                                  /* return error */
     }
-    res = handle->cs_gpio_write(0);                                                /* set cs low */
+    res = a_wt588e02b_bus_cs_write(bus, mask, 1);                                  /* set cs high */
     if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                 /* cs gpio write failed */
+        WT588E02B_BUS_ERR(bus, CS_GPIO_WRITE_FAILED);                              /* cs gpio write failed */
         
         return 1;                                                                  /* return error */
     }
-    handle->delay_ms(5);                                                           /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_STOP);       /* write command */
-    if (res != 0)                                                                  /* check result */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief         bus update check
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[in,out] *mask pointer to a chip mask
+ * @param[in]     expect expected sum
+ * @return        status code
+ *                - 0 success
+ *                - 1 every chip failed
+ * @note          chips with a wrong sum leave the set, the others go on
+ */
+static uint8_t a_wt588e02b_bus_update_check(wt588e02b_bus_t *bus, uint32_t *mask, uint16_t expect)
+{
+    uint8_t i;
+    uint16_t sum[WT588E02B_BUS_MAX_CHIP];
+    
+    if (a_wt588e02b_bus_get_status(bus, *mask, sum) != 0)                          /* get status */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");              /* write with no cs failed */
+        WT588E02B_BUS_ERR(bus, UPDATE_GET_STATUS_FAILED);                          /* update get status failed */
+        *mask = 0;                                                                 /* nothing is known */
         
         return 1;                                                                  /* return error */
     }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, 0xEF);                         /* write command */
-    if (res != 0)                                                                  /* check result */
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                   /* loop all chips */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");              /* write with no cs failed */
-        
-        return 1;                                                                  /* return error */
+        if (((*mask & (1UL << i)) != 0) && (sum[i] != expect))                     /* check sum */
+        {
+            WT588E02B_BUS_ERR_ARG(bus, CHIP_SUM_CHECK_ERROR, i);                   /* sum check error */
+            *mask &= ~(1UL << i);                                                  /* drop the chip */
+        }
     }
-    res = handle->cs_gpio_write(1);                                                /* set cs high */
-    if (res != 0)                                                                  /* check result */
+    if (*mask == 0)                                                                /* check mask */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                 /* cs gpio write failed */
-        
         return 1;                                                                  /* return error */
     }
     
@@ -691,288 +985,470 @@ uint8_t wt588e02b_stop(wt588e02b_handle_t *handle)
 }
 
 /**
- * @brief     play list
- * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] *list pointer to a list buffer
- * @param[in] len length of list
- * @return    status code
- *            - 0 success
- *            - 1 play list failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 len > 40
- *            - 5 list is invalid
- *            - 6 chip is busy
- * @note      len > 40
- *            list > 0xDF
+ * @brief     bus update mask
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @return    mask of the initialized chips
+ * @note      the shadow state of every chip in the set is dropped
  */
-uint8_t wt588e02b_play_list(wt588e02b_handle_t *handle, uint8_t *list, uint8_t len)
+static uint32_t a_wt588e02b_bus_update_mask(wt588e02b_bus_t *bus, uint32_t mask)
 {
     uint8_t i;
-    uint8_t res;
-    uint8_t busy;
     
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
-    {
-        return 3;                                                                        /* return error */
-    }
-    if (len > 40)                                                                        /* check length */
-    {
-        handle->debug_print("wt588e02b: len > 40.\n");                                   /* len > 40 */
-        
-        return 4;                                                                        /* return error */
-    }
-    for (i = 0; i < len; i++)                                                            /* check all */
+    mask &= bus->attached;                                                  /* only attached chips */
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                            /* loop all chips */
     {
-        if (list[i] > 0xDF)                                                              /* check range */
+        if ((mask & (1UL << i)) == 0)                                       /* check the chip */
         {
-            handle->debug_print("wt588e02b: list[%d] > 0xDF.\n", i);                     /* list > 0xDF */
+            continue;                                                       /* next */
+        }
+        if (bus->chip[i]->inited != 1)                                      /* check handle initialization */
+        {
+            mask &= ~(1UL << i);                                            /* remove the chip */
             
-            return 5;                                                                    /* return error */
+            continue;                                                       /* next */
         }
+        a_wt588e02b_shadow_reset(bus->chip[i]);                             /* the chip is rewritten */
     }
-    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("wt588e02b: check busy failed.\n");                          /* check busy failed */
-        
-        return 1;                                                                        /* return error */
-    }
-    if (busy != 0)                                                                       /* check busy */
+    
+    return mask;                                                            /* return mask */
+}
+
+/**
+ * @brief         bus update
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[in,out] *mask pointer to a chip mask
+ * @param[in]     *cmd pointer to a 2 bytes update command
+ * @param[in]     *path pointer to a path buffer
+ * @param[in]     all update all flag
+ * @return        status code
+ *                - 0 success
+ *                - 1 update failed
+ *                - 4 bin read init failed
+ *                - 5 bin size is invalid
+ * @note          every packet is read once and clocked into all chips of the set
+ */
+static uint8_t a_wt588e02b_bus_update(wt588e02b_bus_t *bus, uint32_t *mask, const uint8_t *cmd, char *path, uint8_t all)
+{
+    uint8_t res;
+    uint16_t expect;
+    uint16_t i;
+    uint32_t size;
+    uint32_t addr;
+    uint32_t n;
+    
+    if ((bus->bin_read_init == NULL) || (bus->bin_read == NULL) ||
+        (bus->bin_read_deinit == NULL))                                                    /* check bin read */
     {
-        handle->debug_print("wt588e02b: chip is busy.\n");                               /* chip is busy */
+        WT588E02B_BUS_ERR(bus, BUS_BIN_READ_NULL);                                         /* bus bin read is null */
         
-        return 6;                                                                        /* return error */
+        return 4;                                                                          /* return error */
     }
-    
-    res = handle->sclk_gpio_write(0);                                                    /* set sclk low */
-    if (res != 0)                                                                        /* check result */
+    res = bus->bin_read_init(path, &size);                                                 /* bin read init */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                     /* sclk gpio write failed */
+        WT588E02B_BUS_ERR(bus, BIN_READ_INIT_FAILED);                                      /* bin read init failed */
         
-        return 1;                                                                        /* return error */
+        return 4;                                                                          /* return error */
     }
-    res = handle->cs_gpio_write(0);                                                      /* set cs low */
-    if (res != 0)                                                                        /* check result */
+    if ((all != 0) && ((size % 512) != 0))                                                 /* check size */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
+        WT588E02B_BUS_ERR(bus, BIN_SIZE_INVALID);                                          /* bin size is invalid */
+        (void)bus->bin_read_deinit();                                                      /* bin read deinit */
         
-        return 1;                                                                        /* return error */
+        return 5;                                                                          /* return error */
     }
-    handle->delay_ms(5);                                                                 /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LIST);        /* write command */
-    if (res != 0)                                                                        /* check result */
+    res = a_wt588e02b_bus_frame(bus, *mask, cmd, 2, 5, 20, 100);                           /* update command */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
+        WT588E02B_BUS_ERR(bus, UPDATE_FAILED);                                             /* update failed */
+        (void)bus->bin_read_deinit();                                                      /* bin read deinit */
         
-        return 1;                                                                        /* return error */
+        return 1;                                                                          /* return error */
     }
-    for (i = 0; i < len; i ++)                                                           /* write all */
+    expect = (uint16_t)(cmd[0] + cmd[1]);                                                  /* command sum */
+    bus->delay_ms(30);                                                                     /* delay 30ms */
+    for (addr = 0; addr < size; addr += 512)                                               /* loop all packets */
     {
-        res = a_wt588e02b_write_with_no_cs(handle, 100, list[i]);                        /* write command */
-        if (res != 0)                                                                    /* check result */
+        n = size - addr;                                                                   /* get remain */
+        if (n > 512)                                                                       /* check remain */
+        {
+            n = 512;                                                                       /* one packet */
+        }
+        bus->delay_ms(16);                                                                 /* delay 16ms */
+        memset(bus->buf, 0, sizeof(uint8_t) * 512);                                        /* init 0 */
+        res = bus->bin_read(addr, (uint16_t)n, bus->buf);                                  /* bin read */
+        if (res != 0)                                                                      /* check result */
         {
-            handle->debug_print("wt588e02b: write with no cs failed.\n");                /* write with no cs failed */
+            WT588E02B_BUS_ERR(bus, BIN_READ_FAILED);                                       /* bin read failed */
+            (void)bus->bin_read_deinit();                                                  /* bin read deinit */
             
-            return 1;                                                                    /* return error */
+            return 1;                                                                      /* return error */
+        }
+        if (a_wt588e02b_bus_update_check(bus, mask, expect) != 0)                          /* check the last frame */
+        {
+            (void)bus->bin_read_deinit();                                                  /* bin read deinit */
+            
+            return 1;                                                                      /* return error */
+        }
+        bus->delay_ms(1);                                                                  /* delay 1ms */
+        res = a_wt588e02b_bus_frame(bus, *mask, bus->buf, 512, 0, 20, 2);                  /* send pack */
+        if (res != 0)                                                                      /* check result */
+        {
+            WT588E02B_BUS_ERR(bus, UPDATE_SEND_PACK_FAILED);                               /* update send pack failed */
+            (void)bus->bin_read_deinit();                                                  /* bin read deinit */
+            
+            return 1;                                                                      /* return error */
+        }
+        WT588E02B_BUS_DBG_ARG(bus, BUS_UPDATE_PACK_SENT, addr / 512);                      /* pack sent */
+        expect = 0;                                                                        /* init 0 */
+        for (i = 0; i < 512; i += 2)                                                       /* word sum */
+        {
+            expect = (uint16_t)(expect + (uint16_t)(bus->buf[i] | ((uint16_t)bus->buf[i + 1] << 8)));
         }
     }
-    res = handle->cs_gpio_write(1);                                                      /* set cs high */
-    if (res != 0)                                                                        /* check result */
+    bus->buf[0] = WT588E02B_COMMAND_UPDATE_END;                                            /* set end */
+    res = a_wt588e02b_bus_frame(bus, *mask, bus->buf, 1, 5, 0, 100);                       /* update end */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
+        WT588E02B_BUS_ERR(bus, UPDATE_END_FAILED);                                         /* update end failed */
+        (void)bus->bin_read_deinit();                                                      /* bin read deinit */
         
-        return 1;                                                                        /* return error */
+        return 1;                                                                          /* return error */
+    }
+    res = bus->bin_read_deinit();                                                          /* bin read deinit */
+    if (res != 0)                                                                          /* check result */
+    {
+        WT588E02B_BUS_ERR(bus, BIN_READ_DEINIT_FAILED);                                    /* bin read deinit failed */
+        
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
+#endif
+
 
 /**
- * @brief     play loop
- * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] ind index
- * @return    status code
- *            - 0 success
- *            - 1 play loop failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 ind > 0xDF
- *            - 5 chip is busy
- * @note      ind > 0xDF
+ * @brief      read busy
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *busy pointer to a busy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       only samples miso, so it is safe without the lock
  */
-uint8_t wt588e02b_play_loop(wt588e02b_handle_t *handle, uint8_t ind)
+static uint8_t a_wt588e02b_read_busy(wt588e02b_handle_t *handle, uint8_t *busy)
 {
     uint8_t res;
-    uint8_t busy;
+    uint8_t miso;
     
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
-    {
-        return 3;                                                                        /* return error */
-    }
-    if (ind > 0xDF)                                                                      /* check result */
+    res = handle->ops->miso_gpio_read(&miso);   /* read data */
+    if (res != 0)                               /* check result */
     {
-        handle->debug_print("wt588e02b: ind > 0xDF.\n");                                 /* ind > 0xDF */
-        
-        return 4;                                                                        /* return error */
+        return 1;                               /* return error */
     }
-    
-    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
-    if (res != 0)                                                                        /* check result */
+    if (miso != 0)                              /* check busy */
     {
-        handle->debug_print("wt588e02b: check busy failed.\n");                          /* check busy failed */
-        
-        return 1;                                                                        /* return error */
+        *busy = 0;                              /* no busy */
     }
-    if (busy != 0)                                                                       /* check busy */
+    else
     {
-        handle->debug_print("wt588e02b: chip is busy.\n");                               /* chip is busy */
-        
-        return 5;                                                                        /* return error */
+        *busy = 1;                              /* busy */
     }
+
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      check busy
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *busy pointer to a busy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the caller holds the lock
+ */
+static uint8_t a_wt588e02b_check_busy(wt588e02b_handle_t *handle, uint8_t *busy)
+{
+    uint8_t res;
     
-    res = handle->sclk_gpio_write(0);                                                    /* set sclk low */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                     /* sclk gpio write failed */
-        
-        return 1;                                                                        /* return error */
-    }
-    res = handle->cs_gpio_write(0);                                                      /* set cs low */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
-    }
-    handle->delay_ms(5);                                                                 /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LOOP);        /* write command */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
-    }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, 0x02);                               /* write command */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
-    }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, ind);                                /* write command */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
-        return 1;                                                                        /* return error */
-    }
-    res = handle->cs_gpio_write(1);                                                      /* set cs high */
-    if (res != 0)                                                                        /* check result */
+    res = a_wt588e02b_read_busy(handle, busy);  /* read busy */
+    if (res != 0)                               /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
-        
-        return 1;                                                                        /* return error */
+        return 1;                               /* return error */
     }
-    
-    return 0;                                                                            /* success return 0 */
+    a_wt588e02b_duration_update(handle, *busy); /* update the profiler */
+    a_wt588e02b_shadow_busy(handle, *busy);     /* update the shadow state */
+
+    return 0;                                   /* success return 0 */
 }
 
 /**
- * @brief     play loop advance
+ * @brief     write with no cs
  * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] ind index
+ * @param[in] us delay us in writing
+ * @param[in] data input data
  * @return    status code
  *            - 0 success
- *            - 1 play loop advance failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 ind > 0xDF
- *            - 5 chip is busy
- * @note      ind > 0xDF
+ *            - 1 write failed
+ * @note      none
  */
-uint8_t wt588e02b_play_loop_advance(wt588e02b_handle_t *handle, uint8_t ind)
+static uint8_t a_wt588e02b_write_with_no_cs(wt588e02b_handle_t *handle, uint32_t us, uint8_t data)
 {
     uint8_t res;
-    uint8_t busy;
+    uint8_t mosi;
+    uint8_t i;
     
-    if (handle == NULL)                                                                  /* check handle */
+    for (i = 0; i < 8; i++)                         /* loop 8 bits */
     {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+        mosi = (data >> (7 - i)) & 0x01;            /* get output bit */
+        
+        res = a_wt588e02b_mosi_write(handle, mosi); /* write one bit */
+        if (res != 0)                               /* check result */
+        {
+            return 1;                               /* return error */
+        }
+        res = a_wt588e02b_sclk_write(handle, 1);    /* set sclk high */
+        if (res != 0)                               /* check result */
+        {
+            return 1;                               /* return error */
+        }
+        handle->ops->delay_us(us);                  /* delay us */
+        res = a_wt588e02b_sclk_write(handle, 0);    /* set sclk low */
+        if (res != 0)                               /* check result */
+        {
+            return 1;                               /* return error */
+        }
+        handle->ops->delay_us(us);                  /* delay us */
+    }
+    
+    return 0;                                       /* return error */
+}
+
+/**
+ * @brief     frame lead
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] part frame part
+ * @return    status code
+ *            - 0 success
+ *            - 1 lead failed
+ * @note      the head sets sclk low and cs low, a whole frame also waits the 5ms lead,
+ *            a split frame leaves the lead to the caller between the head and the tail
+ */
+static uint8_t a_wt588e02b_frame_lead(wt588e02b_handle_t *handle, uint8_t part)
+{
+    uint8_t res;
+    
+    if ((part & WT588E02B_FRAME_HEAD) != 0)                                  /* check the head */
     {
-        return 3;                                                                        /* return error */
+        res = a_wt588e02b_sclk_write(handle, 0);                             /* set sclk low */
+        if (res != 0)                                                        /* check result */
+        {
+            WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                   /* sclk gpio write failed */
+            
+            return 1;                                                        /* return error */
+        }
+        res = handle->ops->cs_gpio_write(0);                                 /* set cs low */
+        if (res != 0)                                                        /* check result */
+        {
+            WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                     /* cs gpio write failed */
+            
+            return 1;                                                        /* return error */
+        }
     }
-    if (ind > 0xDF)                                                                      /* check result */
+    if (part == WT588E02B_FRAME_ALL)                                         /* whole frame */
     {
-        handle->debug_print("wt588e02b: ind > 0xDF.\n");                                 /* ind > 0xDF */
-        
-        return 4;                                                                        /* return error */
+        handle->ops->delay_ms(WT588E02B_FRAME_LEAD_US / 1000);               /* delay 5ms */
     }
     
-    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
-    if (res != 0)                                                                        /* check result */
+    return 0;                                                                /* success return 0 */
+}
+
+#if ((WT588E02B_FEATURE_UPDATE != 0) || (WT588E02B_FEATURE_REG != 0))
+/**
+ * @brief      read with no cs
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[in]  us delay us in reading
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_wt588e02b_read_with_no_cs(wt588e02b_handle_t *handle, uint32_t us, uint8_t *data)
+{
+    uint8_t res;
+    uint8_t miso;
+    uint8_t i;
+    
+    res = a_wt588e02b_mosi_write(handle, 0);        /* set low */
+    if (res != 0)                                   /* check result */
     {
-        handle->debug_print("wt588e02b: check busy failed.\n");                          /* check busy failed */
-        
-        return 1;                                                                        /* return error */
+        return 1;                                   /* return error */
     }
-    if (busy != 0)                                                                       /* check busy */
+    *data = 0;                                      /* init 0 */
+    for (i = 0; i < 8; i++)                         /* loop 8 bits */
     {
-        handle->debug_print("wt588e02b: chip is busy.\n");                               /* chip is busy */
-        
-        return 5;                                                                        /* return error */
+        res = a_wt588e02b_sclk_write(handle, 1);    /* set sclk high */
+        if (res != 0)                               /* check result */
+        {
+            return 1;                               /* return error */
+        }
+        handle->ops->delay_us(us);                  /* delay us */
+        res = a_wt588e02b_sclk_write(handle, 0);    /* set sclk low */
+        if (res != 0)                               /* check result */
+        {
+            return 1;                               /* return error */
+        }
+        res = handle->ops->miso_gpio_read(&miso);   /* read data */
+        if (res != 0)                               /* check result */
+        {
+            return 1;                               /* return error */
+        }
+        if (miso != 0)                              /* check 1 */
+        {
+            *data |= 1 << (7 - i);                  /* set bit */
+        }
+        handle->ops->delay_us(us);                  /* delay us */
     }
     
-    res = handle->sclk_gpio_write(0);                                                    /* set sclk low */
-    if (res != 0)                                                                        /* check result */
+    return 0;                                       /* return error */
+}
+#endif
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief      update get status
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *sum pointer to a sum buffer
+ * @param[in]  part frame part
+ * @return     status code
+ *             - 0 success
+ *             - 1 update get status failed
+ * @note       the sum is only read by the tail
+ */
+static uint8_t a_update_get_status(wt588e02b_handle_t *handle, uint16_t *sum, uint8_t part)
+{
+    uint8_t res;
+    uint8_t data1;
+    uint8_t data2;
+    
+    *sum = 0;                                                                               /* init 0 */
+    if (a_wt588e02b_frame_lead(handle, part) != 0)                                          /* sclk low, cs low and the lead */
+    {
+        return 1;                                                                           /* return error */
+    }
+    if ((part & WT588E02B_FRAME_TAIL) == 0)                                                 /* the caller waits the lead */
+    {
+        return 0;                                                                           /* success return 0 */
+    }
+    if (handle->ops->frame_transfer != NULL)                                                /* check the frame transfer */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                     /* sclk gpio write failed */
+        uint8_t tx[3];
+        uint8_t rx[3];
         
-        return 1;                                                                        /* return error */
+        tx[0] = WT588E02B_COMMAND_UPDATE_STATUS;                                            /* set command */
+        tx[1] = 0x00;                                                                       /* mosi low */
+        tx[2] = 0x00;                                                                       /* mosi low */
+        res = handle->ops->frame_transfer(tx, rx, 3, 20, 20);                               /* transfer the frame */
+        if (res != 0)                                                                       /* check result */
+        {
+            WT588E02B_ERR(handle, FRAME_TRANSFER_FAILED);                                   /* frame transfer failed */
+            
+            return 1;                                                                       /* return error */
+        }
+        data1 = rx[1];                                                                      /* get low byte */
+        data2 = rx[2];                                                                      /* get high byte */
+    }
+    else
+    {
+        res = a_wt588e02b_write_with_no_cs(handle, 20, WT588E02B_COMMAND_UPDATE_STATUS);    /* write command */
+        if (res != 0)                                                                       /* check result */
+        {
+            WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                 /* write with no cs failed */
+            
+            return 1;                                                                       /* return error */
+        }
+        handle->ops->delay_us(20);                                                          /* delay 20us */
+        res = a_wt588e02b_read_with_no_cs(handle, 20, &data1);                              /* read one byte */
+        if (res != 0)                                                                       /* check result */
+        {
+            WT588E02B_ERR(handle, READ_WITH_NO_CS_FAILED);                                  /* read with no cs failed */
+            
+            return 1;                                                                       /* return error */
+        }
+        handle->ops->delay_us(20);                                                          /* delay 20us */
+        res = a_wt588e02b_read_with_no_cs(handle, 20, &data2);                              /* read one byte */
+        if (res != 0)                                                                       /* check result */
+        {
+            WT588E02B_ERR(handle, READ2_WITH_NO_CS_FAILED);                                 /* read with no cs failed */
+            
+            return 1;                                                                       /* return error */
+        }
+    }
+    *sum = (uint16_t)((uint16_t)(data2) << 8) | data1;                                      /* get sum */
+    res = handle->ops->cs_gpio_write(1);                                                    /* set cs high */
+    if (res != 0)                                                                           /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                        /* cs gpio write failed */
+        
+        return 1;                                                                           /* return error */
     }
-    res = handle->cs_gpio_write(0);                                                      /* set cs low */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     update
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] addr input address
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ * @note      none
+ */
+static uint8_t a_update(wt588e02b_handle_t *handle, uint8_t addr)
+{
+    uint8_t res;
+    
+    handle->sum = 0;                                                                     /* init 0 */
+    res = a_wt588e02b_sclk_write(handle, 0);                                             /* set sclk low */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                                   /* sclk gpio write failed */
         
         return 1;                                                                        /* return error */
     }
-    handle->delay_ms(5);                                                                 /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LOOP);        /* write command */
+    res = handle->ops->cs_gpio_write(0);                                                 /* set cs low */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
         
         return 1;                                                                        /* return error */
     }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, 0x01);                               /* write command */
+    handle->ops->delay_ms(5);                                                            /* delay 5ms */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_UPDATE_ADDR);      /* write command */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
         
         return 1;                                                                        /* return error */
     }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, ind);                                /* write command */
+    handle->sum += WT588E02B_COMMAND_UPDATE_ADDR;                                        /* add sum */
+    handle->ops->delay_us(20);                                                           /* delay 20us */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, addr);                               /* write command */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
         
         return 1;                                                                        /* return error */
     }
-    res = handle->cs_gpio_write(1);                                                      /* set cs high */
+    handle->sum += addr;                                                                 /* add sum */
+    res = handle->ops->cs_gpio_write(1);                                                 /* set cs high */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
         
         return 1;                                                                        /* return error */
     }
@@ -981,77 +1457,87 @@ uint8_t wt588e02b_play_loop_advance(wt588e02b_handle_t *handle, uint8_t ind)
 }
 
 /**
- * @brief     play loop all
+ * @brief     update all
  * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] part frame part
  * @return    status code
  *            - 0 success
- *            - 1 play loop all failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 chip is busy
+ *            - 1 update all failed
  * @note      none
  */
-uint8_t wt588e02b_play_loop_all(wt588e02b_handle_t *handle)
+static uint8_t a_update_all(wt588e02b_handle_t *handle, uint8_t part)
 {
     uint8_t res;
-    uint8_t busy;
     
-    if (handle == NULL)                                                                  /* check handle */
+    handle->sum = 0;                                                                     /* init 0 */
+    if (a_wt588e02b_frame_lead(handle, part) != 0)                                       /* sclk low, cs low and the lead */
     {
-        return 2;                                                                        /* return error */
+        return 1;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if ((part & WT588E02B_FRAME_TAIL) == 0)                                              /* the caller waits the lead */
     {
-        return 3;                                                                        /* return error */
+        return 0;                                                                        /* success return 0 */
     }
-    
-    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_UPDATE_ALL);       /* write command */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: check busy failed.\n");                          /* check busy failed */
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
         
         return 1;                                                                        /* return error */
     }
-    if (busy != 0)                                                                       /* check busy */
-    {
-        handle->debug_print("wt588e02b: chip is busy.\n");                               /* chip is busy */
-        
-        return 4;                                                                        /* return error */
-    }
-    
-    res = handle->sclk_gpio_write(0);                                                    /* set sclk low */
+    handle->sum += WT588E02B_COMMAND_UPDATE_ALL;                                         /* add sum */
+    handle->ops->delay_us(20);                                                           /* delay 20us */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, 0xFF);                               /* write command */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");                     /* sclk gpio write failed */
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
         
         return 1;                                                                        /* return error */
     }
-    res = handle->cs_gpio_write(0);                                                      /* set cs low */
+    handle->sum += 0xFF;                                                                 /* add sum */
+    res = handle->ops->cs_gpio_write(1);                                                 /* set cs high */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
         
         return 1;                                                                        /* return error */
     }
-    handle->delay_ms(5);                                                                 /* delay 5ms */
-    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LOOP);        /* write command */
-    if (res != 0)                                                                        /* check result */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     update end
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] part frame part
+ * @return    status code
+ *            - 0 success
+ *            - 1 update end failed
+ * @note      none
+ */
+static uint8_t a_update_end(wt588e02b_handle_t *handle, uint8_t part)
+{
+    uint8_t res;
+    
+    if (a_wt588e02b_frame_lead(handle, part) != 0)                                       /* sclk low, cs low and the lead */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
-        
         return 1;                                                                        /* return error */
     }
-    res = a_wt588e02b_write_with_no_cs(handle, 100, 0x03);                               /* write command */
+    if ((part & WT588E02B_FRAME_TAIL) == 0)                                              /* the caller waits the lead */
+    {
+        return 0;                                                                        /* success return 0 */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_UPDATE_END);       /* write command */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: write with no cs failed.\n");                    /* write with no cs failed */
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
         
         return 1;                                                                        /* return error */
     }
-    res = handle->cs_gpio_write(1);                                                      /* set cs high */
+    res = handle->ops->cs_gpio_write(1);                                                 /* set cs high */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");                       /* cs gpio write failed */
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
         
         return 1;                                                                        /* return error */
     }
@@ -1060,547 +1546,4294 @@ uint8_t wt588e02b_play_loop_all(wt588e02b_handle_t *handle)
 }
 
 /**
- * @brief     update audio
+ * @brief     update send pack
  * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] ind index
- * @param[in] *path pointer to a path buffer
+ * @param[in] *buf pointer to a buffer address
+ * @param[in] len buffer length
  * @return    status code
  *            - 0 success
- *            - 1 update failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 bin read init failed
- *            - 5 ind > 0xDF
- * @note      ind > 0xDF
+ *            - 1 update send pack failed
+ * @note      none
  */
-uint8_t wt588e02b_update(wt588e02b_handle_t *handle, uint8_t ind, char *path)
+static uint8_t a_update_send_pack(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len)
 {
     uint8_t res;
-    uint16_t sum;
-    uint32_t size;
-    uint32_t i;
-    uint32_t m;
-    uint32_t n;
-    uint32_t addr;
+    uint16_t check;
+    uint16_t i;
     
-    if (handle == NULL)                                                           /* check handle */
-    {
-        return 2;                                                                 /* return error */
-    }
-    if (handle->inited != 1)                                                      /* check handle initialization */
-    {
-        return 3;                                                                 /* return error */
-    }
-    if (ind > 0xDF)                                                               /* check result */
+    handle->sum = 0;                                                             /* init 0 */
+    res = a_wt588e02b_sclk_write(handle, 0);                                     /* set sclk low */
+    if (res != 0)                                                                /* check result */
     {
-        handle->debug_print("wt588e02b: ind > 0xDF.\n");                          /* ind > 0xDF */
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                           /* sclk gpio write failed */
         
-        return 5;                                                                 /* return error */
+        return 1;                                                                /* return error */
     }
-    
-    res = handle->bin_read_init(path, &size);                                     /* bin read init */
-    if (res != 0)                                                                 /* check result */
+    res = handle->ops->cs_gpio_write(0);                                         /* set cs low */
+    if (res != 0)                                                                /* check result */
     {
-        handle->debug_print("wt588e02b: bin read init failed.\n");                /* bin read init failed */
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                             /* cs gpio write failed */
         
-        return 4;                                                                 /* return error */
+        return 1;                                                                /* return error */
     }
-    
-    m = size / 512;                                                               /* get package number */
-    n = size - m * 512;                                                           /* get package remain */
-    res = a_update(handle, ind);                                                  /* update */
-    if (res != 0)                                                                 /* check result */
+    if (handle->ops->frame_transfer != NULL)                                     /* check the frame transfer */
     {
-        handle->debug_print("wt588e02b: update failed.\n");                       /* update failed */
-        (void)handle->bin_read_deinit();                                          /* bin read deinit */
-        
-        return 1;                                                                 /* return error */
+        res = handle->ops->frame_transfer(buf, NULL, len, 2, 20);                /* transfer the whole pack */
+        if (res != 0)                                                            /* check result */
+        {
+            WT588E02B_ERR(handle, FRAME_TRANSFER_FAILED);                        /* frame transfer failed */
+            
+            return 1;                                                            /* return error */
+        }
     }
-    handle->delay_ms(30);                                                         /* delay 30ms */
-    addr = 0;                                                                     /* init 0 */
-    for (i = 0; i < m; i++)                                                       /* loop all */
+    for (i = 0; i < len; i++)                                                    /* loop all */
     {
-        handle->delay_ms(16);                                                     /* delay 16ms */
-        res = handle->bin_read(addr, 512, handle->buf);                           /* bin read */
-        if (res != 0)                                                             /* check result */
-        {
-            handle->debug_print("wt588e02b: bin read failed.\n");                 /* bin read failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
-        }
-        addr += 512;                                                              /* add 512 */
-        res = a_update_get_status(handle, &sum);                                  /* get status */
-        if (res != 0)                                                             /* check result */
+        if (handle->ops->frame_transfer == NULL)                                 /* bit by bit */
         {
-            handle->debug_print("wt588e02b: update get status failed.\n");        /* update get status failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
+            handle->ops->delay_us(20);
+            res = a_wt588e02b_write_with_no_cs(handle, 2, buf[i]);               /* write command */
+            if (res != 0)                                                        /* check result */
+            {
+                WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                  /* write with no cs failed */
+                
+                return 1;                                                        /* return error */
+            }
         }
-        if (handle->sum != sum)                                                   /* check sum */
+        if ((i % 2) != 0)                                                        /* the second */
         {
-            handle->debug_print("wt588e02b: sum check error.\n");                 /* sum check error */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
+            check = check | ((uint16_t)(buf[i]) << 8);                           /* set sum */
+            handle->sum += check;                                                /* add sum */
         }
-        handle->delay_ms(1);                                                      /* delay 1ms */
-        res = a_update_send_pack(handle, handle->buf, 512);                       /* send pack */
-        if (res != 0)                                                             /* check sum */
+        else
         {
-            handle->debug_print("wt588e02b: update send pack failed.\n");         /* update send pack failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
+            check = buf[i];                                                      /* set sum */
         }
     }
-    if (n != 0)                                                                   /* check remain */
+    res = handle->ops->cs_gpio_write(1);                                         /* set cs high */
+    if (res != 0)                                                                /* check result */
     {
-        handle->delay_ms(16);                                                     /* delay 16ms */
-        memset(handle->buf, 0, sizeof(uint8_t) * 512);                            /* init 0 */
-        res = handle->bin_read(addr, n, handle->buf);                             /* bin read */
-        if (res != 0)                                                             /* check result */
-        {
-            handle->debug_print("wt588e02b: bin read failed.\n");                 /* bin read failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
-        }
-        addr += n;                                                                /* add n */
-        res = a_update_get_status(handle, &sum);                                  /* get status */
-        if (res != 0)                                                             /* check result */
-        {
-            handle->debug_print("wt588e02b: update get status failed.\n");        /* update get status failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
-        }
-        if (handle->sum != sum)                                                   /* check sum */
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                             /* cs gpio write failed */
+        
+        return 1;                                                                /* return error */
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     play one index
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @param[in] part frame part
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 5 chip is busy
+ * @note      busy is checked by the head
+ */
+static uint8_t a_wt588e02b_play(wt588e02b_handle_t *handle, uint8_t ind, uint8_t part)
+{
+    uint8_t res;
+    uint8_t busy;
+    
+    if ((part & WT588E02B_FRAME_HEAD) != 0)                                         /* check the head */
+    {
+        res = a_wt588e02b_check_busy(handle, &busy);                                /* read busy */
+        if (res != 0)                                                               /* check result */
         {
-            handle->debug_print("wt588e02b: sum check error.\n");                 /* sum check error */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
+            WT588E02B_ERR(handle, CHECK_BUSY_FAILED);                               /* check busy failed */
             
-            return 1;                                                             /* return error */
+            return 1;                                                               /* return error */
         }
-        handle->delay_ms(1);                                                      /* delay 1ms */
-        res = a_update_send_pack(handle, handle->buf, 512);                       /* send pack */
-        if (res != 0)                                                             /* check sum */
+        if (busy != 0)                                                              /* check busy */
         {
-            handle->debug_print("wt588e02b: update send pack failed.\n");         /* update send pack failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
+            WT588E02B_WARN(handle, CHIP_BUSY);                                      /* chip is busy */
             
-            return 1;                                                             /* return error */
+            return 5;                                                               /* return error */
         }
+        a_wt588e02b_shadow_begin(handle);                                           /* start the shadow transaction */
     }
-    res = a_update_end(handle);                                                   /* update end */
-    if (res != 0)                                                                 /* check result */
+    if (a_wt588e02b_frame_lead(handle, part) != 0)                                  /* sclk low, cs low and the lead */
     {
-        handle->debug_print("wt588e02b: update end failed.\n");                   /* update end failed */
-        (void)handle->bin_read_deinit();                                          /* bin read deinit */
+        return 1;                                                                   /* return error */
+    }
+    if ((part & WT588E02B_FRAME_TAIL) == 0)                                         /* the caller waits the lead */
+    {
+        return 0;                                                                   /* success return 0 */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY);        /* write command */
+    if (res != 0)                                                                   /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                             /* write with no cs failed */
         
-        return 1;                                                                 /* return error */
+        return 1;                                                                   /* return error */
     }
-    res = handle->bin_read_deinit();                                              /* bin read deinit */
-    if (res != 0)                                                                 /* check result */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, ind);                           /* write command */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("wt588e02b: bin read deinit failed.\n");              /* bin read deinit failed */
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                             /* write with no cs failed */
         
-        return 1;                                                                 /* return error */
+        return 1;                                                                   /* return error */
+    }
+    res = handle->ops->cs_gpio_write(1);                                            /* set cs high */
+    if (res != 0)                                                                   /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                /* cs gpio write failed */
+        
+        return 1;                                                                   /* return error */
     }
+    a_wt588e02b_shadow_loop(handle, 0, ind, WT588E02B_SHADOW_BUSY_UNKNOWN);         /* save the loop state */
+    a_wt588e02b_shadow_end(handle);                                                 /* end the shadow transaction */
+    a_wt588e02b_duration_start(handle, ind);                                        /* start the profiler */
     
-    return 0;                                                                     /* success return 0 */
+    return 0;                                                                       /* success return 0 */
 }
 
 /**
- * @brief     update all audio
+ * @brief     play list
  * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] *path pointer to a path buffer
+ * @param[in] *list pointer to a list buffer
+ * @param[in] len length of list
  * @return    status code
  *            - 0 success
- *            - 1 update failed
+ *            - 1 play list failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 bin read init failed
- *            - 5 bin size is invalid
- * @note      none
+ *            - 4 len > 40
+ *            - 5 list is invalid
+ *            - 6 chip is busy
+ * @note      the caller holds the lock
  */
-uint8_t wt588e02b_update_all(wt588e02b_handle_t *handle, char *path)
+static uint8_t a_wt588e02b_play_list(wt588e02b_handle_t *handle, uint8_t *list, uint8_t len)
 {
+    uint8_t i;
     uint8_t res;
-    uint16_t sum;
-    uint32_t size;
-    uint32_t i;
-    uint32_t m;
-    uint32_t addr;
+    uint8_t busy;
     
-    if (handle == NULL)                                                           /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                 /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                 /* return error */
+        return 3;                                                                        /* return error */
     }
-    
-    res = handle->bin_read_init(path, &size);                                     /* bin read init */
-    if (res != 0)                                                                 /* check result */
+    if (len > 40)                                                                        /* check length */
     {
-        handle->debug_print("wt588e02b: bin read init failed.\n");                /* bin read init failed */
+        WT588E02B_ERR(handle, LEN_INVALID);                                              /* len > 40 */
         
-        return 4;                                                                 /* return error */
+        return 4;                                                                        /* return error */
     }
-    if ((size % 512) != 0)                                                        /* check size */
+    for (i = 0; i < len; i++)                                                            /* check all */
+    {
+        if (list[i] > 0xDF)                                                              /* check range */
+        {
+            WT588E02B_ERR_ARG(handle, LIST_IND_INVALID, i);                              /* list > 0xDF */
+            
+            return 5;                                                                    /* return error */
+        }
+    }
+    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: bin size is invalid.\n");                 /* bin size is invalid */
-        (void)handle->bin_read_deinit();                                          /* bin read deinit */
+        WT588E02B_ERR(handle, CHECK_BUSY_FAILED);                                        /* check busy failed */
         
-        return 5;                                                                 /* return error */
+        return 1;                                                                        /* return error */
+    }
+    if (busy != 0)                                                                       /* check busy */
+    {
+        WT588E02B_WARN(handle, CHIP_BUSY);                                               /* chip is busy */
+        
+        return 6;                                                                        /* return error */
     }
     
-    m = size / 512;                                                               /* get package number */
-    res = a_update_all(handle);                                                   /* update all */
-    if (res != 0)                                                                 /* check result */
+    res = a_wt588e02b_sclk_write(handle, 0);                                             /* set sclk low */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("wt588e02b: update all failed.\n");                   /* update all failed */
-        (void)handle->bin_read_deinit();                                          /* bin read deinit */
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                                   /* sclk gpio write failed */
         
-        return 1;                                                                 /* return error */
+        return 1;                                                                        /* return error */
     }
-    handle->delay_ms(30);                                                         /* delay 30ms */
-    addr = 0;                                                                     /* init 0 */
-    for (i = 0; i < m; i++)                                                       /* loop all */
+    a_wt588e02b_duration_stop(handle);                                                   /* stop the profiler */
+    a_wt588e02b_shadow_begin(handle);                                                    /* start the shadow transaction */
+    res = handle->ops->cs_gpio_write(0);                                                 /* set cs low */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->delay_ms(16);                                                     /* delay 16ms */
-        res = handle->bin_read(addr, 512, handle->buf);                           /* bin read */
-        if (res != 0)                                                             /* check result */
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    handle->ops->delay_ms(5);                                                            /* delay 5ms */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LIST);        /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    for (i = 0; i < len; i ++)                                                           /* write all */
+    {
+        res = a_wt588e02b_write_with_no_cs(handle, 100, list[i]);                        /* write command */
+        if (res != 0)                                                                    /* check result */
         {
-            handle->debug_print("wt588e02b: bin read failed.\n");                 /* bin read failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
+            WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                              /* write with no cs failed */
             
-            return 1;                                                             /* return error */
+            return 1;                                                                    /* return error */
         }
-        addr += 512;                                                              /* add 512 */
-        res = a_update_get_status(handle, &sum);                                  /* get status */
-        if (res != 0)                                                             /* check result */
+    }
+    res = handle->ops->cs_gpio_write(1);                                                 /* set cs high */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_wt588e02b_shadow_loop(handle, 0, list[0], WT588E02B_SHADOW_BUSY_UNKNOWN);          /* save the loop state */
+    a_wt588e02b_shadow_end(handle);                                                      /* end the shadow transaction */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     coalesce drop
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @note      none
+ */
+static void a_wt588e02b_coalesce_drop(wt588e02b_handle_t *handle)
+{
+#if (WT588E02B_FEATURE_COALESCE != 0)
+    if (handle->coalesce != NULL)                         /* check the queue */
+    {
+        handle->coalesce->len = 0;                        /* drop the queued indexes */
+    }
+#else
+    (void)handle;                                         /* no queue is compiled */
+#endif
+}
+
+#if (WT588E02B_FEATURE_COALESCE != 0)
+/**
+ * @brief     coalesce flush
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 4 chip is busy
+ * @note      the queue is kept when the chip is busy
+ */
+static uint8_t a_wt588e02b_coalesce_flush(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t len;
+    
+    if (handle->coalesce == NULL)                                                           /* check the queue */
+    {
+        return 0;                                                                           /* nothing to do */
+    }
+    len = handle->coalesce->len;                                                            /* get length */
+    if (len == 0)                                                                           /* check length */
+    {
+        return 0;                                                                           /* nothing to do */
+    }
+    if (len == 1)                                                                           /* one index */
+    {
+        res = a_wt588e02b_play(handle, handle->coalesce->list[0], WT588E02B_FRAME_ALL);     /* play */
+        if (res == 5)                                                                       /* check busy */
         {
-            handle->debug_print("wt588e02b: update get status failed.\n");        /* update get status failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
+            return 4;                                                                       /* return error */
         }
-        if (handle->sum != sum)                                                   /* check sum */
+    }
+    else
+    {
+        res = a_wt588e02b_play_list(handle, handle->coalesce->list, len);                   /* play list */
+        if (res == 6)                                                                       /* check busy */
         {
-            handle->debug_print("wt588e02b: sum check error.\n");                 /* sum check error */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
-            
-            return 1;                                                             /* return error */
+            return 4;                                                                       /* return error */
         }
-        handle->delay_ms(1);                                                      /* delay 1ms */
-        res = a_update_send_pack(handle, handle->buf, 512);                       /* send pack */
-        if (res != 0)                                                             /* check sum */
+    }
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->coalesce->len = 0;                                                          /* drop the queue */
+        
+        return 1;                                                                           /* return error */
+    }
+#if (WT588E02B_FEATURE_STATS != 0)
+    handle->stats.merged += (uint32_t)(len - 1);                                            /* add merged */
+    handle->stats.saved_us += (uint32_t)(len - 1) * WT588E02B_COALESCE_SAVED_US;            /* add the saved time */
+#endif
+    handle->coalesce->len = 0;                                                              /* clear the queue */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     coalesce push
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 5 chip is busy
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_coalesce_push(wt588e02b_handle_t *handle, uint8_t ind)
+{
+    uint8_t res;
+    
+    if ((handle->coalesce->len != 0) &&
+        (((handle->ops->timestamp_ms() - handle->coalesce->start) >= handle->coalesce->ms) ||
+        (handle->coalesce->len >= WT588E02B_COALESCE_MAX)))                     /* window is closed */
+    {
+        res = a_wt588e02b_coalesce_flush(handle);                               /* flush */
+        if (res == 4)                                                           /* check busy */
+        {
+            return 5;                                                           /* return error */
+        }
+        if (res != 0)                                                           /* check result */
         {
-            handle->debug_print("wt588e02b: update send pack failed.\n");         /* update send pack failed */
-            (void)handle->bin_read_deinit();                                      /* bin read deinit */
+            WT588E02B_ERR(handle, COALESCE_FLUSH_FAILED);                       /* coalesce flush failed */
             
-            return 1;                                                             /* return error */
+            return 1;                                                           /* return error */
+        }
+    }
+    if (handle->coalesce->len == 0)                                             /* first index */
+    {
+        handle->coalesce->start = handle->ops->timestamp_ms();                  /* open the window */
+    }
+    handle->coalesce->list[handle->coalesce->len] = ind;                        /* queue index */
+    handle->coalesce->len++;                                                    /* length++ */
+    
+    return 0;                                                                   /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     coalesce expire
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @note      the caller holds the lock, an expired window is flushed so that a queued play is
+ *            not held back until the next play, the queue is kept when the chip is busy
+ */
+static void a_wt588e02b_coalesce_expire(wt588e02b_handle_t *handle)
+{
+#if (WT588E02B_FEATURE_COALESCE != 0)
+    uint8_t res;
+    
+    if ((handle->coalesce != NULL) && (handle->coalesce->ms != 0) && (handle->coalesce->len != 0) &&
+        ((handle->ops->timestamp_ms() - handle->coalesce->start) >= handle->coalesce->ms))        /* window is closed */
+    {
+        res = a_wt588e02b_coalesce_flush(handle);                                                 /* flush */
+        if ((res != 0) && (res != 4))                                                             /* check result */
+        {
+            WT588E02B_ERR(handle, COALESCE_FLUSH_FAILED);                                         /* coalesce flush failed */
+        }
+    }
+#else
+    (void)handle;                                                                                 /* no queue is compiled */
+#endif
+}
+
+/**
+ * @brief     enter the driver
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] wait 1 blocks until the lock is taken, 0 only tries once
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      takes the lock and flushes an expired coalescing window before the new command
+ */
+static uint8_t a_wt588e02b_enter(wt588e02b_handle_t *handle, uint8_t wait)
+{
+    if (a_wt588e02b_lock(handle, wait) != 0)             /* lock */
+    {
+        return 1;                                        /* return error */
+    }
+    a_wt588e02b_coalesce_expire(handle);                 /* flush an expired window */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     play audio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ind > 0xDF
+ *            - 5 chip is busy
+ * @note      with a coalescing window the index is queued and sent later as one play list,
+ *            busy is then reported by the flush that closes the window, the window is closed by
+ *            the next driver call after it expired or by wt588e02b_coalesce_poll
+ */
+uint8_t wt588e02b_play(wt588e02b_handle_t *handle, uint8_t ind)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if (ind > 0xDF)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, IND_INVALID);                                         /* ind > 0xDF */
+        
+        return 4;                                                                   /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                                          /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                         /* lock failed */
+        
+        return 1;                                                                   /* return error */
+    }
+#if (WT588E02B_FEATURE_COALESCE != 0)
+    if ((handle->coalesce != NULL) && (handle->coalesce->ms != 0))                  /* check the coalescing window */
+    {
+        res = a_wt588e02b_coalesce_push(handle, ind);                               /* queue */
+    }
+    else
+    {
+        res = a_wt588e02b_play(handle, ind, WT588E02B_FRAME_ALL);                   /* play */
+    }
+#else
+    res = a_wt588e02b_play(handle, ind, WT588E02B_FRAME_ALL);                       /* play */
+#endif
+    a_wt588e02b_unlock(handle);                                                     /* unlock */
+    
+    return res;                                                                     /* return the result */
+}
+
+/**
+ * @brief     set the volume
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] vol volume
+ * @return    status code
+ *            - 0 success
+ *            - 1 set vol failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 vol > 0x3F
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_set_vol(wt588e02b_handle_t *handle, uint8_t vol)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (vol > 0x3F)                                                                /* check result */
+    {
+        WT588E02B_ERR(handle, VOL_INVALID);                                        /* vol > 0x3F */
+        
+        return 4;                                                                  /* return error */
+    }
+    if (a_wt588e02b_shadow_vol_hit(handle, vol) != 0)                              /* check the shadow state */
+    {
+        a_wt588e02b_shadow_skip(handle, 2);                                        /* redundant command */
+        
+        return 0;                                                                  /* success return 0 */
+    }
+    
+    res = a_wt588e02b_sclk_write(handle, 0);                                       /* set sclk low */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                             /* sclk gpio write failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    a_wt588e02b_shadow_begin(handle);                                              /* start the shadow transaction */
+    res = handle->ops->cs_gpio_write(0);                                           /* set cs low */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                               /* cs gpio write failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    handle->ops->delay_ms(5);                                                      /* delay 5ms */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_VOL);        /* write command */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                            /* write with no cs failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, vol);                          /* write command */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                            /* write with no cs failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    res = handle->ops->cs_gpio_write(1);                                           /* set cs high */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                               /* cs gpio write failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    a_wt588e02b_shadow_vol(handle, vol);                                           /* save volume */
+    a_wt588e02b_shadow_end(handle);                                                /* end the shadow transaction */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the volume
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] vol volume
+ * @return    status code
+ *            - 0 success
+ *            - 1 set vol failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 vol > 0x3F
+ * @note      vol > 0x3F
+ */
+uint8_t wt588e02b_set_vol(wt588e02b_handle_t *handle, uint8_t vol)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_set_vol(handle, vol);               /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+
+/**
+ * @brief     stop frame
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] part frame part
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_stop_frame(wt588e02b_handle_t *handle, uint8_t part)
+{
+    uint8_t res;
+    
+    if ((part & WT588E02B_FRAME_HEAD) != 0)                                        /* check the head */
+    {
+        a_wt588e02b_duration_stop(handle);                                         /* stop the profiler */
+        a_wt588e02b_shadow_begin(handle);                                          /* start the shadow transaction */
+    }
+    if (a_wt588e02b_frame_lead(handle, part) != 0)                                 /* sclk low, cs low and the lead */
+    {
+        return 1;                                                                  /* return error */
+    }
+    if ((part & WT588E02B_FRAME_TAIL) == 0)                                        /* the caller waits the lead */
+    {
+        return 0;                                                                  /* success return 0 */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_STOP);       /* write command */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                            /* write with no cs failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, 0xEF);                         /* write command */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                            /* write with no cs failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    res = handle->ops->cs_gpio_write(1);                                           /* set cs high */
+    if (res != 0)                                                                  /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                               /* cs gpio write failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    a_wt588e02b_shadow_loop(handle, 0, 0, WT588E02B_SHADOW_BUSY_STOPPED);          /* stop sent */
+    a_wt588e02b_shadow_end(handle);                                                /* end the shadow transaction */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     stop audio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_stop(wt588e02b_handle_t *handle)
+{
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    a_wt588e02b_coalesce_drop(handle);                                             /* drop the queued indexes */
+    if (a_wt588e02b_shadow_loop_hit(handle, 0, 0) != 0)                            /* check the shadow state */
+    {
+        a_wt588e02b_shadow_skip(handle, 2);                                        /* redundant command */
+        
+        return 0;                                                                  /* success return 0 */
+    }
+    
+    return a_wt588e02b_stop_frame(handle, WT588E02B_FRAME_ALL);                    /* send the whole frame */
+}
+
+/**
+ * @brief     stop audio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      an expired coalescing window is flushed first, the indexes of an open window are dropped
+ */
+uint8_t wt588e02b_stop(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_stop(handle);                       /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+
+/**
+ * @brief     play list
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *list pointer to a list buffer
+ * @param[in] len length of list
+ * @return    status code
+ *            - 0 success
+ *            - 1 play list failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len > 40
+ *            - 5 list is invalid
+ *            - 6 chip is busy
+ * @note      len > 40
+ *            list > 0xDF
+ */
+uint8_t wt588e02b_play_list(wt588e02b_handle_t *handle, uint8_t *list, uint8_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_play_list(handle, list, len);       /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+
+#if (WT588E02B_FEATURE_LOOP != 0)
+/**
+ * @brief     play loop
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @return    status code
+ *            - 0 success
+ *            - 1 play loop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ind > 0xDF
+ *            - 5 chip is busy
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_play_loop(wt588e02b_handle_t *handle, uint8_t ind)
+{
+    uint8_t res;
+    uint8_t busy;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (ind > 0xDF)                                                                      /* check result */
+    {
+        WT588E02B_ERR(handle, IND_INVALID);                                              /* ind > 0xDF */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (a_wt588e02b_shadow_loop_hit(handle, 0x02, ind) != 0)                             /* check the shadow state */
+    {
+        a_wt588e02b_shadow_skip(handle, 3);                                              /* redundant command */
+        
+        return 0;                                                                        /* success return 0 */
+    }
+    
+    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CHECK_BUSY_FAILED);                                        /* check busy failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    if (busy != 0)                                                                       /* check busy */
+    {
+        WT588E02B_WARN(handle, CHIP_BUSY);                                               /* chip is busy */
+        
+        return 5;                                                                        /* return error */
+    }
+    
+    res = a_wt588e02b_sclk_write(handle, 0);                                             /* set sclk low */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                                   /* sclk gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_wt588e02b_duration_stop(handle);                                                   /* stop the profiler */
+    a_wt588e02b_shadow_begin(handle);                                                    /* start the shadow transaction */
+    res = handle->ops->cs_gpio_write(0);                                                 /* set cs low */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    handle->ops->delay_ms(5);                                                            /* delay 5ms */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LOOP);        /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, 0x02);                               /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, ind);                                /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = handle->ops->cs_gpio_write(1);                                                 /* set cs high */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_wt588e02b_shadow_loop(handle, 0x02, ind, WT588E02B_SHADOW_BUSY_UNKNOWN);           /* save the loop state */
+    a_wt588e02b_shadow_end(handle);                                                      /* end the shadow transaction */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     play loop
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @return    status code
+ *            - 0 success
+ *            - 1 play loop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ind > 0xDF
+ *            - 5 chip is busy
+ * @note      ind > 0xDF
+ */
+uint8_t wt588e02b_play_loop(wt588e02b_handle_t *handle, uint8_t ind)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_play_loop(handle, ind);             /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+
+/**
+ * @brief     play loop advance
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @return    status code
+ *            - 0 success
+ *            - 1 play loop advance failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ind > 0xDF
+ *            - 5 chip is busy
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_play_loop_advance(wt588e02b_handle_t *handle, uint8_t ind)
+{
+    uint8_t res;
+    uint8_t busy;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (ind > 0xDF)                                                                      /* check result */
+    {
+        WT588E02B_ERR(handle, IND_INVALID);                                              /* ind > 0xDF */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (a_wt588e02b_shadow_loop_hit(handle, 0x01, ind) != 0)                             /* check the shadow state */
+    {
+        a_wt588e02b_shadow_skip(handle, 3);                                              /* redundant command */
+        
+        return 0;                                                                        /* success return 0 */
+    }
+    
+    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CHECK_BUSY_FAILED);                                        /* check busy failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    if (busy != 0)                                                                       /* check busy */
+    {
+        WT588E02B_WARN(handle, CHIP_BUSY);                                               /* chip is busy */
+        
+        return 5;                                                                        /* return error */
+    }
+    
+    res = a_wt588e02b_sclk_write(handle, 0);                                             /* set sclk low */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                                   /* sclk gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_wt588e02b_duration_stop(handle);                                                   /* stop the profiler */
+    a_wt588e02b_shadow_begin(handle);                                                    /* start the shadow transaction */
+    res = handle->ops->cs_gpio_write(0);                                                 /* set cs low */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    handle->ops->delay_ms(5);                                                            /* delay 5ms */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LOOP);        /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, 0x01);                               /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, ind);                                /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = handle->ops->cs_gpio_write(1);                                                 /* set cs high */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_wt588e02b_shadow_loop(handle, 0x01, ind, WT588E02B_SHADOW_BUSY_UNKNOWN);           /* save the loop state */
+    a_wt588e02b_shadow_end(handle);                                                      /* end the shadow transaction */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     play loop advance
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @return    status code
+ *            - 0 success
+ *            - 1 play loop advance failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ind > 0xDF
+ *            - 5 chip is busy
+ * @note      ind > 0xDF
+ */
+uint8_t wt588e02b_play_loop_advance(wt588e02b_handle_t *handle, uint8_t ind)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_play_loop_advance(handle, ind);     /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+
+/**
+ * @brief     play loop all
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 play loop all failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_play_loop_all(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t busy;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (a_wt588e02b_shadow_loop_hit(handle, 0x03, 0) != 0)                               /* check the shadow state */
+    {
+        a_wt588e02b_shadow_skip(handle, 2);                                              /* redundant command */
+        
+        return 0;                                                                        /* success return 0 */
+    }
+    
+    res = a_wt588e02b_check_busy(handle, &busy);                                         /* read busy */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CHECK_BUSY_FAILED);                                        /* check busy failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    if (busy != 0)                                                                       /* check busy */
+    {
+        WT588E02B_WARN(handle, CHIP_BUSY);                                               /* chip is busy */
+        
+        return 4;                                                                        /* return error */
+    }
+    
+    res = a_wt588e02b_sclk_write(handle, 0);                                             /* set sclk low */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                                   /* sclk gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_wt588e02b_duration_stop(handle);                                                   /* stop the profiler */
+    a_wt588e02b_shadow_begin(handle);                                                    /* start the shadow transaction */
+    res = handle->ops->cs_gpio_write(0);                                                 /* set cs low */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    handle->ops->delay_ms(5);                                                            /* delay 5ms */
+    res = a_wt588e02b_write_with_no_cs(handle, 100, WT588E02B_COMMAND_PLAY_LOOP);        /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = a_wt588e02b_write_with_no_cs(handle, 100, 0x03);                               /* write command */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                                  /* write with no cs failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    res = handle->ops->cs_gpio_write(1);                                                 /* set cs high */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                                     /* cs gpio write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_wt588e02b_shadow_loop(handle, 0x03, 0, WT588E02B_SHADOW_BUSY_UNKNOWN);             /* save the loop state */
+    a_wt588e02b_shadow_end(handle);                                                      /* end the shadow transaction */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     play loop all
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 play loop all failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t wt588e02b_play_loop_all(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_play_loop_all(handle);              /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+#endif
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief     update audio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @param[in] *path pointer to a path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 bin read init failed or the update is not linked
+ *            - 5 ind > 0xDF
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_update(wt588e02b_handle_t *handle, uint8_t ind, char *path)
+{
+    uint8_t res;
+    uint16_t sum;
+    uint32_t size;
+    uint32_t i;
+    uint32_t m;
+    uint32_t n;
+    uint32_t addr;
+    
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    if (ind > 0xDF)                                                               /* check result */
+    {
+        WT588E02B_ERR(handle, IND_INVALID);                                       /* ind > 0xDF */
+        
+        return 5;                                                                 /* return error */
+    }
+    
+    if ((handle->ops->bin_read_init == NULL) || (handle->ops->bin_read == NULL) ||
+        (handle->ops->bin_read_deinit == NULL) || (handle->buf == NULL))          /* check the update link */
+    {
+        WT588E02B_ERR(handle, UPDATE_NOT_LINKED);                                 /* update is not linked */
+        
+        return 4;                                                                 /* return error */
+    }
+    a_wt588e02b_shadow_reset(handle);                                             /* the chip is rewritten */
+    res = handle->ops->bin_read_init(path, &size);                                /* bin read init */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, BIN_READ_INIT_FAILED);                              /* bin read init failed */
+        
+        return 4;                                                                 /* return error */
+    }
+    
+    m = size / 512;                                                               /* get package number */
+    n = size - m * 512;                                                           /* get package remain */
+    res = a_update(handle, ind);                                                  /* update */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, UPDATE_FAILED);                                     /* update failed */
+        (void)handle->ops->bin_read_deinit();                                     /* bin read deinit */
+        
+        return 1;                                                                 /* return error */
+    }
+    handle->ops->delay_ms(30);                                                    /* delay 30ms */
+    addr = 0;                                                                     /* init 0 */
+    for (i = 0; i < m; i++)                                                       /* loop all */
+    {
+        handle->ops->delay_ms(16);                                                /* delay 16ms */
+        res = handle->ops->bin_read(addr, 512, handle->buf);                      /* bin read */
+        if (res != 0)                                                             /* check result */
+        {
+            WT588E02B_ERR(handle, BIN_READ_FAILED);                               /* bin read failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        addr += 512;                                                              /* add 512 */
+        res = a_update_get_status(handle, &sum, WT588E02B_FRAME_ALL);             /* get status */
+        if (res != 0)                                                             /* check result */
+        {
+            WT588E02B_ERR(handle, UPDATE_GET_STATUS_FAILED);                      /* update get status failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        if (handle->sum != sum)                                                   /* check sum */
+        {
+            WT588E02B_ERR(handle, SUM_CHECK_ERROR);                               /* sum check error */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_ms(1);                                                 /* delay 1ms */
+        res = a_update_send_pack(handle, handle->buf, 512);                       /* send pack */
+        if (res != 0)                                                             /* check sum */
+        {
+            WT588E02B_ERR(handle, UPDATE_SEND_PACK_FAILED);                       /* update send pack failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        WT588E02B_DBG_ARG(handle, UPDATE_PACK_SENT, i);                           /* pack sent */
+    }
+    if (n != 0)                                                                   /* check remain */
+    {
+        handle->ops->delay_ms(16);                                                /* delay 16ms */
+        memset(handle->buf, 0, sizeof(uint8_t) * 512);                            /* init 0 */
+        res = handle->ops->bin_read(addr, n, handle->buf);                        /* bin read */
+        if (res != 0)                                                             /* check result */
+        {
+            WT588E02B_ERR(handle, BIN_READ_FAILED);                               /* bin read failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        addr += n;                                                                /* add n */
+        res = a_update_get_status(handle, &sum, WT588E02B_FRAME_ALL);             /* get status */
+        if (res != 0)                                                             /* check result */
+        {
+            WT588E02B_ERR(handle, UPDATE_GET_STATUS_FAILED);                      /* update get status failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        if (handle->sum != sum)                                                   /* check sum */
+        {
+            WT588E02B_ERR(handle, SUM_CHECK_ERROR);                               /* sum check error */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_ms(1);                                                 /* delay 1ms */
+        res = a_update_send_pack(handle, handle->buf, 512);                       /* send pack */
+        if (res != 0)                                                             /* check sum */
+        {
+            WT588E02B_ERR(handle, UPDATE_SEND_PACK_FAILED);                       /* update send pack failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+    }
+    res = a_update_end(handle, WT588E02B_FRAME_ALL);                              /* update end */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, UPDATE_END_FAILED);                                 /* update end failed */
+        (void)handle->ops->bin_read_deinit();                                     /* bin read deinit */
+        
+        return 1;                                                                 /* return error */
+    }
+    res = handle->ops->bin_read_deinit();                                         /* bin read deinit */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, BIN_READ_DEINIT_FAILED);                            /* bin read deinit failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     update audio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] ind index
+ * @param[in] *path pointer to a path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 bin read init failed or the update is not linked
+ *            - 5 ind > 0xDF
+ * @note      ind > 0xDF,
+ *            the lock is held for the whole update
+ */
+uint8_t wt588e02b_update(wt588e02b_handle_t *handle, uint8_t ind, char *path)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_update(handle, ind, path);          /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+
+/**
+ * @brief     update all audio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *path pointer to a path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 bin read init failed or the update is not linked
+ *            - 5 bin size is invalid
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_update_all(wt588e02b_handle_t *handle, char *path)
+{
+    uint8_t res;
+    uint16_t sum;
+    uint32_t size;
+    uint32_t i;
+    uint32_t m;
+    uint32_t addr;
+    
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    if ((handle->ops->bin_read_init == NULL) || (handle->ops->bin_read == NULL) ||
+        (handle->ops->bin_read_deinit == NULL) || (handle->buf == NULL))          /* check the update link */
+    {
+        WT588E02B_ERR(handle, UPDATE_NOT_LINKED);                                 /* update is not linked */
+        
+        return 4;                                                                 /* return error */
+    }
+    a_wt588e02b_shadow_reset(handle);                                             /* the chip is rewritten */
+    res = handle->ops->bin_read_init(path, &size);                                /* bin read init */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, BIN_READ_INIT_FAILED);                              /* bin read init failed */
+        
+        return 4;                                                                 /* return error */
+    }
+    if ((size % 512) != 0)                                                        /* check size */
+    {
+        WT588E02B_ERR(handle, BIN_SIZE_INVALID);                                  /* bin size is invalid */
+        (void)handle->ops->bin_read_deinit();                                     /* bin read deinit */
+        
+        return 5;                                                                 /* return error */
+    }
+    
+    m = size / 512;                                                               /* get package number */
+    res = a_update_all(handle, WT588E02B_FRAME_ALL);                              /* update all */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, UPDATE_ALL_FAILED);                                 /* update all failed */
+        (void)handle->ops->bin_read_deinit();                                     /* bin read deinit */
+        
+        return 1;                                                                 /* return error */
+    }
+    handle->ops->delay_ms(30);                                                    /* delay 30ms */
+    addr = 0;                                                                     /* init 0 */
+    for (i = 0; i < m; i++)                                                       /* loop all */
+    {
+        handle->ops->delay_ms(16);                                                /* delay 16ms */
+        res = handle->ops->bin_read(addr, 512, handle->buf);                      /* bin read */
+        if (res != 0)                                                             /* check result */
+        {
+            WT588E02B_ERR(handle, BIN_READ_FAILED);                               /* bin read failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        addr += 512;                                                              /* add 512 */
+        res = a_update_get_status(handle, &sum, WT588E02B_FRAME_ALL);             /* get status */
+        if (res != 0)                                                             /* check result */
+        {
+            WT588E02B_ERR(handle, UPDATE_GET_STATUS_FAILED);                      /* update get status failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        if (handle->sum != sum)                                                   /* check sum */
+        {
+            WT588E02B_ERR(handle, SUM_CHECK_ERROR);                               /* sum check error */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_ms(1);                                                 /* delay 1ms */
+        res = a_update_send_pack(handle, handle->buf, 512);                       /* send pack */
+        if (res != 0)                                                             /* check sum */
+        {
+            WT588E02B_ERR(handle, UPDATE_SEND_PACK_FAILED);                       /* update send pack failed */
+            (void)handle->ops->bin_read_deinit();                                 /* bin read deinit */
+            
+            return 1;                                                             /* return error */
+        }
+    }
+    res = a_update_end(handle, WT588E02B_FRAME_ALL);                              /* update end */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, UPDATE_END_FAILED);                                 /* update end failed */
+        (void)handle->ops->bin_read_deinit();                                     /* bin read deinit */
+        
+        return 1;                                                                 /* return error */
+    }
+    res = handle->ops->bin_read_deinit();                                         /* bin read deinit */
+    if (res != 0)                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, BIN_READ_DEINIT_FAILED);                            /* bin read deinit failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     update all audio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *path pointer to a path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 bin read init failed or the update is not linked
+ *            - 5 bin size is invalid
+ * @note      the lock is held for the whole update
+ */
+uint8_t wt588e02b_update_all(wt588e02b_handle_t *handle, char *path)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
+        
+        return 1;                                         /* return error */
+    }
+    res = a_wt588e02b_update_all(handle, path);           /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
+}
+#endif
+
+/**
+ * @brief      check chip busy
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *enable pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 check busy failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       miso is sampled without the lock, the sample only feeds the profiler
+ *             and the shadow state when the lock is free, an idle sample also flushes an expired
+ *             coalescing window, busy then rises after the play response time
+ */
+uint8_t wt588e02b_check_busy(wt588e02b_handle_t *handle, wt588e02b_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t busy;
+    
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+
+    res = a_wt588e02b_read_busy(handle, &busy);                        /* read busy without the lock */
+    if (res != 0)                                                      /* check result */
+    {
+        WT588E02B_ERR(handle, CHECK_BUSY_FAILED);                      /* check busy failed */
+        
+        return 1;                                                      /* return error */
+    }
+    if (a_wt588e02b_lock(handle, 0) == 0)                              /* try the lock */
+    {
+        a_wt588e02b_duration_update(handle, busy);                     /* update the profiler */
+        a_wt588e02b_shadow_busy(handle, busy);                         /* update the shadow state */
+        if (busy == 0)                                                 /* check idle */
+        {
+            a_wt588e02b_coalesce_expire(handle);                       /* flush an expired window */
+        }
+        a_wt588e02b_unlock(handle);                                    /* unlock */
+    }
+    if (busy != 0)                                                     /* check busy */
+    {
+        *enable = WT588E02B_BOOL_TRUE;                                 /* set true */
+    }
+    else
+    {
+        *enable = WT588E02B_BOOL_FALSE;                                /* set false */
+    }
+
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     deinit the own sclk and mosi gpio
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @note      the bus owns them for an attached chip
+ */
+static void a_wt588e02b_gpio_deinit(wt588e02b_handle_t *handle)
+{
+    if (handle->bus == NULL)                                                 /* check the bus */
+    {
+        (void)handle->ops->sclk_gpio_deinit();                               /* sclk gpio deinit */
+        (void)handle->ops->mosi_gpio_deinit();                               /* mosi gpio deinit */
+    }
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ * @note      the bin read functions and the update buffer are only checked by the update functions,
+ *            so a handle which only plays may leave them NULL
+ */
+uint8_t wt588e02b_init(wt588e02b_handle_t *handle)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->ops == NULL)                                                 /* check ops */
+    {
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->debug_print == NULL)                                    /* check debug_print */
+    {
+        return 3;                                                            /* return error */
+    }
+    if ((handle->bus == NULL) && (handle->ops->sclk_gpio_init == NULL))      /* check sclk_gpio_init */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_INIT_NULL);                          /* sclk_gpio_init is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if ((handle->bus == NULL) && (handle->ops->sclk_gpio_deinit == NULL))    /* check sclk_gpio_deinit */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_DEINIT_NULL);                        /* sclk_gpio_deinit is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if ((handle->bus == NULL) && (handle->ops->sclk_gpio_write == NULL))     /* check sclk_gpio_write */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_NULL);                         /* sclk_gpio_write is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if ((handle->bus == NULL) && (handle->ops->mosi_gpio_init == NULL))      /* check mosi_gpio_init */
+    {
+        WT588E02B_ERR(handle, MOSI_GPIO_INIT_NULL);                          /* mosi_gpio_init is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if ((handle->bus == NULL) && (handle->ops->mosi_gpio_deinit == NULL))    /* check mosi_gpio_deinit */
+    {
+        WT588E02B_ERR(handle, MOSI_GPIO_DEINIT_NULL);                        /* mosi_gpio_deinit is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if ((handle->bus == NULL) && (handle->ops->mosi_gpio_write == NULL))     /* check mosi_gpio_write */
+    {
+        WT588E02B_ERR(handle, MOSI_GPIO_WRITE_NULL);                         /* mosi_gpio_write is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->miso_gpio_init == NULL)                                 /* check miso_gpio_init */
+    {
+        WT588E02B_ERR(handle, MISO_GPIO_INIT_NULL);                          /* miso_gpio_init is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->miso_gpio_deinit == NULL)                               /* check miso_gpio_deinit */
+    {
+        WT588E02B_ERR(handle, MISO_GPIO_DEINIT_NULL);                        /* miso_gpio_deinit is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->miso_gpio_read == NULL)                                 /* check miso_gpio_read */
+    {
+        WT588E02B_ERR(handle, MISO_GPIO_READ_NULL);                          /* miso_gpio_read is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->cs_gpio_init == NULL)                                   /* check cs_gpio_init */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_INIT_NULL);                            /* cs_gpio_init is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->cs_gpio_deinit == NULL)                                 /* check cs_gpio_deinit */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_DEINIT_NULL);                          /* cs_gpio_deinit is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->cs_gpio_write == NULL)                                  /* check cs_gpio_write */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_NULL);                           /* cs_gpio_write is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->delay_ms == NULL)                                       /* check delay_ms */
+    {
+        WT588E02B_ERR(handle, DELAY_MS_NULL);                                /* delay_ms is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if (handle->ops->delay_us == NULL)                                       /* check delay_us */
+    {
+        WT588E02B_ERR(handle, DELAY_US_NULL);                                /* delay_us is null */
+       
+        return 3;                                                            /* return error */
+    }
+    if ((handle->ops->lock == NULL) != (handle->ops->unlock == NULL))        /* check lock and unlock */
+    {
+        WT588E02B_ERR(handle, LOCK_UNLOCK_UNPAIRED);                         /* lock and unlock must be linked together */
+       
+        return 3;                                                            /* return error */
+    }
+    
+    if ((handle->bus == NULL) && (handle->ops->sclk_gpio_init() != 0))       /* sclk gpio init */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_INIT_FAILED);                        /* sclk gpio init failed */
+       
+        return 1;                                                            /* return error */
+    }
+    if ((handle->bus == NULL) && (handle->ops->mosi_gpio_init() != 0))       /* mosi gpio init */
+    {
+        WT588E02B_ERR(handle, MOSI_GPIO_INIT_FAILED);                        /* mosi gpio init failed */
+        (void)handle->ops->sclk_gpio_deinit();                               /* sclk gpio deinit */
+        
+        return 1;                                                            /* return error */
+    }
+    if (handle->ops->miso_gpio_init() != 0)                                  /* miso gpio init */
+    {
+        WT588E02B_ERR(handle, MISO_GPIO_INIT_FAILED);                        /* miso gpio init failed */
+        a_wt588e02b_gpio_deinit(handle);                                     /* sclk and mosi gpio deinit */
+        
+        return 1;                                                            /* return error */
+    }
+    if (handle->ops->cs_gpio_init() != 0)                                    /* cs gpio init */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_INIT_FAILED);                          /* cs gpio init failed */
+        a_wt588e02b_gpio_deinit(handle);                                     /* sclk and mosi gpio deinit */
+        (void)handle->ops->miso_gpio_deinit();                               /* miso gpio deinit */
+        
+        return 1;                                                            /* return error */
+    }
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    handle->sum = 0;                                                         /* init 0 */
+#endif
+    a_wt588e02b_duration_stop(handle);                                       /* init idle */
+    a_wt588e02b_shadow_reset(handle);                                        /* invalidate the shadow state */
+    a_wt588e02b_coalesce_drop(handle);                                       /* empty queue */
+    handle->inited = 1;                                                      /* flag finished */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     deinit the chip
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t wt588e02b_deinit(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    res = (handle->bus == NULL) ? handle->ops->sclk_gpio_deinit() : 0;       /* sclk gpio deinit failed */
+    if (res != 0)                                                            /* check result */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_DEINIT_FAILED);                      /* sclk gpio deinit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    res = (handle->bus == NULL) ? handle->ops->mosi_gpio_deinit() : 0;       /* mosi gpio deinit failed */
+    if (res != 0)                                                            /* check result */
+    {
+        WT588E02B_ERR(handle, MOSI_GPIO_DEINIT_FAILED);                      /* mosi gpio deinit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    res = handle->ops->miso_gpio_deinit();                                   /* miso gpio deinit failed */
+    if (res != 0)                                                            /* check result */
+    {
+        WT588E02B_ERR(handle, MISO_GPIO_DEINIT_FAILED);                      /* miso gpio deinit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    res = handle->ops->cs_gpio_deinit();                                     /* cs gpio deinit failed */
+    if (res != 0)                                                            /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_DEINIT_FAILED);                        /* cs gpio deinit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    handle->inited = 0;                                                      /* flag closed */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+#if (WT588E02B_FEATURE_DURATION != 0)
+/**
+ * @brief     set the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *table pointer to a duration table structure, NULL disables the profiler
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_ms is NULL
+ * @note      the table content is kept, so a loaded table can be refined;
+ *            a sample is the time from the first busy sample after the play frame until
+ *            the busy pin is seen idle again, the frame to busy latency is not counted
+ *            and the resolution is the check busy polling period
+ */
+uint8_t wt588e02b_set_duration_table(wt588e02b_handle_t *handle, wt588e02b_duration_table_t *table)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if ((table != NULL) && (handle->ops->timestamp_ms == NULL))          /* check timestamp_ms */
+    {
+        WT588E02B_ERR(handle, TIMESTAMP_MS_NULL);                        /* timestamp_ms is null */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                              /* lock failed */
+        
+        return 1;                                                        /* return error */
+    }
+    handle->duration_table = table;                                      /* set the table */
+    a_wt588e02b_duration_stop(handle);                                   /* init idle */
+    a_wt588e02b_unlock(handle);                                          /* unlock */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      estimate the play duration of an index
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[in]  ind index
+ * @param[out] *ms pointer to a mean duration buffer
+ * @param[out] *var pointer to a duration variance buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample or lock failed
+ *             - 2 handle, ms or var is NULL
+ *             - 3 handle is not initialized
+ *             - 4 ind > 0xDF
+ *             - 5 duration table is NULL
+ * @note       the estimate never touches the bus, the entry is read under the lock
+ *             so the mean and the variance come from the same sample
+ */
+uint8_t wt588e02b_estimate_duration(wt588e02b_handle_t *handle, uint8_t ind, uint32_t *ms, float *var)
+{
+    uint8_t res;
+    wt588e02b_duration_entry_t *entry;
+    
+    if ((handle == NULL) || (ms == NULL) || (var == NULL))               /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if (ind > 0xDF)                                                      /* check result */
+    {
+        WT588E02B_ERR(handle, IND_INVALID);                              /* ind > 0xDF */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                                /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                              /* lock failed */
+        
+        return 1;                                                        /* return error */
+    }
+    if (handle->duration_table == NULL)                                  /* check the table */
+    {
+        WT588E02B_ERR(handle, DURATION_TABLE_NULL);                      /* duration table is null */
+        a_wt588e02b_unlock(handle);                                      /* unlock */
+        
+        return 5;                                                        /* return error */
+    }
+    entry = &handle->duration_table->entry[ind];                         /* get the entry */
+    res = 1;                                                             /* no sample */
+    if (entry->count != 0)                                               /* check the count */
+    {
+        *ms = (uint32_t)(entry->mean_ms + 0.5f);                         /* round the mean */
+        *var = entry->var_ms2;                                           /* get the variance */
+        res = 0;                                                         /* set ok */
+    }
+    a_wt588e02b_unlock(handle);                                          /* unlock */
+    
+    return res;                                                          /* return the result */
+}
+
+/**
+ * @brief     write the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *write pointer to a write function
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 5 duration table is NULL
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_duration_save(wt588e02b_handle_t *handle, uint8_t (*write)(uint8_t *buf, uint16_t len))
+{
+    uint8_t buf[WT588E02B_DURATION_RECORD_SIZE];
+    uint8_t num;
+    uint16_t i;
+    uint32_t mean;
+    uint32_t var;
+    wt588e02b_duration_entry_t *entry;
+    
+    if (handle->duration_table == NULL)                                           /* check the table */
+    {
+        WT588E02B_ERR(handle, DURATION_TABLE_NULL);                               /* duration table is null */
+        
+        return 5;                                                                 /* return error */
+    }
+    
+    num = 0;                                                                      /* init 0 */
+    for (i = 0; i < 0xE0; i++)                                                    /* count all */
+    {
+        if (handle->duration_table->entry[i].count != 0)                          /* check the count */
+        {
+            num++;                                                                /* num++ */
+        }
+    }
+    buf[0] = WT588E02B_DURATION_MAGIC0;                                           /* set magic */
+    buf[1] = WT588E02B_DURATION_MAGIC1;                                           /* set magic */
+    buf[2] = WT588E02B_DURATION_VERSION;                                          /* set version */
+    buf[3] = num;                                                                 /* set record number */
+    if (write(buf, 4) != 0)                                                       /* write header */
+    {
+        WT588E02B_ERR(handle, WRITE_FAILED);                                      /* write failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    for (i = 0; i < 0xE0; i++)                                                    /* write all */
+    {
+        entry = &handle->duration_table->entry[i];                                /* get the entry */
+        if (entry->count == 0)                                                    /* check the count */
+        {
+            continue;                                                             /* skip */
+        }
+        memcpy(&mean, &entry->mean_ms, sizeof(uint32_t));                         /* copy mean bits */
+        memcpy(&var, &entry->var_ms2, sizeof(uint32_t));                          /* copy variance bits */
+        buf[0] = (uint8_t)(i);                                                    /* set index */
+        buf[1] = (uint8_t)(entry->count & 0xFF);                                  /* set count lsb */
+        buf[2] = (uint8_t)((entry->count >> 8) & 0xFF);                           /* set count msb */
+        buf[3] = (uint8_t)(mean & 0xFF);                                          /* set mean */
+        buf[4] = (uint8_t)((mean >> 8) & 0xFF);                                   /* set mean */
+        buf[5] = (uint8_t)((mean >> 16) & 0xFF);                                  /* set mean */
+        buf[6] = (uint8_t)((mean >> 24) & 0xFF);                                  /* set mean */
+        buf[7] = (uint8_t)(var & 0xFF);                                           /* set variance */
+        buf[8] = (uint8_t)((var >> 8) & 0xFF);                                    /* set variance */
+        buf[9] = (uint8_t)((var >> 16) & 0xFF);                                   /* set variance */
+        buf[10] = (uint8_t)((var >> 24) & 0xFF);                                  /* set variance */
+        if (write(buf, WT588E02B_DURATION_RECORD_SIZE) != 0)                      /* write record */
+        {
+            WT588E02B_ERR(handle, WRITE_FAILED);                                  /* write failed */
+            
+            return 1;                                                             /* return error */
+        }
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     save the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *write pointer to a write function, called once per record
+ * @return    status code
+ *            - 0 success
+ *            - 1 write or lock failed
+ *            - 2 handle or write is NULL
+ *            - 3 handle is not initialized
+ *            - 5 duration table is NULL
+ * @note      only the measured indexes are written, the format is a 4 bytes header
+ *            followed by 11 bytes little endian records;
+ *            write runs with the handle lock held and must not call the driver
+ */
+uint8_t wt588e02b_duration_save(wt588e02b_handle_t *handle, uint8_t (*write)(uint8_t *buf, uint16_t len))
+{
+    uint8_t res;
+    
+    if ((handle == NULL) || (write == NULL))                                      /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                                         /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                       /* lock failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    res = a_wt588e02b_duration_save(handle, write);                               /* run with the lock held */
+    a_wt588e02b_unlock(handle);                                                   /* unlock */
+    
+    return res;                                                                   /* return the result */
+}
+
+/**
+ * @brief     read the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *read pointer to a read function
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 4 data is invalid
+ *            - 5 duration table is NULL
+ * @note      the caller holds the lock
+ */
+static uint8_t a_wt588e02b_duration_load(wt588e02b_handle_t *handle, uint8_t (*read)(uint8_t *buf, uint16_t len))
+{
+    uint8_t buf[WT588E02B_DURATION_RECORD_SIZE];
+    uint8_t num;
+    uint8_t i;
+    uint32_t mean;
+    uint32_t var;
+    wt588e02b_duration_entry_t *entry;
+    
+    if (handle->duration_table == NULL)                                           /* check the table */
+    {
+        WT588E02B_ERR(handle, DURATION_TABLE_NULL);                               /* duration table is null */
+        
+        return 5;                                                                 /* return error */
+    }
+    
+    if (read(buf, 4) != 0)                                                        /* read header */
+    {
+        WT588E02B_ERR(handle, READ_FAILED);                                       /* read failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    if ((buf[0] != WT588E02B_DURATION_MAGIC0) ||                                  /* check magic */
+        (buf[1] != WT588E02B_DURATION_MAGIC1) ||                                  /* check magic */
+        (buf[2] != WT588E02B_DURATION_VERSION) ||                                 /* check version */
+        (buf[3] > 0xE0))                                                          /* check record number */
+    {
+        WT588E02B_ERR(handle, DATA_INVALID);                                      /* data is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    num = buf[3];                                                                 /* get record number */
+    for (i = 0; i < num; i++)                                                     /* read all */
+    {
+        if (read(buf, WT588E02B_DURATION_RECORD_SIZE) != 0)                       /* read record */
+        {
+            WT588E02B_ERR(handle, READ_FAILED);                                   /* read failed */
+            
+            return 1;                                                             /* return error */
+        }
+        if (buf[0] > 0xDF)                                                        /* check index */
+        {
+            WT588E02B_ERR(handle, DATA_INVALID);                                  /* data is invalid */
+            
+            return 4;                                                             /* return error */
+        }
+        mean = (uint32_t)(buf[3]) | ((uint32_t)(buf[4]) << 8) |                   /* get mean */
+               ((uint32_t)(buf[5]) << 16) | ((uint32_t)(buf[6]) << 24);           /* get mean */
+        var = (uint32_t)(buf[7]) | ((uint32_t)(buf[8]) << 8) |                    /* get variance */
+              ((uint32_t)(buf[9]) << 16) | ((uint32_t)(buf[10]) << 24);           /* get variance */
+        entry = &handle->duration_table->entry[buf[0]];                           /* get the entry */
+        entry->count = (uint16_t)((uint16_t)(buf[2]) << 8) | buf[1];              /* set count */
+        memcpy(&entry->mean_ms, &mean, sizeof(uint32_t));                         /* set mean */
+        memcpy(&entry->var_ms2, &var, sizeof(uint32_t));                          /* set variance */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     load the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *read pointer to a read function, called once per record
+ * @return    status code
+ *            - 0 success
+ *            - 1 read or lock failed
+ *            - 2 handle or read is NULL
+ *            - 3 handle is not initialized
+ *            - 4 data is invalid
+ *            - 5 duration table is NULL
+ * @note      a table saved by an older record format version is refused;
+ *            read runs with the handle lock held and must not call the driver
+ */
+uint8_t wt588e02b_duration_load(wt588e02b_handle_t *handle, uint8_t (*read)(uint8_t *buf, uint16_t len))
+{
+    uint8_t res;
+    
+    if ((handle == NULL) || (read == NULL))                                       /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                                         /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                       /* lock failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    res = a_wt588e02b_duration_load(handle, read);                                /* run with the lock held */
+    a_wt588e02b_unlock(handle);                                                   /* unlock */
+    
+    return res;                                                                   /* return the result */
+}
+#endif
+
+#if (WT588E02B_FEATURE_SHADOW != 0)
+/**
+ * @brief     enable or disable the shadow state
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, set vol with the same volume, stop when the chip is known idle
+ *            and re-arming the running loop are skipped without touching the bus
+ */
+uint8_t wt588e02b_set_shadow(wt588e02b_handle_t *handle, wt588e02b_bool_t enable)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->inited != 1)                                /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                   /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                 /* lock failed */
+        
+        return 1;                                           /* return error */
+    }
+    handle->shadow_enable = (uint8_t)enable;                /* set enable */
+    a_wt588e02b_unlock(handle);                             /* unlock */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     invalidate the shadow state
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the next commands always go to the bus
+ */
+uint8_t wt588e02b_shadow_invalidate(wt588e02b_handle_t *handle)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->inited != 1)                                /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                   /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                 /* lock failed */
+        
+        return 1;                                           /* return error */
+    }
+    a_wt588e02b_shadow_reset(handle);                       /* drop the shadow state */
+    a_wt588e02b_unlock(handle);                             /* unlock */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     force the chip to the shadow state
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      writes the cached volume again, e.g. after the chip was reset,
+ *            the loop state is dropped so that the next loop command goes to the bus
+ */
+uint8_t wt588e02b_shadow_sync(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t valid;
+    
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                                 /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                               /* lock failed */
+        
+        return 1;                                                         /* return error */
+    }
+    valid = handle->shadow_valid;                                         /* save the valid flags */
+    a_wt588e02b_shadow_reset(handle);                                     /* drop the shadow state */
+    res = 0;                                                              /* init 0 */
+    if (((valid & WT588E02B_SHADOW_PENDING) == 0) &&
+        ((valid & WT588E02B_SHADOW_VOL) != 0))                            /* check the volume */
+    {
+        res = a_wt588e02b_set_vol(handle, handle->shadow_vol);            /* write the volume */
+    }
+    a_wt588e02b_unlock(handle);                                           /* unlock */
+    if (res != 0)                                                         /* check result */
+    {
+        WT588E02B_ERR(handle, SET_VOL_FAILED);                            /* set vol failed */
+        
+        return 1;                                                         /* return error */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+#endif
+
+#if (WT588E02B_FEATURE_COALESCE != 0)
+/**
+ * @brief     set the coalescing window
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *coalesce pointer to a caller owned queue, NULL disables coalescing
+ * @param[in] ms window length in ms, 0 disables coalescing
+ * @return    status code
+ *            - 0 success
+ *            - 1 set coalesce failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 timestamp_ms is NULL
+ * @note      play requests inside the window are merged into one play list frame,
+ *            the indexes queued in the old queue are flushed first, an expired window is flushed
+ *            by the next driver call or wt588e02b_coalesce_poll
+ */
+uint8_t wt588e02b_set_coalesce(wt588e02b_handle_t *handle, wt588e02b_coalesce_t *coalesce, uint16_t ms)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    if ((coalesce != NULL) && (ms != 0) &&
+        (handle->ops->timestamp_ms == NULL))                           /* check timestamp_ms */
+    {
+        WT588E02B_ERR(handle, TIMESTAMP_MS_NULL);                      /* timestamp_ms is null */
+        
+        return 5;                                                      /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                              /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                            /* lock failed */
+        
+        return 1;                                                      /* return error */
+    }
+    res = a_wt588e02b_coalesce_flush(handle);                          /* flush the old queue */
+    if (res == 0)                                                      /* check result */
+    {
+        handle->coalesce = coalesce;                                   /* set queue */
+        if (coalesce != NULL)                                          /* check the queue */
+        {
+            coalesce->ms = ms;                                         /* set window */
+            coalesce->len = 0;                                         /* empty queue */
+        }
+    }
+    a_wt588e02b_unlock(handle);                                        /* unlock */
+    if (res == 4)                                                      /* check busy */
+    {
+        return 4;                                                      /* return error */
+    }
+    if (res != 0)                                                      /* check result */
+    {
+        WT588E02B_ERR(handle, COALESCE_FLUSH_FAILED);                  /* coalesce flush failed */
+        
+        return 1;                                                      /* return error */
+    }
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     send the queued indexes when the coalescing window is closed
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      nothing is sent while the window is open, every other command and an idle check_busy
+ *            also flush an expired window, call it periodically when no other driver call follows
+ */
+uint8_t wt588e02b_coalesce_poll(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                                                         /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                                       /* lock failed */
+        
+        return 1;                                                                                 /* return error */
+    }
+    res = 0;                                                                                      /* init 0 */
+    if ((handle->coalesce != NULL) && (handle->coalesce->len != 0) &&
+        ((handle->ops->timestamp_ms() - handle->coalesce->start) >= handle->coalesce->ms))        /* window is closed */
+    {
+        res = a_wt588e02b_coalesce_flush(handle);                                                 /* flush */
+    }
+    a_wt588e02b_unlock(handle);                                                                   /* unlock */
+    if (res == 4)                                                                                 /* check busy */
+    {
+        return 4;                                                                                 /* return error */
+    }
+    if (res != 0)                                                                                 /* check result */
+    {
+        WT588E02B_ERR(handle, COALESCE_FLUSH_FAILED);                                             /* coalesce flush failed */
+        
+        return 1;                                                                                 /* return error */
+    }
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     send the queued indexes now
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      the queue is kept when the chip is busy
+ */
+uint8_t wt588e02b_coalesce_flush(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                                  /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                /* lock failed */
+        
+        return 1;                                                          /* return error */
+    }
+    res = a_wt588e02b_coalesce_flush(handle);                              /* flush */
+    a_wt588e02b_unlock(handle);                                            /* unlock */
+    if (res == 4)                                                          /* check busy */
+    {
+        return 4;                                                          /* return error */
+    }
+    if (res != 0)                                                          /* check result */
+    {
+        WT588E02B_ERR(handle, COALESCE_FLUSH_FAILED);                      /* coalesce flush failed */
+        
+        return 1;                                                          /* return error */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+#endif
+
+#if (WT588E02B_FEATURE_STATS != 0)
+/**
+ * @brief      get the command stats
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 lock failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t wt588e02b_get_stats(wt588e02b_handle_t *handle, wt588e02b_stats_t *stats)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->inited != 1)                                /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                   /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                 /* lock failed */
+        
+        return 1;                                           /* return error */
+    }
+    *stats = handle->stats;                                 /* copy stats */
+    a_wt588e02b_unlock(handle);                             /* unlock */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     clear the command stats
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t wt588e02b_clear_stats(wt588e02b_handle_t *handle)
+{
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    if (a_wt588e02b_lock(handle, 1) != 0)                               /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                             /* lock failed */
+        
+        return 1;                                                       /* return error */
+    }
+    memset(&handle->stats, 0, sizeof(wt588e02b_stats_t));               /* clear stats */
+    a_wt588e02b_unlock(handle);                                         /* unlock */
+    
+    return 0;                                                           /* success return 0 */
+}
+#endif
+
+#if (WT588E02B_FEATURE_STEP != 0)
+/**
+ * @brief     step done
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *step pointer to a step structure
+ * @note      releases the lock of the command
+ */
+static void a_wt588e02b_step_done(wt588e02b_handle_t *handle, wt588e02b_step_t *step)
+{
+    step->state = WT588E02B_STEP_IDLE;                                          /* no command */
+    step->wait_us = 0;                                                          /* done */
+    a_wt588e02b_unlock(handle);                                                 /* unlock */
+}
+
+/**
+ * @brief     step fail
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *step pointer to a step structure
+ * @return    status code
+ *            - 1 step failed
+ * @note      releases cs, the update file and the lock, a pending shadow state is dropped by the next command
+ */
+static uint8_t a_wt588e02b_step_fail(wt588e02b_handle_t *handle, wt588e02b_step_t *step)
+{
+    (void)handle->ops->cs_gpio_write(1);                                        /* release cs */
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    if (step->state >= WT588E02B_STEP_UPDATE_ALL)                               /* update file is open */
+    {
+        (void)handle->ops->bin_read_deinit();                                   /* bin read deinit */
+    }
+#endif
+    a_wt588e02b_step_done(handle, step);                                        /* unlock */
+    
+    return 1;                                                                   /* return error */
+}
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief     step to the update end frame
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *step pointer to a step structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 step failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_step_update_end(wt588e02b_handle_t *handle, wt588e02b_step_t *step)
+{
+    if (a_update_end(handle, WT588E02B_FRAME_HEAD) != 0)                        /* sclk low and cs low */
+    {
+        WT588E02B_ERR(handle, UPDATE_END_FAILED);                               /* update end failed */
+        
+        return a_wt588e02b_step_fail(handle, step);                             /* return error */
+    }
+    step->state = WT588E02B_STEP_UPDATE_END;                                    /* end tail */
+    step->wait_us = WT588E02B_FRAME_LEAD_US;                                    /* cs lead */
+    
+    return 0;                                                                   /* success return 0 */
+}
+#endif
+
+/**
+ * @brief      start a stepped play
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *step pointer to a step structure
+ * @param[in]  ind index
+ * @return     status code
+ *             - 0 success
+ *             - 1 play failed
+ *             - 2 handle or step is NULL
+ *             - 3 handle is not initialized
+ *             - 4 ind > 0xDF
+ *             - 5 chip is busy
+ * @note       the same frame as wt588e02b_play, the caller waits step->wait_us and calls wt588e02b_step
+ *             until wait_us is 0, with a coalescing window the index is queued and wait_us is 0 at once
+ */
+uint8_t wt588e02b_step_play(wt588e02b_handle_t *handle, wt588e02b_step_t *step, uint8_t ind)
+{
+    uint8_t res;
+    
+    if ((handle == NULL) || (step == NULL))                                     /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    step->state = WT588E02B_STEP_IDLE;                                          /* no command */
+    step->wait_us = 0;                                                          /* done */
+    if (ind > 0xDF)                                                             /* check result */
+    {
+        WT588E02B_ERR(handle, IND_INVALID);                                     /* ind > 0xDF */
+        
+        return 4;                                                               /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                                      /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                     /* lock failed */
+        
+        return 1;                                                               /* return error */
+    }
+#if (WT588E02B_FEATURE_COALESCE != 0)
+    if ((handle->coalesce != NULL) && (handle->coalesce->ms != 0))              /* check the coalescing window */
+    {
+        res = a_wt588e02b_coalesce_push(handle, ind);                           /* queue */
+        a_wt588e02b_unlock(handle);                                             /* unlock */
+        
+        return res;                                                             /* return the result */
+    }
+#endif
+    res = a_wt588e02b_play(handle, ind, WT588E02B_FRAME_HEAD);                  /* busy check, sclk low and cs low */
+    if (res == 1)                                                               /* check result */
+    {
+        return a_wt588e02b_step_fail(handle, step);                             /* return error */
+    }
+    if (res != 0)                                                               /* chip is busy */
+    {
+        a_wt588e02b_step_done(handle, step);                                    /* unlock */
+        
+        return res;                                                             /* return error */
+    }
+    step->ind = ind;                                                            /* save index */
+    step->state = WT588E02B_STEP_PLAY;                                          /* play tail */
+    step->wait_us = WT588E02B_FRAME_LEAD_US;                                    /* cs lead */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      start a stepped stop
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *step pointer to a step structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 stop failed
+ *             - 2 handle or step is NULL
+ *             - 3 handle is not initialized
+ * @note       the same frame as wt588e02b_stop, an expired coalescing window is flushed first,
+ *             a redundant stop is skipped and wait_us is 0 at once
+ */
+uint8_t wt588e02b_step_stop(wt588e02b_handle_t *handle, wt588e02b_step_t *step)
+{
+    if ((handle == NULL) || (step == NULL))                                     /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    step->state = WT588E02B_STEP_IDLE;                                          /* no command */
+    step->wait_us = 0;                                                          /* done */
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                                      /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                     /* lock failed */
+        
+        return 1;                                                               /* return error */
+    }
+    a_wt588e02b_coalesce_drop(handle);                                          /* drop the queued indexes */
+    if (a_wt588e02b_shadow_loop_hit(handle, 0, 0) != 0)                         /* check the shadow state */
+    {
+        a_wt588e02b_shadow_skip(handle, 2);                                     /* redundant command */
+        a_wt588e02b_step_done(handle, step);                                    /* unlock */
+        
+        return 0;                                                               /* success return 0 */
+    }
+    if (a_wt588e02b_stop_frame(handle, WT588E02B_FRAME_HEAD) != 0)              /* sclk low and cs low */
+    {
+        return a_wt588e02b_step_fail(handle, step);                             /* return error */
+    }
+    step->state = WT588E02B_STEP_STOP;                                          /* stop tail */
+    step->wait_us = WT588E02B_FRAME_LEAD_US;                                    /* cs lead */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief      start a stepped update of all audio
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *step pointer to a step structure
+ * @param[in]  *path pointer to a path buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 update failed
+ *             - 2 handle or step is NULL
+ *             - 3 handle is not initialized
+ *             - 4 bin read init failed or the update is not linked
+ *             - 5 bin size is invalid
+ * @note       the same frames and gaps as wt588e02b_update_all
+ */
+uint8_t wt588e02b_step_update_all(wt588e02b_handle_t *handle, wt588e02b_step_t *step, char *path)
+{
+    if ((handle == NULL) || (step == NULL))                                     /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    step->state = WT588E02B_STEP_IDLE;                                          /* no command */
+    step->wait_us = 0;                                                          /* done */
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                                      /* lock */
+    {
+        WT588E02B_ERR(handle, LOCK_FAILED);                                     /* lock failed */
+        
+        return 1;                                                               /* return error */
+    }
+    if ((handle->ops->bin_read_init == NULL) || (handle->ops->bin_read == NULL) ||
+        (handle->ops->bin_read_deinit == NULL) || (handle->buf == NULL))        /* check the update link */
+    {
+        WT588E02B_ERR(handle, UPDATE_NOT_LINKED);                               /* update is not linked */
+        a_wt588e02b_step_done(handle, step);                                    /* unlock */
+        
+        return 4;                                                               /* return error */
+    }
+    a_wt588e02b_shadow_reset(handle);                                           /* the chip is rewritten */
+    if (handle->ops->bin_read_init(path, &step->size) != 0)                     /* bin read init */
+    {
+        WT588E02B_ERR(handle, BIN_READ_INIT_FAILED);                            /* bin read init failed */
+        a_wt588e02b_step_done(handle, step);                                    /* unlock */
+        
+        return 4;                                                               /* return error */
+    }
+    if ((step->size % 512) != 0)                                                /* check size */
+    {
+        WT588E02B_ERR(handle, BIN_SIZE_INVALID);                                /* bin size is invalid */
+        (void)handle->ops->bin_read_deinit();                                   /* bin read deinit */
+        a_wt588e02b_step_done(handle, step);                                    /* unlock */
+        
+        return 5;                                                               /* return error */
+    }
+    step->addr = 0;                                                             /* init 0 */
+    step->state = WT588E02B_STEP_UPDATE_ALL;                                    /* update all tail */
+    if (a_update_all(handle, WT588E02B_FRAME_HEAD) != 0)                        /* sclk low and cs low */
+    {
+        WT588E02B_ERR(handle, UPDATE_ALL_FAILED);                               /* update all failed */
+        
+        return a_wt588e02b_step_fail(handle, step);                             /* return error */
+    }
+    step->wait_us = WT588E02B_FRAME_LEAD_US;                                    /* cs lead */
+    
+    return 0;                                                                   /* success return 0 */
+}
+#endif
+
+/**
+ * @brief         run the next step of a command
+ * @param[in]     *handle pointer to a wt588e02b handle structure
+ * @param[in,out] *step pointer to a step structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 step failed
+ *                - 2 handle or step is NULL
+ *                - 3 handle is not initialized
+ *                - 4 no command is running
+ * @note          the lock is held from the start to the last step or a failed one, so the caller
+ *                waits without blocking the thread but must not take the same lock meanwhile
+ */
+uint8_t wt588e02b_step(wt588e02b_handle_t *handle, wt588e02b_step_t *step)
+{
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    uint8_t res;
+    uint16_t sum;
+#endif
+    
+    if ((handle == NULL) || (step == NULL))                                     /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    switch (step->state)
+    {
+        case WT588E02B_STEP_PLAY :
+        {
+            if (a_wt588e02b_play(handle, step->ind, WT588E02B_FRAME_TAIL) != 0) /* bytes and cs high */
+            {
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            a_wt588e02b_step_done(handle, step);                                /* unlock */
+            
+            return 0;                                                           /* success return 0 */
+        }
+        case WT588E02B_STEP_STOP :
+        {
+            if (a_wt588e02b_stop_frame(handle, WT588E02B_FRAME_TAIL) != 0)      /* bytes and cs high */
+            {
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            a_wt588e02b_step_done(handle, step);                                /* unlock */
+            
+            return 0;                                                           /* success return 0 */
+        }
+#if (WT588E02B_FEATURE_UPDATE != 0)
+        case WT588E02B_STEP_UPDATE_ALL :
+        {
+            if (a_update_all(handle, WT588E02B_FRAME_TAIL) != 0)                /* bytes and cs high */
+            {
+                WT588E02B_ERR(handle, UPDATE_ALL_FAILED);                       /* update all failed */
+                
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            step->state = WT588E02B_STEP_UPDATE_READ;                           /* first packet */
+            step->wait_us = (step->size != 0) ? (30000 + 16000) : 30000;        /* 30ms and the 16ms of the packet */
+            
+            return 0;                                                           /* success return 0 */
+        }
+        case WT588E02B_STEP_UPDATE_READ :
+        {
+            if (step->addr >= step->size)                                       /* no packet */
+            {
+                return a_wt588e02b_step_update_end(handle, step);               /* update end */
+            }
+            res = handle->ops->bin_read(step->addr, 512, handle->buf);          /* bin read */
+            if (res != 0)                                                       /* check result */
+            {
+                WT588E02B_ERR(handle, BIN_READ_FAILED);                         /* bin read failed */
+                
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            step->addr += 512;                                                  /* add 512 */
+            if (a_update_get_status(handle, &sum, WT588E02B_FRAME_HEAD) != 0)   /* sclk low and cs low */
+            {
+                WT588E02B_ERR(handle, UPDATE_GET_STATUS_FAILED);                /* update get status failed */
+                
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            step->state = WT588E02B_STEP_UPDATE_STATUS;                         /* status tail */
+            step->wait_us = WT588E02B_FRAME_LEAD_US;                            /* cs lead */
+            
+            return 0;                                                           /* success return 0 */
+        }
+        case WT588E02B_STEP_UPDATE_STATUS :
+        {
+            if (a_update_get_status(handle, &sum, WT588E02B_FRAME_TAIL) != 0)   /* get status */
+            {
+                WT588E02B_ERR(handle, UPDATE_GET_STATUS_FAILED);                /* update get status failed */
+                
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            if (handle->sum != sum)                                             /* check sum */
+            {
+                WT588E02B_ERR(handle, SUM_CHECK_ERROR);                         /* sum check error */
+                
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            step->state = WT588E02B_STEP_UPDATE_PACK;                           /* packet */
+            step->wait_us = 1000;                                               /* 1ms */
+            
+            return 0;                                                           /* success return 0 */
+        }
+        case WT588E02B_STEP_UPDATE_PACK :
+        {
+            if (a_update_send_pack(handle, handle->buf, 512) != 0)              /* send pack */
+            {
+                WT588E02B_ERR(handle, UPDATE_SEND_PACK_FAILED);                 /* update send pack failed */
+                
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            if (step->addr < step->size)                                        /* next packet */
+            {
+                step->state = WT588E02B_STEP_UPDATE_READ;                       /* read the packet */
+                step->wait_us = 16000;                                          /* 16ms */
+                
+                return 0;                                                       /* success return 0 */
+            }
+            
+            return a_wt588e02b_step_update_end(handle, step);                   /* update end */
+        }
+        case WT588E02B_STEP_UPDATE_END :
+        {
+            if (a_update_end(handle, WT588E02B_FRAME_TAIL) != 0)                /* bytes and cs high */
+            {
+                WT588E02B_ERR(handle, UPDATE_END_FAILED);                       /* update end failed */
+                
+                return a_wt588e02b_step_fail(handle, step);                     /* return error */
+            }
+            res = handle->ops->bin_read_deinit();                               /* bin read deinit */
+            a_wt588e02b_step_done(handle, step);                                /* unlock */
+            if (res != 0)                                                       /* check result */
+            {
+                WT588E02B_ERR(handle, BIN_READ_DEINIT_FAILED);                  /* bin read deinit failed */
+                
+                return 1;                                                       /* return error */
+            }
+            
+            return 0;                                                           /* success return 0 */
+        }
+#endif
+        default :
+        {
+            WT588E02B_ERR(handle, NO_COMMAND_RUNNING);                          /* no command is running */
+            
+            return 4;                                                           /* return error */
+        }
+    }
+}
+
+/**
+ * @brief         abort a stepped command
+ * @param[in]     *handle pointer to a wt588e02b handle structure
+ * @param[in,out] *step pointer to a step structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle or step is NULL
+ *                - 3 handle is not initialized
+ * @note          releases cs, the update file and the lock, the shadow state of the command is dropped
+ */
+uint8_t wt588e02b_step_abort(wt588e02b_handle_t *handle, wt588e02b_step_t *step)
+{
+    if ((handle == NULL) || (step == NULL))                                     /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    if (step->state != WT588E02B_STEP_IDLE)                                     /* check the command */
+    {
+        (void)a_wt588e02b_step_fail(handle, step);                              /* release cs and the lock */
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     initialize the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 bus is NULL
+ *            - 3 linked functions is NULL
+ * @note      none
+ */
+uint8_t wt588e02b_bus_init(wt588e02b_bus_t *bus)
+{
+    if (bus == NULL)                                                         /* check bus */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (bus->debug_print == NULL)                                            /* check debug_print */
+    {
+        return 3;                                                            /* return error */
+    }
+    if ((bus->sclk_gpio_init == NULL) || (bus->sclk_gpio_deinit == NULL) ||
+        (bus->sclk_gpio_write == NULL))                                      /* check sclk */
+    {
+        WT588E02B_BUS_ERR(bus, BUS_SCLK_GPIO_NULL);                          /* bus sclk gpio is null */
+        
+        return 3;                                                            /* return error */
+    }
+    if ((bus->mosi_gpio_init == NULL) || (bus->mosi_gpio_deinit == NULL) ||
+        (bus->mosi_gpio_write == NULL))                                      /* check mosi */
+    {
+        WT588E02B_BUS_ERR(bus, BUS_MOSI_GPIO_NULL);                          /* bus mosi gpio is null */
+        
+        return 3;                                                            /* return error */
+    }
+    if ((bus->delay_ms == NULL) || (bus->delay_us == NULL))                  /* check delay */
+    {
+        WT588E02B_BUS_ERR(bus, BUS_DELAY_NULL);                              /* bus delay is null */
+        
+        return 3;                                                            /* return error */
+    }
+    if ((bus->lock == NULL) != (bus->unlock == NULL))                        /* check lock and unlock */
+    {
+        WT588E02B_BUS_ERR(bus, BUS_LOCK_UNLOCK_UNPAIRED);                    /* bus lock and unlock must be linked together */
+        
+        return 3;                                                            /* return error */
+    }
+    
+    if (bus->sclk_gpio_init() != 0)                                          /* sclk gpio init */
+    {
+        WT588E02B_BUS_ERR(bus, SCLK_GPIO_INIT_FAILED);                       /* sclk gpio init failed */
+        
+        return 1;                                                            /* return error */
+    }
+    if (bus->mosi_gpio_init() != 0)                                          /* mosi gpio init */
+    {
+        WT588E02B_BUS_ERR(bus, MOSI_GPIO_INIT_FAILED);                       /* mosi gpio init failed */
+        (void)bus->sclk_gpio_deinit();                                       /* sclk gpio deinit */
+        
+        return 1;                                                            /* return error */
+    }
+    memset(bus->chip, 0, sizeof(bus->chip));                                 /* no chip */
+    bus->attached = 0;                                                       /* no chip */
+    bus->inited = 1;                                                         /* flag finished */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     close the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 chips are still attached
+ * @note      none
+ */
+uint8_t wt588e02b_bus_deinit(wt588e02b_bus_t *bus)
+{
+    if (bus == NULL)                                                         /* check bus */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (bus->inited != 1)                                                    /* check bus initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if (bus->attached != 0)                                                  /* check attached chips */
+    {
+        WT588E02B_BUS_ERR(bus, CHIPS_ATTACHED);                              /* chips are still attached */
+        
+        return 4;                                                            /* return error */
+    }
+    
+    if (bus->sclk_gpio_deinit() != 0)                                        /* sclk gpio deinit */
+    {
+        WT588E02B_BUS_ERR(bus, SCLK_GPIO_DEINIT_FAILED);                     /* sclk gpio deinit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    if (bus->mosi_gpio_deinit() != 0)                                        /* mosi gpio deinit */
+    {
+        WT588E02B_BUS_ERR(bus, MOSI_GPIO_DEINIT_FAILED);                     /* mosi gpio deinit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    bus->inited = 0;                                                         /* flag closed */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     attach a chip to the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] chip chip number
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus or handle is NULL
+ *            - 3 bus is not initialized
+ *            - 4 chip >= 32
+ *            - 5 chip is used
+ *            - 6 handle is initialized
+ * @note      call it after linking the handle and before wt588e02b_init,
+ *            the handle then uses the bus sclk and mosi and keeps its own cs and miso
+ */
+uint8_t wt588e02b_bus_attach(wt588e02b_bus_t *bus, wt588e02b_handle_t *handle, uint8_t chip)
+{
+    if ((bus == NULL) || (handle == NULL))                                   /* check bus and handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (bus->inited != 1)                                                    /* check bus initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if (chip >= WT588E02B_BUS_MAX_CHIP)                                      /* check chip */
+    {
+        WT588E02B_BUS_ERR(bus, CHIP_INVALID);                                /* chip >= 32 */
+        
+        return 4;                                                            /* return error */
+    }
+    if ((bus->attached & (1UL << chip)) != 0)                                /* check used */
+    {
+        WT588E02B_BUS_ERR(bus, CHIP_USED);                                   /* chip is used */
+        
+        return 5;                                                            /* return error */
+    }
+    if (handle->inited == 1)                                                 /* check handle initialization */
+    {
+        WT588E02B_BUS_ERR(bus, HANDLE_INITIALIZED);                          /* handle is initialized */
+        
+        return 6;                                                            /* return error */
+    }
+    
+    handle->bus = bus;                                                       /* set bus, it owns the shared sclk and mosi */
+    handle->chip = chip;                                                     /* set chip */
+    bus->chip[chip] = handle;                                                /* save handle */
+    bus->attached |= 1UL << chip;                                            /* set attached */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     detach a chip from the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus or handle is NULL
+ *            - 3 bus is not initialized
+ *            - 4 handle is not attached
+ *            - 5 handle is initialized
+ * @note      none
+ */
+uint8_t wt588e02b_bus_detach(wt588e02b_bus_t *bus, wt588e02b_handle_t *handle)
+{
+    if ((bus == NULL) || (handle == NULL))                                   /* check bus and handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (bus->inited != 1)                                                    /* check bus initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if ((handle->bus != bus) || (bus->chip[handle->chip] != handle))         /* check attached */
+    {
+        WT588E02B_BUS_ERR(bus, HANDLE_NOT_ATTACHED);                         /* handle is not attached */
+        
+        return 4;                                                            /* return error */
+    }
+    if (handle->inited == 1)                                                 /* check handle initialization */
+    {
+        WT588E02B_BUS_ERR(bus, HANDLE_INITIALIZED);                          /* handle is initialized */
+        
+        return 5;                                                            /* return error */
+    }
+    
+    bus->chip[handle->chip] = NULL;                                          /* clear handle */
+    bus->attached &= ~(1UL << handle->chip);                                 /* clear attached */
+    handle->bus = NULL;                                                      /* no bus */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     set the volume of several chips with one frame
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @param[in] vol volume
+ * @return    status code
+ *            - 0 success
+ *            - 1 set vol failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 vol > 0x3F
+ *            - 5 no initialized chip in the mask
+ * @note      the caller holds the bus lock
+ */
+static uint8_t a_wt588e02b_bus_set_vol(wt588e02b_bus_t *bus, uint32_t mask, uint8_t vol)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t buf[2];
+    uint32_t send;
+    wt588e02b_handle_t *handle;
+    
+    if (bus == NULL)                                                                     /* check bus */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (bus->inited != 1)                                                                /* check bus initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (vol > 0x3F)                                                                      /* check vol */
+    {
+        WT588E02B_BUS_ERR(bus, VOL_INVALID);                                             /* vol > 0x3F */
+        
+        return 4;                                                                        /* return error */
+    }
+    
+    send = 0;                                                                            /* init 0 */
+    mask &= bus->attached;                                                               /* only attached chips */
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                         /* loop all chips */
+    {
+        handle = bus->chip[i];                                                           /* get handle */
+        if (((mask & (1UL << i)) == 0) || (handle->inited != 1))                         /* check the chip */
+        {
+            mask &= ~(1UL << i);                                                         /* remove the chip */
+            
+            continue;                                                                    /* next */
+        }
+        if (a_wt588e02b_shadow_vol_hit(handle, vol) != 0)                                /* check the shadow state */
+        {
+            a_wt588e02b_shadow_skip(handle, 2);                                          /* redundant command */
+            
+            continue;                                                                    /* next */
+        }
+        send |= 1UL << i;                                                                /* send to the chip */
+    }
+    if (mask == 0)                                                                       /* check mask */
+    {
+        WT588E02B_BUS_ERR(bus, MASK_NOT_INITIALIZED);                                    /* no initialized chip */
+        
+        return 5;                                                                        /* return error */
+    }
+    if (send == 0)                                                                       /* all redundant */
+    {
+        return 0;                                                                        /* success return 0 */
+    }
+    
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                         /* loop all chips */
+    {
+        if ((send & (1UL << i)) != 0)                                                    /* check the chip */
+        {
+            a_wt588e02b_shadow_begin(bus->chip[i]);                                      /* start the shadow transaction */
+        }
+    }
+    buf[0] = WT588E02B_COMMAND_VOL;                                                      /* set command */
+    buf[1] = vol;                                                                        /* set vol */
+    res = a_wt588e02b_bus_frame(bus, send, buf, 2, 5, 0, 100);                           /* broadcast */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_BUS_ERR(bus, BUS_FRAME_FAILED);                                        /* bus frame failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                         /* loop all chips */
+    {
+        if ((send & (1UL << i)) != 0)                                                    /* check the chip */
+        {
+            handle = bus->chip[i];                                                       /* get handle */
+            a_wt588e02b_shadow_vol(handle, vol);                                         /* save volume */
+            a_wt588e02b_shadow_end(handle);                                              /* end the shadow transaction */
+        }
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the volume of several chips with one frame
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @param[in] vol volume
+ * @return    status code
+ *            - 0 success
+ *            - 1 set vol failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 vol > 0x3F
+ *            - 5 no initialized chip in the mask
+ * @note      chips whose shadow state already holds the volume are left out
+ */
+uint8_t wt588e02b_bus_set_vol(wt588e02b_bus_t *bus, uint32_t mask, uint8_t vol)
+{
+    uint8_t res;
+    
+    if (bus == NULL)                                   /* check bus */
+    {
+        return 2;                                      /* return error */
+    }
+    if (bus->inited != 1)                              /* check bus initialization */
+    {
+        return 3;                                      /* return error */
+    }
+    
+    if (a_wt588e02b_bus_lock(bus) != 0)                /* lock the bus */
+    {
+        WT588E02B_BUS_ERR(bus, LOCK_FAILED);           /* lock failed */
+        
+        return 1;                                      /* return error */
+    }
+    res = a_wt588e02b_bus_set_vol(bus, mask, vol);     /* run with the lock held */
+    a_wt588e02b_bus_unlock(bus);                       /* unlock the bus */
+    
+    return res;                                        /* return the result */
+}
+
+/**
+ * @brief     stop several chips with one frame
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 no initialized chip in the mask
+ * @note      the caller holds the bus lock
+ */
+static uint8_t a_wt588e02b_bus_stop(wt588e02b_bus_t *bus, uint32_t mask)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t buf[2];
+    uint32_t send;
+    wt588e02b_handle_t *handle;
+    
+    if (bus == NULL)                                                                     /* check bus */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (bus->inited != 1)                                                                /* check bus initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    send = 0;                                                                            /* init 0 */
+    mask &= bus->attached;                                                               /* only attached chips */
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                         /* loop all chips */
+    {
+        handle = bus->chip[i];                                                           /* get handle */
+        if (((mask & (1UL << i)) == 0) || (handle->inited != 1))                         /* check the chip */
+        {
+            mask &= ~(1UL << i);                                                         /* remove the chip */
+            
+            continue;                                                                    /* next */
+        }
+        a_wt588e02b_coalesce_drop(handle);                                               /* drop the queued indexes */
+        if (a_wt588e02b_shadow_loop_hit(handle, 0, 0) != 0)                              /* check the shadow state */
+        {
+            a_wt588e02b_shadow_skip(handle, 2);                                          /* redundant command */
+            
+            continue;                                                                    /* next */
+        }
+        send |= 1UL << i;                                                                /* send to the chip */
+    }
+    if (mask == 0)                                                                       /* check mask */
+    {
+        WT588E02B_BUS_ERR(bus, MASK_NOT_INITIALIZED);                                    /* no initialized chip */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (send == 0)                                                                       /* all redundant */
+    {
+        return 0;                                                                        /* success return 0 */
+    }
+    
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                         /* loop all chips */
+    {
+        if ((send & (1UL << i)) != 0)                                                    /* check the chip */
+        {
+            a_wt588e02b_duration_stop(bus->chip[i]);                                     /* stop the profiler */
+            a_wt588e02b_shadow_begin(bus->chip[i]);                                      /* start the shadow transaction */
+        }
+    }
+    buf[0] = WT588E02B_COMMAND_STOP;                                                     /* set command */
+    buf[1] = 0xEF;                                                                       /* set end */
+    res = a_wt588e02b_bus_frame(bus, send, buf, 2, 5, 0, 100);                           /* broadcast */
+    if (res != 0)                                                                        /* check result */
+    {
+        WT588E02B_BUS_ERR(bus, BUS_FRAME_FAILED);                                        /* bus frame failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    for (i = 0; i < WT588E02B_BUS_MAX_CHIP; i++)                                         /* loop all chips */
+    {
+        if ((send & (1UL << i)) != 0)                                                    /* check the chip */
+        {
+            handle = bus->chip[i];                                                       /* get handle */
+            a_wt588e02b_shadow_loop(handle, 0, 0, WT588E02B_SHADOW_BUSY_STOPPED);        /* stop sent */
+            a_wt588e02b_shadow_end(handle);                                              /* end the shadow transaction */
+        }
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     stop several chips with one frame
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 no initialized chip in the mask
+ * @note      chips whose shadow state is known idle are left out
+ */
+uint8_t wt588e02b_bus_stop(wt588e02b_bus_t *bus, uint32_t mask)
+{
+    uint8_t res;
+    
+    if (bus == NULL)                                   /* check bus */
+    {
+        return 2;                                      /* return error */
+    }
+    if (bus->inited != 1)                              /* check bus initialization */
+    {
+        return 3;                                      /* return error */
+    }
+    
+    if (a_wt588e02b_bus_lock(bus) != 0)                /* lock the bus */
+    {
+        WT588E02B_BUS_ERR(bus, LOCK_FAILED);           /* lock failed */
+        
+        return 1;                                      /* return error */
+    }
+    res = a_wt588e02b_bus_stop(bus, mask);             /* run with the lock held */
+    a_wt588e02b_bus_unlock(bus);                       /* unlock the bus */
+    
+    return res;                                        /* return the result */
+}
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief         update audio on several chips in lockstep
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[in]     mask chip mask
+ * @param[in]     ind index
+ * @param[in]     *path pointer to a path buffer
+ * @param[out]    *done pointer to a mask buffer of the chips that finished
+ * @return        status code
+ *                - 0 success
+ *                - 1 update failed
+ *                - 2 bus is NULL
+ *                - 3 bus is not initialized
+ *                - 4 bin read init failed
+ *                - 5 ind > 0xDF
+ *                - 6 no initialized chip in the mask
+ * @note          a chip with a wrong status sum is dropped and the rest go on,
+ *                success means at least one chip finished,
+ *                the bus lock is held for the whole update
+ */
+uint8_t wt588e02b_bus_update(wt588e02b_bus_t *bus, uint32_t mask, uint8_t ind, char *path, uint32_t *done)
+{
+    uint8_t res;
+    uint8_t cmd[2];
+    
+    if (bus == NULL)                                                       /* check bus */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (bus->inited != 1)                                                  /* check bus initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if (ind > 0xDF)                                                        /* check ind */
+    {
+        WT588E02B_BUS_ERR(bus, IND_INVALID);                               /* ind > 0xDF */
+        
+        return 5;                                                          /* return error */
+    }
+    
+    if (a_wt588e02b_bus_lock(bus) != 0)                                    /* lock the bus */
+    {
+        WT588E02B_BUS_ERR(bus, LOCK_FAILED);                               /* lock failed */
+        
+        return 1;                                                          /* return error */
+    }
+    *done = a_wt588e02b_bus_update_mask(bus, mask);                        /* get the chip set */
+    if (*done == 0)                                                        /* check mask */
+    {
+        a_wt588e02b_bus_unlock(bus);                                       /* unlock the bus */
+        WT588E02B_BUS_ERR(bus, MASK_NOT_INITIALIZED);                      /* no initialized chip */
+        
+        return 6;                                                          /* return error */
+    }
+    cmd[0] = WT588E02B_COMMAND_UPDATE_ADDR;                                /* update address */
+    cmd[1] = ind;                                                          /* set ind */
+    
+    res = a_wt588e02b_bus_update(bus, done, cmd, path, 0);                 /* update */
+    a_wt588e02b_bus_unlock(bus);                                           /* unlock the bus */
+    
+    return res;                                                            /* return the result */
+}
+
+/**
+ * @brief         update all audio on several chips in lockstep
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[in]     mask chip mask
+ * @param[in]     *path pointer to a path buffer
+ * @param[out]    *done pointer to a mask buffer of the chips that finished
+ * @return        status code
+ *                - 0 success
+ *                - 1 update failed
+ *                - 2 bus is NULL
+ *                - 3 bus is not initialized
+ *                - 4 bin read init failed
+ *                - 5 bin size is invalid
+ *                - 6 no initialized chip in the mask
+ * @note          a chip with a wrong status sum is dropped and the rest go on,
+ *                success means at least one chip finished,
+ *                the bus lock is held for the whole update
+ */
+uint8_t wt588e02b_bus_update_all(wt588e02b_bus_t *bus, uint32_t mask, char *path, uint32_t *done)
+{
+    uint8_t res;
+    uint8_t cmd[2];
+    
+    if (bus == NULL)                                                       /* check bus */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (bus->inited != 1)                                                  /* check bus initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    if (a_wt588e02b_bus_lock(bus) != 0)                                    /* lock the bus */
+    {
+        WT588E02B_BUS_ERR(bus, LOCK_FAILED);                               /* lock failed */
+        
+        return 1;                                                          /* return error */
+    }
+    *done = a_wt588e02b_bus_update_mask(bus, mask);                        /* get the chip set */
+    if (*done == 0)                                                        /* check mask */
+    {
+        a_wt588e02b_bus_unlock(bus);                                       /* unlock the bus */
+        WT588E02B_BUS_ERR(bus, MASK_NOT_INITIALIZED);                      /* no initialized chip */
+        
+        return 6;                                                          /* return error */
+    }
+    cmd[0] = WT588E02B_COMMAND_UPDATE_ALL;                                 /* update all */
+    cmd[1] = 0xFF;                                                         /* set all */
+    
+    res = a_wt588e02b_bus_update(bus, done, cmd, path, 1);                 /* update */
+    a_wt588e02b_bus_unlock(bus);                                           /* unlock the bus */
+    
+    return res;                                                            /* return the result */
+}
+#endif
+
+/**
+ * @brief     read a little endian u16 of an image
+ * @param[in] *p pointer to a data buffer
+ * @return    u16 value
+ * @note      none
+ */
+static uint32_t a_wt588e02b_image_u16(const uint8_t *p)
+{
+    return (uint32_t)(p[0]) | ((uint32_t)(p[1]) << 8);                                  /* get u16 */
+}
+
+/**
+ * @brief     read a little endian u32 of an image
+ * @param[in] *p pointer to a data buffer
+ * @return    u32 value
+ * @note      none
+ */
+static uint32_t a_wt588e02b_image_u32(const uint8_t *p)
+{
+    return (uint32_t)(p[0]) | ((uint32_t)(p[1]) << 8) |                                 /* get u32 */
+           ((uint32_t)(p[2]) << 16) | ((uint32_t)(p[3]) << 24);                         /* get u32 */
+}
+
+/**
+ * @brief     open a voice image
+ * @param[in] *image pointer to a wt588e02b image structure
+ * @param[in] *buf pointer to an image buffer
+ * @param[in] size buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 1 header is invalid
+ *            - 2 image or buf is NULL
+ *            - 4 size is too small
+ *            - 5 image size is not the buffer size
+ *            - 6 voice table is invalid
+ *            - 7 list table is invalid
+ * @note      the buffer is parsed in place and must stay valid while the image is used,
+ *            so it can be a whole bin file in memory or a mmap of it;
+ *            nothing touches the bus, so a bad file is refused before a long update
+ */
+uint8_t wt588e02b_image_open(wt588e02b_image_t *image, const uint8_t *buf, uint32_t size)
+{
+    uint32_t i;
+    uint32_t addr;
+    uint32_t prev;
+    uint32_t n;
+    uint32_t list_table;
+    uint32_t voice_table;
+    uint32_t data;
+    uint32_t list_count;
+    uint32_t voice_count;
+    
+    if ((image == NULL) || (buf == NULL))                                               /* check image and buf */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    memset(image, 0, sizeof(wt588e02b_image_t));                                        /* a failed open leaves it closed */
+    if (size < WT588E02B_IMAGE_HEADER_SIZE)                                             /* check the header size */
+    {
+        return 4;                                                                       /* return error */
+    }
+    if ((memcmp(&buf[WT588E02B_IMAGE_TAG], "LibDriver", 9) != 0) ||                     /* check the tag */
+        (memchr(&buf[WT588E02B_IMAGE_VERSION], 0,
+                WT588E02B_IMAGE_VERSION_SIZE) == NULL))                                 /* check the version is terminated */
+    {
+        return 1;                                                                       /* return error */
+    }
+    if ((a_wt588e02b_image_u32(&buf[WT588E02B_IMAGE_SIZE - 1]) >> 8) != size)           /* check the image size */
+    {
+        return 5;                                                                       /* return error */
+    }
+    
+    voice_table = a_wt588e02b_image_u16(&buf[WT588E02B_IMAGE_VOICE_TABLE]);            /* get the voice table */
+    voice_count = a_wt588e02b_image_u16(&buf[WT588E02B_IMAGE_VOICE_LAST]) + 1;         /* get the voice number */
+    data = a_wt588e02b_image_u32(&buf[WT588E02B_IMAGE_DATA]);                           /* get the first voice */
+    if ((voice_count > 0xE0) ||                                                         /* check the voice number */
+        (voice_table < WT588E02B_IMAGE_HEADER_SIZE) ||                                  /* check the table start */
+        (voice_table + voice_count * 4 > size) ||                                       /* check the table end */
+        (data < voice_table + voice_count * 4) || (data >= size))                       /* check the data start */
+    {
+        return 6;                                                                       /* return error */
+    }
+    prev = data;                                                                        /* voices start at the data */
+    for (i = 0; i < voice_count; i++)                                                   /* check all voices */
+    {
+        addr = a_wt588e02b_image_u32(&buf[voice_table + i * 4]);                        /* get the voice offset */
+        if ((addr < prev) || (addr >= size) || ((i != 0) && (addr == prev)))            /* voices are ascending and not empty */
+        {
+            return 6;                                                                   /* return error */
+        }
+        prev = addr;                                                                    /* save the offset */
+    }
+    
+    list_table = a_wt588e02b_image_u16(&buf[WT588E02B_IMAGE_LIST_TABLE]);              /* get the list table */
+    list_count = a_wt588e02b_image_u16(&buf[WT588E02B_IMAGE_LIST_LAST]) + 1;           /* get the list number */
+    if ((list_table < WT588E02B_IMAGE_HEADER_SIZE) ||                                   /* check the table start */
+        (list_table + list_count * 4 > size))                                           /* check the table end */
+    {
+        return 7;                                                                       /* return error */
+    }
+    for (i = 0; i < list_count; i++)                                                    /* check all lists */
+    {
+        addr = a_wt588e02b_image_u32(&buf[list_table + i * 4]);                         /* get the list offset */
+        if (addr < WT588E02B_IMAGE_HEADER_SIZE)                                         /* check the list start */
+        {
+            return 7;                                                                   /* return error */
+        }
+        for (n = 0; ; n++)                                                              /* walk the list */
+        {
+            if (addr + 2 > size)                                                        /* check the list is terminated */
+            {
+                return 7;                                                               /* return error */
+            }
+            prev = a_wt588e02b_image_u16(&buf[addr]);                                   /* get the voice index */
+            if (prev == WT588E02B_IMAGE_LIST_END)                                       /* check the end */
+            {
+                break;                                                                  /* break */
+            }
+            if ((prev >= voice_count) || (n >= 0xFF))                                   /* check the index and the length */
+            {
+                return 7;                                                               /* return error */
+            }
+            addr += 2;                                                                  /* next index */
+        }
+    }
+    
+    image->size = size;                                                                 /* save the size */
+    image->list_table = list_table;                                                     /* save the list table */
+    image->voice_table = voice_table;                                                   /* save the voice table */
+    image->data = data;                                                                 /* save the data start */
+    image->list_count = (uint16_t)list_count;                                           /* save the list number */
+    image->voice_count = (uint16_t)voice_count;                                         /* save the voice number */
+    image->version = (const char *)&buf[WT588E02B_IMAGE_VERSION];                       /* point to the version */
+    image->buf = buf;                                                                   /* the image is opened */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get a voice of an image
+ * @param[in]  *image pointer to a wt588e02b image structure
+ * @param[in]  index voice index
+ * @param[out] *voice pointer to a wt588e02b image voice structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 image or voice is NULL
+ *             - 3 image is not opened
+ *             - 4 index is over the voice number
+ * @note       the length is the slot length up to the next voice, so it includes the padding;
+ *             the blocks are the 512 bytes update packets which hold the voice
+ */
+uint8_t wt588e02b_image_get_voice(const wt588e02b_image_t *image, uint16_t index, wt588e02b_image_voice_t *voice)
+{
+    uint32_t end;
+    
+    if ((image == NULL) || (voice == NULL))                                             /* check image and voice */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (image->buf == NULL)                                                             /* check the image */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if (index >= image->voice_count)                                                    /* check the index */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    voice->index = index;                                                               /* set the index */
+    voice->offset = a_wt588e02b_image_u32(&image->buf[image->voice_table + index * 4]); /* get the offset */
+    if (index + 1 < image->voice_count)                                                 /* check the last voice */
+    {
+        end = a_wt588e02b_image_u32(&image->buf[image->voice_table + index * 4 + 4]);   /* up to the next voice */
+    }
+    else
+    {
+        end = image->size;                                                              /* up to the image end */
+    }
+    voice->length = end - voice->offset;                                                /* set the length */
+    if (image->buf[voice->offset] == WT588E02B_IMAGE_T3Z_MAGIC)                         /* check the magic */
+    {
+        voice->format = WT588E02B_IMAGE_FORMAT_T3Z;                                     /* t3z */
+    }
+    else
+    {
+        voice->format = WT588E02B_IMAGE_FORMAT_UNKNOWN;                                 /* unknown */
+    }
+    voice->first_block = voice->offset / WT588E02B_IMAGE_BLOCK_SIZE;                    /* set the first block */
+    voice->block_count = (end + WT588E02B_IMAGE_BLOCK_SIZE - 1) /
+                         WT588E02B_IMAGE_BLOCK_SIZE - voice->first_block;               /* set the block number */
+    voice->data = &image->buf[voice->offset];                                           /* point to the data */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief         get a play list of an image
+ * @param[in]     *image pointer to a wt588e02b image structure
+ * @param[in]     list list number
+ * @param[out]    *ind pointer to an index buffer
+ * @param[in,out] *len pointer to an index buffer length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 index buffer is too small
+ *                - 2 image, ind or len is NULL
+ *                - 3 image is not opened
+ *                - 4 list is over the list number
+ * @note          the indexes can be passed to wt588e02b_play_list as they are
+ */
+uint8_t wt588e02b_image_get_list(const wt588e02b_image_t *image, uint16_t list, uint8_t *ind, uint8_t *len)
+{
+    uint32_t addr;
+    uint32_t value;
+    uint8_t n;
+    
+    if ((image == NULL) || (ind == NULL) || (len == NULL))                              /* check image, ind and len */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (image->buf == NULL)                                                             /* check the image */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if (list >= image->list_count)                                                      /* check the list */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    addr = a_wt588e02b_image_u32(&image->buf[image->list_table + list * 4]);            /* get the list offset */
+    for (n = 0; ; n++)                                                                  /* walk the list, checked at open */
+    {
+        value = a_wt588e02b_image_u16(&image->buf[addr + n * 2]);                       /* get the voice index */
+        if (value == WT588E02B_IMAGE_LIST_END)                                          /* check the end */
+        {
+            break;                                                                      /* break */
+        }
+        if (n >= *len)                                                                  /* check the buffer */
+        {
+            return 1;                                                                   /* return error */
+        }
+        ind[n] = (uint8_t)value;                                                        /* save the index */
+    }
+    *len = n;                                                                           /* set the length */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief         read a log ring
+ * @param[in]     *log pointer to a log ring
+ * @param[out]    *record pointer to a record buffer
+ * @param[in,out] *len pointer to a record buffer length buffer
+ * @param[out]    *lost pointer to a lost record number buffer
+ * @note          only the tail is written and the copy stops at the first slot without its stamp,
+ *                so the reader never races a writer on a slot, no ring or a log level of none reads nothing
+ */
+static void a_wt588e02b_log_read(wt588e02b_log_t *log, wt588e02b_log_record_t *record, uint16_t *len, uint32_t *lost)
+{
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    uint32_t tail;
+    uint32_t n;
+    uint32_t i;
+    wt588e02b_log_record_t *r;
+    
+    if (log == NULL)                                                               /* check the ring */
+    {
+        *len = 0;                                                                  /* set the length */
+        *lost = 0;                                                                 /* set the lost number */
+        
+        return;                                                                    /* return */
+    }
+    tail = log->tail;                                                              /* get tail */
+    n = log->head - tail;                                                          /* get the reserved number */
+    if (n > *len)                                                                  /* check the buffer */
+    {
+        n = *len;                                                                  /* limit */
+    }
+    for (i = 0; i < n; i++)                                                        /* copy the committed records */
+    {
+        r = &log->record[(tail + i) & (WT588E02B_LOG_SIZE - 1)];                   /* get slot */
+        if (*(volatile uint8_t *)&r->seq != (uint8_t)(tail + i + 1))               /* check the stamp */
+        {
+            break;                                                                 /* a writer still fills the slot */
+        }
+        WT588E02B_LOG_BARRIER();                                                   /* read the stamp before the record */
+        record[i] = *r;                                                            /* copy the record */
+    }
+    WT588E02B_LOG_BARRIER();                                                       /* copy the records before the tail */
+    log->tail = tail + i;                                                          /* pop */
+    *len = (uint16_t)i;                                                            /* set the length */
+    *lost = log->lost;                                                             /* set the lost number */
+#else
+    (void)log;                                                                     /* no record is compiled */
+    (void)record;                                                                  /* no record is compiled */
+    *len = 0;                                                                      /* set the length */
+    *lost = 0;                                                                     /* set the lost number */
+#endif
+}
+
+/**
+ * @brief     clear a log ring
+ * @param[in] *log pointer to a log ring
+ * @param[in] *timestamp_ms pointer to a record clock, NULL stamps 0
+ * @note      every slot gets the stamp of the lap before, so no slot reads as committed
+ */
+static void a_wt588e02b_log_clear(wt588e02b_log_t *log, uint32_t (*timestamp_ms)(void))
+{
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    uint32_t i;
+    
+    for (i = 0; i < WT588E02B_LOG_SIZE; i++)                                       /* all slots */
+    {
+        log->record[i].seq = (uint8_t)(i + 1 - WT588E02B_LOG_SIZE);                /* not committed */
+    }
+#endif
+    log->timestamp_ms = timestamp_ms;                                              /* set the record clock */
+    log->head = 0;                                                                 /* clear head */
+    log->tail = 0;                                                                 /* clear tail */
+    log->lost = 0;                                                                 /* clear lost */
+}
+
+/**
+ * @brief     set the deferred log ring
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *log pointer to a caller owned ring, NULL prints through debug_print
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the ring is cleared and the timestamp_ms linked at the call is used as the record clock
+ */
+uint8_t wt588e02b_set_log(wt588e02b_handle_t *handle, wt588e02b_log_t *log)
+{
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    
+    if (log != NULL)                                                               /* check the ring */
+    {
+        a_wt588e02b_log_clear(log, (handle->ops != NULL) ?                         /* clear the ring */
+                              handle->ops->timestamp_ms : NULL);                   /* with the record clock */
+    }
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    handle->log = log;                                                             /* set the ring */
+#endif
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief         read the deferred log
+ * @param[in]     *handle pointer to a wt588e02b handle structure
+ * @param[out]    *record pointer to a record buffer
+ * @param[in,out] *len pointer to a record buffer length buffer
+ * @param[out]    *lost pointer to a lost record number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ * @note          none
+ */
+uint8_t wt588e02b_log_read(wt588e02b_handle_t *handle, wt588e02b_log_record_t *record, uint16_t *len, uint32_t *lost)
+{
+    if ((handle == NULL) || (record == NULL) || (len == NULL) || (lost == NULL))   /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    a_wt588e02b_log_read(handle->log, record, len, lost);                          /* read the ring */
+#else
+    a_wt588e02b_log_read(NULL, record, len, lost);                                 /* no ring is compiled */
+#endif
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the deferred log ring of the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] *log pointer to a caller owned ring, NULL prints through debug_print
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ * @note      the ring is cleared
+ */
+uint8_t wt588e02b_bus_set_log(wt588e02b_bus_t *bus, wt588e02b_log_t *log)
+{
+    if (bus == NULL)                                                               /* check bus */
+    {
+        return 2;                                                                  /* return error */
+    }
+    
+    if (log != NULL)                                                               /* check the ring */
+    {
+        a_wt588e02b_log_clear(log, NULL);                                          /* clear the ring, no record clock */
+    }
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    bus->log = log;                                                                /* set the ring */
+#endif
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief         read the deferred log of the shared bus
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[out]    *record pointer to a record buffer
+ * @param[in,out] *len pointer to a record buffer length buffer
+ * @param[out]    *lost pointer to a lost record number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 bus is NULL
+ * @note          none
+ */
+uint8_t wt588e02b_bus_log_read(wt588e02b_bus_t *bus, wt588e02b_log_record_t *record, uint16_t *len, uint32_t *lost)
+{
+    if ((bus == NULL) || (record == NULL) || (len == NULL) || (lost == NULL))      /* check bus */
+    {
+        return 2;                                                                  /* return error */
+    }
+    
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    a_wt588e02b_log_read(bus->log, record, len, lost);                             /* read the ring */
+#else
+    a_wt588e02b_log_read(NULL, record, len, lost);                                 /* no ring is compiled */
+#endif
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+#if (WT588E02B_FEATURE_REG != 0)
+/**
+ * @brief     wait a segment gap
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] us gap in us
+ * @note      whole ms go to delay_ms, so a long gap never overflows a short delay_us timer
+ */
+static void a_wt588e02b_gap(wt588e02b_handle_t *handle, uint32_t us)
+{
+    if (us >= 1000)                                                              /* check ms */
+    {
+        handle->ops->delay_ms(us / 1000);                                        /* delay ms */
+    }
+    if ((us % 1000) != 0)                                                        /* check us */
+    {
+        handle->ops->delay_us(us % 1000);                                        /* delay us */
+    }
+}
+
+/**
+ * @brief     begin a raw frame
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 begin failed
+ * @note      raw frames invalidate the shadow state
+ */
+static uint8_t a_wt588e02b_raw_begin(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    
+    res = a_wt588e02b_sclk_write(handle, 0);                                     /* set sclk low */
+    if (res != 0)                                                                /* check result */
+    {
+        WT588E02B_ERR(handle, SCLK_GPIO_WRITE_FAILED);                           /* sclk gpio write failed */
+        
+        return 1;                                                                /* return error */
+    }
+    a_wt588e02b_shadow_reset(handle);                                            /* raw frames invalidate the shadow state */
+    res = handle->ops->cs_gpio_write(0);                                         /* set cs low */
+    if (res != 0)                                                                /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                             /* cs gpio write failed */
+        (void)handle->ops->cs_gpio_write(1);                                     /* release cs */
+        
+        return 1;                                                                /* return error */
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     end a raw frame
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 end failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_raw_end(wt588e02b_handle_t *handle)
+{
+    uint8_t res;
+    
+    res = handle->ops->cs_gpio_write(1);                                         /* set cs high */
+    if (res != 0)                                                                /* check result */
+    {
+        WT588E02B_ERR(handle, CS_GPIO_WRITE_FAILED);                             /* cs gpio write failed */
+        
+        return 1;                                                                /* return error */
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     run one segment of a raw frame
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *seg pointer to a segment structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 segment failed
+ * @note      cs is held low by the caller and released on an error
+ */
+static uint8_t a_wt588e02b_raw_segment(wt588e02b_handle_t *handle, const wt588e02b_segment_t *seg)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    a_wt588e02b_gap(handle, seg->gap_us);                                        /* wait the gap */
+    for (i = 0; i < seg->len; i++)                                               /* run all bytes */
+    {
+        if (seg->dir == WT588E02B_SEGMENT_WRITE)                                 /* check direction */
+        {
+            res = a_wt588e02b_write_with_no_cs(handle, seg->half_us, seg->buf[i]); /* write data */
+            if (res != 0)                                                        /* check result */
+            {
+                WT588E02B_ERR(handle, WRITE_WITH_NO_CS_FAILED);                  /* write with no cs failed */
+                (void)handle->ops->cs_gpio_write(1);                             /* release cs */
+                
+                return 1;                                                        /* return error */
+            }
+        }
+        else
+        {
+            res = a_wt588e02b_read_with_no_cs(handle, seg->half_us, &seg->buf[i]); /* read data */
+            if (res != 0)                                                        /* check result */
+            {
+                WT588E02B_ERR(handle, READ_WITH_NO_CS_FAILED);                   /* read with no cs failed */
+                (void)handle->ops->cs_gpio_write(1);                             /* release cs */
+                
+                return 1;                                                        /* return error */
+            }
+        }
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     run the chip register bytes one by one
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] dir segment direction
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @param[in] us delay us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the caller holds the lock, every byte waits 5ms in the frame
+ */
+static uint8_t a_wt588e02b_reg(wt588e02b_handle_t *handle, wt588e02b_segment_dir_t dir, uint8_t *buf, uint16_t len, uint32_t us)
+{
+    uint16_t i;
+    wt588e02b_segment_t seg;
+    
+    if (a_wt588e02b_raw_begin(handle) != 0)                                      /* begin */
+    {
+        return 1;                                                                /* return error */
+    }
+    seg.dir = dir;                                                               /* set direction */
+    seg.len = 1;                                                                 /* one byte */
+    seg.half_us = us;                                                            /* set half period */
+    seg.gap_us = 5000;                                                           /* 5ms before every byte */
+    for (i = 0; i < len; i++)                                                    /* run all bytes */
+    {
+        seg.buf = &buf[i];                                                       /* set the byte */
+        if (a_wt588e02b_raw_segment(handle, &seg) != 0)                          /* run the byte */
+        {
+            return 1;                                                            /* return error */
         }
     }
-    res = a_update_end(handle);                                                   /* update end */
-    if (res != 0)                                                                 /* check result */
+    
+    return a_wt588e02b_raw_end(handle);                                          /* end */
+}
+
+/**
+ * @brief     set the chip register
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @param[in] us delay us
+ * @return    status code
+ *            - 0 success
+ *            - 1 set reg failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      every byte waits 5ms in the frame, wt588e02b_transfer sets the gaps per segment
+ */
+uint8_t wt588e02b_set_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t us)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
     {
-        handle->debug_print("wt588e02b: update end failed.\n");                   /* update end failed */
-        (void)handle->bin_read_deinit();                                          /* bin read deinit */
-        
-        return 1;                                                                 /* return error */
+        return 2;                                         /* return error */
     }
-    res = handle->bin_read_deinit();                                              /* bin read deinit */
-    if (res != 0)                                                                 /* check result */
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
     {
-        handle->debug_print("wt588e02b: bin read deinit failed.\n");              /* bin read deinit failed */
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
         
-        return 1;                                                                 /* return error */
+        return 1;                                         /* return error */
     }
+    res = a_wt588e02b_reg(handle, WT588E02B_SEGMENT_WRITE, buf, len, us);  /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
     
-    return 0;                                                                     /* success return 0 */
+    return res;                                           /* return the result */
 }
 
 /**
- * @brief      check chip busy
+ * @brief      get the chip register
  * @param[in]  *handle pointer to a wt588e02b handle structure
- * @param[out] *enable pointer to a bool buffer
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @param[in]  us delay us
  * @return     status code
  *             - 0 success
- *             - 1 check busy failed
+ *             - 1 get reg failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       every byte waits 5ms in the frame, wt588e02b_transfer sets the gaps per segment
  */
-uint8_t wt588e02b_check_busy(wt588e02b_handle_t *handle, wt588e02b_bool_t *enable)
+uint8_t wt588e02b_get_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t us)
 {
     uint8_t res;
-    uint8_t busy;
     
-    if (handle == NULL)                                                /* check handle */
+    if (handle == NULL)                                   /* check handle */
     {
-        return 2;                                                      /* return error */
+        return 2;                                         /* return error */
     }
-    if (handle->inited != 1)                                           /* check handle initialization */
+    if (handle->inited != 1)                              /* check handle initialization */
     {
-        return 3;                                                      /* return error */
+        return 3;                                         /* return error */
     }
-
-    res = a_wt588e02b_check_busy(handle, &busy);                       /* read busy */
-    if (res != 0)                                                      /* check result */
+    
+    if (a_wt588e02b_enter(handle, 1) != 0)                /* lock */
     {
-        handle->debug_print("wt588e02b: check busy failed.\n");        /* check busy failed */
+        WT588E02B_ERR(handle, LOCK_FAILED);               /* lock failed */
         
-        return 1;                                                      /* return error */
+        return 1;                                         /* return error */
     }
-    if (busy != 0)                                                     /* check busy */
-    {
-        *enable = WT588E02B_BOOL_TRUE;                                 /* set true */
-    }
-    else
-    {
-        *enable = WT588E02B_BOOL_FALSE;                                /* set false */
-    }
-
-    return 0;                                                          /* success return 0 */
+    res = a_wt588e02b_reg(handle, WT588E02B_SEGMENT_READ, buf, len, us);   /* run with the lock held */
+    a_wt588e02b_unlock(handle);                           /* unlock */
+    
+    return res;                                           /* return the result */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     run a raw transaction
  * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *segs pointer to a segment array
+ * @param[in] n segment number
  * @return    status code
  *            - 0 success
- *            - 1 gpio initialization failed
+ *            - 1 transfer failed
  *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- * @note      none
+ *            - 3 handle is not initialized
+ *            - 4 segment is invalid
+ * @note      all segments run in one cs assertion, a read segment clocks mosi low,
+ *            the gap of a segment is only waited once, so a 16 bytes segment costs one gap instead of 16
  */
-uint8_t wt588e02b_init(wt588e02b_handle_t *handle)
+uint8_t wt588e02b_transfer(wt588e02b_handle_t *handle, const wt588e02b_segment_t *segs, uint16_t n)
 {
-    if (handle == NULL)                                                      /* check handle */
-    {
-        return 2;                                                            /* return error */
-    }
-    if (handle->debug_print == NULL)                                         /* check debug_print */
-    {
-        return 3;                                                            /* return error */
-    }
-    if (handle->sclk_gpio_init == NULL)                                      /* check sclk_gpio_init */
-    {
-        handle->debug_print("wt588e02b: sclk_gpio_init is null.\n");         /* sclk_gpio_init is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->sclk_gpio_deinit == NULL)                                    /* check sclk_gpio_deinit */
-    {
-        handle->debug_print("wt588e02b: sclk_gpio_deinit is null.\n");       /* sclk_gpio_deinit is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->sclk_gpio_write == NULL)                                     /* check sclk_gpio_write */
-    {
-        handle->debug_print("wt588e02b: sclk_gpio_write is null.\n");        /* sclk_gpio_write is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->mosi_gpio_init == NULL)                                      /* check mosi_gpio_init */
-    {
-        handle->debug_print("wt588e02b: mosi_gpio_init is null.\n");         /* mosi_gpio_init is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->mosi_gpio_deinit == NULL)                                    /* check mosi_gpio_deinit */
-    {
-        handle->debug_print("wt588e02b: mosi_gpio_deinit is null.\n");       /* mosi_gpio_deinit is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->mosi_gpio_write == NULL)                                     /* check mosi_gpio_write */
-    {
-        handle->debug_print("wt588e02b: mosi_gpio_write is null.\n");        /* mosi_gpio_write is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->miso_gpio_init == NULL)                                      /* check miso_gpio_init */
-    {
-        handle->debug_print("wt588e02b: miso_gpio_init is null.\n");         /* miso_gpio_init is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->miso_gpio_deinit == NULL)                                    /* check miso_gpio_deinit */
-    {
-        handle->debug_print("wt588e02b: miso_gpio_deinit is null.\n");       /* miso_gpio_deinit is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->miso_gpio_read == NULL)                                      /* check miso_gpio_read */
-    {
-        handle->debug_print("wt588e02b: miso_gpio_read is null.\n");         /* miso_gpio_read is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->cs_gpio_init == NULL)                                        /* check cs_gpio_init */
-    {
-        handle->debug_print("wt588e02b: cs_gpio_init is null.\n");           /* cs_gpio_init is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->cs_gpio_deinit == NULL)                                      /* check cs_gpio_deinit */
-    {
-        handle->debug_print("wt588e02b: cs_gpio_deinit is null.\n");         /* cs_gpio_deinit is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->cs_gpio_write == NULL)                                       /* check cs_gpio_write */
-    {
-        handle->debug_print("wt588e02b: cs_gpio_write is null.\n");          /* cs_gpio_write is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->delay_ms == NULL)                                            /* check delay_ms */
-    {
-        handle->debug_print("wt588e02b: delay_ms is null.\n");               /* delay_ms is null */
-       
-        return 3;                                                            /* return error */
-    }
-    if (handle->delay_us == NULL)                                            /* check delay_us */
+    uint8_t res;
+    uint16_t i;
+    
+    if (handle == NULL)                                                          /* check handle */
     {
-        handle->debug_print("wt588e02b: delay_us is null.\n");               /* delay_us is null */
-       
-        return 3;                                                            /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->bin_read_init == NULL)                                       /* check bin_read_init */
+    if (handle->inited != 1)                                                     /* check handle initialization */
     {
-        handle->debug_print("wt588e02b: bin_read_init is null.\n");          /* bin_read_init is null */
-       
-        return 3;                                                            /* return error */
+        return 3;                                                                /* return error */
     }
-    if (handle->bin_read == NULL)                                            /* check bin_read */
+    if ((segs == NULL) || (n == 0))                                              /* check segments */
     {
-        handle->debug_print("wt588e02b: bin_read is null.\n");               /* bin_read is null */
-       
-        return 3;                                                            /* return error */
+        WT588E02B_ERR(handle, SEGMENT_INVALID);                                  /* segment is invalid */
+        
+        return 4;                                                                /* return error */
     }
-    if (handle->bin_read_deinit == NULL)                                     /* check bin_read_deinit */
+    for (i = 0; i < n; i++)                                                      /* check all segments */
     {
-        handle->debug_print("wt588e02b: bin_read_deinit is null.\n");        /* bin_read_deinit is null */
-       
-        return 3;                                                            /* return error */
+        if (((segs[i].dir != WT588E02B_SEGMENT_WRITE) && (segs[i].dir != WT588E02B_SEGMENT_READ)) ||
+            ((segs[i].len != 0) && (segs[i].buf == NULL)))                       /* check segment */
+        {
+            WT588E02B_ERR_ARG(handle, SEGMENT_N_INVALID, i);                     /* segment is invalid */
+            
+            return 4;                                                            /* return error */
+        }
     }
     
-    if (handle->sclk_gpio_init() != 0)                                       /* sclk gpio init */
-    {
-        handle->debug_print("wt588e02b: sclk gpio init failed.\n");          /* sclk gpio init failed */
-       
-        return 1;                                                            /* return error */
-    }
-    if (handle->mosi_gpio_init() != 0)                                       /* mosi gpio init */
+    if (a_wt588e02b_enter(handle, 1) != 0)                                       /* lock */
     {
-        handle->debug_print("wt588e02b: mosi gpio init failed.\n");          /* mosi gpio init failed */
-        (void)handle->sclk_gpio_deinit();                                    /* sclk gpio deinit */
+        WT588E02B_ERR(handle, LOCK_FAILED);                                      /* lock failed */
         
-        return 1;                                                            /* return error */
+        return 1;                                                                /* return error */
     }
-    if (handle->miso_gpio_init() != 0)                                       /* miso gpio init */
+    res = a_wt588e02b_raw_begin(handle);                                         /* begin */
+    for (i = 0; (i < n) && (res == 0); i++)                                      /* run all segments */
     {
-        handle->debug_print("wt588e02b: miso gpio init failed.\n");          /* miso gpio init failed */
-        (void)handle->sclk_gpio_deinit();                                    /* sclk gpio deinit */
-        (void)handle->mosi_gpio_deinit();                                    /* mosi gpio deinit */
-        
-        return 1;                                                            /* return error */
+        res = a_wt588e02b_raw_segment(handle, &segs[i]);                         /* run the segment */
     }
-    if (handle->cs_gpio_init() != 0)                                         /* cs gpio init */
+    if (res == 0)                                                                /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio init failed.\n");            /* cs gpio init failed */
-        (void)handle->sclk_gpio_deinit();                                    /* sclk gpio deinit */
-        (void)handle->mosi_gpio_deinit();                                    /* mosi gpio deinit */
-        (void)handle->miso_gpio_deinit();                                    /* miso gpio deinit */
-        
-        return 1;                                                            /* return error */
+        res = a_wt588e02b_raw_end(handle);                                       /* end */
     }
-    handle->sum = 0;                                                         /* init 0 */
-    handle->inited = 1;                                                      /* flag finished */
+    a_wt588e02b_unlock(handle);                                                  /* unlock */
     
-    return 0;                                                                /* success return 0 */
+    return res;                                                                  /* return the result */
 }
 
 /**
- * @brief     deinit the chip
+ * @brief     begin a split raw transaction
  * @param[in] *handle pointer to a wt588e02b handle structure
  * @return    status code
  *            - 0 success
- *            - 1 deinit failed
+ *            - 1 begin failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the lock is held until wt588e02b_raw_end or a failed segment,
+ *            cs stays low between the calls, so the caller may wait a long gap without blocking
  */
-uint8_t wt588e02b_deinit(wt588e02b_handle_t *handle)
+uint8_t wt588e02b_raw_begin(wt588e02b_handle_t *handle)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                      /* check handle */
+    if (handle == NULL)                                                          /* check handle */
     {
-        return 2;                                                            /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                     /* check handle initialization */
     {
-        return 3;                                                            /* return error */
+        return 3;                                                                /* return error */
     }
     
-    res = handle->sclk_gpio_deinit();                                        /* sclk gpio deinit failed */
-    if (res != 0)                                                            /* check result */
-    {
-        handle->debug_print("wt588e02b: sclk gpio deinit failed.\n");        /* sclk gpio deinit failed */
-        
-        return 1;                                                            /* return error */
-    }
-    res = handle->mosi_gpio_deinit();                                        /* mosi gpio deinit failed */
-    if (res != 0)                                                            /* check result */
-    {
-        handle->debug_print("wt588e02b: mosi gpio deinit failed.\n");        /* mosi gpio deinit failed */
-        
-        return 1;                                                            /* return error */
-    }
-    res = handle->miso_gpio_deinit();                                        /* miso gpio deinit failed */
-    if (res != 0)                                                            /* check result */
+    if (a_wt588e02b_enter(handle, 1) != 0)                                       /* lock */
     {
-        handle->debug_print("wt588e02b: miso gpio deinit failed.\n");        /* miso gpio deinit failed */
+        WT588E02B_ERR(handle, LOCK_FAILED);                                      /* lock failed */
         
-        return 1;                                                            /* return error */
+        return 1;                                                                /* return error */
     }
-    res = handle->cs_gpio_deinit();                                          /* cs gpio deinit failed */
-    if (res != 0)                                                            /* check result */
+    res = a_wt588e02b_raw_begin(handle);                                         /* begin */
+    if (res != 0)                                                                /* check result */
     {
-        handle->debug_print("wt588e02b: cs gpio deinit failed.\n");          /* cs gpio deinit failed */
-        
-        return 1;                                                            /* return error */
+        a_wt588e02b_unlock(handle);                                              /* unlock */
     }
-    handle->inited = 0;                                                      /* flag closed */
     
-    return 0;                                                                /* success return 0 */
+    return res;                                                                  /* return the result */
 }
 
 /**
- * @brief     set the chip register
+ * @brief     run one segment of a split raw transaction
  * @param[in] *handle pointer to a wt588e02b handle structure
- * @param[in] *buf pointer to a data buffer
- * @param[in] len buffer length
- * @param[in] us delay us
+ * @param[in] *seg pointer to a segment structure
  * @return    status code
  *            - 0 success
- *            - 1 set reg failed
+ *            - 1 segment failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 segment is invalid
+ * @note      cs and the lock are released on an error, so the transaction must begin again
  */
-uint8_t wt588e02b_set_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t us)
+uint8_t wt588e02b_raw_segment(wt588e02b_handle_t *handle, const wt588e02b_segment_t *seg)
 {
     uint8_t res;
-    uint16_t i;
     
     if (handle == NULL)                                                          /* check handle */
     {
@@ -1610,60 +5843,39 @@ uint8_t wt588e02b_set_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len
     {
         return 3;                                                                /* return error */
     }
-    
-    res = handle->sclk_gpio_write(0);                                            /* set sclk low */
-    if (res != 0)                                                                /* check result */
-    {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");             /* sclk gpio write failed */
-        
-        return 1;                                                                /* return error */
-    }
-    res = handle->cs_gpio_write(0);                                              /* set cs low */
-    if (res != 0)                                                                /* check result */
+    if ((seg == NULL) ||
+        ((seg->dir != WT588E02B_SEGMENT_WRITE) && (seg->dir != WT588E02B_SEGMENT_READ)) ||
+        ((seg->len != 0) && (seg->buf == NULL)))                                 /* check segment */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");               /* cs gpio write failed */
+        WT588E02B_ERR(handle, SEGMENT_INVALID);                                  /* segment is invalid */
+        (void)handle->ops->cs_gpio_write(1);                                     /* release cs */
+        a_wt588e02b_unlock(handle);                                              /* unlock */
         
-        return 1;                                                                /* return error */
-    }
-    for (i = 0; i < len; i++)                                                    /* write all */
-    {
-        handle->delay_ms(5);                                                     /* delay 5ms */
-        res = a_wt588e02b_write_with_no_cs(handle, us, buf[i]);                  /* write command */
-        if (res != 0)                                                            /* check result */
-        {
-            handle->debug_print("wt588e02b: write with no cs failed.\n");        /* write with no cs failed */
-            
-            return 1;                                                            /* return error */
-        }
+        return 4;                                                                /* return error */
     }
-    res = handle->cs_gpio_write(1);                                              /* set cs high */
-    if (res != 0)                                                                /* check result */
+    
+    res = a_wt588e02b_raw_segment(handle, seg);                                  /* run the segment */
+    if (res != 0)                                                                /* cs is released */
     {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");               /* cs gpio write failed */
-        
-        return 1;                                                                /* return error */
+        a_wt588e02b_unlock(handle);                                              /* unlock */
     }
     
-    return 0;                                                                    /* success return 0 */
+    return res;                                                                  /* return the result */
 }
 
 /**
- * @brief      get the chip register
- * @param[in]  *handle pointer to a wt588e02b handle structure
- * @param[out] *buf pointer to a data buffer
- * @param[in]  len buffer length
- * @param[in]  us delay us
- * @return     status code
- *             - 0 success
- *             - 1 get reg failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     end a split raw transaction
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 end failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the lock is released even if cs can not be set high
  */
-uint8_t wt588e02b_get_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t us)
+uint8_t wt588e02b_raw_end(wt588e02b_handle_t *handle)
 {
     uint8_t res;
-    uint16_t i;
     
     if (handle == NULL)                                                          /* check handle */
     {
@@ -1674,41 +5886,12 @@ uint8_t wt588e02b_get_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len
         return 3;                                                                /* return error */
     }
     
-    res = handle->sclk_gpio_write(0);                                            /* set sclk low */
-    if (res != 0)                                                                /* check result */
-    {
-        handle->debug_print("wt588e02b: sclk gpio write failed.\n");             /* sclk gpio write failed */
-        
-        return 1;                                                                /* return error */
-    }
-    res = handle->cs_gpio_write(0);                                              /* set cs low */
-    if (res != 0)                                                                /* check result */
-    {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");               /* cs gpio write failed */
-        
-        return 1;                                                                /* return error */
-    }
-    for (i = 0; i < len; i++)                                                    /* write all */
-    {
-        handle->delay_ms(5);                                                     /* delay 5ms */
-        res = a_wt588e02b_read_with_no_cs(handle, us, &buf[i]);                  /* read data */
-        if (res != 0)                                                            /* check result */
-        {
-            handle->debug_print("wt588e02b: read with no cs failed.\n");         /* read with no cs failed */
-            
-            return 1;                                                            /* return error */
-        }
-    }
-    res = handle->cs_gpio_write(1);                                              /* set cs high */
-    if (res != 0)                                                                /* check result */
-    {
-        handle->debug_print("wt588e02b: cs gpio write failed.\n");               /* cs gpio write failed */
-        
-        return 1;                                                                /* return error */
-    }
+    res = a_wt588e02b_raw_end(handle);                                           /* end */
+    a_wt588e02b_unlock(handle);                                                  /* unlock */
     
-    return 0;                                                                    /* success return 0 */
+    return res;                                                                  /* return the result */
 }
+#endif
 
 /**
  * @brief      get chip's information
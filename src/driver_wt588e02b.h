@@ -40,6 +40,8 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include "driver_wt588e02b_config.h"
+#include "driver_wt588e02b_log.h"
 
 #ifdef __cplusplus
 extern "C"{
@@ -66,9 +68,128 @@ typedef enum
 } wt588e02b_bool_t;
 
 /**
- * @brief wt588e02b handle structure definition
+ * @brief wt588e02b duration entry structure definition
  */
-typedef struct wt588e02b_handle_s
+typedef struct wt588e02b_duration_entry_s
+{
+    float mean_ms;         /**< moving average of the busy time in ms */
+    float var_ms2;         /**< moving variance of the busy time in ms^2 */
+    uint16_t count;        /**< sample count */
+} wt588e02b_duration_entry_t;
+
+/**
+ * @brief wt588e02b duration table structure definition
+ */
+typedef struct wt588e02b_duration_table_s
+{
+    wt588e02b_duration_entry_t entry[0xE0];        /**< one entry per index */
+    uint32_t start;                                /**< measurement start time */
+    uint8_t state;                                 /**< measurement state */
+    uint8_t ind;                                   /**< measurement index */
+} wt588e02b_duration_table_t;
+
+/**
+ * @brief wt588e02b coalescing queue structure definition
+ */
+typedef struct wt588e02b_coalesce_s
+{
+    uint32_t start;              /**< window start time */
+    uint16_t ms;                 /**< window length in ms */
+    uint8_t len;                 /**< queued index number */
+    uint8_t list[40];            /**< queued indexes */
+} wt588e02b_coalesce_t;
+
+/**
+ * @brief wt588e02b stats structure definition
+ */
+typedef struct wt588e02b_stats_s
+{
+    uint32_t sent;            /**< command frames sent */
+    uint32_t skipped;         /**< redundant command frames skipped */
+    uint32_t merged;          /**< play requests merged into a play list */
+    uint32_t saved_us;        /**< estimated bus time saved in us */
+} wt588e02b_stats_t;
+
+/**
+ * @brief wt588e02b step structure definition
+ */
+typedef struct wt588e02b_step_s
+{
+    uint32_t wait_us;        /**< time the caller waits before the next step, 0 means done */
+    uint32_t size;           /**< update image size */
+    uint32_t addr;           /**< next update address */
+    uint8_t state;           /**< next step */
+    uint8_t ind;             /**< played index */
+} wt588e02b_step_t;
+
+/**
+ * @brief wt588e02b log record structure definition
+ */
+typedef struct wt588e02b_log_record_s
+{
+    uint16_t id;           /**< message id, see wt588e02b_log_message_t */
+    uint8_t level;         /**< log level */
+    uint8_t seq;           /**< commit stamp of the ring slot, not part of the message */
+    uint32_t arg;          /**< message argument */
+    uint32_t ms;           /**< timestamp in ms, 0 without a clock */
+} wt588e02b_log_record_t;
+
+/**
+ * @brief wt588e02b log ring structure definition
+ */
+typedef struct wt588e02b_log_s
+{
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    wt588e02b_log_record_t record[WT588E02B_LOG_SIZE];        /**< records */
+#endif
+    volatile uint32_t head;                                   /**< reserved records, only the writers change it */
+    volatile uint32_t tail;                                   /**< read records, only the reader changes it */
+    volatile uint32_t lost;                                   /**< records dropped on a full ring */
+    uint32_t (*timestamp_ms)(void);                           /**< record clock */
+} wt588e02b_log_t;
+
+/**
+ * @brief wt588e02b bus max chip definition
+ */
+#define WT588E02B_BUS_MAX_CHIP        32        /**< one bit per chip in a cs mask */
+
+/**
+ * @brief wt588e02b bus structure definition
+ */
+typedef struct wt588e02b_bus_s
+{
+    uint8_t (*sclk_gpio_init)(void);                                 /**< point to a sclk_gpio_init function address */
+    uint8_t (*sclk_gpio_deinit)(void);                               /**< point to a sclk_gpio_deinit function address */
+    uint8_t (*sclk_gpio_write)(uint8_t data);                        /**< point to a sclk_gpio_write function address */
+    uint8_t (*mosi_gpio_init)(void);                                 /**< point to a mosi_gpio_init function address */
+    uint8_t (*mosi_gpio_deinit)(void);                               /**< point to a mosi_gpio_deinit function address */
+    uint8_t (*mosi_gpio_write)(uint8_t data);                        /**< point to a mosi_gpio_write function address */
+    uint8_t (*cs_gpio_write_mask)(uint32_t mask, uint8_t data);      /**< point to a cs_gpio_write_mask function address */
+    uint8_t (*miso_gpio_read_mask)(uint32_t *data);                  /**< point to a miso_gpio_read_mask function address */
+    uint8_t (*bin_read_init)(char *name, uint32_t *size);            /**< point to a bin_read_init function address */
+    uint8_t (*bin_read)(uint32_t addr, uint16_t size, uint8_t *buf); /**< point to a bin_read function address */
+    uint8_t (*bin_read_deinit)(void);                                /**< point to a bin_read_deinit function address */
+    void (*delay_ms)(uint32_t ms);                                   /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                   /**< point to a delay_us function address */
+    void (*debug_print)(const char *const fmt, ...);                 /**< point to a debug_print function address */
+    uint8_t (*lock)(uint8_t wait);                                   /**< point to a lock function address */
+    uint8_t (*unlock)(void);                                         /**< point to an unlock function address */
+    struct wt588e02b_handle_s *chip[WT588E02B_BUS_MAX_CHIP];         /**< attached chips */
+    uint32_t attached;                                               /**< attached chip mask */
+    uint8_t inited;                                                  /**< inited flag */
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    uint8_t buf[512];                                                /**< inner buffer */
+#endif
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    wt588e02b_log_t *log;                                            /**< deferred log ring, NULL prints through debug_print */
+#endif
+} wt588e02b_bus_t;
+
+/**
+ * @brief wt588e02b ops structure definition
+ * @note  the table only holds function addresses, so it can be const and shared by all chips
+ */
+typedef struct wt588e02b_ops_s
 {
     uint8_t (*sclk_gpio_init)(void);                                           /**< point to a sclk_gpio_init function address */
     uint8_t (*sclk_gpio_deinit)(void);                                         /**< point to a sclk_gpio_deinit function address */
@@ -88,11 +209,115 @@ typedef struct wt588e02b_handle_s
     uint8_t (*bin_read_init)(char *name, uint32_t *size);                      /**< point to a bin_read_init function address */
     uint8_t (*bin_read)(uint32_t addr, uint16_t size, uint8_t *buffer);        /**< point to a bin_read function address */
     uint8_t (*bin_read_deinit)(void);                                          /**< point to a bin_read_deinit function address */
-    uint8_t inited;                                                            /**< inited flag */
+    uint32_t (*timestamp_ms)(void);                                            /**< point to a timestamp_ms function address */
+    uint8_t (*lock)(uint8_t wait);                                             /**< point to a lock function address */
+    uint8_t (*unlock)(void);                                                   /**< point to an unlock function address */
+    uint8_t (*frame_transfer)(uint8_t *tx, uint8_t *rx, uint16_t len,
+                              uint32_t us, uint32_t gap_us);                   /**< point to a frame_transfer function address */
+} wt588e02b_ops_t;
+
+/**
+ * @brief wt588e02b handle structure definition
+ */
+typedef struct wt588e02b_handle_s
+{
+    const wt588e02b_ops_t *ops;                                                /**< interface table */
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    uint8_t *buf;                                                              /**< 512 bytes update buffer, NULL means the handle only plays */
+#endif
+#if (WT588E02B_FEATURE_DURATION != 0)
+    wt588e02b_duration_table_t *duration_table;                                /**< duration table, NULL disables the profiler */
+#endif
+#if (WT588E02B_FEATURE_COALESCE != 0)
+    wt588e02b_coalesce_t *coalesce;                                            /**< coalescing queue, NULL disables coalescing */
+#endif
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    wt588e02b_log_t *log;                                                      /**< deferred log ring, NULL prints through debug_print */
+#endif
+    wt588e02b_bus_t *bus;                                                      /**< shared bus, NULL means own gpio */
+#if (WT588E02B_FEATURE_STATS != 0)
+    wt588e02b_stats_t stats;                                                   /**< command stats */
+#endif
+#if (WT588E02B_FEATURE_UPDATE != 0)
     uint16_t sum;                                                              /**< sum */
-    uint8_t buf[512];                                                          /**< inner buffer */
+#endif
+    uint8_t inited;                                                            /**< inited flag */
+    uint8_t chip;                                                              /**< chip number on the bus */
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    uint8_t shadow_enable;                                                     /**< shadow state enable */
+    uint8_t shadow_valid;                                                      /**< shadow state valid flags */
+    uint8_t shadow_vol;                                                        /**< last volume */
+    uint8_t shadow_loop;                                                       /**< last loop mode, 0 means no loop */
+    uint8_t shadow_ind;                                                        /**< last index */
+    uint8_t shadow_busy;                                                       /**< last known busy level */
+#endif
+#if (WT588E02B_HANDLE_LINK != 0)
+    wt588e02b_ops_t link;                                                      /**< table of the link macros */
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    uint8_t link_buf[512];                                                     /**< update buffer of the link macros */
+#endif
+#endif
 } wt588e02b_handle_t;
 
+/**
+ * @brief wt588e02b image format enumeration definition
+ */
+typedef enum
+{
+    WT588E02B_IMAGE_FORMAT_UNKNOWN = 0x00,        /**< unknown data */
+    WT588E02B_IMAGE_FORMAT_T3Z     = 0x01,        /**< t3z voice */
+} wt588e02b_image_format_t;
+
+/**
+ * @brief wt588e02b image structure definition
+ */
+typedef struct wt588e02b_image_s
+{
+    const uint8_t *buf;             /**< image buffer, it is not copied */
+    uint32_t size;                  /**< image size */
+    uint32_t list_table;            /**< list pointer table offset */
+    uint32_t voice_table;           /**< voice offset table offset */
+    uint32_t data;                  /**< first voice offset */
+    uint16_t list_count;            /**< list number */
+    uint16_t voice_count;           /**< voice number */
+    const char *version;            /**< pointer to the version string in the buffer */
+} wt588e02b_image_t;
+
+/**
+ * @brief wt588e02b image voice structure definition
+ */
+typedef struct wt588e02b_image_voice_s
+{
+    uint16_t index;                         /**< voice index */
+    uint32_t offset;                        /**< voice offset in the image */
+    uint32_t length;                        /**< voice slot length */
+    wt588e02b_image_format_t format;        /**< voice format */
+    uint32_t first_block;                   /**< first 512 bytes update block */
+    uint32_t block_count;                   /**< update block number */
+    const uint8_t *data;                    /**< pointer to the voice data in the buffer */
+} wt588e02b_image_voice_t;
+
+/**
+ * @brief wt588e02b segment direction enumeration definition
+ */
+typedef enum
+{
+    WT588E02B_SEGMENT_WRITE = 0x00,        /**< write the buffer on mosi */
+    WT588E02B_SEGMENT_READ  = 0x01,        /**< read miso into the buffer */
+} wt588e02b_segment_dir_t;
+
+/**
+ * @brief wt588e02b segment structure definition
+ */
+typedef struct wt588e02b_segment_s
+{
+    wt588e02b_segment_dir_t dir;        /**< segment direction */
+    uint8_t *buf;                       /**< data buffer */
+    uint16_t len;                       /**< data length */
+    uint32_t half_us;                   /**< sclk half period in us */
+    uint32_t gap_us;                    /**< delay in us before the first byte of the segment */
+} wt588e02b_segment_t;
+
 /**
  * @brief wt588e02b information structure definition
  */
@@ -120,13 +345,43 @@ typedef struct wt588e02b_info_s
  * @{
  */
 
+/**
+ * @brief     link a shared ops table
+ * @param[in] HANDLE pointer to a wt588e02b handle structure
+ * @param[in] OPS pointer to a wt588e02b ops structure
+ * @note      the table is not copied, it can be const and shared by all chips
+ */
+#define DRIVER_WT588E02B_LINK_OPS(HANDLE, OPS)                           (HANDLE)->ops = OPS
+
+/**
+ * @brief     link an update buffer
+ * @param[in] HANDLE pointer to a wt588e02b handle structure
+ * @param[in] BUF pointer to a 512 bytes buffer
+ * @note      the buffer is only used by the update functions, it can be shared by the chips which are not updated at once,
+ *            the link is ignored when the update feature is compiled out
+ */
+#if (WT588E02B_FEATURE_UPDATE != 0)
+#define DRIVER_WT588E02B_LINK_BUFFER(HANDLE, BUF)                        (HANDLE)->buf = BUF
+#else
+#define DRIVER_WT588E02B_LINK_BUFFER(HANDLE, BUF)                        (void)(BUF)
+#endif
+
+#if (WT588E02B_HANDLE_LINK != 0)
+
 /**
  * @brief     initialize wt588e02b_handle_t structure
  * @param[in] HANDLE pointer to a wt588e02b handle structure
  * @param[in] STRUCTURE wt588e02b_handle_t
- * @note      none
+ * @note      the handle uses its own link table and update buffer, the hook link macros below only exist with WT588E02B_HANDLE_LINK 1
  */
-#define DRIVER_WT588E02B_LINK_INIT(HANDLE, STRUCTURE)                    memset(HANDLE, 0, sizeof(STRUCTURE))
+#if (WT588E02B_FEATURE_UPDATE != 0)
+#define DRIVER_WT588E02B_LINK_INIT(HANDLE, STRUCTURE)                    (memset(HANDLE, 0, sizeof(STRUCTURE)), \
+                                                                          (HANDLE)->ops = &(HANDLE)->link, \
+                                                                          (HANDLE)->buf = (HANDLE)->link_buf)
+#else
+#define DRIVER_WT588E02B_LINK_INIT(HANDLE, STRUCTURE)                    (memset(HANDLE, 0, sizeof(STRUCTURE)), \
+                                                                          (HANDLE)->ops = &(HANDLE)->link)
+#endif
 
 /**
  * @brief     link sclk_gpio_init function
@@ -134,7 +389,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a sclk_gpio_init function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_SCLK_GPIO_INIT(HANDLE, FUC)                (HANDLE)->sclk_gpio_init = FUC
+#define DRIVER_WT588E02B_LINK_SCLK_GPIO_INIT(HANDLE, FUC)                (HANDLE)->link.sclk_gpio_init = FUC
 
 /**
  * @brief     link sclk_gpio_deinit function
@@ -142,7 +397,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a sclk_gpio_deinit function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_SCLK_GPIO_DEINIT(HANDLE, FUC)              (HANDLE)->sclk_gpio_deinit = FUC
+#define DRIVER_WT588E02B_LINK_SCLK_GPIO_DEINIT(HANDLE, FUC)              (HANDLE)->link.sclk_gpio_deinit = FUC
 
 /**
  * @brief     link sclk_gpio_write function
@@ -150,7 +405,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a sclk_gpio_write function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_SCLK_GPIO_WRITE(HANDLE, FUC)               (HANDLE)->sclk_gpio_write = FUC
+#define DRIVER_WT588E02B_LINK_SCLK_GPIO_WRITE(HANDLE, FUC)               (HANDLE)->link.sclk_gpio_write = FUC
 
 /**
  * @brief     link mosi_gpio_init function
@@ -158,7 +413,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a mosi_gpio_init function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_MOSI_GPIO_INIT(HANDLE, FUC)                (HANDLE)->mosi_gpio_init = FUC
+#define DRIVER_WT588E02B_LINK_MOSI_GPIO_INIT(HANDLE, FUC)                (HANDLE)->link.mosi_gpio_init = FUC
 
 /**
  * @brief     link mosi_gpio_deinit function
@@ -166,7 +421,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a mosi_gpio_deinit function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_MOSI_GPIO_DEINIT(HANDLE, FUC)              (HANDLE)->mosi_gpio_deinit = FUC
+#define DRIVER_WT588E02B_LINK_MOSI_GPIO_DEINIT(HANDLE, FUC)              (HANDLE)->link.mosi_gpio_deinit = FUC
 
 /**
  * @brief     link mosi_gpio_write function
@@ -174,7 +429,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a mosi_gpio_write function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_MOSI_GPIO_WRITE(HANDLE, FUC)               (HANDLE)->mosi_gpio_write = FUC
+#define DRIVER_WT588E02B_LINK_MOSI_GPIO_WRITE(HANDLE, FUC)               (HANDLE)->link.mosi_gpio_write = FUC
 
 /**
  * @brief     link miso_gpio_init function
@@ -182,7 +437,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a miso_gpio_init function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_MISO_GPIO_INIT(HANDLE, FUC)                (HANDLE)->miso_gpio_init = FUC
+#define DRIVER_WT588E02B_LINK_MISO_GPIO_INIT(HANDLE, FUC)                (HANDLE)->link.miso_gpio_init = FUC
 
 /**
  * @brief     link miso_gpio_deinit function
@@ -190,7 +445,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a miso_gpio_deinit function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_MISO_GPIO_DEINIT(HANDLE, FUC)              (HANDLE)->miso_gpio_deinit = FUC
+#define DRIVER_WT588E02B_LINK_MISO_GPIO_DEINIT(HANDLE, FUC)              (HANDLE)->link.miso_gpio_deinit = FUC
 
 /**
  * @brief     link miso_gpio_read function
@@ -198,7 +453,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a miso_gpio_read function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_MISO_GPIO_READ(HANDLE, FUC)                (HANDLE)->miso_gpio_read = FUC
+#define DRIVER_WT588E02B_LINK_MISO_GPIO_READ(HANDLE, FUC)                (HANDLE)->link.miso_gpio_read = FUC
 
 /**
  * @brief     link cs_gpio_init function
@@ -206,7 +461,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a cs_gpio_init function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_CS_GPIO_INIT(HANDLE, FUC)                  (HANDLE)->cs_gpio_init = FUC
+#define DRIVER_WT588E02B_LINK_CS_GPIO_INIT(HANDLE, FUC)                  (HANDLE)->link.cs_gpio_init = FUC
 
 /**
  * @brief     link cs_gpio_deinit function
@@ -214,7 +469,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a cs_gpio_deinit function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_CS_GPIO_DEINIT(HANDLE, FUC)                (HANDLE)->cs_gpio_deinit = FUC
+#define DRIVER_WT588E02B_LINK_CS_GPIO_DEINIT(HANDLE, FUC)                (HANDLE)->link.cs_gpio_deinit = FUC
 
 /**
  * @brief     link cs_gpio_write function
@@ -222,7 +477,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a cs_gpio_write function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_CS_GPIO_WRITE(HANDLE, FUC)                 (HANDLE)->cs_gpio_write = FUC
+#define DRIVER_WT588E02B_LINK_CS_GPIO_WRITE(HANDLE, FUC)                 (HANDLE)->link.cs_gpio_write = FUC
 
 /**
  * @brief     link bin_read_init function
@@ -230,7 +485,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a bin_read_init function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_BIN_READ_INIT(HANDLE, FUC)                 (HANDLE)->bin_read_init = FUC
+#define DRIVER_WT588E02B_LINK_BIN_READ_INIT(HANDLE, FUC)                 (HANDLE)->link.bin_read_init = FUC
 
 /**
  * @brief     link bin_read function
@@ -238,7 +493,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a bin_read function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_BIN_READ(HANDLE, FUC)                      (HANDLE)->bin_read = FUC
+#define DRIVER_WT588E02B_LINK_BIN_READ(HANDLE, FUC)                      (HANDLE)->link.bin_read = FUC
 
 /**
  * @brief     link bin_read_deinit function
@@ -246,7 +501,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a bin_read_deinit function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_BIN_READ_DEINIT(HANDLE, FUC)               (HANDLE)->bin_read_deinit = FUC
+#define DRIVER_WT588E02B_LINK_BIN_READ_DEINIT(HANDLE, FUC)               (HANDLE)->link.bin_read_deinit = FUC
 
 /**
  * @brief     link delay_ms function
@@ -254,7 +509,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a delay_ms function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_DELAY_MS(HANDLE, FUC)                      (HANDLE)->delay_ms = FUC
+#define DRIVER_WT588E02B_LINK_DELAY_MS(HANDLE, FUC)                      (HANDLE)->link.delay_ms = FUC
 
 /**
  * @brief     link delay_us function
@@ -262,7 +517,7 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a delay_us function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_DELAY_US(HANDLE, FUC)                      (HANDLE)->delay_us = FUC
+#define DRIVER_WT588E02B_LINK_DELAY_US(HANDLE, FUC)                      (HANDLE)->link.delay_us = FUC
 
 /**
  * @brief     link debug_print function
@@ -270,7 +525,193 @@ typedef struct wt588e02b_info_s
  * @param[in] FUC pointer to a debug_print function address
  * @note      none
  */
-#define DRIVER_WT588E02B_LINK_DEBUG_PRINT(HANDLE, FUC)                   (HANDLE)->debug_print = FUC
+#define DRIVER_WT588E02B_LINK_DEBUG_PRINT(HANDLE, FUC)                   (HANDLE)->link.debug_print = FUC
+
+/**
+ * @brief     link timestamp_ms function
+ * @param[in] HANDLE pointer to a wt588e02b handle structure
+ * @param[in] FUC pointer to a timestamp_ms function address
+ * @note      optional, used by the duration profiler and the coalescing window
+ */
+#define DRIVER_WT588E02B_LINK_TIMESTAMP_MS(HANDLE, FUC)                  (HANDLE)->link.timestamp_ms = FUC
+
+/**
+ * @brief     link lock function
+ * @param[in] HANDLE pointer to a wt588e02b handle structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      optional, link it with unlock when several threads share the handle,
+ *            wait 1 blocks until the lock is taken, wait 0 only tries once,
+ *            it returns 0 when the lock is taken
+ */
+#define DRIVER_WT588E02B_LINK_LOCK(HANDLE, FUC)                          (HANDLE)->link.lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] HANDLE pointer to a wt588e02b handle structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      optional, a chip on a shared bus uses the bus lock instead
+ */
+#define DRIVER_WT588E02B_LINK_UNLOCK(HANDLE, FUC)                        (HANDLE)->link.unlock = FUC
+
+/**
+ * @brief     link frame_transfer function
+ * @param[in] HANDLE pointer to a wt588e02b handle structure
+ * @param[in] FUC pointer to a frame_transfer function address
+ * @note      optional, when linked the update packets and the update status reads are handed
+ *            to it as whole frames instead of being clocked bit by bit through the gpio hooks,
+ *            it waits gap_us before every byte, clocks the byte out msb first with a half
+ *            period of us and, when rx is not NULL, samples miso after every falling edge
+ */
+#define DRIVER_WT588E02B_LINK_FRAME_TRANSFER(HANDLE, FUC)                (HANDLE)->link.frame_transfer = FUC
+
+#else
+
+/**
+ * @brief     initialize wt588e02b_handle_t structure
+ * @param[in] HANDLE pointer to a wt588e02b handle structure
+ * @param[in] STRUCTURE wt588e02b_handle_t
+ * @note      link an ops table with DRIVER_WT588E02B_LINK_OPS and,
+ *            for the update functions, a buffer with DRIVER_WT588E02B_LINK_BUFFER
+ */
+#define DRIVER_WT588E02B_LINK_INIT(HANDLE, STRUCTURE)                    memset(HANDLE, 0, sizeof(STRUCTURE))
+
+#endif
+
+/**
+ * @brief     initialize wt588e02b_bus_t structure
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] STRUCTURE wt588e02b_bus_t
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_INIT(BUS, STRUCTURE)                   memset(BUS, 0, sizeof(STRUCTURE))
+
+/**
+ * @brief     link bus sclk_gpio_init function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a sclk_gpio_init function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_SCLK_GPIO_INIT(BUS, FUC)               (BUS)->sclk_gpio_init = FUC
+
+/**
+ * @brief     link bus sclk_gpio_deinit function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a sclk_gpio_deinit function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_SCLK_GPIO_DEINIT(BUS, FUC)             (BUS)->sclk_gpio_deinit = FUC
+
+/**
+ * @brief     link bus sclk_gpio_write function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a sclk_gpio_write function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_SCLK_GPIO_WRITE(BUS, FUC)              (BUS)->sclk_gpio_write = FUC
+
+/**
+ * @brief     link bus mosi_gpio_init function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a mosi_gpio_init function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_MOSI_GPIO_INIT(BUS, FUC)               (BUS)->mosi_gpio_init = FUC
+
+/**
+ * @brief     link bus mosi_gpio_deinit function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a mosi_gpio_deinit function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_MOSI_GPIO_DEINIT(BUS, FUC)             (BUS)->mosi_gpio_deinit = FUC
+
+/**
+ * @brief     link bus mosi_gpio_write function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a mosi_gpio_write function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_MOSI_GPIO_WRITE(BUS, FUC)              (BUS)->mosi_gpio_write = FUC
+
+/**
+ * @brief     link bus cs_gpio_write_mask function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a cs_gpio_write_mask function address
+ * @note      optional, without it the broadcast drives the chip cs lines one by one
+ */
+#define DRIVER_WT588E02B_BUS_LINK_CS_GPIO_WRITE_MASK(BUS, FUC)           (BUS)->cs_gpio_write_mask = FUC
+
+/**
+ * @brief     link bus miso_gpio_read_mask function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a miso_gpio_read_mask function address
+ * @note      optional, without it the status read samples the chip miso lines one by one
+ */
+#define DRIVER_WT588E02B_BUS_LINK_MISO_GPIO_READ_MASK(BUS, FUC)          (BUS)->miso_gpio_read_mask = FUC
+
+/**
+ * @brief     link bus bin_read_init function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a bin_read_init function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_BIN_READ_INIT(BUS, FUC)                (BUS)->bin_read_init = FUC
+
+/**
+ * @brief     link bus bin_read function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a bin_read function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_BIN_READ(BUS, FUC)                     (BUS)->bin_read = FUC
+
+/**
+ * @brief     link bus bin_read_deinit function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a bin_read_deinit function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_BIN_READ_DEINIT(BUS, FUC)              (BUS)->bin_read_deinit = FUC
+
+/**
+ * @brief     link bus delay_ms function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a delay_ms function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_DELAY_MS(BUS, FUC)                     (BUS)->delay_ms = FUC
+
+/**
+ * @brief     link bus delay_us function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_DELAY_US(BUS, FUC)                     (BUS)->delay_us = FUC
+
+/**
+ * @brief     link bus debug_print function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a debug_print function address
+ * @note      none
+ */
+#define DRIVER_WT588E02B_BUS_LINK_DEBUG_PRINT(BUS, FUC)                  (BUS)->debug_print = FUC
+
+/**
+ * @brief     link bus lock function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      optional, serializes the frames of all attached chips
+ */
+#define DRIVER_WT588E02B_BUS_LINK_LOCK(BUS, FUC)                         (BUS)->lock = FUC
+
+/**
+ * @brief     link bus unlock function
+ * @param[in] BUS pointer to a wt588e02b bus structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      optional
+ */
+#define DRIVER_WT588E02B_BUS_LINK_UNLOCK(BUS, FUC)                       (BUS)->unlock = FUC
 
 /**
  * @}
@@ -301,7 +742,8 @@ uint8_t wt588e02b_info(wt588e02b_info_t *info);
  *            - 1 gpio initialization failed
  *            - 2 handle is NULL
  *            - 3 linked functions is NULL
- * @note      none
+ * @note      the bin read functions and the update buffer are only checked by the update functions,
+ *            so a handle which only plays may leave them NULL
  */
 uint8_t wt588e02b_init(wt588e02b_handle_t *handle);
 
@@ -326,7 +768,9 @@ uint8_t wt588e02b_deinit(wt588e02b_handle_t *handle);
  *             - 1 check busy failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       miso is sampled without the lock, the sample only feeds the profiler
+ *             and the shadow state when the lock is free, an idle sample also flushes an expired
+ *             coalescing window, busy then rises after the play response time
  */
 uint8_t wt588e02b_check_busy(wt588e02b_handle_t *handle, wt588e02b_bool_t *enable);
 
@@ -341,7 +785,9 @@ uint8_t wt588e02b_check_busy(wt588e02b_handle_t *handle, wt588e02b_bool_t *enabl
  *            - 3 handle is not initialized
  *            - 4 ind > 0xDF
  *            - 5 chip is busy
- * @note      ind > 0xDF
+ * @note      with a coalescing window the index is queued and sent later as one play list,
+ *            busy is then reported by the flush that closes the window, the window is closed by
+ *            the next driver call after it expired or by wt588e02b_coalesce_poll
  */
 uint8_t wt588e02b_play(wt588e02b_handle_t *handle, uint8_t ind);
 
@@ -353,7 +799,7 @@ uint8_t wt588e02b_play(wt588e02b_handle_t *handle, uint8_t ind);
  *            - 1 stop failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      an expired coalescing window is flushed first, the indexes of an open window are dropped
  */
 uint8_t wt588e02b_stop(wt588e02b_handle_t *handle);
 
@@ -371,6 +817,7 @@ uint8_t wt588e02b_stop(wt588e02b_handle_t *handle);
  */
 uint8_t wt588e02b_set_vol(wt588e02b_handle_t *handle, uint8_t vol);
 
+#if (WT588E02B_FEATURE_LOOP != 0)
 /**
  * @brief     play loop
  * @param[in] *handle pointer to a wt588e02b handle structure
@@ -413,6 +860,7 @@ uint8_t wt588e02b_play_loop_advance(wt588e02b_handle_t *handle, uint8_t ind);
  * @note      none
  */
 uint8_t wt588e02b_play_loop_all(wt588e02b_handle_t *handle);
+#endif
 
 /**
  * @brief     play list
@@ -432,6 +880,7 @@ uint8_t wt588e02b_play_loop_all(wt588e02b_handle_t *handle);
  */
 uint8_t wt588e02b_play_list(wt588e02b_handle_t *handle, uint8_t *list, uint8_t len);
 
+#if (WT588E02B_FEATURE_UPDATE != 0)
 /**
  * @brief     update audio
  * @param[in] *handle pointer to a wt588e02b handle structure
@@ -442,9 +891,10 @@ uint8_t wt588e02b_play_list(wt588e02b_handle_t *handle, uint8_t *list, uint8_t l
  *            - 1 update failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 bin read init failed
+ *            - 4 bin read init failed or the update is not linked
  *            - 5 ind > 0xDF
- * @note      ind > 0xDF
+ * @note      ind > 0xDF,
+ *            the lock is held for the whole update
  */
 uint8_t wt588e02b_update(wt588e02b_handle_t *handle, uint8_t ind, char *path);
 
@@ -457,11 +907,563 @@ uint8_t wt588e02b_update(wt588e02b_handle_t *handle, uint8_t ind, char *path);
  *            - 1 update failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 bin read init failed
+ *            - 4 bin read init failed or the update is not linked
  *            - 5 bin size is invalid
- * @note      none
+ * @note      the lock is held for the whole update
  */
 uint8_t wt588e02b_update_all(wt588e02b_handle_t *handle, char *path);
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup wt588e02b_profile_driver wt588e02b profile driver function
+ * @brief    wt588e02b profile driver modules
+ * @ingroup  wt588e02b_driver
+ * @{
+ */
+
+#if (WT588E02B_FEATURE_DURATION != 0)
+/**
+ * @brief     set the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *table pointer to a duration table structure, NULL disables the profiler
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_ms is NULL
+ * @note      the table content is kept, so a loaded table can be refined;
+ *            a sample is the time from the first busy sample after the play frame until
+ *            the busy pin is seen idle again, the frame to busy latency is not counted
+ *            and the resolution is the check busy polling period
+ */
+uint8_t wt588e02b_set_duration_table(wt588e02b_handle_t *handle, wt588e02b_duration_table_t *table);
+
+/**
+ * @brief      estimate the play duration of an index
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[in]  ind index
+ * @param[out] *ms pointer to a mean duration buffer
+ * @param[out] *var pointer to a duration variance buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample or lock failed
+ *             - 2 handle, ms or var is NULL
+ *             - 3 handle is not initialized
+ *             - 4 ind > 0xDF
+ *             - 5 duration table is NULL
+ * @note       the estimate never touches the bus, the entry is read under the lock
+ *             so the mean and the variance come from the same sample
+ */
+uint8_t wt588e02b_estimate_duration(wt588e02b_handle_t *handle, uint8_t ind, uint32_t *ms, float *var);
+
+/**
+ * @brief     save the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *write pointer to a write function, called once per record
+ * @return    status code
+ *            - 0 success
+ *            - 1 write or lock failed
+ *            - 2 handle or write is NULL
+ *            - 3 handle is not initialized
+ *            - 5 duration table is NULL
+ * @note      only the measured indexes are written, the format is a 4 bytes header
+ *            followed by 11 bytes little endian records;
+ *            write runs with the handle lock held and must not call the driver
+ */
+uint8_t wt588e02b_duration_save(wt588e02b_handle_t *handle, uint8_t (*write)(uint8_t *buf, uint16_t len));
+
+/**
+ * @brief     load the duration table
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *read pointer to a read function, called once per record
+ * @return    status code
+ *            - 0 success
+ *            - 1 read or lock failed
+ *            - 2 handle or read is NULL
+ *            - 3 handle is not initialized
+ *            - 4 data is invalid
+ *            - 5 duration table is NULL
+ * @note      a table saved by an older record format version is refused;
+ *            read runs with the handle lock held and must not call the driver
+ */
+uint8_t wt588e02b_duration_load(wt588e02b_handle_t *handle, uint8_t (*read)(uint8_t *buf, uint16_t len));
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup wt588e02b_shadow_driver wt588e02b shadow driver function
+ * @brief    wt588e02b shadow driver modules
+ * @ingroup  wt588e02b_driver
+ * @{
+ */
+
+#if (WT588E02B_FEATURE_SHADOW != 0)
+/**
+ * @brief     enable or disable the shadow state
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, set vol with the same volume, stop when the chip is known idle
+ *            and re-arming the running loop are skipped without touching the bus
+ */
+uint8_t wt588e02b_set_shadow(wt588e02b_handle_t *handle, wt588e02b_bool_t enable);
+
+/**
+ * @brief     invalidate the shadow state
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the next commands always go to the bus
+ */
+uint8_t wt588e02b_shadow_invalidate(wt588e02b_handle_t *handle);
+
+/**
+ * @brief     force the chip to the shadow state
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      writes the cached volume again, e.g. after the chip was reset,
+ *            the loop state is dropped so that the next loop command goes to the bus
+ */
+uint8_t wt588e02b_shadow_sync(wt588e02b_handle_t *handle);
+#endif
+
+#if (WT588E02B_FEATURE_COALESCE != 0)
+/**
+ * @brief     set the coalescing window
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *coalesce pointer to a coalescing queue structure, NULL disables coalescing
+ * @param[in] ms window length in ms, 0 disables coalescing
+ * @return    status code
+ *            - 0 success
+ *            - 1 set coalesce failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 timestamp_ms is NULL
+ * @note      play requests inside the window are merged into one play list frame,
+ *            the indexes queued in the old queue are flushed first, an expired window is flushed
+ *            by the next driver call or wt588e02b_coalesce_poll
+ */
+uint8_t wt588e02b_set_coalesce(wt588e02b_handle_t *handle, wt588e02b_coalesce_t *coalesce, uint16_t ms);
+
+/**
+ * @brief     send the queued indexes when the coalescing window is closed
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      nothing is sent while the window is open, every other command and an idle check_busy
+ *            also flush an expired window, call it periodically when no other driver call follows
+ */
+uint8_t wt588e02b_coalesce_poll(wt588e02b_handle_t *handle);
+
+/**
+ * @brief     send the queued indexes now
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      the queue is kept when the chip is busy
+ */
+uint8_t wt588e02b_coalesce_flush(wt588e02b_handle_t *handle);
+#endif
+
+#if (WT588E02B_FEATURE_STATS != 0)
+/**
+ * @brief      get the command stats
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 lock failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t wt588e02b_get_stats(wt588e02b_handle_t *handle, wt588e02b_stats_t *stats);
+
+/**
+ * @brief     clear the command stats
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t wt588e02b_clear_stats(wt588e02b_handle_t *handle);
+#endif
+
+#if (WT588E02B_FEATURE_STEP != 0)
+/**
+ * @brief      start a stepped play
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *step pointer to a step structure
+ * @param[in]  ind index
+ * @return     status code
+ *             - 0 success
+ *             - 1 play failed
+ *             - 2 handle or step is NULL
+ *             - 3 handle is not initialized
+ *             - 4 ind > 0xDF
+ *             - 5 chip is busy
+ * @note       the same frame as wt588e02b_play, the caller waits step->wait_us and calls wt588e02b_step
+ *             until wait_us is 0, with a coalescing window the index is queued and wait_us is 0 at once
+ */
+uint8_t wt588e02b_step_play(wt588e02b_handle_t *handle, wt588e02b_step_t *step, uint8_t ind);
+
+/**
+ * @brief      start a stepped stop
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *step pointer to a step structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 stop failed
+ *             - 2 handle or step is NULL
+ *             - 3 handle is not initialized
+ * @note       the same frame as wt588e02b_stop, an expired coalescing window is flushed first,
+ *             a redundant stop is skipped and wait_us is 0 at once
+ */
+uint8_t wt588e02b_step_stop(wt588e02b_handle_t *handle, wt588e02b_step_t *step);
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief      start a stepped update of all audio
+ * @param[in]  *handle pointer to a wt588e02b handle structure
+ * @param[out] *step pointer to a step structure
+ * @param[in]  *path pointer to a path buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 update failed
+ *             - 2 handle or step is NULL
+ *             - 3 handle is not initialized
+ *             - 4 bin read init failed or the update is not linked
+ *             - 5 bin size is invalid
+ * @note       the same frames and gaps as wt588e02b_update_all
+ */
+uint8_t wt588e02b_step_update_all(wt588e02b_handle_t *handle, wt588e02b_step_t *step, char *path);
+#endif
+
+/**
+ * @brief         run the next step of a command
+ * @param[in]     *handle pointer to a wt588e02b handle structure
+ * @param[in,out] *step pointer to a step structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 step failed
+ *                - 2 handle or step is NULL
+ *                - 3 handle is not initialized
+ *                - 4 no command is running
+ * @note          the lock is held from the start to the last step or a failed one, so the caller
+ *                waits without blocking the thread but must not take the same lock meanwhile
+ */
+uint8_t wt588e02b_step(wt588e02b_handle_t *handle, wt588e02b_step_t *step);
+
+/**
+ * @brief         abort a stepped command
+ * @param[in]     *handle pointer to a wt588e02b handle structure
+ * @param[in,out] *step pointer to a step structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle or step is NULL
+ *                - 3 handle is not initialized
+ * @note          releases cs, the update file and the lock, the shadow state of the command is dropped
+ */
+uint8_t wt588e02b_step_abort(wt588e02b_handle_t *handle, wt588e02b_step_t *step);
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup wt588e02b_bus_driver wt588e02b bus driver function
+ * @brief    wt588e02b bus driver modules
+ * @ingroup  wt588e02b_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 bus is NULL
+ *            - 3 linked functions is NULL
+ * @note      none
+ */
+uint8_t wt588e02b_bus_init(wt588e02b_bus_t *bus);
+
+/**
+ * @brief     close the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 chips are still attached
+ * @note      none
+ */
+uint8_t wt588e02b_bus_deinit(wt588e02b_bus_t *bus);
+
+/**
+ * @brief     attach a chip to the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] chip chip number
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus or handle is NULL
+ *            - 3 bus is not initialized
+ *            - 4 chip >= 32
+ *            - 5 chip is used
+ *            - 6 handle is initialized
+ * @note      call it after linking the handle and before wt588e02b_init,
+ *            the handle then uses the bus sclk and mosi and keeps its own cs and miso
+ */
+uint8_t wt588e02b_bus_attach(wt588e02b_bus_t *bus, wt588e02b_handle_t *handle, uint8_t chip);
+
+/**
+ * @brief     detach a chip from the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus or handle is NULL
+ *            - 3 bus is not initialized
+ *            - 4 handle is not attached
+ *            - 5 handle is initialized
+ * @note      none
+ */
+uint8_t wt588e02b_bus_detach(wt588e02b_bus_t *bus, wt588e02b_handle_t *handle);
+
+/**
+ * @brief     set the volume of several chips with one frame
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @param[in] vol volume
+ * @return    status code
+ *            - 0 success
+ *            - 1 set vol failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 vol > 0x3F
+ *            - 5 no initialized chip in the mask
+ * @note      chips whose shadow state already holds the volume are left out
+ */
+uint8_t wt588e02b_bus_set_vol(wt588e02b_bus_t *bus, uint32_t mask, uint8_t vol);
+
+/**
+ * @brief     stop several chips with one frame
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask chip mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 no initialized chip in the mask
+ * @note      chips whose shadow state is known idle are left out
+ */
+uint8_t wt588e02b_bus_stop(wt588e02b_bus_t *bus, uint32_t mask);
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief         update audio on several chips in lockstep
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[in]     mask chip mask
+ * @param[in]     ind index
+ * @param[in]     *path pointer to a path buffer
+ * @param[out]    *done pointer to a mask buffer of the chips that finished
+ * @return        status code
+ *                - 0 success
+ *                - 1 update failed
+ *                - 2 bus is NULL
+ *                - 3 bus is not initialized
+ *                - 4 bin read init failed
+ *                - 5 ind > 0xDF
+ *                - 6 no initialized chip in the mask
+ * @note          every packet is read once and clocked into all chips with the same edges,
+ *                so the bus sclk, mosi and cs mask hooks should each be one bulk gpio write;
+ *                a chip with a wrong status sum is dropped and the rest go on,
+ *                success means at least one chip finished,
+ *                the bus lock is held for the whole update
+ */
+uint8_t wt588e02b_bus_update(wt588e02b_bus_t *bus, uint32_t mask, uint8_t ind, char *path, uint32_t *done);
+
+/**
+ * @brief         update all audio on several chips in lockstep
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[in]     mask chip mask
+ * @param[in]     *path pointer to a path buffer
+ * @param[out]    *done pointer to a mask buffer of the chips that finished
+ * @return        status code
+ *                - 0 success
+ *                - 1 update failed
+ *                - 2 bus is NULL
+ *                - 3 bus is not initialized
+ *                - 4 bin read init failed
+ *                - 5 bin size is invalid
+ *                - 6 no initialized chip in the mask
+ * @note          a chip with a wrong status sum is dropped and the rest go on,
+ *                success means at least one chip finished,
+ *                the bus lock is held for the whole update
+ */
+uint8_t wt588e02b_bus_update_all(wt588e02b_bus_t *bus, uint32_t mask, char *path, uint32_t *done);
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup wt588e02b_image_driver wt588e02b image driver function
+ * @brief    wt588e02b image driver modules
+ * @ingroup  wt588e02b_driver
+ * @{
+ */
+
+/**
+ * @brief     open a voice image
+ * @param[in] *image pointer to a wt588e02b image structure
+ * @param[in] *buf pointer to an image buffer
+ * @param[in] size buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 1 header is invalid
+ *            - 2 image or buf is NULL
+ *            - 4 size is too small
+ *            - 5 image size is not the buffer size
+ *            - 6 voice table is invalid
+ *            - 7 list table is invalid
+ * @note      the buffer is parsed in place and must stay valid while the image is used,
+ *            so it can be a whole bin file in memory or a mmap of it;
+ *            nothing touches the bus, so a bad file is refused before a long update
+ */
+uint8_t wt588e02b_image_open(wt588e02b_image_t *image, const uint8_t *buf, uint32_t size);
+
+/**
+ * @brief      get a voice of an image
+ * @param[in]  *image pointer to a wt588e02b image structure
+ * @param[in]  index voice index
+ * @param[out] *voice pointer to a wt588e02b image voice structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 image or voice is NULL
+ *             - 3 image is not opened
+ *             - 4 index is over the voice number
+ * @note       the length is the slot length up to the next voice, so it includes the padding;
+ *             the blocks are the 512 bytes update packets which hold the voice
+ */
+uint8_t wt588e02b_image_get_voice(const wt588e02b_image_t *image, uint16_t index, wt588e02b_image_voice_t *voice);
+
+/**
+ * @brief         get a play list of an image
+ * @param[in]     *image pointer to a wt588e02b image structure
+ * @param[in]     list list number
+ * @param[out]    *ind pointer to an index buffer
+ * @param[in,out] *len pointer to an index buffer length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 index buffer is too small
+ *                - 2 image, ind or len is NULL
+ *                - 3 image is not opened
+ *                - 4 list is over the list number
+ * @note          the indexes can be passed to wt588e02b_play_list as they are
+ */
+uint8_t wt588e02b_image_get_list(const wt588e02b_image_t *image, uint16_t list, uint8_t *ind, uint8_t *len);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup wt588e02b_log_driver wt588e02b log driver function
+ * @brief    wt588e02b log driver modules
+ * @ingroup  wt588e02b_driver
+ * @{
+ */
+
+/**
+ * @brief     set the deferred log ring
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *log pointer to a log ring structure, NULL prints through debug_print
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      with a ring, a log site writes a 12 bytes record of its message id, level,
+ *            argument and timestamp into it instead of formatting through debug_print;
+ *            it may be called before wt588e02b_init, so the init errors are recorded too;
+ *            the ring is cleared, any number of writers reserve their slots atomically, so a site
+ *            that logs before the lock or from another thread is kept, and it has one reader
+ */
+uint8_t wt588e02b_set_log(wt588e02b_handle_t *handle, wt588e02b_log_t *log);
+
+/**
+ * @brief         read the deferred log
+ * @param[in]     *handle pointer to a wt588e02b handle structure
+ * @param[out]    *record pointer to a record buffer
+ * @param[in,out] *len pointer to a record buffer length buffer
+ * @param[out]    *lost pointer to a lost record number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ * @note          lost counts the records dropped on a full ring since the ring was set, no ring reads nothing,
+ *                the records are expanded on the host by wt588e02b-log with the message table of driver_wt588e02b_log.h
+ */
+uint8_t wt588e02b_log_read(wt588e02b_handle_t *handle, wt588e02b_log_record_t *record, uint16_t *len, uint32_t *lost);
+
+/**
+ * @brief     set the deferred log ring of the shared bus
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] *log pointer to a log ring structure, NULL prints through debug_print
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ * @note      the bus has no clock, so its records have a 0 timestamp
+ */
+uint8_t wt588e02b_bus_set_log(wt588e02b_bus_t *bus, wt588e02b_log_t *log);
+
+/**
+ * @brief         read the deferred log of the shared bus
+ * @param[in]     *bus pointer to a wt588e02b bus structure
+ * @param[out]    *record pointer to a record buffer
+ * @param[in,out] *len pointer to a record buffer length buffer
+ * @param[out]    *lost pointer to a lost record number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 bus is NULL
+ * @note          none
+ */
+uint8_t wt588e02b_bus_log_read(wt588e02b_bus_t *bus, wt588e02b_log_record_t *record, uint16_t *len, uint32_t *lost);
 
 /**
  * @}
@@ -478,6 +1480,7 @@ uint8_t wt588e02b_update_all(wt588e02b_handle_t *handle, char *path);
  * @}
  */
 
+#if (WT588E02B_FEATURE_REG != 0)
 /**
  * @brief     set the chip register
  * @param[in] *handle pointer to a wt588e02b handle structure
@@ -489,7 +1492,7 @@ uint8_t wt588e02b_update_all(wt588e02b_handle_t *handle, char *path);
  *            - 1 set reg failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      every byte waits 5ms in the frame, wt588e02b_transfer sets the gaps per segment
  */
 uint8_t wt588e02b_set_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t us);
 
@@ -504,10 +1507,66 @@ uint8_t wt588e02b_set_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len
  *             - 1 get reg failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       every byte waits 5ms in the frame, wt588e02b_transfer sets the gaps per segment
  */
 uint8_t wt588e02b_get_reg(wt588e02b_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t us);
 
+/**
+ * @brief     run a raw transaction
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *segs pointer to a segment array
+ * @param[in] n segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 segment is invalid
+ * @note      all segments run in one cs assertion, a read segment clocks mosi low,
+ *            the gap of a segment is only waited once, so a 16 bytes segment costs one gap instead of 16
+ */
+uint8_t wt588e02b_transfer(wt588e02b_handle_t *handle, const wt588e02b_segment_t *segs, uint16_t n);
+
+/**
+ * @brief     begin a split raw transaction
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 begin failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the lock is held until wt588e02b_raw_end or a failed segment,
+ *            cs stays low between the calls, so the caller may wait a long gap without blocking
+ */
+uint8_t wt588e02b_raw_begin(wt588e02b_handle_t *handle);
+
+/**
+ * @brief     run one segment of a split raw transaction
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @param[in] *seg pointer to a segment structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 segment failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 segment is invalid
+ * @note      cs and the lock are released on an error, so the transaction must begin again
+ */
+uint8_t wt588e02b_raw_segment(wt588e02b_handle_t *handle, const wt588e02b_segment_t *seg);
+
+/**
+ * @brief     end a split raw transaction
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 end failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the lock is released even if cs can not be set high
+ */
+uint8_t wt588e02b_raw_end(wt588e02b_handle_t *handle);
+#endif
+
 /**
  * @}
  */
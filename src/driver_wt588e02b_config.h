@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_config.h
+ * @brief     driver wt588e02b config header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_WT588E02B_CONFIG_H
+#define DRIVER_WT588E02B_CONFIG_H
+
+/**
+ * @defgroup wt588e02b_config_driver wt588e02b config driver function
+ * @brief    wt588e02b config driver modules
+ * @ingroup  wt588e02b_driver
+ * @note     every switch can be set here or by the build flags, a disabled feature
+ *           compiles out its functions, its handle storage and its interface checks
+ * @{
+ */
+
+/**
+ * @brief wt588e02b log level definition
+ */
+#define WT588E02B_LOG_LEVEL_NONE         0        /**< no log site is compiled */
+#define WT588E02B_LOG_LEVEL_ERROR        1        /**< failed calls */
+#define WT588E02B_LOG_LEVEL_WARN         2        /**< refused calls the caller can retry */
+#define WT588E02B_LOG_LEVEL_DEBUG        3        /**< per packet trace */
+
+/**
+ * @brief wt588e02b log config definition
+ */
+#ifndef WT588E02B_LOG_LEVEL
+    #define WT588E02B_LOG_LEVEL          WT588E02B_LOG_LEVEL_WARN        /**< sites above the level are compiled out, none also drops the records */
+#endif
+#ifndef WT588E02B_LOG_SIZE
+    #define WT588E02B_LOG_SIZE           16                              /**< deferred records per ring, a power of 2 up to 128 */
+#endif
+
+/**
+ * @brief wt588e02b handle layout config definition
+ */
+#ifndef WT588E02B_HANDLE_LINK
+    #define WT588E02B_HANDLE_LINK        0                               /**< 0 links a shared const ops table, 1 keeps a link table and an update buffer in every handle */
+#endif
+
+/**
+ * @brief wt588e02b feature config definition
+ */
+#ifndef WT588E02B_FEATURE_UPDATE
+    #define WT588E02B_FEATURE_UPDATE     1                               /**< update, update all, bus update and the 512 bytes buffers */
+#endif
+#ifndef WT588E02B_FEATURE_REG
+    #define WT588E02B_FEATURE_REG        1                               /**< raw set_reg and get_reg */
+#endif
+#ifndef WT588E02B_FEATURE_LOOP
+    #define WT588E02B_FEATURE_LOOP       1                               /**< play loop, play loop advance and play loop all */
+#endif
+#ifndef WT588E02B_FEATURE_STRING
+    #define WT588E02B_FEATURE_STRING     1                               /**< log format strings, 0 prints the message id and the argument */
+#endif
+#ifndef WT588E02B_FEATURE_COALESCE
+    #define WT588E02B_FEATURE_COALESCE   1                               /**< play coalescing window and its queue pointer */
+#endif
+#ifndef WT588E02B_FEATURE_SHADOW
+    #define WT588E02B_FEATURE_SHADOW     1                               /**< shadow state that skips redundant command frames */
+#endif
+#ifndef WT588E02B_FEATURE_STATS
+    #define WT588E02B_FEATURE_STATS      1                               /**< sent, skipped and merged command counters */
+#endif
+#ifndef WT588E02B_FEATURE_DURATION
+    #define WT588E02B_FEATURE_DURATION   1                               /**< play duration profiler and its table pointer */
+#endif
+#ifndef WT588E02B_FEATURE_STEP
+    #define WT588E02B_FEATURE_STEP       1                               /**< stepped play, stop and update all that leave the waits to the caller */
+#endif
+
+/**
+ * @brief wt588e02b interface config definition
+ */
+#ifndef WT588E02B_INTERFACE_FRAME_TRANSFER
+    #define WT588E02B_INTERFACE_FRAME_TRANSFER    0                      /**< 1 links wt588e02b_interface_frame_transfer, only for a port with a waveform engine */
+#endif
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_log.h
+ * @brief     driver wt588e02b log message header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_WT588E02B_LOG_H
+#define DRIVER_WT588E02B_LOG_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup wt588e02b_basic_driver
+ * @{
+ */
+
+/**
+ * @brief wt588e02b log message table definition
+ * @note  X(id, name, format), the id is the message id of a log record and never changes,
+ *        a new message is appended with the next id and an id is never reused, so wt588e02b-log
+ *        decodes the records of every driver revision without its source
+ */
+#define WT588E02B_LOG_MESSAGE_TABLE(X)    \
+    X(  1, SCLK_GPIO_WRITE_FAILED,   "wt588e02b: sclk gpio write failed.\n"                     )    \
+    X(  2, CS_GPIO_WRITE_FAILED,     "wt588e02b: cs gpio write failed.\n"                       )    \
+    X(  3, WRITE_WITH_NO_CS_FAILED,  "wt588e02b: write with no cs failed.\n"                    )    \
+    X(  4, READ_WITH_NO_CS_FAILED,   "wt588e02b: read with no cs failed.\n"                     )    \
+    X(  5, UPDATE_GET_STATUS_FAILED, "wt588e02b: update get status failed.\n"                   )    \
+    X(  6, CHIP_SUM_CHECK_ERROR,     "wt588e02b: chip %d sum check error.\n"                    )    \
+    X(  7, BUS_BIN_READ_NULL,        "wt588e02b: bus bin read is null.\n"                       )    \
+    X(  8, BIN_READ_INIT_FAILED,     "wt588e02b: bin read init failed.\n"                       )    \
+    X(  9, BIN_SIZE_INVALID,         "wt588e02b: bin size is invalid.\n"                        )    \
+    X( 10, UPDATE_FAILED,            "wt588e02b: update failed.\n"                              )    \
+    X( 11, BIN_READ_FAILED,          "wt588e02b: bin read failed.\n"                            )    \
+    X( 12, UPDATE_SEND_PACK_FAILED,  "wt588e02b: update send pack failed.\n"                    )    \
+    X( 13, BUS_UPDATE_PACK_SENT,     "wt588e02b: bus update pack %d sent.\n"                    )    \
+    X( 14, UPDATE_END_FAILED,        "wt588e02b: update end failed.\n"                          )    \
+    X( 15, BIN_READ_DEINIT_FAILED,   "wt588e02b: bin read deinit failed.\n"                     )    \
+    X( 16, FRAME_TRANSFER_FAILED,    "wt588e02b: frame transfer failed.\n"                      )    \
+    X( 17, READ2_WITH_NO_CS_FAILED,  "wt588e02b: read2 with no cs failed.\n"                    )    \
+    X( 18, CHECK_BUSY_FAILED,        "wt588e02b: check busy failed.\n"                          )    \
+    X( 19, CHIP_BUSY,                "wt588e02b: chip is busy.\n"                               )    \
+    X( 20, LEN_INVALID,              "wt588e02b: len > 40.\n"                                   )    \
+    X( 21, LIST_IND_INVALID,         "wt588e02b: list[%d] > 0xDF.\n"                            )    \
+    X( 22, COALESCE_FLUSH_FAILED,    "wt588e02b: coalesce flush failed.\n"                      )    \
+    X( 23, IND_INVALID,              "wt588e02b: ind > 0xDF.\n"                                 )    \
+    X( 24, LOCK_FAILED,              "wt588e02b: lock failed.\n"                                )    \
+    X( 25, VOL_INVALID,              "wt588e02b: vol > 0x3F.\n"                                 )    \
+    X( 26, UPDATE_NOT_LINKED,        "wt588e02b: update is not linked.\n"                       )    \
+    X( 27, SUM_CHECK_ERROR,          "wt588e02b: sum check error.\n"                            )    \
+    X( 28, UPDATE_PACK_SENT,         "wt588e02b: update pack %d sent.\n"                        )    \
+    X( 29, UPDATE_ALL_FAILED,        "wt588e02b: update all failed.\n"                          )    \
+    X( 30, SCLK_GPIO_INIT_NULL,      "wt588e02b: sclk_gpio_init is null.\n"                     )    \
+    X( 31, SCLK_GPIO_DEINIT_NULL,    "wt588e02b: sclk_gpio_deinit is null.\n"                   )    \
+    X( 32, SCLK_GPIO_WRITE_NULL,     "wt588e02b: sclk_gpio_write is null.\n"                    )    \
+    X( 33, MOSI_GPIO_INIT_NULL,      "wt588e02b: mosi_gpio_init is null.\n"                     )    \
+    X( 34, MOSI_GPIO_DEINIT_NULL,    "wt588e02b: mosi_gpio_deinit is null.\n"                   )    \
+    X( 35, MOSI_GPIO_WRITE_NULL,     "wt588e02b: mosi_gpio_write is null.\n"                    )    \
+    X( 36, MISO_GPIO_INIT_NULL,      "wt588e02b: miso_gpio_init is null.\n"                     )    \
+    X( 37, MISO_GPIO_DEINIT_NULL,    "wt588e02b: miso_gpio_deinit is null.\n"                   )    \
+    X( 38, MISO_GPIO_READ_NULL,      "wt588e02b: miso_gpio_read is null.\n"                     )    \
+    X( 39, CS_GPIO_INIT_NULL,        "wt588e02b: cs_gpio_init is null.\n"                       )    \
+    X( 40, CS_GPIO_DEINIT_NULL,      "wt588e02b: cs_gpio_deinit is null.\n"                     )    \
+    X( 41, CS_GPIO_WRITE_NULL,       "wt588e02b: cs_gpio_write is null.\n"                      )    \
+    X( 42, DELAY_MS_NULL,            "wt588e02b: delay_ms is null.\n"                           )    \
+    X( 43, DELAY_US_NULL,            "wt588e02b: delay_us is null.\n"                           )    \
+    X( 44, LOCK_UNLOCK_UNPAIRED,     "wt588e02b: lock and unlock must be linked together.\n"    )    \
+    X( 45, SCLK_GPIO_INIT_FAILED,    "wt588e02b: sclk gpio init failed.\n"                      )    \
+    X( 46, MOSI_GPIO_INIT_FAILED,    "wt588e02b: mosi gpio init failed.\n"                      )    \
+    X( 47, MISO_GPIO_INIT_FAILED,    "wt588e02b: miso gpio init failed.\n"                      )    \
+    X( 48, CS_GPIO_INIT_FAILED,      "wt588e02b: cs gpio init failed.\n"                        )    \
+    X( 49, SCLK_GPIO_DEINIT_FAILED,  "wt588e02b: sclk gpio deinit failed.\n"                    )    \
+    X( 50, MOSI_GPIO_DEINIT_FAILED,  "wt588e02b: mosi gpio deinit failed.\n"                    )    \
+    X( 51, MISO_GPIO_DEINIT_FAILED,  "wt588e02b: miso gpio deinit failed.\n"                    )    \
+    X( 52, CS_GPIO_DEINIT_FAILED,    "wt588e02b: cs gpio deinit failed.\n"                      )    \
+    X( 53, TIMESTAMP_MS_NULL,        "wt588e02b: timestamp_ms is null.\n"                       )    \
+    X( 54, DURATION_TABLE_NULL,      "wt588e02b: duration table is null.\n"                     )    \
+    X( 55, WRITE_FAILED,             "wt588e02b: write failed.\n"                               )    \
+    X( 56, READ_FAILED,              "wt588e02b: read failed.\n"                                )    \
+    X( 57, DATA_INVALID,             "wt588e02b: data is invalid.\n"                            )    \
+    X( 58, SET_VOL_FAILED,           "wt588e02b: set vol failed.\n"                             )    \
+    X( 59, NO_COMMAND_RUNNING,       "wt588e02b: no command is running.\n"                      )    \
+    X( 60, BUS_SCLK_GPIO_NULL,       "wt588e02b: bus sclk gpio is null.\n"                      )    \
+    X( 61, BUS_MOSI_GPIO_NULL,       "wt588e02b: bus mosi gpio is null.\n"                      )    \
+    X( 62, BUS_DELAY_NULL,           "wt588e02b: bus delay is null.\n"                          )    \
+    X( 63, BUS_LOCK_UNLOCK_UNPAIRED, "wt588e02b: bus lock and unlock must be linked together.\n")    \
+    X( 64, CHIPS_ATTACHED,           "wt588e02b: chips are still attached.\n"                   )    \
+    X( 65, CHIP_INVALID,             "wt588e02b: chip >= 32.\n"                                 )    \
+    X( 66, CHIP_USED,                "wt588e02b: chip is used.\n"                               )    \
+    X( 67, HANDLE_INITIALIZED,       "wt588e02b: handle is initialized.\n"                      )    \
+    X( 68, HANDLE_NOT_ATTACHED,      "wt588e02b: handle is not attached.\n"                     )    \
+    X( 69, MASK_NOT_INITIALIZED,     "wt588e02b: no initialized chip in the mask.\n"            )    \
+    X( 70, BUS_FRAME_FAILED,         "wt588e02b: bus frame failed.\n"                           )    \
+    X( 71, SEGMENT_INVALID,          "wt588e02b: segment is invalid.\n"                         )    \
+    X( 72, SEGMENT_N_INVALID,        "wt588e02b: segment %d is invalid.\n"                      )
+
+/**
+ * @brief wt588e02b log message enumeration definition
+ */
+#define WT588E02B_LOG_MESSAGE_ENUM(ID, NAME, FMT)        WT588E02B_LOG_MSG_##NAME = ID,
+typedef enum
+{
+    WT588E02B_LOG_MSG_NONE = 0,                                     /**< no message */
+    WT588E02B_LOG_MESSAGE_TABLE(WT588E02B_LOG_MESSAGE_ENUM)
+    WT588E02B_LOG_MSG_END,                                          /**< one after the last message id */
+} wt588e02b_log_message_t;
+#undef WT588E02B_LOG_MESSAGE_ENUM
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
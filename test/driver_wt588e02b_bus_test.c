@@ -0,0 +1,488 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_bus_test.c
+ * @brief     driver wt588e02b bus test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_bus_test.h"
+#include "driver_wt588e02b_mock.h"
+
+/**
+ * @brief bus test definition
+ */
+#define WT588E02B_BUS_TEST_IMAGE_SIZE        1300        /**< three packets, the last one partial */
+
+static wt588e02b_bus_t gs_bus;                                        /**< wt588e02b bus */
+static wt588e02b_handle_t gs_handle[WT588E02B_MOCK_MAX_CHIP];         /**< wt588e02b handles */
+static uint8_t gs_image[WT588E02B_BUS_TEST_IMAGE_SIZE];               /**< voice image */
+static uint32_t gs_image_size;                                        /**< image size seen by the driver */
+static uint32_t gs_image_reads;                                       /**< bin read calls */
+
+/**
+ * @brief      bus test bin read init
+ * @param[in]  *name pointer to a name buffer
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static uint8_t a_wt588e02b_bus_test_bin_read_init(char *name, uint32_t *size)
+{
+    (void)name;
+    
+    *size = gs_image_size;
+    
+    return 0;
+}
+
+/**
+ * @brief      bus test bin read
+ * @param[in]  addr read address
+ * @param[in]  size read size
+ * @param[out] *buf pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_wt588e02b_bus_test_bin_read(uint32_t addr, uint16_t size, uint8_t *buf)
+{
+    if (addr + size > gs_image_size)
+    {
+        return 1;
+    }
+    memcpy(buf, &gs_image[addr], size);
+    gs_image_reads++;
+    
+    return 0;
+}
+
+/**
+ * @brief  bus test bin read deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_wt588e02b_bus_test_bin_read_deinit(void)
+{
+    return 0;
+}
+
+#if (WT588E02B_FEATURE_UPDATE != 0)
+/**
+ * @brief     bus test word sum of the last packet
+ * @param[in] size image size
+ * @return    sum
+ * @note      the unused tail of the last packet is sent as 0
+ */
+static uint16_t a_wt588e02b_bus_test_last_sum(uint32_t size)
+{
+    uint32_t addr;
+    uint32_t i;
+    uint16_t sum;
+    uint16_t lo;
+    uint16_t hi;
+    
+    addr = ((size - 1) / 512) * 512;
+    sum = 0;
+    for (i = addr; i < addr + 512; i += 2)
+    {
+        lo = (i < size) ? gs_image[i] : 0;
+        hi = (i + 1 < size) ? gs_image[i + 1] : 0;
+        sum = (uint16_t)(sum + (uint16_t)(lo | (hi << 8)));
+    }
+    
+    return sum;
+}
+#endif
+
+/**
+ * @brief      bus test get the frame counters
+ * @param[out] *frames pointer to a counter array with one entry per chip
+ * @note       none
+ */
+static void a_wt588e02b_bus_test_frames(uint32_t *frames)
+{
+    uint8_t i;
+    wt588e02b_mock_state_t state;
+    
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)
+    {
+        wt588e02b_mock_get_chip_state(i, &state);
+        frames[i] = state.frames;
+    }
+}
+
+/**
+ * @brief     bus test check a broadcast
+ * @param[in] *frames pointer to the counter array before the broadcast
+ * @param[in] mask chips that must have decoded the frame
+ * @param[in] command broadcast command
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every chip in the mask decodes the frame exactly once, the others see nothing
+ */
+static uint8_t a_wt588e02b_bus_test_broadcast(const uint32_t *frames, uint32_t mask, uint8_t command)
+{
+    uint8_t i;
+    wt588e02b_mock_state_t state;
+    
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)
+    {
+        wt588e02b_mock_get_chip_state(i, &state);
+        if (state.errors != 0)
+        {
+            return 1;
+        }
+        if ((mask & (1UL << i)) != 0)
+        {
+            if ((state.frames != frames[i] + 1) || (state.command != command))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            if (state.frames != frames[i])
+            {
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bus test close
+ * @param[in] n number of initialized handles
+ * @note      handles that already left the bus are skipped
+ */
+static void a_wt588e02b_bus_test_close(uint8_t n)
+{
+    uint8_t i;
+    
+    for (i = 0; i < n; i++)
+    {
+        (void)wt588e02b_deinit(&gs_handle[i]);
+        if (gs_handle[i].bus == &gs_bus)
+        {
+            (void)wt588e02b_bus_detach(&gs_bus, &gs_handle[i]);
+        }
+    }
+    (void)wt588e02b_bus_deinit(&gs_bus);
+}
+
+/**
+ * @brief     bus test one pass
+ * @param[in] mask_hook 1 uses the cs and miso mask hooks, 0 uses the per chip hooks
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_bus_test_run(uint8_t mask_hook)
+{
+    uint8_t res;
+    uint8_t i;
+    uint16_t sum;
+    uint32_t done;
+    uint32_t packets[WT588E02B_MOCK_MAX_CHIP];
+    uint32_t frames[WT588E02B_MOCK_MAX_CHIP];
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+    
+    /* link driver */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = 200000;
+    wt588e02b_mock_init(&config);
+    wt588e02b_mock_bus_link(&gs_bus, mask_hook);
+    DRIVER_WT588E02B_BUS_LINK_BIN_READ_INIT(&gs_bus, a_wt588e02b_bus_test_bin_read_init);
+    DRIVER_WT588E02B_BUS_LINK_BIN_READ(&gs_bus, a_wt588e02b_bus_test_bin_read);
+    DRIVER_WT588E02B_BUS_LINK_BIN_READ_DEINIT(&gs_bus, a_wt588e02b_bus_test_bin_read_deinit);
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)
+    {
+        DRIVER_WT588E02B_LINK_INIT(&gs_handle[i], wt588e02b_handle_t);
+        DRIVER_WT588E02B_LINK_OPS(&gs_handle[i], wt588e02b_mock_chip_ops(i));
+        DRIVER_WT588E02B_LINK_BUFFER(&gs_handle[i], NULL);
+    }
+    wt588e02b_interface_debug_print("wt588e02b: %s cs and miso hooks.\n", (mask_hook != 0) ? "mask" : "per chip");
+    
+    /* init */
+    res = wt588e02b_bus_init(&gs_bus);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus init failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)
+    {
+        res = wt588e02b_bus_attach(&gs_bus, &gs_handle[i], i);
+        if (res == 0)
+        {
+            res = wt588e02b_init(&gs_handle[i]);
+        }
+#if (WT588E02B_FEATURE_SHADOW != 0)
+        if (res == 0)
+        {
+            res = wt588e02b_set_shadow(&gs_handle[i], WT588E02B_BOOL_TRUE);
+        }
+#endif
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: chip %d attach failed.\n", i);
+            (void)wt588e02b_bus_detach(&gs_bus, &gs_handle[i]);
+            a_wt588e02b_bus_test_close(i);
+            
+            return 1;
+        }
+    }
+    
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    /* update all on chips 0, 1 and 3 */
+    gs_image_size = 1024;
+    gs_image_reads = 0;
+    sum = a_wt588e02b_bus_test_last_sum(gs_image_size);
+    res = wt588e02b_bus_update_all(&gs_bus, 0x0B, "mock", &done);
+    if ((res != 0) || (done != 0x0B) || (gs_image_reads != 2))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus update all failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)
+    {
+        wt588e02b_mock_get_chip_state(i, &state);
+        if (i == 2)
+        {
+            res = (state.frames != 0) || (state.packets != 0) || (state.errors != 0);
+        }
+        else
+        {
+            /* update all, 2 status frames, update end */
+            res = (state.frames != 4) || (state.packets != 2) || (state.sum != sum) || (state.errors != 0);
+        }
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: chip %d update all check failed.\n", i);
+            a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+            
+            return 1;
+        }
+        frames[i] = state.frames;
+        packets[i] = state.packets;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: 2 packets read once and clocked into chips 0, 1 and 3 once each.\n");
+    
+    /* update one index on all chips, chip 1 writes its second packet wrong */
+    gs_image_size = WT588E02B_BUS_TEST_IMAGE_SIZE;
+    gs_image_reads = 0;
+    sum = a_wt588e02b_bus_test_last_sum(gs_image_size);
+    wt588e02b_mock_set_corrupt(1, packets[1] + 2);
+    res = wt588e02b_bus_update(&gs_bus, 0x0F, 0x10, "mock", &done);
+    if ((res != 0) || (done != 0x0D) || (gs_image_reads != 3))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus update failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)
+    {
+        wt588e02b_mock_get_chip_state(i, &state);
+        if (i == 1)
+        {
+            /* update address and 3 status frames, the last one drops the chip */
+            res = (state.frames - frames[i] != 4) || (state.packets - packets[i] != 2) ||
+                  (state.sum == sum) || (state.errors != 0);
+        }
+        else
+        {
+            /* update address, 3 status frames, update end */
+            res = (state.frames - frames[i] != 5) || (state.packets - packets[i] != 3) ||
+                  (state.sum != sum) || (state.errors != 0);
+        }
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: chip %d update check failed.\n", i);
+            a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+            
+            return 1;
+        }
+    }
+    wt588e02b_interface_debug_print("wt588e02b: chip 1 status read back alone and dropped, done mask is 0x%02X.\n",
+                                    (unsigned int)done);
+#else
+    (void)sum;
+    (void)done;
+    (void)packets;
+#endif
+    
+    /* broadcast the volume to chips 0 and 2 */
+    a_wt588e02b_bus_test_frames(frames);
+    res = wt588e02b_bus_set_vol(&gs_bus, 0x05, 0x20);
+    if ((res != 0) || (a_wt588e02b_bus_test_broadcast(frames, 0x05, 0xF1) != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus set vol failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    wt588e02b_mock_get_chip_state(2, &state);
+    if (state.vol != 0x20)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus set vol check failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: cs mask 0x05 sent one volume frame to chips 0 and 2.\n");
+    
+    /* broadcast the same volume to all chips */
+    a_wt588e02b_bus_test_frames(frames);
+    res = wt588e02b_bus_set_vol(&gs_bus, 0x0F, 0x20);
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    if ((res != 0) || (a_wt588e02b_bus_test_broadcast(frames, 0x0A, 0xF1) != 0))
+#else
+    if ((res != 0) || (a_wt588e02b_bus_test_broadcast(frames, 0x0F, 0xF1) != 0))
+#endif
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus set vol failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: chips holding the volume are left out of the frame.\n");
+    
+    /* stop chips 1 and 2 */
+    a_wt588e02b_bus_test_frames(frames);
+    res = wt588e02b_bus_stop(&gs_bus, 0x06);
+    if ((res != 0) || (a_wt588e02b_bus_test_broadcast(frames, 0x06, 0xFF) != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus stop failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: cs mask 0x06 sent one stop frame to chips 1 and 2.\n");
+    
+    /* chip 3 leaves the bus */
+    res = wt588e02b_deinit(&gs_handle[3]);
+    if (res == 0)
+    {
+        res = wt588e02b_bus_detach(&gs_bus, &gs_handle[3]);
+    }
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: chip 3 detach failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    a_wt588e02b_bus_test_frames(frames);
+    res = wt588e02b_bus_set_vol(&gs_bus, 0x0F, 0x10);
+    if ((res != 0) || (a_wt588e02b_bus_test_broadcast(frames, 0x07, 0xF1) != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus set vol failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: the detached chip 3 is left out of mask 0x0F.\n");
+    
+    /* refused calls */
+    a_wt588e02b_bus_test_frames(frames);
+    if ((wt588e02b_bus_set_vol(&gs_bus, 0x0F, 0x40) != 4) || (wt588e02b_bus_set_vol(&gs_bus, 0x08, 0x10) != 5) ||
+        (wt588e02b_bus_stop(&gs_bus, 0x08) != 4) || (wt588e02b_bus_attach(&gs_bus, &gs_handle[3], 32) != 4) ||
+        (wt588e02b_bus_attach(&gs_bus, &gs_handle[3], 0) != 5) || (wt588e02b_bus_attach(&gs_bus, &gs_handle[0], 3) != 6) ||
+        (wt588e02b_bus_detach(&gs_bus, &gs_handle[0]) != 5) || (wt588e02b_bus_deinit(&gs_bus) != 4) ||
+        (a_wt588e02b_bus_test_broadcast(frames, 0x00, 0x00) != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bus argument check failed.\n");
+        a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: invalid bus calls are refused without a frame.\n");
+    
+    /* deinit */
+    a_wt588e02b_bus_test_close(WT588E02B_MOCK_MAX_CHIP);
+    
+    return 0;
+}
+
+/**
+ * @brief  bus test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs on several mock chips sharing sclk and mosi, once with the per chip cs and miso hooks
+ *         and once with the mask hooks, and checks that every broadcast packet reaches each selected
+ *         chip exactly once, that every chip reads its own status back and that a cs mask only
+ *         selects the attached chips it names
+ */
+uint8_t wt588e02b_bus_test(void)
+{
+    uint32_t i;
+    
+    /* start bus test */
+    wt588e02b_interface_debug_print("wt588e02b: start bus test.\n");
+    
+    /* voice image */
+    for (i = 0; i < WT588E02B_BUS_TEST_IMAGE_SIZE; i++)
+    {
+        gs_image[i] = (uint8_t)(i * 13 + 7);
+    }
+    
+    /* per chip hooks */
+    if (a_wt588e02b_bus_test_run(0) != 0)
+    {
+        return 1;
+    }
+    
+    /* mask hooks */
+    if (a_wt588e02b_bus_test_run(1) != 0)
+    {
+        return 1;
+    }
+    
+    /* finish bus test */
+    wt588e02b_interface_debug_print("wt588e02b: finish bus test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_coalesce_test.c
+ * @brief     driver wt588e02b coalesce test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_coalesce_test.h"
+#include "driver_wt588e02b_mock.h"
+
+static wt588e02b_handle_t gs_handle;        /**< wt588e02b handle */
+#if (WT588E02B_FEATURE_COALESCE != 0)
+static wt588e02b_coalesce_t gs_coalesce;    /**< coalescing queue */
+#endif
+
+/**
+ * @brief  coalesce test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs on the mock chip with a 50ms window, checks that plays inside the window are
+ *         merged into one play list in order, that an expired window is flushed by
+ *         wt588e02b_coalesce_poll, an idle wt588e02b_check_busy, the next command or a stepped stop
+ *         and that the counters match the frames on the bus
+ */
+uint8_t wt588e02b_coalesce_test(void)
+{
+#if (WT588E02B_FEATURE_COALESCE != 0)
+    uint8_t res;
+    uint8_t i;
+    uint8_t list[3] = {3, 1, 2};
+    uint32_t frames;
+    uint32_t start;
+    wt588e02b_bool_t enable;
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+#if (WT588E02B_FEATURE_STATS != 0)
+    wt588e02b_stats_t stats;
+#endif
+#if (WT588E02B_FEATURE_STEP != 0)
+    wt588e02b_step_t step;
+#endif
+    
+    /* link driver */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = 200000;
+    wt588e02b_mock_init(&config);
+    wt588e02b_mock_link(&gs_handle);
+    
+    /* start coalesce test */
+    wt588e02b_interface_debug_print("wt588e02b: start coalesce test.\n");
+    
+    /* init */
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        
+        return 1;
+    }
+    res = wt588e02b_set_coalesce(&gs_handle, &gs_coalesce, 50);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: set coalesce failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+#if (WT588E02B_FEATURE_STATS != 0)
+    (void)wt588e02b_clear_stats(&gs_handle);
+#endif
+    wt588e02b_mock_get_state(&state);
+    start = state.frames;
+    
+    /* plays inside the window are queued */
+    for (i = 0; i < 3; i++)
+    {
+        res = wt588e02b_play(&gs_handle, list[i]);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: play failed.\n");
+            (void)wt588e02b_deinit(&gs_handle);
+            
+            return 1;
+        }
+        wt588e02b_mock_delay_ms(10);
+    }
+    (void)wt588e02b_check_busy(&gs_handle, &enable);
+    (void)wt588e02b_coalesce_poll(&gs_handle);
+    wt588e02b_mock_get_state(&state);
+    if (state.frames != start)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: open window check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: 3 plays queued while the window is open.\n");
+    
+    /* the poll sends them as one play list in order */
+    wt588e02b_mock_delay_ms(30);
+    res = wt588e02b_coalesce_poll(&gs_handle);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != start + 1) || (state.command != 0xF3) || (state.list_len != 3) ||
+        (state.list[0] != list[0]) || (state.list[1] != list[1]) || (state.list[2] != list[2]) ||
+        (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: merge check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: merged into one play list of %d %d %d.\n",
+                                    state.list[0], state.list[1], state.list[2]);
+    wt588e02b_mock_delay_ms(700);
+    
+    /* an idle check busy flushes an expired window */
+    res = wt588e02b_play(&gs_handle, 7);
+    wt588e02b_mock_delay_ms(60);
+    res |= wt588e02b_check_busy(&gs_handle, &enable);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != start + 2) || (state.command != 0xF0) || (state.ind != 7) ||
+        (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: check busy expiry check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: expired window flushed by check busy.\n");
+    wt588e02b_mock_delay_ms(300);
+    
+    /* the next command flushes an expired window first */
+    res = wt588e02b_play(&gs_handle, 5);
+    res |= wt588e02b_play(&gs_handle, 6);
+    wt588e02b_mock_delay_ms(60);
+    wt588e02b_mock_get_state(&state);
+    frames = state.frames;
+    res |= wt588e02b_set_vol(&gs_handle, 0x20);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != frames + 2) || (state.command != 0xF1) || (state.list_len != 2) ||
+        (state.list[0] != 5) || (state.list[1] != 6) || (state.vol != 0x20) || (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: command expiry check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: expired window flushed before the volume frame.\n");
+    wt588e02b_mock_delay_ms(500);
+    
+    /* an explicit flush does not wait for the window */
+    res = wt588e02b_play(&gs_handle, 9);
+    res |= wt588e02b_coalesce_flush(&gs_handle);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != start + 5) || (state.command != 0xF0) || (state.ind != 9) ||
+        (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: flush check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: flush sent the open window at once.\n");
+    
+#if (WT588E02B_FEATURE_STATS != 0)
+    /* 7 plays went out in 4 frames and one volume frame followed */
+    res = wt588e02b_get_stats(&gs_handle, &stats);
+    if ((res != 0) || (stats.sent != 5) || (stats.merged != 3) || (stats.saved_us == 0) ||
+        ((stats.saved_us % stats.merged) != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: stats check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: sent %d frames, merged %d plays and saved %dus.\n",
+                                    (int)stats.sent, (int)stats.merged, (int)stats.saved_us);
+#endif
+    
+#if (WT588E02B_FEATURE_STEP != 0)
+    /* a stepped stop flushes an expired window first like every other command */
+    wt588e02b_mock_delay_ms(500);
+    res = wt588e02b_play(&gs_handle, 4);
+    wt588e02b_mock_delay_ms(60);
+    wt588e02b_mock_get_state(&state);
+    frames = state.frames;
+    res |= wt588e02b_step_stop(&gs_handle, &step);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != frames + 1) || (state.command != 0xF0) || (state.ind != 4))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: step expiry check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    while (step.wait_us != 0)
+    {
+        wt588e02b_mock_delay_us(step.wait_us);
+        res |= wt588e02b_step(&gs_handle, &step);
+    }
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != frames + 2) || (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: step stop check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: expired window flushed before the stepped stop.\n");
+#endif
+    
+    /* deinit */
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    /* finish coalesce test */
+    wt588e02b_interface_debug_print("wt588e02b: finish coalesce test.\n");
+    
+    return 0;
+#else
+    (void)gs_handle;
+    wt588e02b_interface_debug_print("wt588e02b: coalescing is compiled out.\n");
+    
+    return 0;
+#endif
+}
@@ -0,0 +1,345 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_duration_test.c
+ * @brief     driver wt588e02b duration test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_duration_test.h"
+#include "driver_wt588e02b_mock.h"
+#include <string.h>
+
+/**
+ * @brief duration test definition
+ */
+#define WT588E02B_DURATION_TEST_CLIP_MS        200                       /**< mock voice length */
+#define WT588E02B_DURATION_TEST_BUF_SIZE       (4 + 0xE0 * 11)           /**< header and one record per index */
+
+static wt588e02b_handle_t gs_handle;                                    /**< wt588e02b handle */
+#if (WT588E02B_FEATURE_DURATION != 0)
+static wt588e02b_duration_table_t gs_table;                             /**< duration table */
+static uint8_t gs_buf[WT588E02B_DURATION_TEST_BUF_SIZE];                /**< saved table */
+static uint16_t gs_len;                                                 /**< saved length */
+static uint16_t gs_pos;                                                 /**< read position */
+
+/**
+ * @brief     write the saved table
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_duration_test_write(uint8_t *buf, uint16_t len)
+{
+    if (gs_len + len > WT588E02B_DURATION_TEST_BUF_SIZE)        /* check the size */
+    {
+        return 1;                                               /* return error */
+    }
+    memcpy(&gs_buf[gs_len], buf, len);                          /* copy data */
+    gs_len += len;                                              /* length += len */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      read the saved table
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_wt588e02b_duration_test_read(uint8_t *buf, uint16_t len)
+{
+    if (gs_pos + len > gs_len)                                  /* check the size */
+    {
+        return 1;                                               /* return error */
+    }
+    memcpy(buf, &gs_buf[gs_pos], len);                          /* copy data */
+    gs_pos += len;                                              /* position += len */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     play one index and poll busy every ms until it is idle again
+ * @param[in] ind index
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_duration_test_play(uint8_t ind)
+{
+    uint16_t i;
+    uint8_t seen;
+    wt588e02b_bool_t enable;
+    
+    if (wt588e02b_play(&gs_handle, ind) != 0)                   /* play */
+    {
+        return 1;                                               /* return error */
+    }
+    seen = 0;                                                   /* init 0 */
+    for (i = 0; i < 1000; i++)                                  /* poll 1s */
+    {
+        wt588e02b_mock_delay_ms(1);                             /* poll period */
+        if (wt588e02b_check_busy(&gs_handle, &enable) != 0)     /* check busy */
+        {
+            return 1;                                           /* return error */
+        }
+        if (enable == WT588E02B_BOOL_TRUE)                      /* check busy */
+        {
+            seen = 1;                                           /* busy seen */
+        }
+        else if (seen != 0)                                     /* idle again */
+        {
+            return 0;                                           /* success return 0 */
+        }
+        else
+        {
+            
+        }
+    }
+    
+    return 1;                                                   /* return error */
+}
+#endif
+
+/**
+ * @brief  duration test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs on the mock chip with a 15ms play response and 200ms voices, checks that a
+ *         sample is the busy time without the frame to busy latency, that a table survives
+ *         save and load and that a full table, a saturated count and invalid records are handled
+ */
+uint8_t wt588e02b_duration_test(void)
+{
+#if (WT588E02B_FEATURE_DURATION != 0)
+    uint8_t res;
+    uint8_t i;
+    uint16_t j;
+    uint32_t ms;
+    uint32_t ms_load;
+    float var;
+    float var_load;
+    wt588e02b_mock_config_t config;
+    
+    /* link driver */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = WT588E02B_DURATION_TEST_CLIP_MS * 1000;
+    wt588e02b_mock_init(&config);
+    wt588e02b_mock_link(&gs_handle);
+    memset(&gs_table, 0, sizeof(gs_table));
+    
+    /* start duration test */
+    wt588e02b_interface_debug_print("wt588e02b: start duration test.\n");
+    
+    /* init */
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        
+        return 1;
+    }
+    res = wt588e02b_set_duration_table(&gs_handle, &gs_table);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: set duration table failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* record, the sample starts at the busy edge */
+    for (i = 0; i < 4; i++)
+    {
+        if (a_wt588e02b_duration_test_play(4) != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: play failed.\n");
+            (void)wt588e02b_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    res = wt588e02b_estimate_duration(&gs_handle, 4, &ms, &var);
+    if ((res != 0) || (gs_table.entry[4].count != 4) ||
+        (ms + 1 < WT588E02B_DURATION_TEST_CLIP_MS) || (ms > WT588E02B_DURATION_TEST_CLIP_MS + 1) || (var > 1.0f))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: record check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (wt588e02b_estimate_duration(&gs_handle, 5, &ms_load, &var_load) != 1)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: empty entry check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: index 4 plays %dms of %dms busy time.\n", (int)ms, WT588E02B_DURATION_TEST_CLIP_MS);
+    
+    /* save and load */
+    gs_len = 0;
+    res = wt588e02b_duration_save(&gs_handle, a_wt588e02b_duration_test_write);
+    if ((res != 0) || (gs_len != 4 + 11) || (gs_buf[3] != 1) || (gs_buf[4] != 4))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: save check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(gs_table.entry, 0, sizeof(gs_table.entry));
+    gs_pos = 0;
+    res = wt588e02b_duration_load(&gs_handle, a_wt588e02b_duration_test_read);
+    if ((res != 0) || (gs_pos != gs_len) ||
+        (wt588e02b_estimate_duration(&gs_handle, 4, &ms_load, &var_load) != 0) ||
+        (ms_load != ms) || (var_load != var) || (gs_table.entry[4].count != 4))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: load check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: %d bytes saved and loaded back.\n", gs_len);
+    
+    /* a full table */
+    for (j = 0; j < 0xE0; j++)
+    {
+        gs_table.entry[j].count = (uint16_t)(j + 1);
+        gs_table.entry[j].mean_ms = (float)(j * 10);
+        gs_table.entry[j].var_ms2 = (float)(j);
+    }
+    gs_len = 0;
+    res = wt588e02b_duration_save(&gs_handle, a_wt588e02b_duration_test_write);
+    if ((res != 0) || (gs_len != WT588E02B_DURATION_TEST_BUF_SIZE) || (gs_buf[3] != 0xE0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: full save check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(gs_table.entry, 0, sizeof(gs_table.entry));
+    gs_pos = 0;
+    res = wt588e02b_duration_load(&gs_handle, a_wt588e02b_duration_test_read);
+    if ((res != 0) || (gs_table.entry[0].count != 1) || (gs_table.entry[0xDF].count != 0xE0) ||
+        (gs_table.entry[0xDF].mean_ms != 2230.0f) || (gs_table.entry[0xDF].var_ms2 != 223.0f))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: full load check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: all %d indexes saved and loaded back.\n", 0xE0);
+    
+    /* the count saturates */
+    gs_table.entry[4].count = 0xFFFF;
+    gs_table.entry[4].mean_ms = 100.0f;
+    if ((a_wt588e02b_duration_test_play(4) != 0) || (gs_table.entry[4].count != 0xFFFF) ||
+        (gs_table.entry[4].mean_ms <= 100.0f))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: saturation check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: count saturates at %d and the mean still moves.\n", 0xFFFF);
+    
+    /* invalid records */
+    gs_buf[3] = 0xE1;
+    gs_pos = 0;
+    res = wt588e02b_duration_load(&gs_handle, a_wt588e02b_duration_test_read);
+    if (res != 4)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: record number check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_buf[3] = 0xE0;
+    gs_buf[4 + 11 * 0xDF] = 0xE0;
+    gs_pos = 0;
+    res = wt588e02b_duration_load(&gs_handle, a_wt588e02b_duration_test_read);
+    if (res != 4)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: record index check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_buf[2] = 0x01;
+    gs_pos = 0;
+    res = wt588e02b_duration_load(&gs_handle, a_wt588e02b_duration_test_read);
+    if (res != 4)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: record version check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: too many records, an index > 0xDF and an old version are refused.\n");
+    
+    /* null buffers and hooks */
+    if ((wt588e02b_estimate_duration(&gs_handle, 4, NULL, &var) != 2) ||
+        (wt588e02b_estimate_duration(&gs_handle, 4, &ms, NULL) != 2) ||
+        (wt588e02b_duration_save(&gs_handle, NULL) != 2) ||
+        (wt588e02b_duration_load(&gs_handle, NULL) != 2))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: null pointer check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: null buffers and hooks are refused.\n");
+    
+    /* deinit */
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    /* finish duration test */
+    wt588e02b_interface_debug_print("wt588e02b: finish duration test.\n");
+    
+    return 0;
+#else
+    (void)gs_handle;
+    wt588e02b_interface_debug_print("wt588e02b: duration profiler is compiled out.\n");
+    
+    return 0;
+#endif
+}
@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_image_test.c
+ * @brief     driver wt588e02b image test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_image_test.h"
+
+static uint8_t gs_buf[WT588E02B_IMAGE_TEST_MAX_SIZE];        /**< image buffer */
+
+/**
+ * @brief     check a damaged image is refused
+ * @param[in] addr damaged byte address
+ * @param[in] value damaged byte value
+ * @param[in] size image size
+ * @param[in] expect expected status code
+ * @param[in] *name pointer to a check name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the byte is restored before returning
+ */
+static uint8_t a_image_check(uint32_t addr, uint8_t value, uint32_t size, uint8_t expect, const char *name)
+{
+    uint8_t res;
+    uint8_t saved;
+    wt588e02b_image_t image;
+    
+    /* damage the byte */
+    saved = gs_buf[addr];
+    gs_buf[addr] = value;
+    
+    /* open */
+    res = wt588e02b_image_open(&image, gs_buf, size);
+    gs_buf[addr] = saved;
+    if (res != expect)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: %s check failed, got %d expect %d.\n", name, res, expect);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: %s check ok.\n", name);
+    
+    return 0;
+}
+
+/**
+ * @brief     image test
+ * @param[in] *path pointer to a path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the image is only parsed, the chip is not touched
+ */
+uint8_t wt588e02b_image_test(char *path)
+{
+    uint8_t res;
+    uint8_t len;
+    uint8_t i;
+    uint8_t ind[255];
+    uint16_t n;
+    uint32_t size;
+    uint32_t addr;
+    uint32_t blocks;
+    wt588e02b_image_t image;
+    wt588e02b_image_voice_t voice;
+    
+    /* start image test */
+    wt588e02b_interface_debug_print("wt588e02b: start image test.\n");
+    
+    /* load the image */
+    res = wt588e02b_interface_bin_read_init(path, &size);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: bin read init failed.\n");
+        
+        return 1;
+    }
+    if (size > WT588E02B_IMAGE_TEST_MAX_SIZE)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: image is larger than %d bytes.\n", WT588E02B_IMAGE_TEST_MAX_SIZE);
+        (void)wt588e02b_interface_bin_read_deinit();
+        
+        return 1;
+    }
+    for (addr = 0; addr < size; addr += 512)
+    {
+        res = wt588e02b_interface_bin_read(addr, (uint16_t)((size - addr > 512) ? 512 : (size - addr)), &gs_buf[addr]);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: bin read failed.\n");
+            (void)wt588e02b_interface_bin_read_deinit();
+            
+            return 1;
+        }
+    }
+    (void)wt588e02b_interface_bin_read_deinit();
+    
+    /* open the image */
+    res = wt588e02b_image_open(&image, gs_buf, size);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: image open failed %d.\n", res);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: version is %s.\n", image.version);
+    wt588e02b_interface_debug_print("wt588e02b: size is %d bytes.\n", image.size);
+    wt588e02b_interface_debug_print("wt588e02b: voice number is %d.\n", image.voice_count);
+    wt588e02b_interface_debug_print("wt588e02b: list number is %d.\n", image.list_count);
+    
+    /* print the voice table */
+    blocks = 0;
+    for (n = 0; n < image.voice_count; n++)
+    {
+        res = wt588e02b_image_get_voice(&image, n, &voice);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: image get voice failed.\n");
+            
+            return 1;
+        }
+        wt588e02b_interface_debug_print("wt588e02b: voice %d offset 0x%06X length %d format %s blocks %d-%d.\n",
+                                        voice.index, voice.offset, voice.length,
+                                        (voice.format == WT588E02B_IMAGE_FORMAT_T3Z) ? "t3z" : "unknown",
+                                        voice.first_block, voice.first_block + voice.block_count - 1);
+        blocks += voice.block_count;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: voices use %d of %d blocks.\n", blocks, (size + 511) / 512);
+    
+    /* print the lists */
+    for (n = 0; n < image.list_count; n++)
+    {
+        len = sizeof(ind);
+        res = wt588e02b_image_get_list(&image, n, ind, &len);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: image get list failed.\n");
+            
+            return 1;
+        }
+        wt588e02b_interface_debug_print("wt588e02b: list %d has %d voices", n, len);
+        for (i = 0; i < len; i++)
+        {
+            wt588e02b_interface_debug_print(" %d", ind[i]);
+        }
+        wt588e02b_interface_debug_print(".\n");
+    }
+    
+    /* check the index range */
+    if (wt588e02b_image_get_voice(&image, image.voice_count, &voice) != 4)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: voice range check failed.\n");
+        
+        return 1;
+    }
+    
+    /* check damaged images are refused */
+    if (a_image_check(0x50, 'l', size, 1, "tag") != 0)
+    {
+        return 1;
+    }
+    if (a_image_check(0, gs_buf[0], size - 1, 5, "size") != 0)
+    {
+        return 1;
+    }
+    if (a_image_check(0, gs_buf[0], 0x10, 4, "header") != 0)
+    {
+        return 1;
+    }
+    if (image.voice_count > 1)
+    {
+        addr = image.voice_table + 7;
+        if (a_image_check(addr, 0xFF, size, 6, "voice table") != 0)
+        {
+            return 1;
+        }
+    }
+    if (image.list_count > 0)
+    {
+        addr = gs_buf[image.list_table] | ((uint32_t)gs_buf[image.list_table + 1] << 8) |
+               ((uint32_t)gs_buf[image.list_table + 2] << 16) | ((uint32_t)gs_buf[image.list_table + 3] << 24);
+        if (a_image_check(addr + 1, 0x7F, size, 7, "list table") != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* finish image test */
+    wt588e02b_interface_debug_print("wt588e02b: finish image test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,368 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_latency_test.c
+ * @brief     driver wt588e02b latency test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_latency_test.h"
+#include "driver_wt588e02b_mock.h"
+#include <stdlib.h>
+
+/**
+ * @brief latency test definition
+ */
+#define WT588E02B_LATENCY_POLL_US             100           /**< busy poll interval */
+#define WT588E02B_LATENCY_TIMEOUT_US          2000000       /**< busy edge timeout */
+#define WT588E02B_LATENCY_MOCK_PLAY_US        15000         /**< mock play response */
+#define WT588E02B_LATENCY_MOCK_STOP_US        3000          /**< mock stop response */
+#define WT588E02B_LATENCY_MOCK_JITTER_US      2000          /**< mock jitter */
+#define WT588E02B_LATENCY_MOCK_CLIP_US        200000        /**< mock clip length */
+
+static wt588e02b_handle_t gs_handle;                                        /**< wt588e02b handle */
+
+/**
+ * @brief wt588e02b ops table, it is const and lives in flash
+ */
+static const wt588e02b_ops_t gs_ops =
+{
+    .sclk_gpio_init = wt588e02b_interface_sclk_gpio_init,
+    .sclk_gpio_deinit = wt588e02b_interface_sclk_gpio_deinit,
+    .sclk_gpio_write = wt588e02b_interface_sclk_gpio_write,
+    .mosi_gpio_init = wt588e02b_interface_mosi_gpio_init,
+    .mosi_gpio_deinit = wt588e02b_interface_mosi_gpio_deinit,
+    .mosi_gpio_write = wt588e02b_interface_mosi_gpio_write,
+    .miso_gpio_init = wt588e02b_interface_miso_gpio_init,
+    .miso_gpio_deinit = wt588e02b_interface_miso_gpio_deinit,
+    .miso_gpio_read = wt588e02b_interface_miso_gpio_read,
+    .cs_gpio_init = wt588e02b_interface_cs_gpio_init,
+    .cs_gpio_deinit = wt588e02b_interface_cs_gpio_deinit,
+    .cs_gpio_write = wt588e02b_interface_cs_gpio_write,
+    .bin_read_init = wt588e02b_interface_bin_read_init,
+    .bin_read = wt588e02b_interface_bin_read,
+    .bin_read_deinit = wt588e02b_interface_bin_read_deinit,
+    .delay_ms = wt588e02b_interface_delay_ms,
+    .delay_us = wt588e02b_interface_delay_us,
+    .debug_print = wt588e02b_interface_debug_print,
+    .timestamp_ms = wt588e02b_interface_timestamp_ms,
+    .lock = wt588e02b_interface_lock,
+    .unlock = wt588e02b_interface_unlock,
+};
+static uint32_t gs_play[WT588E02B_LATENCY_TEST_MAX_TIMES];                  /**< play samples */
+static uint32_t gs_stop[WT588E02B_LATENCY_TEST_MAX_TIMES];                  /**< stop samples */
+static uint32_t (*gs_timestamp_us)(void);                                   /**< us clock */
+
+/**
+ * @brief     sample compare
+ * @param[in] *a pointer to the first sample
+ * @param[in] *b pointer to the second sample
+ * @return    compare result
+ * @note      none
+ */
+static int a_wt588e02b_latency_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     sample percentile
+ * @param[in] *buf pointer to a sorted sample buffer
+ * @param[in] len buffer length
+ * @param[in] p percentile
+ * @return    sample value
+ * @note      nearest rank
+ */
+static uint32_t a_wt588e02b_latency_percentile(uint32_t *buf, uint32_t len, uint32_t p)
+{
+    uint32_t rank;
+    
+    rank = (p * len + 99) / 100;        /* ceil */
+    if (rank == 0)                      /* check rank */
+    {
+        rank = 1;                       /* first */
+    }
+    
+    return buf[rank - 1];
+}
+
+/**
+ * @brief      wait busy level
+ * @param[in]  level wanted busy level
+ * @param[out] *t pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ * @note       none
+ */
+static uint8_t a_wt588e02b_latency_wait(wt588e02b_bool_t level, uint32_t *t)
+{
+    uint8_t res;
+    uint32_t start;
+    wt588e02b_bool_t enable;
+    
+    start = gs_timestamp_us();
+    while (1)
+    {
+        res = wt588e02b_check_busy(&gs_handle, &enable);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: check busy failed.\n");
+            
+            return 1;
+        }
+        *t = gs_timestamp_us();
+        if (enable == level)
+        {
+            return 0;
+        }
+        if (*t - start > WT588E02B_LATENCY_TIMEOUT_US)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: wait busy timeout.\n");
+            
+            return 1;
+        }
+        gs_handle.ops->delay_us(WT588E02B_LATENCY_POLL_US);
+    }
+}
+
+/**
+ * @brief     print one metric
+ * @param[in] *name pointer to a metric name
+ * @param[in] *buf pointer to a sample buffer
+ * @param[in] len buffer length
+ * @param[in] format output format
+ * @param[in] last last metric flag
+ * @note      none
+ */
+static void a_wt588e02b_latency_print(const char *name, uint32_t *buf, uint32_t len,
+                                      wt588e02b_latency_format_t format, uint8_t last)
+{
+    qsort(buf, len, sizeof(uint32_t), a_wt588e02b_latency_compare);
+    if (format == WT588E02B_LATENCY_FORMAT_JSON)
+    {
+        wt588e02b_interface_debug_print("\"%s\":{\"count\":%u,\"min_us\":%u,\"p50_us\":%u,\"p95_us\":%u,\"p99_us\":%u,\"max_us\":%u}%s\n",
+                                        name, (unsigned int)len, (unsigned int)buf[0],
+                                        (unsigned int)a_wt588e02b_latency_percentile(buf, len, 50),
+                                        (unsigned int)a_wt588e02b_latency_percentile(buf, len, 95),
+                                        (unsigned int)a_wt588e02b_latency_percentile(buf, len, 99),
+                                        (unsigned int)buf[len - 1], (last != 0) ? "" : ",");
+    }
+    else
+    {
+        wt588e02b_interface_debug_print("%s,%u,%u,%u,%u,%u,%u\n",
+                                        name, (unsigned int)len, (unsigned int)buf[0],
+                                        (unsigned int)a_wt588e02b_latency_percentile(buf, len, 50),
+                                        (unsigned int)a_wt588e02b_latency_percentile(buf, len, 95),
+                                        (unsigned int)a_wt588e02b_latency_percentile(buf, len, 99),
+                                        (unsigned int)buf[len - 1]);
+    }
+}
+
+/**
+ * @brief     latency test
+ * @param[in] ind index
+ * @param[in] times test times
+ * @param[in] format output format
+ * @param[in] *timestamp_us pointer to a us clock function, NULL means the mock chip
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      measures play to busy and stop to idle from the api call,
+ *            the mock chip runs on a virtual clock and checks the result against its model
+ */
+uint8_t wt588e02b_latency_test(uint8_t ind, uint32_t times, wt588e02b_latency_format_t format,
+                               uint32_t (*timestamp_us)(void))
+{
+    uint8_t res;
+    uint8_t mock;
+    uint32_t i;
+    uint32_t t_call;
+    uint32_t t_ret;
+    uint32_t t_edge;
+    uint32_t bad;
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+    
+    /* check times */
+    if ((times == 0) || (times > WT588E02B_LATENCY_TEST_MAX_TIMES))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: times is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link driver */
+    mock = (timestamp_us == NULL) ? 1 : 0;
+    if (mock != 0)
+    {
+        config.play_response_us = WT588E02B_LATENCY_MOCK_PLAY_US;
+        config.stop_response_us = WT588E02B_LATENCY_MOCK_STOP_US;
+        config.jitter_us = WT588E02B_LATENCY_MOCK_JITTER_US;
+        config.clip_us = WT588E02B_LATENCY_MOCK_CLIP_US;
+        wt588e02b_mock_init(&config);
+        wt588e02b_mock_link(&gs_handle);
+        gs_timestamp_us = wt588e02b_mock_timestamp_us;
+    }
+    else
+    {
+        DRIVER_WT588E02B_LINK_INIT(&gs_handle, wt588e02b_handle_t);
+        DRIVER_WT588E02B_LINK_OPS(&gs_handle, &gs_ops);
+        gs_timestamp_us = timestamp_us;
+    }
+    
+    /* start latency test */
+    wt588e02b_interface_debug_print("wt588e02b: start latency test.\n");
+    
+    /* init */
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* stop and wait idle */
+    res = wt588e02b_stop(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: stop failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = a_wt588e02b_latency_wait(WT588E02B_BOOL_FALSE, &t_edge);
+    if (res != 0)
+    {
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    bad = 0;
+    for (i = 0; i < times; i++)
+    {
+        /* play to busy */
+        t_call = gs_timestamp_us();
+        res = wt588e02b_play(&gs_handle, ind);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: play failed.\n");
+            (void)wt588e02b_stop(&gs_handle);
+            (void)wt588e02b_deinit(&gs_handle);
+            
+            return 1;
+        }
+        t_ret = gs_timestamp_us();
+        res = a_wt588e02b_latency_wait(WT588E02B_BOOL_TRUE, &t_edge);
+        if (res != 0)
+        {
+            (void)wt588e02b_stop(&gs_handle);
+            (void)wt588e02b_deinit(&gs_handle);
+            
+            return 1;
+        }
+        gs_play[i] = t_edge - t_call;
+        if ((mock != 0) &&
+            ((t_edge - t_ret < WT588E02B_LATENCY_MOCK_PLAY_US) ||
+             (t_edge - t_ret > WT588E02B_LATENCY_MOCK_PLAY_US + WT588E02B_LATENCY_MOCK_JITTER_US + WT588E02B_LATENCY_POLL_US)))
+        {
+            bad++;
+        }
+        
+        /* stop to idle */
+        t_call = gs_timestamp_us();
+        res = wt588e02b_stop(&gs_handle);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: stop failed.\n");
+            (void)wt588e02b_deinit(&gs_handle);
+            
+            return 1;
+        }
+        t_ret = gs_timestamp_us();
+        res = a_wt588e02b_latency_wait(WT588E02B_BOOL_FALSE, &t_edge);
+        if (res != 0)
+        {
+            (void)wt588e02b_deinit(&gs_handle);
+            
+            return 1;
+        }
+        gs_stop[i] = t_edge - t_call;
+        if ((mock != 0) &&
+            ((t_edge - t_ret < WT588E02B_LATENCY_MOCK_STOP_US) ||
+             (t_edge - t_ret > WT588E02B_LATENCY_MOCK_STOP_US + WT588E02B_LATENCY_MOCK_JITTER_US + WT588E02B_LATENCY_POLL_US)))
+        {
+            bad++;
+        }
+    }
+    
+    /* print the result */
+    if (format == WT588E02B_LATENCY_FORMAT_JSON)
+    {
+        wt588e02b_interface_debug_print("{\"mock\":%s,\"ind\":%d,\"poll_us\":%d,\n", (mock != 0) ? "true" : "false",
+                                        ind, WT588E02B_LATENCY_POLL_US);
+        a_wt588e02b_latency_print("play", gs_play, times, format, 0);
+        a_wt588e02b_latency_print("stop", gs_stop, times, format, 1);
+        wt588e02b_interface_debug_print("}\n");
+    }
+    else
+    {
+        wt588e02b_interface_debug_print("metric,count,min_us,p50_us,p95_us,p99_us,max_us\n");
+        a_wt588e02b_latency_print("play", gs_play, times, format, 0);
+        a_wt588e02b_latency_print("stop", gs_stop, times, format, 1);
+    }
+    
+    /* check the mock model */
+    if (mock != 0)
+    {
+        wt588e02b_mock_get_state(&state);
+        if ((bad != 0) || (state.errors != 0) || (state.frames != times * 2 + 1))
+        {
+            wt588e02b_interface_debug_print("wt588e02b: mock check failed, %u bad samples, %u protocol errors, %u frames.\n",
+                                            (unsigned int)bad, (unsigned int)state.errors, (unsigned int)state.frames);
+            (void)wt588e02b_deinit(&gs_handle);
+            
+            return 1;
+        }
+        wt588e02b_interface_debug_print("wt588e02b: mock model check passed.\n");
+    }
+    
+    /* finish latency test */
+    wt588e02b_interface_debug_print("wt588e02b: finish latency test.\n");
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    return 0;
+}
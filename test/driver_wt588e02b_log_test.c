@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_log_test.c
+ * @brief     driver wt588e02b log test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_wt588e02b_log_test.h"
+#include "driver_wt588e02b_mock.h"
+
+static wt588e02b_handle_t gs_handle;                                          /**< wt588e02b handle */
+static wt588e02b_ops_t gs_ops;                                                /**< mock ops with a counting print */
+static wt588e02b_log_t gs_log;                                                /**< deferred log ring */
+static wt588e02b_log_record_t gs_record[WT588E02B_LOG_SIZE];                  /**< record buffer */
+static volatile uint32_t gs_print;                                            /**< debug_print calls */
+static uint32_t (*gs_clock)(void);                                            /**< mock record clock */
+static volatile uint8_t gs_nest;                                              /**< nested writer armed */
+static volatile uint16_t gs_nest_len;                                         /**< records read inside the writer */
+
+/**
+ * @brief     counting debug print
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_wt588e02b_log_print(const char *const fmt, ...)
+{
+    (void)fmt;
+    
+    gs_print++;
+}
+
+/**
+ * @brief  nesting record clock
+ * @return virtual time in ms
+ * @note   the clock is read between the slot reservation and the commit, so an armed call
+ *         logs and reads the ring there like an interrupt that preempts the writer
+ */
+static uint32_t a_wt588e02b_log_timestamp_ms(void)
+{
+    uint16_t len;
+    uint32_t lost;
+    
+    if (gs_nest != 0)
+    {
+        gs_nest = 0;
+        (void)wt588e02b_play(&gs_handle, 0xE0);
+        len = WT588E02B_LOG_SIZE;
+        (void)wt588e02b_log_read(&gs_handle, gs_record, &len, &lost);
+        gs_nest_len = len;
+    }
+    
+    return gs_clock();
+}
+
+/**
+ * @brief  log test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs on the mock chip, checks that a logged error costs no debug_print call,
+ *         that a full ring counts the dropped records, that a writer preempted inside its slot
+ *         by another writer loses no record and prints the records for wt588e02b-log
+ */
+uint8_t wt588e02b_log_test(void)
+{
+    uint8_t res;
+    uint8_t list[2];
+    uint16_t len;
+    uint16_t i;
+    uint32_t lost;
+    wt588e02b_mock_config_t config;
+    
+    /* link driver */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = 200000;
+    wt588e02b_mock_init(&config);
+    wt588e02b_mock_link(&gs_handle);
+    gs_ops = *gs_handle.ops;
+    gs_ops.debug_print = a_wt588e02b_log_print;
+    gs_clock = gs_ops.timestamp_ms;
+    gs_ops.timestamp_ms = a_wt588e02b_log_timestamp_ms;
+    DRIVER_WT588E02B_LINK_OPS(&gs_handle, &gs_ops);
+    
+    /* start log test */
+    wt588e02b_interface_debug_print("wt588e02b: start log test.\n");
+    
+    /* check the log level */
+    if (WT588E02B_LOG_LEVEL < WT588E02B_LOG_LEVEL_ERROR)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: log sites are compiled out.\n");
+        wt588e02b_interface_debug_print("wt588e02b: finish log test.\n");
+        
+        return 0;
+    }
+    
+    /* init */
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* no ring prints */
+    gs_print = 0;
+    res = wt588e02b_set_vol(&gs_handle, 0x40);
+    if ((res != 4) || (gs_print != 1))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: disabled log check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: disabled log check passed.\n");
+    
+    /* the ring records */
+    res = wt588e02b_set_log(&gs_handle, &gs_log);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: set log failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_print = 0;
+    list[0] = 0x01;
+    list[1] = 0xE5;
+    if ((wt588e02b_play(&gs_handle, 0xE0) != 4) ||
+        (wt588e02b_set_vol(&gs_handle, 0x40) != 4) ||
+        (wt588e02b_play_list(&gs_handle, list, 2) != 5))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: invalid call check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    len = WT588E02B_LOG_SIZE;
+    res = wt588e02b_log_read(&gs_handle, gs_record, &len, &lost);
+    if ((res != 0) || (len != 3) || (lost != 0) || (gs_print != 0) ||
+        (gs_record[0].level != WT588E02B_LOG_LEVEL_ERROR) || (gs_record[2].arg != 1) ||
+        (gs_record[0].id != WT588E02B_LOG_MSG_IND_INVALID) || (gs_record[0].id != 23) ||
+        (gs_record[1].id != WT588E02B_LOG_MSG_VOL_INVALID) || (gs_record[1].id != 25) ||
+        (gs_record[2].id != WT588E02B_LOG_MSG_LIST_IND_INVALID) || (gs_record[2].id != 21))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: enabled log check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        wt588e02b_interface_debug_print("wt588e02b-log: %04X %02X %08X %08X\n",
+                                        gs_record[i].id, gs_record[i].level,
+                                        (unsigned int)gs_record[i].arg, (unsigned int)gs_record[i].ms);
+    }
+    wt588e02b_interface_debug_print("wt588e02b: enabled log check passed.\n");
+    
+    /* the full ring drops */
+    for (i = 0; i < WT588E02B_LOG_SIZE + 4; i++)
+    {
+        (void)wt588e02b_set_vol(&gs_handle, 0x40);
+    }
+    len = WT588E02B_LOG_SIZE;
+    res = wt588e02b_log_read(&gs_handle, gs_record, &len, &lost);
+    if ((res != 0) || (len != WT588E02B_LOG_SIZE) || (lost != 4) || (gs_print != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: full log check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    len = WT588E02B_LOG_SIZE;
+    res = wt588e02b_log_read(&gs_handle, gs_record, &len, &lost);
+    if ((res != 0) || (len != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: empty log check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: full log check passed with %d lost.\n", (int)lost);
+    
+    /* a second writer inside the slot of the first */
+    gs_nest = 1;
+    gs_nest_len = 0xFFFF;
+    (void)wt588e02b_set_vol(&gs_handle, 0x40);
+    len = WT588E02B_LOG_SIZE;
+    res = wt588e02b_log_read(&gs_handle, gs_record, &len, &lost);
+    if ((res != 0) || (gs_nest != 0) || (gs_nest_len != 0) || (len != 2) || (lost != 4) ||
+        (gs_record[0].id != WT588E02B_LOG_MSG_VOL_INVALID) || (gs_record[1].id != WT588E02B_LOG_MSG_IND_INVALID))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: nested writer check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: nested writer kept both records in reservation order.\n");
+    
+    /* finish log test */
+    (void)wt588e02b_set_log(&gs_handle, NULL);
+    (void)wt588e02b_deinit(&gs_handle);
+    wt588e02b_interface_debug_print("wt588e02b: finish log test.\n");
+    
+    return 0;
+}
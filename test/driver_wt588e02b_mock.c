@@ -0,0 +1,779 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_mock.c
+ * @brief     driver wt588e02b mock source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_mock.h"
+#include <string.h>
+
+/**
+ * @brief mock definition
+ */
+#define WT588E02B_MOCK_MAX_FRAME          520           /**< max frame length */
+#define WT588E02B_MOCK_PACK_SIZE          512           /**< update pack size */
+#define WT588E02B_MOCK_COMMAND_LEAD_US    1000          /**< min cs to first clock time of a command frame */
+#define WT588E02B_MOCK_FOREVER            0xFFFFFFFFFFFFFFFFULL        /**< never ends */
+
+/**
+ * @brief mock chip structure definition
+ * @note  every chip on the bus has its own cs, miso and decoder
+ */
+typedef struct wt588e02b_mock_chip_s
+{
+    wt588e02b_mock_state_t state;                          /**< chip model state */
+    uint64_t busy_start;                                   /**< busy start time */
+    uint64_t busy_end;                                     /**< busy end time */
+    uint64_t cs_low_us;                                    /**< cs falling time */
+    uint32_t corrupt;                                      /**< first packet with a wrong sum, 0 means never */
+    uint8_t cs;                                            /**< cs level */
+    uint8_t out;                                           /**< status bit level */
+    uint8_t out_enable;                                    /**< status bit valid */
+    uint8_t packet;                                        /**< frame is a data packet */
+    uint8_t frame[WT588E02B_MOCK_MAX_FRAME];               /**< frame buffer */
+    uint16_t frame_len;                                    /**< frame length */
+    uint8_t bit;                                           /**< bit index in the byte */
+    uint8_t overflow;                                      /**< frame overflow flag */
+} wt588e02b_mock_chip_t;
+
+static wt588e02b_mock_config_t gs_config;                          /**< chip model config */
+static wt588e02b_mock_chip_t gs_chip[WT588E02B_MOCK_MAX_CHIP];     /**< chips on the bus */
+static uint64_t gs_now_us;                                         /**< virtual clock */
+static uint32_t gs_seed;                                           /**< jitter seed */
+static uint8_t gs_sclk;                                            /**< shared sclk level */
+static uint8_t gs_mosi;                                            /**< shared mosi level */
+static uint32_t gs_cs_fault;                                       /**< cs writes of chip 0 until one fails */
+#if ((WT588E02B_HANDLE_LINK == 0) && (WT588E02B_FEATURE_UPDATE != 0))
+static uint8_t gs_buf[512];                                        /**< update buffer shared by the linked handles */
+#endif
+
+/**
+ * @brief  mock jitter
+ * @return random extra time in us
+ * @note   fixed seed so that every run is reproducible
+ */
+static uint32_t a_wt588e02b_mock_jitter(void)
+{
+    if (gs_config.jitter_us == 0)                              /* check jitter */
+    {
+        return 0;                                              /* no jitter */
+    }
+    gs_seed = gs_seed * 1103515245U + 12345U;                  /* lcg step */
+    
+    return (gs_seed >> 8) % (gs_config.jitter_us + 1);         /* return jitter */
+}
+
+/**
+ * @brief     mock is busy
+ * @param[in] *chip pointer to a mock chip structure
+ * @return    busy level
+ * @note      none
+ */
+static uint8_t a_wt588e02b_mock_is_busy(const wt588e02b_mock_chip_t *chip)
+{
+    if ((gs_now_us >= chip->busy_start) && (gs_now_us < chip->busy_end))  /* check window */
+    {
+        return 1;                                                         /* busy */
+    }
+    
+    return 0;                                                             /* idle */
+}
+
+/**
+ * @brief     mock start playing
+ * @param[in] *chip pointer to a mock chip structure
+ * @param[in] clips clip number, 0 means forever
+ * @note      none
+ */
+static void a_wt588e02b_mock_start(wt588e02b_mock_chip_t *chip, uint32_t clips)
+{
+    chip->busy_start = gs_now_us + gs_config.play_response_us + a_wt588e02b_mock_jitter();     /* set start */
+    if (clips == 0)                                                                            /* check forever */
+    {
+        chip->busy_end = WT588E02B_MOCK_FOREVER;                                               /* loop */
+    }
+    else
+    {
+        chip->busy_end = chip->busy_start + (uint64_t)gs_config.clip_us * clips;               /* set end */
+    }
+}
+
+/**
+ * @brief     mock stop playing
+ * @param[in] *chip pointer to a mock chip structure
+ * @note      none
+ */
+static void a_wt588e02b_mock_stop(wt588e02b_mock_chip_t *chip)
+{
+    uint64_t t;
+    
+    t = gs_now_us + gs_config.stop_response_us + a_wt588e02b_mock_jitter();        /* stop time */
+    if (t < chip->busy_end)                                                        /* check end */
+    {
+        chip->busy_end = t;                                                        /* set end */
+    }
+    if (chip->busy_start > chip->busy_end)                                         /* not started yet */
+    {
+        chip->busy_start = chip->busy_end;                                         /* cancel */
+    }
+}
+
+/**
+ * @brief     mock decode a command frame
+ * @param[in] *chip pointer to a mock chip structure
+ * @note      none
+ */
+static void a_wt588e02b_mock_command(wt588e02b_mock_chip_t *chip)
+{
+    uint16_t i;
+    uint16_t len;
+    const uint8_t *frame;
+    wt588e02b_mock_state_t *state;
+    
+    len = chip->frame_len;                                                          /* get length */
+    frame = chip->frame;                                                            /* get frame */
+    state = &chip->state;                                                           /* get state */
+    state->command = frame[0];                                                      /* save command */
+    switch (frame[0])
+    {
+        case 0xF0 :                                                                 /* play */
+        {
+            if ((len != 2) || (frame[1] > 0xDF))                                    /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            state->ind = frame[1];                                                  /* save ind */
+            a_wt588e02b_mock_start(chip, 1);                                        /* start */
+            
+            break;
+        }
+        case 0xF1 :                                                                 /* vol */
+        {
+            if ((len != 2) || (frame[1] > 0x3F))                                    /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            state->vol = frame[1];                                                  /* save vol */
+            
+            break;
+        }
+        case 0xF2 :                                                                 /* loop */
+        {
+            if ((len < 2) || (frame[1] < 0x01) || (frame[1] > 0x03) ||
+                ((frame[1] != 0x03) && (len != 3)) ||
+                ((frame[1] == 0x03) && (len != 2)))                                 /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            state->loop_mode = frame[1];                                            /* save mode */
+            if (len == 3)                                                           /* check ind */
+            {
+                state->ind = frame[2];                                              /* save ind */
+            }
+            a_wt588e02b_mock_start(chip, 0);                                        /* start */
+            
+            break;
+        }
+        case 0xF3 :                                                                 /* list */
+        {
+            if ((len < 2) || (len > 41))                                            /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            for (i = 1; i < len; i++)                                               /* check all */
+            {
+                if (frame[i] > 0xDF)                                                /* check ind */
+                {
+                    state->errors++;                                                /* error */
+                    
+                    return;
+                }
+            }
+            state->list_len = (uint8_t)(len - 1);                                   /* save length */
+            memcpy(state->list, &frame[1], state->list_len);                        /* save list */
+            state->ind = frame[1];                                                  /* save ind */
+            a_wt588e02b_mock_start(chip, state->list_len);                          /* start */
+            
+            break;
+        }
+        case 0xFF :                                                                 /* stop */
+        {
+            if ((len != 2) || (frame[1] != 0xEF))                                   /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            state->loop_mode = 0;                                                   /* clear loop */
+            a_wt588e02b_mock_stop(chip);                                            /* stop */
+            
+            break;
+        }
+        case 0xE0 :                                                                 /* update address */
+        case 0xE1 :                                                                 /* update all */
+        {
+            if ((len != 2) || ((frame[0] == 0xE1) && (frame[1] != 0xFF)))           /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            state->sum = (uint16_t)(frame[0] + frame[1]);                           /* byte sum */
+            
+            break;
+        }
+        case 0xDF :                                                                 /* status */
+        {
+            if (len != 3)                                                           /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            
+            break;
+        }
+        case 0xEF :                                                                 /* update end */
+        {
+            if (len != 1)                                                           /* check frame */
+            {
+                state->errors++;                                                    /* error */
+                
+                return;
+            }
+            
+            break;
+        }
+        default :
+        {
+            state->errors++;                                                        /* unknown command */
+            
+            return;
+        }
+    }
+    state->frames++;                                                                /* frame done */
+}
+
+/**
+ * @brief     mock decode a data packet
+ * @param[in] *chip pointer to a mock chip structure
+ * @note      a corrupt chip reports a wrong sum from its corrupt packet on
+ */
+static void a_wt588e02b_mock_packet(wt588e02b_mock_chip_t *chip)
+{
+    uint16_t i;
+    uint16_t sum;
+    
+    if (chip->frame_len != WT588E02B_MOCK_PACK_SIZE)                                    /* check length */
+    {
+        chip->state.errors++;                                                           /* error */
+        
+        return;
+    }
+    sum = 0;                                                                            /* init 0 */
+    for (i = 0; i < WT588E02B_MOCK_PACK_SIZE; i += 2)                                   /* word sum */
+    {
+        sum = (uint16_t)(sum + (uint16_t)(chip->frame[i] | ((uint16_t)chip->frame[i + 1] << 8)));
+    }
+    chip->state.packets++;                                                              /* packet done */
+    if ((chip->corrupt != 0) && (chip->state.packets >= chip->corrupt))                 /* check corrupt */
+    {
+        sum ^= 0x5A5A;                                                                  /* flash write error */
+    }
+    chip->state.sum = sum;                                                              /* save sum */
+}
+
+/**
+ * @brief     mock clock one bit into a chip
+ * @param[in] *chip pointer to a mock chip structure
+ * @note      called on a rising sclk edge while the chip cs is low
+ */
+static void a_wt588e02b_mock_clock(wt588e02b_mock_chip_t *chip)
+{
+    uint16_t len;
+    uint16_t idx;
+    uint8_t byte;
+    
+    if ((chip->frame_len == 0) && (chip->bit == 0))                                          /* first clock */
+    {
+        chip->packet = (gs_now_us - chip->cs_low_us < WT588E02B_MOCK_COMMAND_LEAD_US) ? 1 : 0; /* check lead time */
+    }
+    if ((chip->packet == 0) && (chip->frame_len >= 1) && (chip->frame[0] == 0xDF))           /* status read */
+    {
+        idx = (uint16_t)((chip->frame_len - 1) * 8 + chip->bit);                             /* out bit index */
+        byte = (idx < 8) ? (uint8_t)(chip->state.sum & 0xFF) :
+                           (uint8_t)(chip->state.sum >> 8);                                  /* lsb byte first */
+        chip->out = (byte >> (7 - (idx % 8))) & 0x01;                                        /* msb bit first */
+        chip->out_enable = 1;                                                                /* status valid */
+    }
+    len = chip->frame_len;                                                                   /* one read, unserialized callers */
+    if (len < WT588E02B_MOCK_MAX_FRAME)                                                      /* check length */
+    {
+        if (chip->bit == 0)                                                                  /* new byte */
+        {
+            chip->frame[len] = 0;                                                            /* init 0 */
+        }
+        chip->frame[len] = (uint8_t)((chip->frame[len] << 1) | gs_mosi);                     /* shift in */
+        chip->bit++;                                                                         /* next bit */
+        if (chip->bit >= 8)                                                                  /* byte done */
+        {
+            chip->bit = 0;                                                                   /* reset */
+            chip->frame_len = (uint16_t)(len + 1);                                           /* next byte */
+        }
+    }
+    else
+    {
+        chip->overflow = 1;                                                                  /* overflow */
+    }
+}
+
+/**
+ * @brief     mock chip cs write
+ * @param[in] *chip pointer to a mock chip structure
+ * @param[in] data written data
+ * @note      a rising edge ends and decodes the frame
+ */
+static void a_wt588e02b_mock_cs(wt588e02b_mock_chip_t *chip, uint8_t data)
+{
+    data = (data != 0) ? 1 : 0;                                   /* normalize */
+    if ((chip->cs == 1) && (data == 0))                           /* falling edge */
+    {
+        chip->cs_low_us = gs_now_us;                              /* save time */
+        chip->frame_len = 0;                                      /* new frame */
+        chip->bit = 0;                                            /* new byte */
+        chip->overflow = 0;                                       /* clear overflow */
+        chip->out_enable = 0;                                     /* no status */
+    }
+    else if ((chip->cs == 0) && (data == 1))                      /* rising edge */
+    {
+        chip->out_enable = 0;                                     /* no status */
+        if ((chip->bit != 0) || (chip->overflow != 0))            /* check bits */
+        {
+            chip->state.errors++;                                 /* broken frame */
+        }
+        else if (chip->frame_len != 0)                            /* check length */
+        {
+            if (chip->packet != 0)                                /* data packet */
+            {
+                a_wt588e02b_mock_packet(chip);                    /* decode packet */
+            }
+            else
+            {
+                a_wt588e02b_mock_command(chip);                   /* decode command */
+            }
+        }
+    }
+    else if ((chip->cs == 0) && (data == 0))                      /* cs low twice */
+    {
+        chip->state.errors++;                                     /* error */
+    }
+    else
+    {
+        
+    }
+    chip->cs = data;                                              /* save level */
+}
+
+/**
+ * @brief     mock chip miso read
+ * @param[in] *chip pointer to a mock chip structure
+ * @return    miso level
+ * @note      low means busy outside a status frame
+ */
+static uint8_t a_wt588e02b_mock_miso(const wt588e02b_mock_chip_t *chip)
+{
+    if ((chip->cs == 0) && (chip->out_enable != 0))               /* status frame */
+    {
+        return chip->out;                                         /* status bit */
+    }
+    
+    return a_wt588e02b_mock_is_busy(chip) ? 0 : 1;                /* low is busy */
+}
+
+void wt588e02b_mock_init(const wt588e02b_mock_config_t *config)
+{
+    uint8_t i;
+    
+    memset(gs_chip, 0, sizeof(gs_chip));                         /* clear all chips */
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)                /* loop all chips */
+    {
+        gs_chip[i].cs = 1;                                       /* cs high */
+    }
+    gs_config = *config;                                         /* save config */
+    gs_now_us = 0;                                               /* reset clock */
+    gs_seed = 0x5EED;                                            /* reset seed */
+    gs_sclk = 0;                                                 /* sclk low */
+    gs_mosi = 0;                                                 /* mosi low */
+    gs_cs_fault = 0;                                             /* no fault */
+}
+
+/**
+ * @brief     mock chip 1 cs gpio write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_wt588e02b_mock_cs1_gpio_write(uint8_t data)
+{
+    a_wt588e02b_mock_cs(&gs_chip[1], data);
+    
+    return 0;
+}
+
+/**
+ * @brief      mock chip 1 miso gpio read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static uint8_t a_wt588e02b_mock_miso1_gpio_read(uint8_t *data)
+{
+    *data = a_wt588e02b_mock_miso(&gs_chip[1]);
+    
+    return 0;
+}
+
+/**
+ * @brief     mock chip 2 cs gpio write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_wt588e02b_mock_cs2_gpio_write(uint8_t data)
+{
+    a_wt588e02b_mock_cs(&gs_chip[2], data);
+    
+    return 0;
+}
+
+/**
+ * @brief      mock chip 2 miso gpio read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static uint8_t a_wt588e02b_mock_miso2_gpio_read(uint8_t *data)
+{
+    *data = a_wt588e02b_mock_miso(&gs_chip[2]);
+    
+    return 0;
+}
+
+/**
+ * @brief     mock chip 3 cs gpio write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_wt588e02b_mock_cs3_gpio_write(uint8_t data)
+{
+    a_wt588e02b_mock_cs(&gs_chip[3], data);
+    
+    return 0;
+}
+
+/**
+ * @brief      mock chip 3 miso gpio read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static uint8_t a_wt588e02b_mock_miso3_gpio_read(uint8_t *data)
+{
+    *data = a_wt588e02b_mock_miso(&gs_chip[3]);
+    
+    return 0;
+}
+
+/**
+ * @brief mock ops table initializer
+ * @note  only the cs and miso hooks differ between the chips
+ */
+#define WT588E02B_MOCK_OPS(CS, MISO)                              \
+{                                                                 \
+    .sclk_gpio_init = wt588e02b_mock_gpio_init,                   \
+    .sclk_gpio_deinit = wt588e02b_mock_gpio_init,                 \
+    .sclk_gpio_write = wt588e02b_mock_sclk_gpio_write,            \
+    .mosi_gpio_init = wt588e02b_mock_gpio_init,                   \
+    .mosi_gpio_deinit = wt588e02b_mock_gpio_init,                 \
+    .mosi_gpio_write = wt588e02b_mock_mosi_gpio_write,            \
+    .miso_gpio_init = wt588e02b_mock_gpio_init,                   \
+    .miso_gpio_deinit = wt588e02b_mock_gpio_init,                 \
+    .miso_gpio_read = MISO,                                       \
+    .cs_gpio_init = wt588e02b_mock_gpio_init,                     \
+    .cs_gpio_deinit = wt588e02b_mock_gpio_init,                   \
+    .cs_gpio_write = CS,                                          \
+    .delay_ms = wt588e02b_mock_delay_ms,                          \
+    .delay_us = wt588e02b_mock_delay_us,                          \
+    .debug_print = wt588e02b_interface_debug_print,               \
+    .bin_read_init = wt588e02b_interface_bin_read_init,           \
+    .bin_read = wt588e02b_interface_bin_read,                     \
+    .bin_read_deinit = wt588e02b_interface_bin_read_deinit,       \
+    .timestamp_ms = wt588e02b_mock_timestamp_ms,                  \
+}
+
+/**
+ * @brief mock ops tables, one per chip
+ */
+static const wt588e02b_ops_t gs_ops[WT588E02B_MOCK_MAX_CHIP] =
+{
+    WT588E02B_MOCK_OPS(wt588e02b_mock_cs_gpio_write, wt588e02b_mock_miso_gpio_read),
+    WT588E02B_MOCK_OPS(a_wt588e02b_mock_cs1_gpio_write, a_wt588e02b_mock_miso1_gpio_read),
+    WT588E02B_MOCK_OPS(a_wt588e02b_mock_cs2_gpio_write, a_wt588e02b_mock_miso2_gpio_read),
+    WT588E02B_MOCK_OPS(a_wt588e02b_mock_cs3_gpio_write, a_wt588e02b_mock_miso3_gpio_read),
+};
+
+void wt588e02b_mock_link(wt588e02b_handle_t *handle)
+{
+#if (WT588E02B_HANDLE_LINK != 0)
+    DRIVER_WT588E02B_LINK_INIT(handle, wt588e02b_handle_t);
+    DRIVER_WT588E02B_LINK_SCLK_GPIO_INIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_SCLK_GPIO_DEINIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_SCLK_GPIO_WRITE(handle, wt588e02b_mock_sclk_gpio_write);
+    DRIVER_WT588E02B_LINK_MOSI_GPIO_INIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_MOSI_GPIO_DEINIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_MOSI_GPIO_WRITE(handle, wt588e02b_mock_mosi_gpio_write);
+    DRIVER_WT588E02B_LINK_MISO_GPIO_INIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_MISO_GPIO_DEINIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_MISO_GPIO_READ(handle, wt588e02b_mock_miso_gpio_read);
+    DRIVER_WT588E02B_LINK_CS_GPIO_INIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_CS_GPIO_DEINIT(handle, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_LINK_CS_GPIO_WRITE(handle, wt588e02b_mock_cs_gpio_write);
+    DRIVER_WT588E02B_LINK_BIN_READ_INIT(handle, wt588e02b_interface_bin_read_init);
+    DRIVER_WT588E02B_LINK_BIN_READ(handle, wt588e02b_interface_bin_read);
+    DRIVER_WT588E02B_LINK_BIN_READ_DEINIT(handle, wt588e02b_interface_bin_read_deinit);
+    DRIVER_WT588E02B_LINK_DELAY_MS(handle, wt588e02b_mock_delay_ms);
+    DRIVER_WT588E02B_LINK_DELAY_US(handle, wt588e02b_mock_delay_us);
+    DRIVER_WT588E02B_LINK_DEBUG_PRINT(handle, wt588e02b_interface_debug_print);
+    DRIVER_WT588E02B_LINK_TIMESTAMP_MS(handle, wt588e02b_mock_timestamp_ms);
+#else
+    DRIVER_WT588E02B_LINK_INIT(handle, wt588e02b_handle_t);
+    DRIVER_WT588E02B_LINK_OPS(handle, &gs_ops[0]);
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    DRIVER_WT588E02B_LINK_BUFFER(handle, gs_buf);
+#endif
+#endif
+}
+
+const wt588e02b_ops_t *wt588e02b_mock_ops(void)
+{
+    return &gs_ops[0];        /* return the table */
+}
+
+const wt588e02b_ops_t *wt588e02b_mock_chip_ops(uint8_t chip)
+{
+    if (chip >= WT588E02B_MOCK_MAX_CHIP)        /* check chip */
+    {
+        return NULL;                            /* no such chip */
+    }
+    
+    return &gs_ops[chip];                       /* return the table */
+}
+
+void wt588e02b_mock_bus_link(wt588e02b_bus_t *bus, uint8_t mask)
+{
+    DRIVER_WT588E02B_BUS_LINK_INIT(bus, wt588e02b_bus_t);
+    DRIVER_WT588E02B_BUS_LINK_SCLK_GPIO_INIT(bus, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_BUS_LINK_SCLK_GPIO_DEINIT(bus, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_BUS_LINK_SCLK_GPIO_WRITE(bus, wt588e02b_mock_sclk_gpio_write);
+    DRIVER_WT588E02B_BUS_LINK_MOSI_GPIO_INIT(bus, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_BUS_LINK_MOSI_GPIO_DEINIT(bus, wt588e02b_mock_gpio_init);
+    DRIVER_WT588E02B_BUS_LINK_MOSI_GPIO_WRITE(bus, wt588e02b_mock_mosi_gpio_write);
+    if (mask != 0)                                                                            /* check mask */
+    {
+        DRIVER_WT588E02B_BUS_LINK_CS_GPIO_WRITE_MASK(bus, wt588e02b_mock_cs_gpio_write_mask);
+        DRIVER_WT588E02B_BUS_LINK_MISO_GPIO_READ_MASK(bus, wt588e02b_mock_miso_gpio_read_mask);
+    }
+    DRIVER_WT588E02B_BUS_LINK_BIN_READ_INIT(bus, wt588e02b_interface_bin_read_init);
+    DRIVER_WT588E02B_BUS_LINK_BIN_READ(bus, wt588e02b_interface_bin_read);
+    DRIVER_WT588E02B_BUS_LINK_BIN_READ_DEINIT(bus, wt588e02b_interface_bin_read_deinit);
+    DRIVER_WT588E02B_BUS_LINK_DELAY_MS(bus, wt588e02b_mock_delay_ms);
+    DRIVER_WT588E02B_BUS_LINK_DELAY_US(bus, wt588e02b_mock_delay_us);
+    DRIVER_WT588E02B_BUS_LINK_DEBUG_PRINT(bus, wt588e02b_interface_debug_print);
+}
+
+void wt588e02b_mock_get_state(wt588e02b_mock_state_t *state)
+{
+    wt588e02b_mock_get_chip_state(0, state);        /* chip 0 */
+}
+
+void wt588e02b_mock_get_chip_state(uint8_t chip, wt588e02b_mock_state_t *state)
+{
+    if (chip >= WT588E02B_MOCK_MAX_CHIP)                                  /* check chip */
+    {
+        memset(state, 0, sizeof(wt588e02b_mock_state_t));                 /* no such chip */
+        
+        return;
+    }
+    gs_chip[chip].state.busy = a_wt588e02b_mock_is_busy(&gs_chip[chip]);  /* update busy */
+    *state = gs_chip[chip].state;                                         /* copy state */
+}
+
+void wt588e02b_mock_set_corrupt(uint8_t chip, uint32_t packet)
+{
+    if (chip < WT588E02B_MOCK_MAX_CHIP)              /* check chip */
+    {
+        gs_chip[chip].corrupt = packet;              /* set corrupt */
+    }
+}
+
+void wt588e02b_mock_set_cs_fault(uint32_t write)
+{
+    gs_cs_fault = write;                             /* set fault */
+}
+
+uint32_t wt588e02b_mock_timestamp_us(void)
+{
+    return (uint32_t)gs_now_us;
+}
+
+uint32_t wt588e02b_mock_timestamp_ms(void)
+{
+    return (uint32_t)(gs_now_us / 1000);
+}
+
+void wt588e02b_mock_delay_us(uint32_t us)
+{
+    gs_now_us += us;
+}
+
+void wt588e02b_mock_delay_ms(uint32_t ms)
+{
+    gs_now_us += (uint64_t)ms * 1000;
+}
+
+uint8_t wt588e02b_mock_gpio_init(void)
+{
+    return 0;
+}
+
+uint8_t wt588e02b_mock_sclk_gpio_write(uint8_t data)
+{
+    uint8_t i;
+    uint8_t selected;
+    
+    data = (data != 0) ? 1 : 0;                                    /* normalize */
+    if ((gs_sclk == 0) && (data == 1))                             /* rising edge */
+    {
+        selected = 0;                                              /* init 0 */
+        for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)              /* loop all chips */
+        {
+            if (gs_chip[i].cs == 0)                                /* check cs */
+            {
+                a_wt588e02b_mock_clock(&gs_chip[i]);               /* clock the chip */
+                selected = 1;                                      /* flag selected */
+            }
+        }
+        if (selected == 0)                                         /* clock without cs */
+        {
+            gs_chip[0].state.errors++;                             /* error */
+        }
+    }
+    gs_sclk = data;                                                /* save level */
+    
+    return 0;
+}
+
+uint8_t wt588e02b_mock_mosi_gpio_write(uint8_t data)
+{
+    gs_mosi = (data != 0) ? 1 : 0;
+    
+    return 0;
+}
+
+uint8_t wt588e02b_mock_miso_gpio_read(uint8_t *data)
+{
+    *data = a_wt588e02b_mock_miso(&gs_chip[0]);        /* chip 0 */
+    
+    return 0;
+}
+
+uint8_t wt588e02b_mock_cs_gpio_write(uint8_t data)
+{
+    if (gs_cs_fault != 0)                              /* check the fault */
+    {
+        gs_cs_fault--;                                 /* count the write */
+        if (gs_cs_fault == 0)                          /* this write fails */
+        {
+            return 1;                                  /* the level is kept */
+        }
+    }
+    a_wt588e02b_mock_cs(&gs_chip[0], data);            /* chip 0 */
+    
+    return 0;
+}
+
+uint8_t wt588e02b_mock_cs_gpio_write_mask(uint32_t mask, uint8_t data)
+{
+    uint8_t i;
+    
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)              /* loop all chips */
+    {
+        if ((mask & (1UL << i)) != 0)                          /* check the chip */
+        {
+            a_wt588e02b_mock_cs(&gs_chip[i], data);            /* same edge for all */
+        }
+    }
+    
+    return 0;
+}
+
+uint8_t wt588e02b_mock_miso_gpio_read_mask(uint32_t *data)
+{
+    uint8_t i;
+    
+    *data = 0;                                                 /* init 0 */
+    for (i = 0; i < WT588E02B_MOCK_MAX_CHIP; i++)              /* loop all chips */
+    {
+        if (a_wt588e02b_mock_miso(&gs_chip[i]) != 0)           /* check level */
+        {
+            *data |= 1UL << i;                                 /* set bit */
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_mock.h
+ * @brief     driver wt588e02b mock header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_WT588E02B_MOCK_H
+#define DRIVER_WT588E02B_MOCK_H
+
+#include "driver_wt588e02b_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup wt588e02b_test_driver
+ * @{
+ */
+
+/**
+ * @brief wt588e02b mock max chip definition
+ */
+#define WT588E02B_MOCK_MAX_CHIP        4        /**< chips sharing the mock sclk and mosi */
+
+/**
+ * @brief wt588e02b mock config structure definition
+ */
+typedef struct wt588e02b_mock_config_s
+{
+    uint32_t play_response_us;        /**< time from the play frame end to busy */
+    uint32_t stop_response_us;        /**< time from the stop frame end to idle */
+    uint32_t jitter_us;               /**< max random extra response time */
+    uint32_t clip_us;                 /**< length of every voice */
+} wt588e02b_mock_config_t;
+
+/**
+ * @brief wt588e02b mock state structure definition
+ */
+typedef struct wt588e02b_mock_state_s
+{
+    uint32_t frames;                  /**< decoded frames */
+    uint32_t packets;                 /**< decoded update packets */
+    uint32_t errors;                  /**< protocol violations */
+    uint8_t vol;                      /**< last volume */
+    uint8_t loop_mode;                /**< last loop mode */
+    uint8_t ind;                      /**< last played index */
+    uint8_t list_len;                 /**< last play list length */
+    uint8_t list[40];                 /**< last play list */
+    uint8_t command;                  /**< last command */
+    uint16_t sum;                     /**< last update packet sum */
+    uint8_t busy;                     /**< busy level now */
+} wt588e02b_mock_state_t;
+
+/**
+ * @brief     mock init
+ * @param[in] *config pointer to a mock config structure
+ * @note      resets the virtual clock and every chip model,
+ *            the model has no lock, frames from unserialized threads show up as protocol errors
+ */
+void wt588e02b_mock_init(const wt588e02b_mock_config_t *config);
+
+/**
+ * @brief     mock link
+ * @param[in] *handle pointer to a wt588e02b handle structure
+ * @note      links every hook of the handle to the mock,
+ *            without the handle link table it shares the mock ops table and one mock update buffer,
+ *            so the handles linked to it must not be updated at once
+ */
+void wt588e02b_mock_link(wt588e02b_handle_t *handle);
+
+/**
+ * @brief  mock get the ops table
+ * @return pointer to a const ops table of the mock
+ * @note   the table can be shared by any number of handles
+ */
+const wt588e02b_ops_t *wt588e02b_mock_ops(void);
+
+/**
+ * @brief     mock get the ops table of one chip
+ * @param[in] chip chip number
+ * @return    pointer to a const ops table, NULL if chip >= WT588E02B_MOCK_MAX_CHIP
+ * @note      every table drives the shared sclk and mosi and its own cs and miso,
+ *            chip 0 is the table of wt588e02b_mock_ops
+ */
+const wt588e02b_ops_t *wt588e02b_mock_chip_ops(uint8_t chip);
+
+/**
+ * @brief     mock bus link
+ * @param[in] *bus pointer to a wt588e02b bus structure
+ * @param[in] mask 1 links the cs and miso mask hooks, 0 leaves the per chip hooks in use
+ * @note      none
+ */
+void wt588e02b_mock_bus_link(wt588e02b_bus_t *bus, uint8_t mask);
+
+/**
+ * @brief      mock get state
+ * @param[out] *state pointer to a mock state structure
+ * @note       none
+ */
+void wt588e02b_mock_get_state(wt588e02b_mock_state_t *state);
+
+/**
+ * @brief      mock get the state of one chip
+ * @param[in]  chip chip number
+ * @param[out] *state pointer to a mock state structure
+ * @note       a chip >= WT588E02B_MOCK_MAX_CHIP reads as all zero
+ */
+void wt588e02b_mock_get_chip_state(uint8_t chip, wt588e02b_mock_state_t *state);
+
+/**
+ * @brief     mock corrupt the update of one chip
+ * @param[in] chip chip number
+ * @param[in] packet first packet with a wrong sum, 1 is the first packet, 0 disables
+ * @note      the chip then reports a wrong status sum like a flash write error
+ */
+void wt588e02b_mock_set_corrupt(uint8_t chip, uint32_t packet);
+
+/**
+ * @brief     mock fail a cs write of chip 0
+ * @param[in] write the write that fails, 1 is the next cs write, 0 disables
+ * @note      the failed write returns 1 and keeps the cs level, like a broken gpio
+ */
+void wt588e02b_mock_set_cs_fault(uint32_t write);
+
+/**
+ * @brief  mock timestamp us
+ * @return virtual time in us
+ * @note   none
+ */
+uint32_t wt588e02b_mock_timestamp_us(void);
+
+/**
+ * @brief  mock timestamp ms
+ * @return virtual time in ms
+ * @note   none
+ */
+uint32_t wt588e02b_mock_timestamp_ms(void);
+
+/**
+ * @brief     mock delay us
+ * @param[in] us time
+ * @note      advances the virtual clock
+ */
+void wt588e02b_mock_delay_us(uint32_t us);
+
+/**
+ * @brief     mock delay ms
+ * @param[in] ms time
+ * @note      advances the virtual clock
+ */
+void wt588e02b_mock_delay_ms(uint32_t ms);
+
+/**
+ * @brief  mock gpio init
+ * @return status code
+ *         - 0 success
+ * @note   shared by all init and deinit hooks
+ */
+uint8_t wt588e02b_mock_gpio_init(void);
+
+/**
+ * @brief     mock sclk gpio write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wt588e02b_mock_sclk_gpio_write(uint8_t data);
+
+/**
+ * @brief     mock mosi gpio write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wt588e02b_mock_mosi_gpio_write(uint8_t data);
+
+/**
+ * @brief      mock miso gpio read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       chip 0, low means busy outside a status frame
+ */
+uint8_t wt588e02b_mock_miso_gpio_read(uint8_t *data);
+
+/**
+ * @brief     mock cs gpio write
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      chip 0, a rising edge ends and decodes the frame
+ */
+uint8_t wt588e02b_mock_cs_gpio_write(uint8_t data);
+
+/**
+ * @brief     mock cs gpio write of several chips
+ * @param[in] mask chip mask
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ * @note      all chips in the mask see the same edge
+ */
+uint8_t wt588e02b_mock_cs_gpio_write_mask(uint32_t mask, uint8_t data);
+
+/**
+ * @brief      mock miso gpio read of all chips
+ * @param[out] *data pointer to a level mask buffer
+ * @return     status code
+ *             - 0 success
+ * @note       one bit per chip
+ */
+uint8_t wt588e02b_mock_miso_gpio_read_mask(uint32_t *data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
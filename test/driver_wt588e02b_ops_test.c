@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_ops_test.c
+ * @brief     driver wt588e02b ops test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_wt588e02b_ops_test.h"
+#include "driver_wt588e02b_mock.h"
+#include <stddef.h>
+
+/**
+ * @brief wt588e02b baseline handle structure definition
+ * @note  the layout before the ops table split, every handle carried the links and the buffer
+ */
+typedef struct wt588e02b_ops_baseline_s
+{
+    uint8_t (*sclk_gpio_init)(void);                                           /**< point to a sclk_gpio_init function address */
+    uint8_t (*sclk_gpio_deinit)(void);                                         /**< point to a sclk_gpio_deinit function address */
+    uint8_t (*sclk_gpio_write)(uint8_t data);                                  /**< point to a sclk_gpio_write function address */
+    uint8_t (*mosi_gpio_init)(void);                                           /**< point to a mosi_gpio_init function address */
+    uint8_t (*mosi_gpio_deinit)(void);                                         /**< point to a mosi_gpio_deinit function address */
+    uint8_t (*mosi_gpio_write)(uint8_t data);                                  /**< point to a mosi_gpio_write function address */
+    uint8_t (*miso_gpio_init)(void);                                           /**< point to a miso_gpio_init function address */
+    uint8_t (*miso_gpio_deinit)(void);                                         /**< point to a miso_gpio_deinit function address */
+    uint8_t (*miso_gpio_read)(uint8_t *data);                                  /**< point to a miso_gpio_read function address */
+    uint8_t (*cs_gpio_init)(void);                                             /**< point to a cs_gpio_init function address */
+    uint8_t (*cs_gpio_deinit)(void);                                           /**< point to a cs_gpio_deinit function address */
+    uint8_t (*cs_gpio_write)(uint8_t data);                                    /**< point to a cs_gpio_write function address */
+    void (*delay_ms)(uint32_t ms);                                             /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                             /**< point to a delay_us function address */
+    void (*debug_print)(const char *const fmt, ...);                           /**< point to a debug_print function address */
+    uint8_t (*bin_read_init)(char *name, uint32_t *size);                      /**< point to a bin_read_init function address */
+    uint8_t (*bin_read)(uint32_t addr, uint16_t size, uint8_t *buffer);        /**< point to a bin_read function address */
+    uint8_t (*bin_read_deinit)(void);                                          /**< point to a bin_read_deinit function address */
+    uint8_t inited;                                                            /**< inited flag */
+    uint16_t sum;                                                              /**< sum */
+    uint8_t buf[512];                                                          /**< inner buffer */
+} wt588e02b_ops_baseline_t;
+
+static wt588e02b_handle_t gs_handle[WT588E02B_OPS_TEST_CHIP];        /**< wt588e02b handles */
+
+/**
+ * @brief  handle size with the link table and buffer
+ * @return size in bytes
+ * @note   none
+ */
+static uint32_t a_wt588e02b_ops_link_size(void)
+{
+#if (WT588E02B_HANDLE_LINK != 0)
+    return (uint32_t)sizeof(wt588e02b_handle_t);
+#elif (WT588E02B_FEATURE_UPDATE != 0)
+    return (uint32_t)(sizeof(wt588e02b_handle_t) + sizeof(wt588e02b_ops_t) + 512);
+#else
+    return (uint32_t)(sizeof(wt588e02b_handle_t) + sizeof(wt588e02b_ops_t));
+#endif
+}
+
+/**
+ * @brief  handle size with a shared ops table
+ * @return size in bytes
+ * @note   none
+ */
+static uint32_t a_wt588e02b_ops_shared_size(void)
+{
+#if (WT588E02B_HANDLE_LINK != 0)
+    uint32_t align = (uint32_t)sizeof(void *);
+    
+    return (((uint32_t)offsetof(wt588e02b_handle_t, link) + align - 1) / align) * align;
+#else
+    return (uint32_t)sizeof(wt588e02b_handle_t);
+#endif
+}
+
+/**
+ * @brief  ops test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs play only chips on the mock chip with one const ops table and no update buffer,
+ *         checks that the update is refused and prints the handle size against the baseline layout,
+ *         the caller owned log ring, coalescing queue and duration table are not counted
+ */
+uint8_t wt588e02b_ops_test(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint32_t frames;
+    uint32_t baseline_size;
+    uint32_t link_size;
+    uint32_t shared_size;
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+    
+    /* link driver */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = 200000;
+    wt588e02b_mock_init(&config);
+    for (i = 0; i < WT588E02B_OPS_TEST_CHIP; i++)
+    {
+        DRIVER_WT588E02B_LINK_INIT(&gs_handle[i], wt588e02b_handle_t);
+        DRIVER_WT588E02B_LINK_OPS(&gs_handle[i], wt588e02b_mock_ops());
+        DRIVER_WT588E02B_LINK_BUFFER(&gs_handle[i], NULL);
+    }
+    
+    /* start ops test */
+    wt588e02b_interface_debug_print("wt588e02b: start ops test.\n");
+    
+    /* init */
+    for (i = 0; i < WT588E02B_OPS_TEST_CHIP; i++)
+    {
+        res = wt588e02b_init(&gs_handle[i]);
+        if (res != 0)
+        {
+            wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* play and stop on every chip */
+    wt588e02b_mock_get_state(&state);
+    frames = state.frames;
+    for (i = 0; i < WT588E02B_OPS_TEST_CHIP; i++)
+    {
+        if ((wt588e02b_play(&gs_handle[i], i) != 0) || (wt588e02b_stop(&gs_handle[i]) != 0))
+        {
+            wt588e02b_interface_debug_print("wt588e02b: play failed.\n");
+            
+            return 1;
+        }
+    }
+    wt588e02b_mock_get_state(&state);
+    if ((state.frames - frames != 2 * WT588E02B_OPS_TEST_CHIP) || (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: play check failed.\n");
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: %d chips played with one ops table.\n", WT588E02B_OPS_TEST_CHIP);
+    
+#if (WT588E02B_FEATURE_UPDATE != 0)
+    /* the update needs a buffer */
+    res = wt588e02b_update(&gs_handle[0], 0, "update.bin");
+    if (res != 4)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: update check failed.\n");
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: update without a buffer is refused.\n");
+#endif
+    
+    /* size report */
+    baseline_size = (uint32_t)sizeof(wt588e02b_ops_baseline_t);
+    link_size = a_wt588e02b_ops_link_size();
+    shared_size = a_wt588e02b_ops_shared_size();
+    wt588e02b_interface_debug_print("wt588e02b: ops table is %d bytes and can live in flash.\n", (int)sizeof(wt588e02b_ops_t));
+    wt588e02b_interface_debug_print("wt588e02b: baseline handle is %d bytes.\n", (int)baseline_size);
+    wt588e02b_interface_debug_print("wt588e02b: handle with the link table and buffer is %d bytes.\n", (int)link_size);
+    wt588e02b_interface_debug_print("wt588e02b: handle with a shared ops table is %d bytes.\n", (int)shared_size);
+    wt588e02b_interface_debug_print("wt588e02b: %d play only chips use %d bytes instead of %d bytes.\n",
+                                    WT588E02B_OPS_TEST_CHIP, (int)(shared_size * WT588E02B_OPS_TEST_CHIP),
+                                    (int)(baseline_size * WT588E02B_OPS_TEST_CHIP));
+    
+    /* deinit */
+    for (i = 0; i < WT588E02B_OPS_TEST_CHIP; i++)
+    {
+        (void)wt588e02b_deinit(&gs_handle[i]);
+    }
+    
+    /* finish ops test */
+    wt588e02b_interface_debug_print("wt588e02b: finish ops test.\n");
+    
+    return 0;
+}
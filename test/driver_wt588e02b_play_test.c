@@ -39,6 +39,34 @@
 
 static wt588e02b_handle_t gs_handle;        /**< wt588e02b handle */
 
+/**
+ * @brief wt588e02b ops table, it is const and lives in flash
+ */
+static const wt588e02b_ops_t gs_ops =
+{
+    .sclk_gpio_init = wt588e02b_interface_sclk_gpio_init,
+    .sclk_gpio_deinit = wt588e02b_interface_sclk_gpio_deinit,
+    .sclk_gpio_write = wt588e02b_interface_sclk_gpio_write,
+    .mosi_gpio_init = wt588e02b_interface_mosi_gpio_init,
+    .mosi_gpio_deinit = wt588e02b_interface_mosi_gpio_deinit,
+    .mosi_gpio_write = wt588e02b_interface_mosi_gpio_write,
+    .miso_gpio_init = wt588e02b_interface_miso_gpio_init,
+    .miso_gpio_deinit = wt588e02b_interface_miso_gpio_deinit,
+    .miso_gpio_read = wt588e02b_interface_miso_gpio_read,
+    .cs_gpio_init = wt588e02b_interface_cs_gpio_init,
+    .cs_gpio_deinit = wt588e02b_interface_cs_gpio_deinit,
+    .cs_gpio_write = wt588e02b_interface_cs_gpio_write,
+    .bin_read_init = wt588e02b_interface_bin_read_init,
+    .bin_read = wt588e02b_interface_bin_read,
+    .bin_read_deinit = wt588e02b_interface_bin_read_deinit,
+    .delay_ms = wt588e02b_interface_delay_ms,
+    .delay_us = wt588e02b_interface_delay_us,
+    .debug_print = wt588e02b_interface_debug_print,
+    .timestamp_ms = wt588e02b_interface_timestamp_ms,
+    .lock = wt588e02b_interface_lock,
+    .unlock = wt588e02b_interface_unlock,
+};
+
 /**
  * @brief     play test
  * @param[in] ind index
@@ -56,24 +84,7 @@ uint8_t wt588e02b_play_test(uint8_t ind)
 
     /* link driver */
     DRIVER_WT588E02B_LINK_INIT(&gs_handle, wt588e02b_handle_t);
-    DRIVER_WT588E02B_LINK_SCLK_GPIO_INIT(&gs_handle, wt588e02b_interface_sclk_gpio_init);
-    DRIVER_WT588E02B_LINK_SCLK_GPIO_DEINIT(&gs_handle, wt588e02b_interface_sclk_gpio_deinit);
-    DRIVER_WT588E02B_LINK_SCLK_GPIO_WRITE(&gs_handle, wt588e02b_interface_sclk_gpio_write);
-    DRIVER_WT588E02B_LINK_MOSI_GPIO_INIT(&gs_handle, wt588e02b_interface_mosi_gpio_init);
-    DRIVER_WT588E02B_LINK_MOSI_GPIO_DEINIT(&gs_handle, wt588e02b_interface_mosi_gpio_deinit);
-    DRIVER_WT588E02B_LINK_MOSI_GPIO_WRITE(&gs_handle, wt588e02b_interface_mosi_gpio_write);
-    DRIVER_WT588E02B_LINK_MISO_GPIO_INIT(&gs_handle, wt588e02b_interface_miso_gpio_init);
-    DRIVER_WT588E02B_LINK_MISO_GPIO_DEINIT(&gs_handle, wt588e02b_interface_miso_gpio_deinit);
-    DRIVER_WT588E02B_LINK_MISO_GPIO_READ(&gs_handle, wt588e02b_interface_miso_gpio_read);
-    DRIVER_WT588E02B_LINK_CS_GPIO_INIT(&gs_handle, wt588e02b_interface_cs_gpio_init);
-    DRIVER_WT588E02B_LINK_CS_GPIO_DEINIT(&gs_handle, wt588e02b_interface_cs_gpio_deinit);
-    DRIVER_WT588E02B_LINK_CS_GPIO_WRITE(&gs_handle, wt588e02b_interface_cs_gpio_write);
-    DRIVER_WT588E02B_LINK_BIN_READ_INIT(&gs_handle, wt588e02b_interface_bin_read_init);
-    DRIVER_WT588E02B_LINK_BIN_READ(&gs_handle, wt588e02b_interface_bin_read);
-    DRIVER_WT588E02B_LINK_BIN_READ_DEINIT(&gs_handle, wt588e02b_interface_bin_read_deinit);
-    DRIVER_WT588E02B_LINK_DELAY_MS(&gs_handle, wt588e02b_interface_delay_ms);
-    DRIVER_WT588E02B_LINK_DELAY_US(&gs_handle, wt588e02b_interface_delay_us);
-    DRIVER_WT588E02B_LINK_DEBUG_PRINT(&gs_handle, wt588e02b_interface_debug_print);
+    DRIVER_WT588E02B_LINK_OPS(&gs_handle, &gs_ops);
 
     /* get information */
     res = wt588e02b_info(&info);
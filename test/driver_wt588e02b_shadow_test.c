@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_shadow_test.c
+ * @brief     driver wt588e02b shadow test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_shadow_test.h"
+#include "driver_wt588e02b_mock.h"
+
+static wt588e02b_handle_t gs_handle;        /**< wt588e02b handle */
+#if (WT588E02B_FEATURE_SHADOW != 0)
+static wt588e02b_log_t gs_log;              /**< deferred log ring */
+static uint32_t gs_frames;                  /**< frames before the step */
+static uint32_t gs_skipped;                 /**< expected skipped frames */
+
+/**
+ * @brief     check the frames sent since the last check
+ * @param[in] frames expected new frames
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_wt588e02b_shadow_test_frames(uint32_t frames)
+{
+    wt588e02b_mock_state_t state;
+    
+    wt588e02b_mock_get_state(&state);                          /* get state */
+    if ((state.frames - gs_frames != frames) ||                /* check frames */
+        (state.errors != 0))                                   /* check errors */
+    {
+        return 1;                                              /* return error */
+    }
+    gs_frames = state.frames;                                  /* save frames */
+    
+    return 0;                                                  /* success return 0 */
+}
+#endif
+
+/**
+ * @brief  shadow test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs on the mock chip with the shadow state enabled, checks that a repeated volume,
+ *         loop or stop is skipped without a frame and that a failed frame, a raw transfer
+ *         or wt588e02b_shadow_invalidate sends the next command again
+ */
+uint8_t wt588e02b_shadow_test(void)
+{
+#if (WT588E02B_FEATURE_SHADOW != 0)
+    uint8_t res;
+    uint8_t cmd[2];
+    uint16_t len;
+    uint32_t lost;
+    wt588e02b_bool_t enable;
+    wt588e02b_segment_t seg;
+    wt588e02b_log_record_t record[4];
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+#if (WT588E02B_FEATURE_STATS != 0)
+    wt588e02b_stats_t stats;
+#endif
+    
+    /* link driver */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = 200000;
+    wt588e02b_mock_init(&config);
+    wt588e02b_mock_link(&gs_handle);
+    
+    /* start shadow test */
+    wt588e02b_interface_debug_print("wt588e02b: start shadow test.\n");
+    
+    /* init */
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        
+        return 1;
+    }
+    res = wt588e02b_set_shadow(&gs_handle, WT588E02B_BOOL_TRUE);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: set shadow failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+#if (WT588E02B_FEATURE_STATS != 0)
+    (void)wt588e02b_clear_stats(&gs_handle);
+#endif
+    wt588e02b_mock_get_state(&state);
+    gs_frames = state.frames;
+    gs_skipped = 0;
+    
+    /* a repeated volume is skipped */
+    res = wt588e02b_set_vol(&gs_handle, 0x20);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    res |= wt588e02b_set_vol(&gs_handle, 0x20);
+    res |= a_wt588e02b_shadow_test_frames(0);
+    res |= wt588e02b_set_vol(&gs_handle, 0x21);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    gs_skipped += 1;
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: volume skip check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: the same volume is skipped, a new one is sent.\n");
+    
+#if (WT588E02B_FEATURE_LOOP != 0)
+    /* re-arming the running loop is skipped */
+    res = wt588e02b_play_loop(&gs_handle, 3);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    wt588e02b_mock_delay_ms(50);
+    res |= wt588e02b_check_busy(&gs_handle, &enable);
+    res |= wt588e02b_play_loop(&gs_handle, 3);
+    res |= a_wt588e02b_shadow_test_frames(0);
+    gs_skipped += 1;
+    if ((res != 0) || (enable != WT588E02B_BOOL_TRUE))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: loop skip check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: re-arming the running loop is skipped.\n");
+#endif
+    
+    /* a stop is skipped once the chip is known idle */
+    res = wt588e02b_stop(&gs_handle);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    res |= wt588e02b_stop(&gs_handle);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    wt588e02b_mock_delay_ms(50);
+    res |= wt588e02b_check_busy(&gs_handle, &enable);
+    res |= wt588e02b_stop(&gs_handle);
+    res |= a_wt588e02b_shadow_test_frames(0);
+    gs_skipped += 1;
+    if ((res != 0) || (enable != WT588E02B_BOOL_FALSE))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: stop skip check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: a stop is skipped after idle is seen.\n");
+    
+    /* a failed frame sends the next one again, its error goes to the ring */
+    (void)wt588e02b_set_log(&gs_handle, &gs_log);
+    wt588e02b_mock_set_cs_fault(1);
+    if (wt588e02b_set_vol(&gs_handle, 0x30) != 1)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: fault check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    len = 4;
+    res = wt588e02b_log_read(&gs_handle, record, &len, &lost);
+    (void)wt588e02b_set_log(&gs_handle, NULL);
+#if (WT588E02B_LOG_LEVEL != WT588E02B_LOG_LEVEL_NONE)
+    res |= (len == 0) ? 1 : 0;
+#endif
+    res |= a_wt588e02b_shadow_test_frames(0);
+    res |= wt588e02b_set_vol(&gs_handle, 0x21);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    res |= wt588e02b_set_vol(&gs_handle, 0x21);
+    res |= a_wt588e02b_shadow_test_frames(0);
+    gs_skipped += 1;
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.vol != 0x21))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: pending check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: a broken frame sends the cached volume again.\n");
+    
+    /* a raw transfer sends the next one again */
+    cmd[0] = 0xF1;
+    cmd[1] = 0x10;
+    seg.dir = WT588E02B_SEGMENT_WRITE;
+    seg.buf = cmd;
+    seg.len = 2;
+    seg.half_us = 100;
+    seg.gap_us = 5000;
+    res = wt588e02b_transfer(&gs_handle, &seg, 1);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    res |= wt588e02b_set_vol(&gs_handle, 0x21);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.vol != 0x21))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: raw transfer check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: a raw transfer sends the cached volume again.\n");
+    
+    /* an invalidation sends the next one again */
+    res = wt588e02b_shadow_invalidate(&gs_handle);
+    res |= wt588e02b_set_vol(&gs_handle, 0x21);
+    res |= a_wt588e02b_shadow_test_frames(1);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: invalidate check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: an invalidation sends the cached volume again.\n");
+    
+#if (WT588E02B_FEATURE_STATS != 0)
+    /* the counters */
+    res = wt588e02b_get_stats(&gs_handle, &stats);
+    if ((res != 0) || (stats.skipped != gs_skipped))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: stats check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: sent %d frames and skipped %d.\n", (int)stats.sent, (int)stats.skipped);
+#endif
+    
+    /* deinit */
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    /* finish shadow test */
+    wt588e02b_interface_debug_print("wt588e02b: finish shadow test.\n");
+    
+    return 0;
+#else
+    (void)gs_handle;
+    wt588e02b_interface_debug_print("wt588e02b: shadow state is compiled out.\n");
+    
+    return 0;
+#endif
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_wt588e02b_transfer_test.c
+ * @brief     driver wt588e02b transfer test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_wt588e02b_transfer_test.h"
+#include "driver_wt588e02b_mock.h"
+
+static wt588e02b_handle_t gs_handle;        /**< wt588e02b handle */
+static uint8_t gs_pack[512];                /**< data packet */
+
+/**
+ * @brief  transfer test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs on the mock chip, sends a command, a data packet and a status frame with
+ *         mixed write and read segments and compares the frame time with wt588e02b_set_reg
+ */
+uint8_t wt588e02b_transfer_test(void)
+{
+    uint8_t res;
+    uint8_t cmd[2];
+    uint8_t rx[2];
+    uint16_t i;
+    uint16_t sum;
+    uint32_t t;
+    uint32_t transfer_us;
+    uint32_t reg_us;
+    wt588e02b_segment_t seg[2];
+    wt588e02b_mock_config_t config;
+    wt588e02b_mock_state_t state;
+    
+    /* link driver */
+    config.play_response_us = 15000;
+    config.stop_response_us = 3000;
+    config.jitter_us = 0;
+    config.clip_us = 200000;
+    wt588e02b_mock_init(&config);
+    wt588e02b_mock_link(&gs_handle);
+    
+    /* start transfer test */
+    wt588e02b_interface_debug_print("wt588e02b: start transfer test.\n");
+    
+    /* init */
+    res = wt588e02b_init(&gs_handle);
+    if (res != 0)
+    {
+        wt588e02b_interface_debug_print("wt588e02b: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* a play command with one lead gap */
+    cmd[0] = 0xF0;
+    cmd[1] = 0x05;
+    seg[0].dir = WT588E02B_SEGMENT_WRITE;
+    seg[0].buf = cmd;
+    seg[0].len = 2;
+    seg[0].half_us = 100;
+    seg[0].gap_us = 5000;
+    t = wt588e02b_mock_timestamp_us();
+    res = wt588e02b_transfer(&gs_handle, seg, 1);
+    transfer_us = wt588e02b_mock_timestamp_us() - t;
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != 1) || (state.ind != 0x05) || (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: command check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the same command with a 5ms wait per byte */
+    t = wt588e02b_mock_timestamp_us();
+    res = wt588e02b_set_reg(&gs_handle, cmd, 2, 100);
+    reg_us = wt588e02b_mock_timestamp_us() - t;
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != 2) || (state.errors != 0) || (transfer_us >= reg_us))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: set reg check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: command frame takes %dus with transfer and %dus with set reg.\n",
+                                    (int)transfer_us, (int)reg_us);
+    
+    /* a data packet at line rate */
+    sum = 0;
+    for (i = 0; i < 512; i++)
+    {
+        gs_pack[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (i = 0; i < 512; i += 2)
+    {
+        sum = (uint16_t)(sum + (uint16_t)(gs_pack[i] | ((uint16_t)gs_pack[i + 1] << 8)));
+    }
+    seg[0].dir = WT588E02B_SEGMENT_WRITE;
+    seg[0].buf = gs_pack;
+    seg[0].len = 512;
+    seg[0].half_us = 2;
+    seg[0].gap_us = 0;
+    t = wt588e02b_mock_timestamp_us();
+    res = wt588e02b_transfer(&gs_handle, seg, 1);
+    transfer_us = wt588e02b_mock_timestamp_us() - t;
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.packets != 1) || (state.sum != sum) || (state.errors != 0))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: packet check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: 512 bytes packet takes %dus in one segment.\n", (int)transfer_us);
+    
+    /* a status frame with a write and a read segment */
+    cmd[0] = 0xDF;
+    rx[0] = 0;
+    rx[1] = 0;
+    seg[0].dir = WT588E02B_SEGMENT_WRITE;
+    seg[0].buf = cmd;
+    seg[0].len = 1;
+    seg[0].half_us = 20;
+    seg[0].gap_us = 5000;
+    seg[1].dir = WT588E02B_SEGMENT_READ;
+    seg[1].buf = rx;
+    seg[1].len = 2;
+    seg[1].half_us = 20;
+    seg[1].gap_us = 20;
+    res = wt588e02b_transfer(&gs_handle, seg, 2);
+    wt588e02b_mock_get_state(&state);
+    if ((res != 0) || (state.frames != 3) || (state.errors != 0) ||
+        ((uint16_t)(rx[0] | ((uint16_t)rx[1] << 8)) != sum))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: status check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: status 0x%04X read back in one frame.\n", sum);
+    
+    /* invalid segments */
+    seg[1].buf = NULL;
+    if ((wt588e02b_transfer(&gs_handle, seg, 0) != 4) || (wt588e02b_transfer(&gs_handle, seg, 2) != 4))
+    {
+        wt588e02b_interface_debug_print("wt588e02b: segment check failed.\n");
+        (void)wt588e02b_deinit(&gs_handle);
+        
+        return 1;
+    }
+    wt588e02b_interface_debug_print("wt588e02b: invalid segments are refused.\n");
+    
+    /* deinit */
+    (void)wt588e02b_deinit(&gs_handle);
+    
+    /* finish transfer test */
+    wt588e02b_interface_debug_print("wt588e02b: finish transfer test.\n");
+    
+    return 0;
+}